@@ -0,0 +1,67 @@
+#pragma once
+
+/**
+ * App registry.
+ *
+ * Each app describes itself with a ui_app_t; the launcher builds its button
+ * row from the registry in ui_app.c. An app allocates its screen and heavy
+ * buffers in create() and releases them in destroy(), so nothing but its
+ * descriptor and small static state is resident while it isn't open. The
+ * launcher screen itself is released while an app runs.
+ */
+
+#include "lvgl.h"
+#include "ui_mem.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief App descriptor (const, lives in flash)
+ */
+typedef struct {
+    const char *name;
+    const char *icon;           // LV_SYMBOL_* glyph for the launcher button
+    uint32_t color;             // Accent colour, 0xRRGGBB
+    ui_mem_app_t mem_app;       // Heap attribution tag
+    size_t mem_budget;          // Bytes the app may hold through ui_mem while open, 0 = unchecked
+    void (*create)(void);       // Build and load the app screen, allocate its buffers
+    void (*destroy)(void);      // Free everything create() allocated, NULL if nothing to do
+} ui_app_t;
+
+/**
+ * @brief Number of registered apps
+ */
+size_t ui_app_count(void);
+
+/**
+ * @brief Registered app @p i in launcher order (NULL if out of range)
+ */
+const ui_app_t *ui_app_get(size_t i);
+
+/**
+ * @brief App currently open, NULL on the launcher
+ */
+const ui_app_t *ui_app_current(void);
+
+/**
+ * @brief Open @p app and release the launcher screen
+ * Safe to call from a launcher event callback.
+ */
+void ui_app_launch(const ui_app_t *app);
+
+/**
+ * @brief Close the current app and return to the launcher
+ * Loads the launcher, then - once the calling event is done, so it is safe
+ * from an event on the app's screen - runs the app's destroy hook, checks
+ * its heap budget, flags blocks it still owns as leaks and logs the heap it
+ * gave back. destroy() therefore runs with the launcher as the active screen.
+ */
+void ui_app_exit(void);
+
+#ifdef __cplusplus
+}
+#endif
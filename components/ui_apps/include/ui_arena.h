@@ -0,0 +1,89 @@
+#pragma once
+
+/**
+ * Per-screen arenas for LVGL allocations.
+ *
+ * With CONFIG_LV_USE_CUSTOM_MALLOC, LVGL's lv_malloc/lv_free go through
+ * ui_arena.c. Between ui_arena_begin() and ui_arena_end(), small LVGL
+ * allocations made by the calling task (objects, styles, label text) are
+ * carved from size-class slabs in a few large chunks instead of the shared
+ * heap. When the bound screen is deleted and its last block is freed, the
+ * chunks go back to the heap in one shot, so rebuilding screens does not
+ * leave small holes scattered across the heap.
+ *
+ * Blocks that outlive the screen (e.g. something global created during
+ * construction) keep the arena "pinned" until they are freed; only the
+ * chunks they sit in are kept, and this shows up in the stats.
+ *
+ * The slabs themselves are in ui_arena_core.c; tools/arena_soak.c runs them
+ * through screen build/delete cycles on the host. The arenas are off by
+ * default (CONFIG_UI_ARENA) until they leave the heap less fragmented than
+ * plain malloc there.
+ */
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ui_arena ui_arena_t;
+
+/**
+ * @brief Allocator and heap fragmentation counters
+ */
+typedef struct {
+    uint32_t arenas_open;       // Screens still being built or alive
+    uint32_t arenas_pinned;     // Screens deleted but blocks still alive
+    uint32_t chunks;            // Arena chunks currently held
+    size_t arena_held_bytes;    // Chunk memory currently held
+    size_t arena_live_bytes;    // Bytes in live arena blocks
+    uint32_t arena_allocs;      // LVGL allocations served from arenas
+    uint32_t heap_allocs;       // LVGL allocations served from the heap
+    uint32_t releases;          // Arenas returned to the heap in one shot
+    size_t internal_free;
+    size_t internal_largest;
+    uint8_t internal_frag_pct;  // 100 - largest free block / free bytes
+    size_t spiram_free;
+    size_t spiram_largest;
+    uint8_t spiram_frag_pct;
+} ui_arena_stats_t;
+
+/**
+ * @brief Route this task's LVGL allocations into a fresh arena
+ * Call with the LVGL lock held, before creating the screen.
+ * @return NULL if arenas are disabled or all slots are in use (heap is used)
+ */
+ui_arena_t *ui_arena_begin(const char *name);
+
+/**
+ * @brief Stop routing and bind the arena to @p screen
+ * The arena is released once @p screen is deleted and its last block freed.
+ * Passing NULL screen releases it as soon as it is empty.
+ */
+void ui_arena_end(ui_arena_t *arena, lv_obj_t *screen);
+
+/**
+ * @brief Snapshot allocator counters and current heap fragmentation
+ */
+void ui_arena_get_stats(ui_arena_stats_t *out);
+
+/**
+ * @brief Log ui_arena_get_stats() on one line
+ */
+void ui_arena_log_stats(void);
+
+/**
+ * @brief Start a task that opens and closes every app @p cycles times
+ * Apps go through ui_app_launch()/ui_app_exit(), transitions and destroy
+ * hooks included, and the task logs fragmentation and arena counters as it
+ * goes. Soak check for bench/QEMU builds (CONFIG_UI_ARENA_SOAK_CYCLES).
+ */
+void ui_arena_soak_start(uint32_t cycles);
+
+#ifdef __cplusplus
+}
+#endif
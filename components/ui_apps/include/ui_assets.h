@@ -0,0 +1,48 @@
+#pragma once
+
+/**
+ * Read-only asset pack in the `storage` partition, and font lookup.
+ *
+ * tools/mkassets.py builds assets/manifest.json into a pack that
+ * `idf.py flash` writes to the start of the `storage` partition. At boot the
+ * pack is memory-mapped once and entries are returned as pointers into the
+ * mapping, with no copy. It carries the maze levels, which replace the
+ * built-in ones without a firmware update; anything missing from the pack
+ * (or the whole pack) falls back to the copy compiled into the firmware.
+ *
+ * Fonts are not packed: LVGL's binfont loader copies a font into RAM, so a
+ * packed font costs RAM and boot time while saving nothing unless the same
+ * size is dropped from the firmware.
+ */
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Map the pack, if one is flashed
+ * Call once at boot.
+ */
+void ui_assets_init(void);
+
+/**
+ * @brief Look up an entry by name
+ * @param data Set to the entry's bytes in mapped flash (valid until reboot)
+ * @return false if there is no pack or no such entry
+ */
+bool ui_assets_find(const char *name, const void **data, size_t *size);
+
+/**
+ * @brief Montserrat at @p size px if that size is compiled in, else
+ * LV_FONT_DEFAULT
+ */
+const lv_font_t *ui_assets_font(uint8_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+
+/**
+ * Boot step graph and timeline.
+ *
+ * app_main() describes its start-up as a table of steps with explicit
+ * dependencies and hands it to ui_boot_run(). Steps are split over two
+ * lanes: the calling task (main lane) and a worker pinned to the other
+ * core (side lane). Each lane runs its steps in table order, so the table
+ * must be in dependency order; a step waits only for the steps named in
+ * its deps mask, wherever they run. Steps flagged lvgl run with the LVGL
+ * lock held.
+ *
+ * Every step records start/end/wait times and its core. The timeline is
+ * printed when the run ends and again with 'b' on the serial console.
+ */
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_BOOT_MAX_STEPS 24            // One event group bit each
+#define UI_BOOT_DEP(i)    (1u << (i))   // Dependency on step @p i of the table
+
+typedef enum {
+    UI_BOOT_LANE_MAIN = 0,              // Task calling ui_boot_run()
+    UI_BOOT_LANE_SIDE,                  // Worker on the other core
+} ui_boot_lane_t;
+
+typedef esp_err_t (*ui_boot_fn_t)(void);
+
+/**
+ * @brief One start-up step
+ */
+typedef struct {
+    const char *name;
+    ui_boot_fn_t fn;
+    uint32_t deps;              // UI_BOOT_DEP() bits of steps that must finish first
+    ui_boot_lane_t lane;
+    bool lvgl;                  // Hold the LVGL lock while it runs
+} ui_boot_step_t;
+
+/**
+ * @brief Run @p steps and print the boot timeline
+ * A failed step makes every step that depends on it, directly or not, skip.
+ * @return ESP_OK, or the error of the first step that failed
+ */
+esp_err_t ui_boot_run(const ui_boot_step_t *steps, size_t count);
+
+/**
+ * @brief Print the timeline of the last run (ms since reset)
+ */
+void ui_boot_report(FILE *out);
+
+/**
+ * @brief Log time since reset and idle heap, against the previous firmware
+ * The first boot of each firmware image (by ELF SHA-256) stores its numbers
+ * in NVS. Every boot logs its own next to those of the last different image
+ * that booted, so flashing a change shows its boot cost in the log.
+ * Call once the UI takes input.
+ */
+void ui_boot_log_cost(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+
+/**
+ * Single-key serial console commands.
+ *
+ * One low priority task polls the console and dispatches keys registered by
+ * the diagnostic modules (trace, memory, ...). '?' lists the commands.
+ * Compiled out unless CONFIG_UI_CONSOLE_CMDS is set.
+ */
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*ui_console_cmd_t)(FILE *out);
+
+/**
+ * @brief Bind @p key to @p cmd; starts the console task on first use
+ * Safe to call from any task or core.
+ */
+void ui_console_register(char key, const char *help, ui_console_cmd_t cmd);
+
+#ifdef __cplusplus
+}
+#endif
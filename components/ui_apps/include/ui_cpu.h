@@ -0,0 +1,83 @@
+#pragma once
+
+/**
+ * Per-core CPU load and per-task runtime from FreeRTOS run-time counters.
+ *
+ * Sampling is pull-based: nothing runs unless the hub "CPU" page is open or
+ * 'p' is pressed on the serial console, so the steady-state cost is zero.
+ * Needs CONFIG_FREERTOS_USE_TRACE_FACILITY and
+ * CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS (set in sdkconfig.defaults).
+ */
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_CPU_MAX_TASKS    48
+#define UI_CPU_MAX_CORES    2
+
+/**
+ * @brief One task over the last window
+ */
+typedef struct {
+    char name[16];
+    int8_t core;                // Pinned core, -1 if it may run on either
+    uint8_t priority;
+    uint16_t share_permille;    // Of total CPU time (all cores) in the window
+    uint32_t stack_free;        // Stack high-water mark: least free ever (bytes)
+} ui_cpu_task_t;
+
+/**
+ * @brief Load over one sampling window, tasks sorted by share (busiest first)
+ */
+typedef struct {
+    uint32_t window_ms;
+    uint8_t core_load_pct[UI_CPU_MAX_CORES];
+    uint32_t idle_wakeups_per_sec[UI_CPU_MAX_CORES];  // Tick rate + switches back to idle
+    uint32_t task_count;
+    ui_cpu_task_t tasks[UI_CPU_MAX_TASKS];
+} ui_cpu_snapshot_t;
+
+/**
+ * @brief Previous counters of one consumer (page, console, ...)
+ * Zero-initialise; each consumer keeps its own so windows don't interfere.
+ */
+typedef struct {
+    bool valid;
+    uint32_t total_time;
+    uint32_t idle_wakeups[UI_CPU_MAX_CORES];
+    uint32_t count;
+    void *handle[UI_CPU_MAX_TASKS];
+    uint32_t runtime[UI_CPU_MAX_TASKS];
+} ui_cpu_window_t;
+
+/**
+ * @brief Install the per-core idle hooks and register the 'p' console command
+ */
+void ui_cpu_init(void);
+
+/**
+ * @brief Close the window started by the previous call and start a new one
+ * @return false on the first call for @p win (baseline only) or if
+ *         run-time stats are disabled
+ */
+bool ui_cpu_sample(ui_cpu_window_t *win, ui_cpu_snapshot_t *out);
+
+/**
+ * @brief Print a snapshot as a table
+ */
+void ui_cpu_print(const ui_cpu_snapshot_t *snap, FILE *out);
+
+/**
+ * @brief Build the CPU dashboard into @p parent (hub view)
+ */
+void ui_cpu_page_create(lv_obj_t *parent);
+
+#ifdef __cplusplus
+}
+#endif
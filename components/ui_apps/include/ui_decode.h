@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * Background image decode for SD media.
+ *
+ * JPEG and PNG files are decoded on a worker task, fitted into a
+ * caller-owned RGB565 or ARGB8565 draw buffer (aspect kept, letterboxed on
+ * black or transparent) and written row by row, so the LVGL task never decodes and no
+ * full-resolution frame is held for JPEGs: they are decoded with a scaled
+ * IDCT at close to the target size. PNGs have no scaled decode and are
+ * limited to UI_DECODE_PNG_MAX_PIXELS.
+ *
+ * With UI_DECODE_PREVIEW, the callback also reports progress while rows
+ * land (a coarse first pass for progressive JPEGs, a top-down reveal
+ * otherwise). With UI_DECODE_CACHED, the result is kept on the SD card at
+ * exactly the buffer's size and format (ui_imgcache.h) and later requests
+ * read it back instead of decoding. Callbacks run on the worker with the
+ * LVGL lock held.
+ */
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_DECODE_PATH_MAX        128
+#define UI_DECODE_PNG_MAX_PIXELS  (1024 * 1024)   // Decoded as RGBA in PSRAM before fitting
+
+#define UI_DECODE_PREVIEW         (1 << 0)        // Progress callbacks while rows land
+#define UI_DECODE_CACHED          (1 << 1)        // Serve from / add to the SD image cache
+
+typedef enum {
+    UI_DECODE_PROGRESS = 0,     // More rows (or a coarse pass) are in the buffer
+    UI_DECODE_DONE,
+    UI_DECODE_FAILED,
+} ui_decode_status_t;
+
+/**
+ * @brief Decode progress, passed to the callback
+ */
+typedef struct {
+    ui_decode_status_t status;
+    uint16_t src_w, src_h;      // Image as stored, 0 until known
+    lv_area_t area;             // Picture inside the buffer (buffer coordinates)
+    uint16_t rows;              // Rows of @p area written in the current pass
+    bool coarse;                // Rows so far are from the coarse pass
+    bool cached;                // Read from the image cache, not decoded
+    uint32_t elapsed_ms;        // Since the worker picked the job up
+} ui_decode_info_t;
+
+typedef void (*ui_decode_cb_t)(uint32_t id, const ui_decode_info_t *info, void *user);
+
+/**
+ * @brief Queue a decode of @p path (POSIX path, e.g. "/sdcard/a.jpg") into @p dst
+ * @p dst must be RGB565 or ARGB8565 and stay valid until the DONE/FAILED
+ * callback or ui_decode_cancel(). Call with the LVGL lock held.
+ * @param flags UI_DECODE_PREVIEW, UI_DECODE_CACHED
+ * @return job id, 0 if the path is too long or the queue is full
+ */
+uint32_t ui_decode_submit(const char *path, lv_draw_buf_t *dst, uint32_t flags, ui_decode_cb_t cb, void *user);
+
+/**
+ * @brief Drop a queued or running job
+ * On return the worker no longer writes to its buffer and its callback
+ * won't run again. Unknown or finished ids are ignored. Call with the
+ * LVGL lock held.
+ */
+void ui_decode_cancel(uint32_t id);
+
+#ifdef __cplusplus
+}
+#endif
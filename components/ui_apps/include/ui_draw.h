@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * Parallel LVGL software draw units.
+ *
+ * With LV_USE_OS = FreeRTOS and LV_DRAW_SW_DRAW_UNIT_CNT > 1 LVGL runs one
+ * draw thread per unit; the scheduler puts them on whichever core is free.
+ * Independent draw tasks of a layer (non-overlapping areas) are rendered
+ * concurrently. The unit count is fixed at build time: compare single- and
+ * multi-unit frame times by running the benchmark ('d' on the serial
+ * console, or CONFIG_UI_DRAW_BENCH at boot) on builds with
+ * LV_DRAW_SW_DRAW_UNIT_CNT=1 and =N.
+ *
+ * Draw threads only touch draw buffers, never widgets, so they take neither
+ * lock. lv_timer_handler() takes LVGL's own lv_lock() inside the HAL's
+ * lvgl_mgr_lock(); other tasks must keep using lvgl_mgr_lock() only, so the
+ * order is always lvgl_mgr -> lv_lock.
+ */
+
+#include "lvgl.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_DRAW_MAX_BANDS 4
+
+/**
+ * @brief Average frame times of one benchmark run
+ */
+typedef struct {
+    uint32_t units;             // Draw units in this build
+    uint32_t screen_us;         // Full redraw of the active screen incl. flush
+    uint32_t maze_view_us;      // 3D maze canvas frame
+    uint32_t maze_map_us;       // 32x32 maze map canvas
+} ui_draw_bench_t;
+
+/**
+ * @brief Create the band canvases and register the 'd' console command
+ * Call once after the display is created, with the LVGL lock held.
+ */
+void ui_draw_init(void);
+
+/**
+ * @brief Software draw units built in (LV_DRAW_SW_DRAW_UNIT_CNT, 1 without an OS layer)
+ */
+uint32_t ui_draw_unit_count(void);
+
+/**
+ * @brief Bands a canvas is split into by ui_draw_band(), one per draw unit
+ */
+uint32_t ui_draw_band_count(void);
+
+/**
+ * @brief Canvas over rows of band @p b of @p canvas's buffer
+ * The band canvas is hidden and shares @p canvas's pixels and stride, so a
+ * layer from lv_canvas_init_layer() on it is clipped to the band. Draw with
+ * y shifted by -@p y0; invalidate @p canvas once all bands are finished.
+ * @param[out] y0  first row of the band in @p canvas
+ * @param[out] y1  last row of the band in @p canvas
+ * @return the band canvas, or @p canvas itself with a single band
+ */
+lv_obj_t *ui_draw_band(lv_obj_t *canvas, uint32_t b, int32_t *y0, int32_t *y1);
+
+/**
+ * @brief Time redraws with this build's draw units and log them
+ * Call with the LVGL lock held; the active screen is the "screen" scene.
+ * @param[out] result  may be NULL
+ */
+void ui_draw_bench(int frames, ui_draw_bench_t *result);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,77 @@
+#pragma once
+
+/**
+ * RGB565 fill kernels.
+ *
+ * Solid spans and rectangles are written with 32-bit paired stores, or with
+ * the ESP32-S3 128-bit vector stores (PIE) when CONFIG_UI_FILL_SIMD is set.
+ * LVGL's opaque, unmasked RGB565 color fills (map cells, panels, buttons) are
+ * routed here through ui_fill_lvgl.h (LV_DRAW_SW_ASM_CUSTOM); canvas clears
+ * call ui_fill_canvas() instead of lv_canvas_fill_bg(), which writes one
+ * pixel per iteration.
+ *
+ * Strides are in bytes, as in LVGL draw buffers. Buffers must be 2-byte
+ * aligned.
+ *
+ * The kernels and their scalar reference live in the LVGL-free
+ * ui_fill_core.c; tools/fill_test.c runs the same bit-exact check on the
+ * host.
+ */
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Register the 'f' console command (check + bandwidth)
+ */
+void ui_fill_init(void);
+
+/**
+ * @brief Fill @p n pixels starting at @p dst
+ */
+void ui_fill_hspan(uint16_t *dst, size_t n, uint16_t color);
+
+/**
+ * @brief Fill a one pixel wide column of @p h pixels
+ */
+void ui_fill_vspan(uint16_t *dst, int32_t stride, int32_t h, uint16_t color);
+
+/**
+ * @brief Fill a @p w x @p h rectangle
+ */
+void ui_fill_rect(uint16_t *dst, int32_t stride, int32_t w, int32_t h, uint16_t color);
+
+/**
+ * @brief Expand 8-bit indices to RGB565 through a 256-entry palette
+ */
+void ui_fill_lut_expand(uint16_t *dst, const uint8_t *src, size_t n, const uint16_t lut[256]);
+
+/**
+ * @brief Opaque clear of an RGB565 canvas (other formats use lv_canvas_fill_bg())
+ */
+void ui_fill_canvas(lv_obj_t *canvas, lv_color_t color);
+
+/**
+ * @brief Compare every kernel bit-exactly with a scalar reference
+ * Sweeps lengths, alignments and strides and checks guard pixels around
+ * each write. Logs each mismatch.
+ * @return true if all kernels matched
+ */
+bool ui_fill_check(void);
+
+/**
+ * @brief Print fill bandwidth (MB/s) of the scalar reference and the kernels
+ * for an internal RAM and a PSRAM buffer
+ */
+void ui_fill_bench(FILE *out);
+
+#ifdef __cplusplus
+}
+#endif
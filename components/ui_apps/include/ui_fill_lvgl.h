@@ -0,0 +1,14 @@
+#pragma once
+
+/**
+ * LV_DRAW_SW_ASM_CUSTOM_INCLUDE for LVGL's software renderer.
+ *
+ * Included by LVGL's lv_draw_sw_blend_to_*.c. Only the opaque, unmasked
+ * RGB565 color fill is overridden; every other blend keeps LVGL's own code.
+ */
+
+#include "ui_fill.h"
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc)                                              \
+    (ui_fill_rect((uint16_t *)(dsc)->dest_buf, (dsc)->dest_stride, (dsc)->dest_w,           \
+                  (dsc)->dest_h, lv_color_to_u16((dsc)->color)), LV_RESULT_OK)
@@ -0,0 +1,40 @@
+#pragma once
+
+/**
+ * "S:" LVGL file system over the SD card, with read-ahead.
+ *
+ * Replaces LVGL's stdio driver (CONFIG_LV_USE_FS_STDIO and its 8 KB
+ * per-file cache of synchronous freads). Reads go through a shared pool of
+ * CONFIG_UI_FS_BLOCKS buffers of CONFIG_UI_FS_BLOCK_KB, 64-byte aligned in
+ * DMA-capable RAM (ui_rafs_core.h). A handle read sequentially gets the
+ * next CONFIG_UI_FS_READAHEAD blocks loaded by a worker task while its
+ * caller decodes; whole-block reads into DMA-capable buffers bypass the
+ * pool. Opening a file that is already open shares its descriptor and
+ * cached blocks. Buffers are only allocated while a file is open.
+ *
+ * Paths are absolute VFS paths: "S:/sdcard/photo.bin". Files opened for
+ * writing, and directory listing, pass straight through to the VFS.
+ */
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_FS_LETTER    'S'
+
+/**
+ * @brief Register the "S:" driver and the 'r' console command (read benchmark)
+ */
+void ui_fs_init(void);
+
+/**
+ * @brief Sequential and random read MB/s on the SD card, read-ahead vs stdio
+ * Writes a 4 MB scratch file the first time. Prints pool statistics.
+ */
+void ui_fs_bench(FILE *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Governor power modes, in order of increasing idleness
+ */
+typedef enum {
+    UI_GOV_ACTIVE = 0,   // Full refresh rate, all timers running
+    UI_GOV_IDLE,         // Slower refresh, cosmetic timers paused
+    UI_GOV_DIM,          // As IDLE plus backlight dimmed
+} ui_gov_mode_t;
+
+/**
+ * @brief Governor counters, sampled over the last second
+ */
+typedef struct {
+    ui_gov_mode_t mode;
+    uint32_t refr_wakeups_per_sec;   // Display refresh timer runs
+    uint32_t renders_per_sec;        // Refreshes that actually rendered something
+    uint32_t refr_busy_us_per_sec;   // Time spent inside the refresh pipeline
+    uint32_t idle_ms;                // Time since last touch
+} ui_gov_stats_t;
+
+/**
+ * @brief Start the governor (call once with the LVGL lock held, after the display exists)
+ */
+void ui_governor_init(void);
+
+/**
+ * @brief Register a cosmetic timer to pause while idle (e.g. blink/tutorial animations)
+ */
+void ui_governor_register_timer(lv_timer_t *timer);
+
+/**
+ * @brief Forget a timer before deleting it
+ */
+void ui_governor_unregister_timer(lv_timer_t *timer);
+
+/**
+ * @brief Report user activity from a non-touch source and ramp up immediately
+ */
+void ui_governor_notify_activity(void);
+
+/**
+ * @brief Get the current mode
+ */
+ui_gov_mode_t ui_governor_get_mode(void);
+
+/**
+ * @brief Get governor counters for the last sample window
+ */
+void ui_governor_get_stats(ui_gov_stats_t *out);
+
+/**
+ * @brief Human readable mode name
+ */
+const char *ui_governor_mode_name(ui_gov_mode_t mode);
+
+#ifdef __cplusplus
+}
+#endif
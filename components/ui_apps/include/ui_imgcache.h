@@ -0,0 +1,86 @@
+#pragma once
+
+/**
+ * Persistent cache of decoded images on the SD card.
+ *
+ * The first time ui_decode fits a JPEG/PNG into a buffer with
+ * UI_DECODE_CACHED set, the result is written to CONFIG_UI_IMAGE_CACHE_DIR
+ * as an LVGL binary image (lv_image_header_t + pixels) at exactly that
+ * size and colour format (RGB565 or ARGB8565). Later requests for the
+ * same source, size and format are one sequential read, with no decode.
+ * The files can also be shown directly with lv_image_set_src("S:...").
+ *
+ * Entries are keyed by a hash of the source path, size and modification
+ * time (so an edited file misses) plus target width, height and colour
+ * format. Total size is held under CONFIG_UI_IMAGE_CACHE_MB by deleting
+ * the least recently used entries. The index is rebuilt from the folder
+ * on first use after boot.
+ *
+ * Everything except ui_imgcache_init() and the stats runs on the
+ * ui_decode worker.
+ */
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief What a cached image was made from, stored after its pixels
+ */
+typedef struct {
+    uint16_t src_w, src_h;      // Source image as stored
+    lv_area_t area;             // Picture inside the cached buffer (letterboxed)
+    uint32_t decode_ms;         // What the original decode took
+} ui_imgcache_meta_t;
+
+typedef struct {
+    uint32_t hits, misses;
+    uint32_t stores, evictions;
+    uint32_t files;
+    uint64_t bytes;             // On the card
+    uint64_t hit_decode_ms;     // Original decode time of every hit served...
+    uint64_t hit_load_ms;       // ...and what reading them took instead
+} ui_imgcache_stats_t;
+
+/**
+ * @brief Register the 'i' console command (hit rate, decode time saved)
+ */
+void ui_imgcache_init(void);
+
+/**
+ * @brief Open the cached copy of @p src for @p dst's size and colour format
+ * @param meta Filled on a hit
+ * @return Stream at the first pixel row (rows packed, w * bytes per pixel),
+ *         or NULL on a miss (counted)
+ */
+FILE *ui_imgcache_open(const char *src, const lv_draw_buf_t *dst, ui_imgcache_meta_t *meta);
+
+/**
+ * @brief Close a stream from ui_imgcache_open() and count the hit
+ * @param ok false if reading the pixels failed: counted as a miss and the
+ *           entry is dropped
+ */
+void ui_imgcache_close(FILE *f, const char *src, const lv_draw_buf_t *dst, const ui_imgcache_meta_t *meta,
+                       uint32_t load_ms, bool ok);
+
+/**
+ * @brief Write @p img as the cached copy of @p src, evicting as needed
+ * Replaces an existing entry for the same key.
+ */
+void ui_imgcache_store(const char *src, const lv_draw_buf_t *img, const ui_imgcache_meta_t *meta);
+
+void ui_imgcache_get_stats(ui_imgcache_stats_t *out);
+
+/**
+ * @brief Print hit rate, decode time saved and occupancy
+ */
+void ui_imgcache_report(FILE *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,7 +8,7 @@ extern "C" {
 
 /**
  * @brief Initialize the launcher screen (app homepage)
- * Shows buttons for: Maze, Sports, Settings
+ * Shows one button per app in the registry (ui_app.h)
  */
 void ui_launcher_init(void);
 
@@ -17,6 +17,12 @@ void ui_launcher_init(void);
  */
 void ui_launcher_destroy(void);
 
+/**
+ * @brief Destroy the launcher screen once the current event has finished
+ * Used when an app is opened from one of the launcher's buttons.
+ */
+void ui_launcher_destroy_async(void);
+
 /**
  * @brief Show the launcher screen
  * Used to return from apps to the home screen
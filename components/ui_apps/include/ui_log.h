@@ -0,0 +1,66 @@
+#pragma once
+
+/**
+ * ui_apps logging with per-module compile-time levels.
+ *
+ * Define UI_LOG_LEVEL before including this header to pick the module's
+ * level (e.g. CONFIG_UI_LOG_LEVEL_MAZE); otherwise the default applies.
+ *
+ *   UI_LOGE/W/I  -> ESP_LOG immediately (rare events)
+ *   UI_LOGD/V    -> deferred binary record (hot paths), see ui_log_deferred()
+ *
+ * Anything above the module level is compiled out entirely.
+ * Deferred logs only capture 32-bit arguments: integers, pointers and
+ * string literals (resolved offline from the ELF). No floats or 64-bit values.
+ */
+
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef UI_LOG_LEVEL
+#define UI_LOG_LEVEL CONFIG_UI_LOG_LEVEL_DEFAULT
+#endif
+
+#define UI_LOG_MAX_ARGS 10
+
+// Count variadic arguments (0..10)
+#define UI_LOG_NARGS(...) UI_LOG_NARGS_(0, ##__VA_ARGS__, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define UI_LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, N, ...) N
+
+/**
+ * @brief Push a binary log record; arguments are read as uint32_t
+ * Lock-free and cheap enough for per-frame use. Prefer the UI_LOGD/V macros.
+ */
+void ui_log_deferred(esp_log_level_t level, const char *tag, const char *fmt, uint32_t nargs, ...);
+
+/**
+ * @brief Start the deferred log drain task
+ */
+void ui_log_init(void);
+
+/**
+ * @brief Number of deferred records overwritten before they could be drained
+ */
+uint32_t ui_log_get_dropped(void);
+
+#if CONFIG_UI_LOG_DEFERRED
+#define UI_LOG_DEFER(lvl, tag, fmt, ...) \
+    ui_log_deferred(lvl, tag, fmt, UI_LOG_NARGS(__VA_ARGS__), ##__VA_ARGS__)
+#else
+#define UI_LOG_DEFER(lvl, tag, fmt, ...) ESP_LOG_LEVEL_LOCAL(lvl, tag, fmt, ##__VA_ARGS__)
+#endif
+
+#define UI_LOGE(tag, fmt, ...) do { if (UI_LOG_LEVEL >= 1) ESP_LOGE(tag, fmt, ##__VA_ARGS__); } while (0)
+#define UI_LOGW(tag, fmt, ...) do { if (UI_LOG_LEVEL >= 2) ESP_LOGW(tag, fmt, ##__VA_ARGS__); } while (0)
+#define UI_LOGI(tag, fmt, ...) do { if (UI_LOG_LEVEL >= 3) ESP_LOGI(tag, fmt, ##__VA_ARGS__); } while (0)
+#define UI_LOGD(tag, fmt, ...) do { if (UI_LOG_LEVEL >= 4) UI_LOG_DEFER(ESP_LOG_DEBUG, tag, fmt, ##__VA_ARGS__); } while (0)
+#define UI_LOGV(tag, fmt, ...) do { if (UI_LOG_LEVEL >= 5) UI_LOG_DEFER(ESP_LOG_VERBOSE, tag, fmt, ##__VA_ARGS__); } while (0)
+
+#ifdef __cplusplus
+}
+#endif
@@ -12,6 +12,23 @@ extern "C" {
 #define MAZE_SIZE 32
 #define LEVEL_COUNT 3
 
+/**
+ * @brief Maze touch responsiveness counters (since the maze was opened)
+ */
+typedef struct {
+    uint32_t hits;                  // Moves served from a pre-rendered buffer
+    uint32_t misses;                // Moves rendered on the touch path
+    uint32_t prerendered;           // Candidate frames rendered in idle time
+    uint32_t wasted;                // Candidates discarded unused
+    uint32_t hit_latency_avg_us;    // Press to flush complete, hits
+    uint32_t hit_latency_max_us;
+    uint32_t miss_latency_avg_us;   // Press to flush complete, misses
+    uint32_t miss_latency_max_us;
+    uint32_t walk_steps;            // Steps taken by hold-to-walk repeats
+    uint32_t walk_dropped_frames;   // Steps applied without their own frame
+    float walk_steps_per_sec;       // Achieved repeat rate while walking
+} ui_maze_input_stats_t;
+
 /**
  * @brief Show the Maze app screen
  */
@@ -22,6 +39,34 @@ void ui_maze_show(void);
  */
 void ui_maze_cleanup(void);
 
+/**
+ * @brief Get pre-render hit rate, tap-to-flush latency and walk cadence
+ */
+void ui_maze_get_input_stats(ui_maze_input_stats_t *out);
+
+/**
+ * @brief Render regression check (CONFIG_UI_MAZE_RENDER_CHECK)
+ * Compares display-list hashes of every pose against golden values,
+ * enforces the R9C8N invariant and checks frame time/allocations on a
+ * scripted route per level. Call with the LVGL lock held.
+ * @return true if everything passed
+ */
+bool ui_maze_render_check(void);
+
+/**
+ * @brief Average 3D view and map frame times over @p frames offscreen redraws
+ * Workload for ui_draw_bench(); call with the LVGL lock held.
+ */
+void ui_maze_draw_bench(int frames, uint32_t *view_us, uint32_t *map_us);
+
+/**
+ * @brief Time @p moves scripted moves with their hot-path logs off, deferred and as ESP_LOGI
+ * Each move emits the same four records as a touch-driven move, then builds
+ * and rasterizes the view offscreen. Logs the per-move averages
+ * (CONFIG_UI_LOG_BENCH_MOVES). Call with the LVGL lock held.
+ */
+void ui_maze_log_bench(int moves);
+
 #ifdef __cplusplus
 }
 #endif
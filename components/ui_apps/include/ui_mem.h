@@ -0,0 +1,124 @@
+#pragma once
+
+/**
+ * Heap telemetry with per-app attribution.
+ *
+ * Apps allocate their large buffers (canvases, caches) through
+ * ui_mem_malloc()/ui_mem_free(), which tag each block with the owning app,
+ * the caller address and whether it landed in internal RAM or PSRAM.
+ * ui_mem_app_closed() flags anything the app still owns after its cleanup
+ * as a leak. A periodic sampler records free/largest-block/fragmentation
+ * history for both heaps; view it on the hub "Heap" page or dump it as CSV
+ * with 'm' on the serial console.
+ */
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    UI_MEM_APP_SYSTEM = 0,
+    UI_MEM_APP_LAUNCHER,
+    UI_MEM_APP_MAZE,
+    UI_MEM_APP_SPORTS,
+    UI_MEM_APP_WEATHER,
+    UI_MEM_APP_SETTINGS,
+    UI_MEM_APP_PHOTOS,
+    UI_MEM_APP_COUNT,
+} ui_mem_app_t;
+
+/**
+ * @brief Per-app allocation counters
+ */
+typedef struct {
+    uint32_t live_blocks;
+    size_t internal_bytes;      // Live bytes in internal RAM
+    size_t spiram_bytes;        // Live bytes in PSRAM
+    size_t peak_bytes;          // High-water mark of internal + PSRAM
+    uint32_t leaked_blocks;     // Still alive after the app's cleanup
+    size_t leaked_bytes;
+} ui_mem_app_stats_t;
+
+/**
+ * @brief One heap sample
+ */
+typedef struct {
+    uint32_t t_s;               // Seconds since boot
+    size_t internal_free;
+    size_t internal_largest;
+    size_t spiram_free;
+    size_t spiram_largest;
+    uint8_t internal_frag_pct;  // 100 - largest free block / free bytes
+    uint8_t spiram_frag_pct;
+} ui_mem_sample_t;
+
+/**
+ * @brief Start the heap sampler and register the 'm' console command
+ */
+void ui_mem_init(void);
+
+/**
+ * @brief heap_caps_malloc() attributed to @p app
+ */
+void *ui_mem_malloc(ui_mem_app_t app, size_t size, uint32_t caps);
+
+/**
+ * @brief Free a block from ui_mem_malloc() (NULL is ignored)
+ */
+void ui_mem_free(void *p);
+
+/**
+ * @brief Mark the end of an app's cleanup
+ * Blocks the app still owns are logged with their caller and counted as leaked.
+ * @return number of newly flagged blocks
+ */
+uint32_t ui_mem_app_closed(ui_mem_app_t app);
+
+/**
+ * @brief Counters for one app
+ */
+void ui_mem_get_app_stats(ui_mem_app_t app, ui_mem_app_stats_t *out);
+
+/**
+ * @brief Start counting heap allocations made by the calling task
+ * Any allocation counts, not only ui_mem_malloc(); other tasks' (LVGL's
+ * draw threads included) do not. Needs CONFIG_HEAP_USE_HOOKS.
+ */
+void ui_mem_alloc_count_begin(void);
+
+/**
+ * @brief Stop counting
+ * @return Allocations since ui_mem_alloc_count_begin(), -1 without
+ *         CONFIG_HEAP_USE_HOOKS
+ */
+int32_t ui_mem_alloc_count_end(void);
+
+/**
+ * @brief Take a heap sample now (also used by the periodic sampler)
+ */
+void ui_mem_sample(ui_mem_sample_t *out);
+
+/**
+ * @brief App name
+ */
+const char *ui_mem_app_name(ui_mem_app_t app);
+
+/**
+ * @brief Print samples, per-app counters and live blocks as CSV
+ */
+void ui_mem_dump_csv(FILE *out);
+
+/**
+ * @brief Build the heap telemetry page into @p parent (hub view)
+ */
+void ui_mem_page_create(lv_obj_t *parent);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+/**
+ * Shared HTTP(S) client for the apps' network fetches.
+ *
+ * One pool for every app (ui_http_core.h over mbedtls and the certificate
+ * bundle): requests to a host reuse its idle keep-alive connection, and
+ * new TLS connections resume the host's last session, so most refreshes
+ * skip the full handshake and its certificate verification and key
+ * exchange. CONFIG_UI_NET_POOL_SLOTS connections are kept for up to
+ * CONFIG_UI_NET_IDLE_S, then closed to give their TLS buffers back; they
+ * are also closed when Wi-Fi drops. Sessions of up to
+ * CONFIG_UI_NET_SESSIONS hosts are saved in NVS so resumption also works
+ * right after a reboot.
+ *
+ * Requests block; call them from a task with 8 KB of stack, never from the
+ * LVGL task.
+ */
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Receives the body in order, in slices of the receive buffer; return false to stop
+typedef bool (*ui_net_body_cb_t)(void *arg, const uint8_t *data, size_t len);
+
+/**
+ * @brief Create the pool, load saved sessions and register the console
+ *        commands: 'h' pool statistics, 'H' refresh benchmark
+ */
+void ui_net_init(void);
+
+/**
+ * @brief GET @p url and stream the body to @p on_body
+ * @param headers Extra request headers, each ending in "\r\n" (may be NULL)
+ * @param status Set to the HTTP status (may be NULL)
+ * @return ESP_OK once the whole response was received, whatever its status
+ */
+esp_err_t ui_net_get(const char *url, const char *headers, ui_net_body_cb_t on_body, void *arg, int *status);
+
+/**
+ * @brief As ui_net_get() for a response that stays open (Server-Sent Events),
+ *        waiting up to @p idle_ms between bytes
+ * @return ESP_OK when the server ended the response, ESP_ERR_INVALID_STATE
+ *         when @p on_body stopped it, ESP_ERR_TIMEOUT when it went silent or dropped
+ */
+esp_err_t ui_net_stream(const char *url, const char *headers, uint32_t idle_ms, ui_net_body_cb_t on_body, void *arg,
+                        int *status);
+
+/**
+ * @brief Close the idle pooled connections now
+ */
+void ui_net_flush(void);
+
+/**
+ * @brief Print request and handshake counts and times of the shared pool
+ */
+void ui_net_report(FILE *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,60 @@
+#pragma once
+
+/**
+ * Delta OTA: rebuild a new firmware from the running one and a patch.
+ *
+ * Patches come from tools/ota_delta.c (old build + new build) and are
+ * fetched with esp_http_client (HTTP or HTTPS with the certificate bundle).
+ * Patches up to CONFIG_UI_OTA_DELTA_BUFFER_KB are downloaded into PSRAM
+ * before anything is written, so the radio can idle while flash is
+ * programmed; larger ones are applied as they arrive. The body is inflated
+ * with the ROM's miniz and applied by ui_delta_core.c, reading the running
+ * slot and writing the other one through esp_ota_write(), so RAM use stays
+ * around 50 KB (plus a buffered patch) whatever the image size.
+ *
+ * The running image's SHA-256 must match the one the patch was built from
+ * and the result must match the new build's, and esp_ota_end() verifies
+ * the image, before the slot is set to boot. Nothing restarts: the new
+ * firmware runs from the next boot.
+ */
+
+#include "esp_err.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    esp_err_t err;
+    uint32_t patch_bytes;       // Downloaded
+    uint32_t image_bytes;       // Written to the slot: what a full OTA downloads
+    uint32_t radio_ms;          // First to last patch byte received
+    uint32_t flash_ms;          // In esp_ota_begin() (erase) and esp_ota_write()
+    uint32_t total_ms;
+    char slot[17];              // Label of the slot written
+} ui_ota_delta_result_t;
+
+/**
+ * @brief Register the 'o' (slots, last update) and 'O' (update from
+ *        CONFIG_UI_OTA_DELTA_URL) console commands
+ */
+void ui_ota_init(void);
+
+/**
+ * @brief Download the patch at @p url and write the patched firmware to the next OTA slot
+ * Blocks for the whole update; call from a task with 8 KB of stack.
+ * @param out Filled whether or not the update succeeds (may be NULL)
+ * @return ESP_OK once the slot is set to boot
+ */
+esp_err_t ui_ota_delta_update(const char *url, ui_ota_delta_result_t *out);
+
+/**
+ * @brief Print the running and next slot and the last update's bytes and times
+ */
+void ui_ota_report(FILE *out);
+
+#ifdef __cplusplus
+}
+#endif
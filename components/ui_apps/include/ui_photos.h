@@ -0,0 +1,31 @@
+#pragma once
+
+/**
+ * Photos app: thumbnail grid of the JPEG/PNG files in CONFIG_UI_PHOTOS_DIR
+ * and a full-screen viewer. All decoding goes through ui_decode on its
+ * worker task. Thumbnails live in a fixed PSRAM slab sized by
+ * CONFIG_UI_PHOTOS_THUMB_CACHE_KB; only tiles near the viewport are
+ * decoded and the least recently seen ones are evicted when it is full.
+ * Thumbnails and viewer images also go to the SD image cache
+ * (ui_imgcache.h), so a folder seen before opens without decoding.
+ */
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Show the Photos app screen
+ */
+void ui_photos_show(void);
+
+/**
+ * @brief Cancel decodes and free the screen, thumbnails and viewer buffer
+ */
+void ui_photos_cleanup(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+
+/**
+ * SD Card page of the Board Settings hub: a browsable file list.
+ *
+ * Directories are read on a worker task in batches (ui_dirlist_core.h);
+ * each batch is sorted and merged off the LVGL task and the sorted,
+ * filtered list is handed to the page, so the first entries show after
+ * one small batch whatever the folder size. The list is virtualised: a
+ * fixed pool of row labels is repositioned and relabelled as it scrolls,
+ * so a folder of thousands of files costs the same widgets as one of ten.
+ */
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_SDLIST_ROOT  "/sdcard"
+
+/**
+ * @brief Build the SD Card page into @p parent (hub view) and start listing the root
+ */
+void ui_sdlist_page_create(lv_obj_t *parent);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,38 @@
+#pragma once
+
+/**
+ * Boot splash from a stored launcher frame.
+ *
+ * A few seconds after the launcher is up its screen is snapshotted, and if
+ * the pixels differ from the stored copy the frame is RLE-compressed and
+ * written to the last 1 MB of the `storage` partition. On the next boot the
+ * frame is decoded straight from mapped flash and flushed to the panel
+ * before the HAL UI and the launcher widget tree are built; once the live
+ * launcher is ready the splash is dropped. The status bar lives on the top
+ * layer and is not part of the stored frame, so the clock ticking over
+ * doesn't cause a rewrite.
+ *
+ * Compiled out unless CONFIG_UI_BOOT_SPLASH is set.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Push the stored launcher frame to the panel right away
+ * Call with the LVGL lock held, as soon as the display is up. Logs
+ * time-to-first-pixel. Does nothing if no valid frame is stored.
+ */
+void ui_splash_show(void);
+
+/**
+ * @brief Drop the splash now that the live launcher is built
+ * Also schedules the capture that keeps the stored frame current.
+ * Call with the LVGL lock held.
+ */
+void ui_splash_handover(void);
+
+#ifdef __cplusplus
+}
+#endif
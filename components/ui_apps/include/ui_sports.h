@@ -11,6 +11,13 @@ extern "C" {
  */
 void ui_sports_show(void);
 
+/**
+ * @brief Register the 'l' console command (live scores stream, latency, radio time)
+ *
+ * Scores stream while the app is shown; see CONFIG_UI_SCORES_STREAM_URL.
+ */
+void ui_sports_init(void);
+
 #ifdef __cplusplus
 }
 #endif
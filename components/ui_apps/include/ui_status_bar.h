@@ -0,0 +1,61 @@
+#pragma once
+
+/**
+ * Shared status bar (clock and Wi-Fi state).
+ *
+ * One bar lives on the top layer and wakes only on the minute boundary and
+ * on Wi-Fi connect/disconnect events. It is shown on the launcher only:
+ * every app hides it on create (ui_status_bar_set_visible(false)) and draws
+ * its own top bar, and the launcher shows it again on return. Apps don't
+ * reserve room for it, so showing it over an app would cover the app's
+ * top 40 pixels.
+ */
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Height the launcher reserves for the status bar
+#define UI_STATUS_BAR_HEIGHT 40
+
+/**
+ * @brief Status bar counters (for idle cost measurement)
+ */
+typedef struct {
+    uint32_t wakeups;          // Timer + Wi-Fi event refreshes
+    uint32_t wifi_events;      // Connect/disconnect events received
+    uint32_t label_updates;    // lv_label_set_text calls actually issued
+    uint32_t color_updates;    // Style changes actually issued
+    uint64_t cpu_time_us;      // Time spent inside refresh
+} ui_status_bar_stats_t;
+
+/**
+ * @brief Create the shared status bar on the top layer (idempotent)
+ * The bar survives screen changes; the launcher shows it and apps hide it.
+ */
+void ui_status_bar_init(void);
+
+/**
+ * @brief Show or hide the shared status bar
+ * While hidden its timer is paused so it costs no wakeups.
+ */
+void ui_status_bar_set_visible(bool visible);
+
+/**
+ * @brief Force a refresh (e.g. after an SNTP/HTTP time sync)
+ * Must be called with the LVGL lock held.
+ */
+void ui_status_bar_refresh(void);
+
+/**
+ * @brief Get status bar counters since the last hourly report
+ */
+void ui_status_bar_get_stats(ui_status_bar_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
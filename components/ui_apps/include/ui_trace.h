@@ -0,0 +1,112 @@
+#pragma once
+
+#include "sdkconfig.h"
+#include "esp_cpu.h"
+#include "esp_timer.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Span categories recorded per app
+ */
+typedef enum {
+    UI_TRACE_RENDER = 0,   // Drawing into a canvas/layer
+    UI_TRACE_FLUSH,        // Pushing pixels to the panel
+    UI_TRACE_LAYOUT,       // Building or laying out a screen
+    UI_TRACE_FETCH,        // Network/file fetches
+    UI_TRACE_KIND_COUNT,
+} ui_trace_kind_t;
+
+/**
+ * @brief Span start token (CPU cycle count)
+ */
+typedef uint32_t ui_trace_t;
+
+/**
+ * @brief Start token for spans that may end on another core (us since boot)
+ */
+typedef int64_t ui_trace_us_t;
+
+#if CONFIG_UI_TRACE_ENABLE
+
+/**
+ * @brief Start a span - just reads the cycle counter
+ * Begin and end must run on the same core (true for the LVGL task).
+ */
+static inline ui_trace_t ui_trace_begin(void) {
+    return (ui_trace_t)esp_cpu_get_cycle_count();
+}
+
+/**
+ * @brief Close a span and push it into the ring buffer (lock-free, any task)
+ * @param app  Static string naming the app (usually the module TAG)
+ */
+void ui_trace_end(const char *app, ui_trace_kind_t kind, ui_trace_t start);
+
+/**
+ * @brief Start a span timed with esp_timer instead of the cycle counter
+ * For tasks that are not pinned: begin and end may run on either core.
+ * Microsecond resolution; spans past the cycle-count field (~17 s at
+ * 240 MHz) are clamped.
+ */
+static inline ui_trace_us_t ui_trace_begin_us(void) {
+    return esp_timer_get_time();
+}
+
+/**
+ * @brief Close a span started with ui_trace_begin_us()
+ */
+void ui_trace_end_us(const char *app, ui_trace_kind_t kind, ui_trace_us_t start);
+
+#else
+
+static inline ui_trace_t ui_trace_begin(void) { return 0; }
+static inline void ui_trace_end(const char *app, ui_trace_kind_t kind, ui_trace_t start) {
+    (void)app; (void)kind; (void)start;
+}
+static inline ui_trace_us_t ui_trace_begin_us(void) { return 0; }
+static inline void ui_trace_end_us(const char *app, ui_trace_kind_t kind, ui_trace_us_t start) {
+    (void)app; (void)kind; (void)start;
+}
+
+#endif
+
+/**
+ * @brief Hook display render/flush events and start the serial command task
+ * Call once with the LVGL lock held.
+ */
+void ui_trace_init(void);
+
+/**
+ * @brief Drop all recorded spans
+ */
+void ui_trace_clear(void);
+
+/**
+ * @brief Print last/avg/max per app and span kind
+ */
+void ui_trace_dump_summary(FILE *out);
+
+/**
+ * @brief Print the ring buffer in Chrome trace JSON format (chrome://tracing, Perfetto)
+ */
+void ui_trace_dump_chrome(FILE *out);
+
+/**
+ * @brief Toggle the on-screen span overlay (top layer, survives screen changes)
+ */
+void ui_trace_overlay_toggle(void);
+
+/**
+ * @brief Span kind name
+ */
+const char *ui_trace_kind_name(ui_trace_kind_t kind);
+
+#ifdef __cplusplus
+}
+#endif
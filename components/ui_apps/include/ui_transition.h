@@ -0,0 +1,49 @@
+#pragma once
+
+/**
+ * Snapshot screen transitions.
+ *
+ * The outgoing screen is rendered once into an RGB565 bitmap before the new
+ * screen is built, the incoming one once after. While the transition runs
+ * only those two bitmaps sit on a bare screen, so each frame is an image
+ * blit instead of a redraw of both widget trees. The real incoming screen is
+ * loaded when the animation ends.
+ *
+ * Bitmaps are allocated in PSRAM per transition and freed when it ends.
+ * CONFIG_UI_TRANSITION_MS = 0 turns this into plain lv_screen_load().
+ */
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    UI_TRANSITION_SLIDE_LEFT = 0,   // Incoming screen enters from the right
+    UI_TRANSITION_SLIDE_RIGHT,      // Incoming screen enters from the left
+    UI_TRANSITION_FADE,             // Incoming screen fades in over the outgoing one
+} ui_transition_kind_t;
+
+/**
+ * @brief Snapshot the active screen as the outgoing side
+ * Call before the next screen is built and loaded. A transition that is
+ * still running is finished first.
+ */
+void ui_transition_begin(void);
+
+/**
+ * @brief Snapshot the active (freshly loaded) screen and animate to it
+ * Does nothing if ui_transition_begin() wasn't called or its snapshot
+ * failed, leaving the plain screen load in place.
+ */
+void ui_transition_run(ui_transition_kind_t kind);
+
+/**
+ * @brief True while a transition is on screen
+ */
+bool ui_transition_active(void);
+
+#ifdef __cplusplus
+}
+#endif
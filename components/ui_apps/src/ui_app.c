@@ -0,0 +1,111 @@
+#include "ui_app.h"
+#include "ui_launcher.h"
+#include "ui_transition.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+
+static const char *TAG = "ui_app";
+
+// Descriptors live next to each app
+extern const ui_app_t ui_app_maze;       // ui_maze.c
+extern const ui_app_t ui_app_sports;     // ui_sports.c
+extern const ui_app_t ui_app_weather;    // ui_weather.c
+extern const ui_app_t ui_app_photos;     // ui_photos.c
+extern const ui_app_t ui_app_settings;   // ui_board_settings.c
+
+// Launcher order
+static const ui_app_t *const registry[] = {
+    &ui_app_maze,
+    &ui_app_sports,
+    &ui_app_weather,
+    &ui_app_photos,
+    &ui_app_settings,
+};
+
+#define APP_COUNT (sizeof(registry) / sizeof(registry[0]))
+
+static const ui_app_t *current = NULL;
+static const ui_app_t *closing = NULL;  // Exited, destroy hook still queued
+
+size_t ui_app_count(void) {
+    return APP_COUNT;
+}
+
+const ui_app_t *ui_app_get(size_t i) {
+    return i < APP_COUNT ? registry[i] : NULL;
+}
+
+const ui_app_t *ui_app_current(void) {
+    return current;
+}
+
+static size_t app_held_bytes(const ui_app_t *app) {
+    ui_mem_app_stats_t st;
+    ui_mem_get_app_stats(app->mem_app, &st);
+    return st.internal_bytes + st.spiram_bytes;
+}
+
+// Destroy hook, budget check and leak flagging; doesn't touch the launcher
+static void close_app(const ui_app_t *app) {
+    ui_mem_app_stats_t st;
+    ui_mem_get_app_stats(app->mem_app, &st);
+    if (app->mem_budget && st.peak_bytes > app->mem_budget) {
+        ESP_LOGW(TAG, "%s peaked at %u KB, over its %u KB budget", app->name,
+                 (unsigned)(st.peak_bytes / 1024), (unsigned)(app->mem_budget / 1024));
+    }
+
+    size_t held = app_held_bytes(app);
+    if (app->destroy) app->destroy();
+    uint32_t leaked = ui_mem_app_closed(app->mem_app);
+    size_t left = app_held_bytes(app);
+
+    ESP_LOGI(TAG, "Closed %s: released %u KB, %lu block(s) leaked, free internal %u KB PSRAM %u KB",
+             app->name, (unsigned)((held - left) / 1024), (unsigned long)leaked,
+             (unsigned)(heap_caps_get_free_size(MALLOC_CAP_INTERNAL) / 1024),
+             (unsigned)(heap_caps_get_free_size(MALLOC_CAP_SPIRAM) / 1024));
+}
+
+// Deferred from ui_app_exit(): the exit comes from an event on the app's own
+// screen, which must outlive that event
+static void close_async_cb(void *arg) {
+    const ui_app_t *app = closing;
+    closing = NULL;
+    if (app) close_app(app);
+}
+
+// Run a queued close now (only from outside close_async_cb)
+static void close_pending(void) {
+    if (!closing) return;
+    lv_async_call_cancel(close_async_cb, NULL);
+    close_async_cb(NULL);
+}
+
+void ui_app_launch(const ui_app_t *app) {
+    if (!app) return;
+    close_pending();                    // Relaunched before the last exit finished
+    if (current) close_app(current);
+
+    ESP_LOGI(TAG, "Launching %s", app->name);
+    ui_transition_begin();
+    current = app;
+    app->create();
+    ui_transition_run(UI_TRANSITION_SLIDE_LEFT);
+
+    // The app screen is loaded now; drop the launcher once this event is done
+    ui_launcher_destroy_async();
+}
+
+void ui_app_exit(void) {
+    const ui_app_t *app = current;
+    current = NULL;
+    ui_transition_begin();
+    ui_launcher_show();
+    ui_transition_run(UI_TRANSITION_SLIDE_RIGHT);
+
+    // The launcher is loaded; destroy the app once this event is done
+    if (app) {
+        close_pending();
+        closing = app;
+        lv_async_call(close_async_cb, NULL);
+    }
+}
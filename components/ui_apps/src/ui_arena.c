@@ -0,0 +1,284 @@
+#include "ui_arena.h"
+#include "sdkconfig.h"
+#include "ui_app.h"
+#include "ui_arena_core.h"
+#include "lvgl_mgr.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "ui_arena";
+
+static uint32_t heap_allocs = 0;
+
+#if CONFIG_UI_ARENA
+
+// One screen being built: routes its builder task's allocations into an arena
+struct ui_arena {
+    arena_t *arena;
+    const char *name;
+    TaskHandle_t owner;             // Only this task's allocations are routed
+};
+
+static arena_pool_t *pool = NULL;
+static ui_arena_t scope;
+static ui_arena_t *routing = NULL;
+static portMUX_TYPE arena_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Same placement rule as plain malloc for blocks this size (internal first)
+static void *chunk_alloc(void *ctx, size_t size) {
+    return heap_caps_malloc_prefer(size, 2, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT, MALLOC_CAP_SPIRAM);
+}
+
+static void chunk_free(void *ctx, void *chunk) {
+    heap_caps_free(chunk);
+}
+
+static void pool_lock(void *ctx) {
+    taskENTER_CRITICAL(&arena_lock);
+}
+
+static void pool_unlock(void *ctx) {
+    taskEXIT_CRITICAL(&arena_lock);
+}
+
+// --- LVGL allocator hooks (LV_USE_CUSTOM_MALLOC) ---
+
+// lv_init() calls this before its first allocation
+void lv_mem_init(void) {
+    if (pool) return;
+    const arena_pool_config_t cfg = {
+        .chunk_size = CONFIG_UI_ARENA_CHUNK_SIZE,
+        .max_arenas = CONFIG_UI_ARENA_MAX,
+        .max_chunks = CONFIG_UI_ARENA_MAX_CHUNKS,
+    };
+    const arena_backend_t be = {
+        .chunk_alloc = chunk_alloc,
+        .chunk_free = chunk_free,
+        .lock = pool_lock,
+        .unlock = pool_unlock,
+    };
+    pool = arena_pool_create(&cfg, &be);
+    if (!pool) ESP_LOGE(TAG, "No memory for the arena pool, LVGL uses the heap");
+}
+
+void lv_mem_deinit(void) {}
+
+lv_mem_pool_t lv_mem_add_pool(void *mem, size_t bytes) {
+    (void)mem; (void)bytes;
+    return NULL;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool) {
+    (void)pool;
+}
+
+void *lv_malloc_core(size_t size) {
+    ui_arena_t *r = routing;
+    if (r && r->owner == xTaskGetCurrentTaskHandle() && size <= ARENA_MAX_PAYLOAD) {
+        void *p = arena_alloc(pool, r->arena, size);
+        if (p) return p;
+    }
+    heap_allocs++;
+    return malloc(size);
+}
+
+// Heap blocks are told apart by their header without taking arena_lock
+void lv_free_core(void *p) {
+    if (!pool || !arena_free(pool, p)) free(p);
+}
+
+void *lv_realloc_core(void *p, size_t new_size) {
+    if (!pool || !arena_owns(pool, p)) return realloc(p, new_size);
+
+    void *np = arena_realloc(pool, p, new_size);
+    if (!np) {
+        // Too big for a slab, or the arena couldn't get a chunk
+        heap_allocs++;
+        np = malloc(new_size);
+        if (np) {
+            memcpy(np, p, arena_block_size(p));
+            arena_free(pool, p);
+        }
+    }
+    return np;
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t *mon_p) {
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+    mon_p->total_size = info.total_free_bytes + info.total_allocated_bytes;
+    mon_p->free_size = info.total_free_bytes;
+    mon_p->free_biggest_size = info.largest_free_block;
+    mon_p->free_cnt = info.free_blocks;
+    mon_p->used_cnt = info.allocated_blocks;
+    mon_p->max_used = mon_p->total_size - info.minimum_free_bytes;
+    mon_p->used_pct = mon_p->total_size ? (uint8_t)(info.total_allocated_bytes * 100 / mon_p->total_size) : 0;
+    mon_p->frag_pct = info.total_free_bytes ?
+                      (uint8_t)(100 - info.largest_free_block * 100 / info.total_free_bytes) : 0;
+}
+
+lv_result_t lv_mem_test_core(void) {
+    return heap_caps_check_integrity_all(true) ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+// --- Scoping ---
+
+static void screen_delete_cb(lv_event_t *e) {
+    // The screen itself is freed after this event, so the arena is never
+    // empty here; lv_free_core() releases it when the last block goes.
+    arena_close(pool, (arena_t *)lv_event_get_user_data(e));
+}
+
+ui_arena_t *ui_arena_begin(const char *name) {
+    if (!pool) return NULL;
+    if (routing) {
+        ESP_LOGW(TAG, "Arena '%s' still open, '%s' uses the heap", routing->name, name);
+        return NULL;
+    }
+    arena_t *a = arena_open(pool);
+    if (!a) {
+        ESP_LOGW(TAG, "No free arena slot for '%s' (pinned arenas?)", name);
+        return NULL;
+    }
+    scope.arena = a;
+    scope.name = name;
+    scope.owner = xTaskGetCurrentTaskHandle();
+    routing = &scope;
+    return routing;
+}
+
+void ui_arena_end(ui_arena_t *arena, lv_obj_t *screen) {
+    if (!arena) return;
+    routing = NULL;
+
+    arena_stats_t st;
+    arena_get_stats(pool, arena->arena, &st);
+    ESP_LOGD(TAG, "'%s': %lu blocks, %u bytes in %lu chunks", arena->name,
+             (unsigned long)st.live_blocks, (unsigned)st.live_bytes, (unsigned long)st.chunks);
+
+    if (screen) {
+        lv_obj_add_event_cb(screen, screen_delete_cb, LV_EVENT_DELETE, arena->arena);
+    } else {
+        arena_close(pool, arena->arena);
+    }
+}
+
+#else  // !CONFIG_UI_ARENA
+
+#if CONFIG_LV_USE_CUSTOM_MALLOC
+// Arenas disabled but LVGL still expects the hooks: plain heap passthrough
+void lv_mem_init(void) {}
+void lv_mem_deinit(void) {}
+lv_mem_pool_t lv_mem_add_pool(void *mem, size_t bytes) { (void)mem; (void)bytes; return NULL; }
+void lv_mem_remove_pool(lv_mem_pool_t pool) { (void)pool; }
+void *lv_malloc_core(size_t size) { heap_allocs++; return malloc(size); }
+void *lv_realloc_core(void *p, size_t new_size) { return realloc(p, new_size); }
+void lv_free_core(void *p) { free(p); }
+void lv_mem_monitor_core(lv_mem_monitor_t *mon_p) { memset(mon_p, 0, sizeof(*mon_p)); }
+lv_result_t lv_mem_test_core(void) { return LV_RESULT_OK; }
+#endif
+
+ui_arena_t *ui_arena_begin(const char *name) {
+    (void)name;
+    return NULL;
+}
+
+void ui_arena_end(ui_arena_t *arena, lv_obj_t *screen) {
+    (void)arena; (void)screen;
+}
+
+#endif
+
+static uint8_t frag_pct(size_t free_bytes, size_t largest) {
+    return free_bytes ? (uint8_t)(100 - largest * 100 / free_bytes) : 0;
+}
+
+void ui_arena_get_stats(ui_arena_stats_t *out) {
+    memset(out, 0, sizeof(*out));
+#if CONFIG_UI_ARENA
+    if (pool) {
+        arena_stats_t st;
+        arena_get_stats(pool, NULL, &st);
+        out->arenas_open = st.open;
+        out->arenas_pinned = st.pinned;
+        out->chunks = st.chunks;
+        out->arena_held_bytes = st.held_bytes;
+        out->arena_live_bytes = st.live_bytes;
+        out->arena_allocs = st.allocs;
+        out->releases = st.releases;
+    }
+#endif
+    out->heap_allocs = heap_allocs;
+
+    out->internal_free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    out->internal_largest = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    out->internal_frag_pct = frag_pct(out->internal_free, out->internal_largest);
+    out->spiram_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    out->spiram_largest = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+    out->spiram_frag_pct = frag_pct(out->spiram_free, out->spiram_largest);
+}
+
+void ui_arena_log_stats(void) {
+    ui_arena_stats_t st;
+    ui_arena_get_stats(&st);
+    ESP_LOGI(TAG, "arenas %lu open %lu pinned, %lu chunks (%u held, %u live), "
+             "%lu arena / %lu heap allocs, %lu releases | "
+             "internal free %u largest %u frag %u%% | spiram free %u largest %u frag %u%%",
+             (unsigned long)st.arenas_open, (unsigned long)st.arenas_pinned, (unsigned long)st.chunks,
+             (unsigned)st.arena_held_bytes, (unsigned)st.arena_live_bytes,
+             (unsigned long)st.arena_allocs, (unsigned long)st.heap_allocs, (unsigned long)st.releases,
+             (unsigned)st.internal_free, (unsigned)st.internal_largest, st.internal_frag_pct,
+             (unsigned)st.spiram_free, (unsigned)st.spiram_largest, st.spiram_frag_pct);
+}
+
+// Long enough for the slide transition, the launcher's delayed delete and
+// the queued destroy hook to run before the next step
+#define SOAK_SETTLE_MS  (CONFIG_UI_TRANSITION_MS + 200)
+#define SOAK_LOG_EVERY  10
+#define SOAK_STACK      8192
+
+static void soak_task_fn(void *arg) {
+    uint32_t cycles = (uint32_t)(uintptr_t)arg;
+    ui_arena_stats_t before, after;
+    ESP_LOGI(TAG, "Soak: %lu cycles over %u apps", (unsigned long)cycles, (unsigned)ui_app_count());
+    ui_arena_get_stats(&before);
+
+    for (uint32_t i = 0; i < cycles; i++) {
+        for (size_t n = 0; n < ui_app_count(); n++) {
+            lvgl_mgr_lock();
+            ui_app_launch(ui_app_get(n));
+            lvgl_mgr_unlock();
+            vTaskDelay(pdMS_TO_TICKS(SOAK_SETTLE_MS));
+
+            lvgl_mgr_lock();
+            ui_app_exit();
+            lvgl_mgr_unlock();
+            vTaskDelay(pdMS_TO_TICKS(SOAK_SETTLE_MS));
+        }
+
+        if ((i + 1) % SOAK_LOG_EVERY == 0) {
+            ESP_LOGI(TAG, "Soak cycle %lu", (unsigned long)(i + 1));
+            ui_arena_log_stats();
+        }
+    }
+
+    ui_arena_get_stats(&after);
+    ESP_LOGI(TAG, "Soak done: internal largest %u -> %u (frag %u%% -> %u%%), "
+             "spiram largest %u -> %u (frag %u%% -> %u%%), %lu arenas pinned",
+             (unsigned)before.internal_largest, (unsigned)after.internal_largest,
+             before.internal_frag_pct, after.internal_frag_pct,
+             (unsigned)before.spiram_largest, (unsigned)after.spiram_largest,
+             before.spiram_frag_pct, after.spiram_frag_pct,
+             (unsigned long)after.arenas_pinned);
+    vTaskDelete(NULL);
+}
+
+void ui_arena_soak_start(uint32_t cycles) {
+    if (xTaskCreate(soak_task_fn, "ui_arena_soak", SOAK_STACK, (void *)(uintptr_t)cycles, 1, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "Soak task not created");
+    }
+}
@@ -0,0 +1,362 @@
+#include "ui_arena_core.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_HDR       8           // Keeps payloads 8-byte aligned
+#define ARENA_MAGIC     0xA7E4
+#define CHUNK_HDR       ((sizeof(arena_chunk_t) + 7) & ~(size_t)7)
+#define CHUNK_MAX       (65535u * 8)    // Largest chunk arena_hdr_t.chunk_off can reach
+
+// Payload size classes; anything bigger goes to the heap
+static const uint16_t class_size[] = {16, 24, 32, 48, 64, 96, 128, 192, 256, 384, ARENA_MAX_PAYLOAD};
+#define CLASS_COUNT     (sizeof(class_size) / sizeof(class_size[0]))
+
+typedef struct {
+    uint16_t magic;
+    uint8_t cls;
+    uint8_t reserved;
+    uint16_t size;                  // Requested size, for realloc
+    uint16_t chunk_off;             // Distance back to the chunk, in 8-byte units
+} arena_hdr_t;
+_Static_assert(sizeof(arena_hdr_t) == ARENA_HDR, "arena header must stay 8 bytes");
+_Static_assert(ARENA_MAX_PAYLOAD <= UINT16_MAX, "block sizes must fit arena_hdr_t.size");
+
+typedef struct free_blk {
+    struct free_blk *next;
+} free_blk_t;
+
+typedef struct arena_chunk {
+    struct arena_chunk *next;
+    arena_t *arena;
+    uint32_t size;                  // Usable bytes after the header
+    uint32_t used;                  // Bump offset
+    uint32_t live;                  // Blocks handed out and not freed
+} arena_chunk_t;
+
+struct arena {
+    bool in_use;
+    bool closed;                    // No more blocks; chunks go as they empty
+    arena_chunk_t *chunks;          // Head is the bump chunk
+    free_blk_t *free_list[CLASS_COUNT];
+    uint32_t live;
+    size_t live_bytes;
+    uint32_t chunk_count;
+};
+
+struct arena_pool {
+    arena_pool_config_t cfg;
+    arena_backend_t be;
+    uint32_t allocs;
+    uint32_t releases;
+    uint32_t chunk_releases;
+    uint32_t chunk_count;
+    arena_chunk_t **table;          // Every chunk held, sorted by address
+    arena_t arenas[];
+};
+
+static void lock(arena_pool_t *p) {
+    if (p->be.lock) p->be.lock(p->be.ctx);
+}
+
+static void unlock(arena_pool_t *p) {
+    if (p->be.unlock) p->be.unlock(p->be.ctx);
+}
+
+static int class_for(size_t size) {
+    for (int i = 0; i < (int)CLASS_COUNT; i++) {
+        if (size <= class_size[i]) return i;
+    }
+    return -1;
+}
+
+static arena_hdr_t *hdr_of(const void *ptr) {
+    return (arena_hdr_t *)((uint8_t *)ptr - ARENA_HDR);
+}
+
+// Lock-free first look. The 8 bytes before a heap block are the heap's own
+// header, which never reads as the magic word on the heaps this runs on;
+// a match still has to be confirmed with chunk_of().
+static bool maybe_arena_block(const void *ptr) {
+    return ptr && hdr_of(ptr)->magic == ARENA_MAGIC;
+}
+
+// Caller holds the lock. Index of the last chunk starting at or below
+// @p addr, -1 if none.
+static int chunk_index(arena_pool_t *p, uintptr_t addr) {
+    int lo = 0, hi = (int)p->chunk_count - 1, found = -1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if ((uintptr_t)p->table[mid] <= addr) {
+            found = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return found;
+}
+
+// Caller holds the lock
+static arena_chunk_t *chunk_of(arena_pool_t *p, const void *ptr) {
+    uintptr_t addr = (uintptr_t)ptr;
+    int i = chunk_index(p, addr);
+    if (i < 0) return NULL;
+    arena_chunk_t *c = p->table[i];
+    uintptr_t start = (uintptr_t)c + CHUNK_HDR;
+    return addr >= start + ARENA_HDR && addr < start + c->size ? c : NULL;
+}
+
+// Caller holds the lock and has checked the table has room
+static void table_insert(arena_pool_t *p, arena_chunk_t *c) {
+    int i = chunk_index(p, (uintptr_t)c) + 1;
+    memmove(&p->table[i + 1], &p->table[i], (p->chunk_count - i) * sizeof(p->table[0]));
+    p->table[i] = c;
+    p->chunk_count++;
+}
+
+// Caller holds the lock
+static void table_remove(arena_pool_t *p, arena_chunk_t *c) {
+    int i = chunk_index(p, (uintptr_t)c);
+    assert(i >= 0 && p->table[i] == c);
+    p->chunk_count--;
+    memmove(&p->table[i], &p->table[i + 1], (p->chunk_count - i) * sizeof(p->table[0]));
+}
+
+// Caller holds the lock; returns a block or NULL if the bump chunk is full
+static void *carve(arena_pool_t *p, arena_t *a, int cls, size_t size) {
+    uint8_t *mem = NULL;
+    arena_chunk_t *c = a->chunks;
+    size_t blk = class_size[cls] + ARENA_HDR;
+
+    if (a->free_list[cls]) {
+        mem = (uint8_t *)a->free_list[cls] - ARENA_HDR;
+        a->free_list[cls] = a->free_list[cls]->next;
+        c = (arena_chunk_t *)(mem - ((arena_hdr_t *)mem)->chunk_off * 8u);
+    } else if (c && c->used + blk <= c->size) {
+        mem = (uint8_t *)c + CHUNK_HDR + c->used;
+        c->used += blk;
+    } else {
+        return NULL;
+    }
+
+    arena_hdr_t *hdr = (arena_hdr_t *)mem;
+    hdr->magic = ARENA_MAGIC;
+    hdr->cls = (uint8_t)cls;
+    hdr->size = (uint16_t)size;
+    hdr->chunk_off = (uint16_t)((mem - (uint8_t *)c) / 8);
+    c->live++;
+    a->live++;
+    a->live_bytes += size;
+    p->allocs++;
+    return mem + ARENA_HDR;
+}
+
+// Caller holds the lock; detaches the chunks so they can be freed unlocked
+static arena_chunk_t *arena_reset(arena_pool_t *p, arena_t *a) {
+    arena_chunk_t *chunks = a->chunks;
+    for (arena_chunk_t *c = chunks; c; c = c->next) table_remove(p, c);
+    memset(a, 0, sizeof(*a));
+    p->releases++;
+    return chunks;
+}
+
+// Caller holds the lock; detaches the empty chunks of closed arena @p a
+static arena_chunk_t *drop_empty_chunks(arena_pool_t *p, arena_t *a) {
+    arena_chunk_t *dropped = NULL;
+    for (arena_chunk_t **link = &a->chunks; *link;) {
+        arena_chunk_t *c = *link;
+        if (c->live) {
+            link = &c->next;
+            continue;
+        }
+        *link = c->next;
+        table_remove(p, c);
+        a->chunk_count--;
+        p->chunk_releases++;
+        c->next = dropped;
+        dropped = c;
+    }
+    return dropped;
+}
+
+static void free_chunks(arena_pool_t *p, arena_chunk_t *c) {
+    while (c) {
+        arena_chunk_t *next = c->next;
+        p->be.chunk_free(p->be.ctx, c);
+        c = next;
+    }
+}
+
+arena_pool_t *arena_pool_create(const arena_pool_config_t *cfg, const arena_backend_t *be) {
+    if (cfg->chunk_size < CHUNK_HDR + ARENA_HDR + ARENA_MAX_PAYLOAD || cfg->chunk_size > CHUNK_MAX ||
+        cfg->max_arenas == 0 || cfg->max_chunks == 0) {
+        return NULL;
+    }
+    size_t arenas = cfg->max_arenas * sizeof(arena_t);
+    arena_pool_t *p = calloc(1, sizeof(*p) + arenas + cfg->max_chunks * sizeof(arena_chunk_t *));
+    if (!p) return NULL;
+    p->cfg = *cfg;
+    p->be = *be;
+    p->table = (arena_chunk_t **)((uint8_t *)p->arenas + arenas);
+    return p;
+}
+
+void arena_pool_destroy(arena_pool_t *p) {
+    if (!p) return;
+    for (int i = 0; i < p->cfg.max_arenas; i++) {
+        free_chunks(p, p->arenas[i].chunks);
+    }
+    free(p);
+}
+
+arena_t *arena_open(arena_pool_t *p) {
+    arena_t *a = NULL;
+    lock(p);
+    for (int i = 0; i < p->cfg.max_arenas; i++) {
+        if (!p->arenas[i].in_use) {
+            a = &p->arenas[i];
+            memset(a, 0, sizeof(*a));
+            a->in_use = true;
+            break;
+        }
+    }
+    unlock(p);
+    return a;
+}
+
+void arena_close(arena_pool_t *p, arena_t *a) {
+    arena_chunk_t *to_free = NULL;
+    lock(p);
+    a->closed = true;
+    memset(a->free_list, 0, sizeof(a->free_list));     // Never carved from again
+    if (a->live == 0) {
+        to_free = arena_reset(p, a);
+    } else {
+        to_free = drop_empty_chunks(p, a);
+    }
+    unlock(p);
+    free_chunks(p, to_free);
+}
+
+void *arena_alloc(arena_pool_t *p, arena_t *a, size_t size) {
+    int cls = class_for(size);
+    if (cls < 0) return NULL;
+
+    lock(p);
+    void *ptr = a->closed ? NULL : carve(p, a, cls, size);
+    bool room = !a->closed && p->chunk_count < p->cfg.max_chunks;
+    unlock(p);
+    if (ptr || !room) return ptr;
+
+    arena_chunk_t *c = p->be.chunk_alloc(p->be.ctx, p->cfg.chunk_size);
+    if (!c) return NULL;
+    c->arena = a;
+    c->size = (uint32_t)(p->cfg.chunk_size - CHUNK_HDR);
+    c->used = 0;
+    c->live = 0;
+
+    lock(p);
+    room = p->chunk_count < p->cfg.max_chunks;      // Another task may have taken the slot
+    if (room) {
+        table_insert(p, c);
+        c->next = a->chunks;
+        a->chunks = c;
+        a->chunk_count++;
+        ptr = carve(p, a, cls, size);
+    }
+    unlock(p);
+    if (!room) p->be.chunk_free(p->be.ctx, c);
+    return ptr;
+}
+
+bool arena_owns(arena_pool_t *p, const void *ptr) {
+    if (!maybe_arena_block(ptr)) return false;
+    lock(p);
+    bool owned = chunk_of(p, ptr) != NULL;
+    unlock(p);
+    return owned;
+}
+
+bool arena_free(arena_pool_t *p, void *ptr) {
+    if (!maybe_arena_block(ptr)) return false;
+
+    arena_chunk_t *to_free = NULL;
+    lock(p);
+    arena_chunk_t *c = chunk_of(p, ptr);
+    if (c) {
+        arena_t *a = c->arena;
+        arena_hdr_t *hdr = hdr_of(ptr);
+        c->live--;
+        a->live--;
+        a->live_bytes -= hdr->size;
+        if (!a->closed) {
+            free_blk_t *blk = (free_blk_t *)ptr;
+            blk->next = a->free_list[hdr->cls];
+            a->free_list[hdr->cls] = blk;
+        } else if (a->live == 0) {
+            to_free = arena_reset(p, a);
+        } else if (c->live == 0) {
+            to_free = drop_empty_chunks(p, a);
+        }
+    }
+    unlock(p);
+
+    free_chunks(p, to_free);
+    return c != NULL;
+}
+
+void *arena_realloc(arena_pool_t *p, void *ptr, size_t new_size) {
+    lock(p);
+    arena_chunk_t *c = chunk_of(p, ptr);
+    arena_hdr_t *hdr = hdr_of(ptr);
+    assert(c && hdr->magic == ARENA_MAGIC);
+    arena_t *a = c->arena;
+    if (new_size <= class_size[hdr->cls]) {
+        a->live_bytes += new_size;
+        a->live_bytes -= hdr->size;
+        hdr->size = (uint16_t)new_size;
+        unlock(p);
+        return ptr;     // Still fits its slot
+    }
+    size_t old_size = hdr->size;
+    bool closed = a->closed;
+    unlock(p);
+
+    // Grow within the owning arena so the block goes away with it; a
+    // closed arena takes no new blocks, so the caller moves it to the heap
+    void *np = closed ? NULL : arena_alloc(p, a, new_size);
+    if (np) {
+        memcpy(np, ptr, old_size);
+        arena_free(p, ptr);
+    }
+    return np;
+}
+
+size_t arena_block_size(const void *ptr) {
+    return hdr_of(ptr)->size;
+}
+
+static void add_stats(arena_pool_t *p, const arena_t *a, arena_stats_t *out) {
+    if (a->closed) out->pinned++; else out->open++;
+    out->chunks += a->chunk_count;
+    out->held_bytes += a->chunk_count * (size_t)p->cfg.chunk_size;
+    out->live_blocks += a->live;
+    out->live_bytes += a->live_bytes;
+}
+
+void arena_get_stats(arena_pool_t *p, const arena_t *a, arena_stats_t *out) {
+    memset(out, 0, sizeof(*out));
+    lock(p);
+    if (a) {
+        add_stats(p, a, out);
+    } else {
+        for (int i = 0; i < p->cfg.max_arenas; i++) {
+            if (p->arenas[i].in_use) add_stats(p, &p->arenas[i], out);
+        }
+        out->allocs = p->allocs;
+        out->releases = p->releases;
+        out->chunk_releases = p->chunk_releases;
+    }
+    unlock(p);
+}
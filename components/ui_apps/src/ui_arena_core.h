@@ -0,0 +1,124 @@
+#pragma once
+
+/**
+ * Size-class slab arenas, independent of ESP-IDF, FreeRTOS and LVGL.
+ *
+ * An arena hands out small blocks (up to ARENA_MAX_PAYLOAD bytes) carved
+ * from a few large chunks, with a free list per size class. Once the arena
+ * is closed it takes no new blocks, and each chunk goes back through the
+ * backend as soon as its last block is freed, so blocks that outlive their
+ * screen pin only the chunks they sit in. ui_arena.c binds one arena to each app screen and
+ * routes LVGL's allocations into it; tools/arena_soak.c runs screen
+ * build/delete cycles over a simulated heap and reports fragmentation with
+ * and without arenas.
+ *
+ * Chunk memory and locking come from a backend. The lock is never held
+ * across chunk_alloc()/chunk_free(), and is not taken at all to free or
+ * look up a pointer that is not an arena block: those are told apart by a
+ * header word, then confirmed against a table of chunks sorted by address.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ARENA_MAX_PAYLOAD   512     // Larger requests are the caller's to serve
+
+typedef struct {
+    // Chunk of @p size bytes, 8-byte aligned; NULL if out of memory
+    void *(*chunk_alloc)(void *ctx, size_t size);
+    void (*chunk_free)(void *ctx, void *chunk);
+    // Guard the pool against other tasks; NULL when single-threaded
+    void (*lock)(void *ctx);
+    void (*unlock)(void *ctx);
+    void *ctx;
+} arena_backend_t;
+
+typedef struct {
+    uint32_t chunk_size;        // Bytes per chunk, header included
+    uint8_t max_arenas;         // Arenas alive at once, closed-but-pinned included
+    uint16_t max_chunks;        // Chunks held at once across all arenas
+} arena_pool_config_t;
+
+/**
+ * @brief Counters for a pool, or for one arena
+ */
+typedef struct {
+    uint32_t open;              // Arenas not closed yet
+    uint32_t pinned;            // Closed, but blocks still alive
+    uint32_t chunks;            // Chunks currently held
+    size_t held_bytes;          // Chunk memory currently held
+    uint32_t live_blocks;
+    size_t live_bytes;          // Requested bytes in live blocks
+    uint32_t allocs;            // Blocks handed out (pool only)
+    uint32_t releases;          // Arenas returned in one shot (pool only)
+    uint32_t chunk_releases;    // Chunks returned early by closed arenas (pool only)
+} arena_stats_t;
+
+typedef struct arena_pool arena_pool_t;
+typedef struct arena arena_t;
+
+arena_pool_t *arena_pool_create(const arena_pool_config_t *cfg, const arena_backend_t *be);
+
+/**
+ * @brief Free the pool and every chunk it still holds, live blocks included
+ */
+void arena_pool_destroy(arena_pool_t *p);
+
+/**
+ * @brief Take a free arena slot
+ * @return NULL if every slot is in use (e.g. by pinned arenas)
+ */
+arena_t *arena_open(arena_pool_t *p);
+
+/**
+ * @brief Mark @p a closed; it takes no new blocks, each chunk is released
+ * once its last block is freed and the arena slot once all of them are
+ * (right away if it is already empty). @p a must not be used afterwards.
+ */
+void arena_close(arena_pool_t *p, arena_t *a);
+
+/**
+ * @brief Block of @p size bytes from @p a, 8-byte aligned
+ * @return NULL if @p size is over ARENA_MAX_PAYLOAD, @p a is closed, or no
+ *         chunk could be had (backend out of memory, max_chunks reached)
+ */
+void *arena_alloc(arena_pool_t *p, arena_t *a, size_t size);
+
+/**
+ * @brief Whether @p ptr is a block from one of the pool's arenas
+ */
+bool arena_owns(arena_pool_t *p, const void *ptr);
+
+/**
+ * @brief Free @p ptr if it is an arena block
+ * @return false if it isn't one (the caller frees it)
+ */
+bool arena_free(arena_pool_t *p, void *ptr);
+
+/**
+ * @brief Resize arena block @p ptr
+ * Stays in place while it fits its size class, else moves to a new block in
+ * the same arena so it still goes away with it.
+ * @return New pointer, or NULL if the arena can't hold @p new_size or is
+ *         closed (@p ptr is then untouched, the caller moves it to the heap)
+ */
+void *arena_realloc(arena_pool_t *p, void *ptr, size_t new_size);
+
+/**
+ * @brief Requested size of arena block @p ptr
+ */
+size_t arena_block_size(const void *ptr);
+
+/**
+ * @brief Snapshot counters for the pool (@p a NULL) or one open arena
+ */
+void arena_get_stats(arena_pool_t *p, const arena_t *a, arena_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
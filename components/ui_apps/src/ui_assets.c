@@ -0,0 +1,139 @@
+#include "ui_assets.h"
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include <string.h>
+
+static const char *TAG = "ui_assets";
+
+// Pack layout, kept in sync with tools/mkassets.py (little-endian)
+#define PACK_PARTITION  "storage"
+#define PACK_MAGIC      0x50414955      // "UIAP"
+#define PACK_VERSION    1
+#define PACK_NAME_LEN   40
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint32_t index_offset;
+    uint32_t size;              // Whole pack, header included
+    uint32_t index_crc;         // CRC-32 of the index table
+    uint32_t reserved[3];
+} pack_hdr_t;
+
+typedef struct {
+    char name[PACK_NAME_LEN];   // NUL padded
+    uint32_t offset;            // From the start of the pack, 16-byte aligned
+    uint32_t size;
+} pack_entry_t;
+
+static const uint8_t *pack = NULL;
+static const pack_entry_t *index_tab = NULL;
+static uint16_t entry_count = 0;
+
+// --- Lookup ---
+
+static const pack_entry_t *find_entry(const char *name) {
+    for (uint16_t i = 0; i < entry_count; i++) {
+        if (strncmp(index_tab[i].name, name, PACK_NAME_LEN) == 0) return &index_tab[i];
+    }
+    return NULL;
+}
+
+bool ui_assets_find(const char *name, const void **data, size_t *size) {
+    const pack_entry_t *e = find_entry(name);
+    if (!e) return false;
+    *data = pack + e->offset;
+    *size = e->size;
+    return true;
+}
+
+// Fonts stay compiled in: lv_binfont_create() would copy a packed font into
+// RAM on top of the flash copy, so the pack only adds cost for them
+const lv_font_t *ui_assets_font(uint8_t size) {
+    switch (size) {
+#if CONFIG_LV_FONT_MONTSERRAT_14
+        case 14: return &lv_font_montserrat_14;
+#endif
+#if CONFIG_LV_FONT_MONTSERRAT_16
+        case 16: return &lv_font_montserrat_16;
+#endif
+#if CONFIG_LV_FONT_MONTSERRAT_18
+        case 18: return &lv_font_montserrat_18;
+#endif
+#if CONFIG_LV_FONT_MONTSERRAT_20
+        case 20: return &lv_font_montserrat_20;
+#endif
+#if CONFIG_LV_FONT_MONTSERRAT_22
+        case 22: return &lv_font_montserrat_22;
+#endif
+#if CONFIG_LV_FONT_MONTSERRAT_24
+        case 24: return &lv_font_montserrat_24;
+#endif
+#if CONFIG_LV_FONT_MONTSERRAT_26
+        case 26: return &lv_font_montserrat_26;
+#endif
+#if CONFIG_LV_FONT_MONTSERRAT_28
+        case 28: return &lv_font_montserrat_28;
+#endif
+#if CONFIG_LV_FONT_MONTSERRAT_30
+        case 30: return &lv_font_montserrat_30;
+#endif
+#if CONFIG_LV_FONT_MONTSERRAT_36
+        case 36: return &lv_font_montserrat_36;
+#endif
+        default: return LV_FONT_DEFAULT;
+    }
+}
+
+// --- Init ---
+
+static bool map_pack(void) {
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, PACK_PARTITION);
+    if (!part) return false;
+
+    pack_hdr_t hdr;
+    if (esp_partition_read(part, 0, &hdr, sizeof(hdr)) != ESP_OK || hdr.magic != PACK_MAGIC) {
+        ESP_LOGI(TAG, "No asset pack in '%s', using built-in assets", PACK_PARTITION);
+        return false;
+    }
+    if (hdr.version != PACK_VERSION || hdr.size > part->size ||
+        hdr.index_offset + (uint32_t)hdr.count * sizeof(pack_entry_t) > hdr.size) {
+        ESP_LOGW(TAG, "Asset pack v%u (%lu bytes) not usable, using built-in assets",
+                 hdr.version, (unsigned long)hdr.size);
+        return false;
+    }
+
+    // Mapped for the lifetime of the firmware: entries are handed out as pointers
+    const void *mapped;
+    esp_partition_mmap_handle_t map;
+    if (esp_partition_mmap(part, 0, hdr.size, ESP_PARTITION_MMAP_DATA, &mapped, &map) != ESP_OK) {
+        ESP_LOGW(TAG, "Mapping the asset pack failed");
+        return false;
+    }
+    const pack_entry_t *tab = (const pack_entry_t *)((const uint8_t *)mapped + hdr.index_offset);
+    if (esp_rom_crc32_le(0, (const uint8_t *)tab, hdr.count * sizeof(pack_entry_t)) != hdr.index_crc) {
+        ESP_LOGW(TAG, "Asset pack index is corrupt, using built-in assets");
+        esp_partition_munmap(map);
+        return false;
+    }
+    for (uint16_t i = 0; i < hdr.count; i++) {
+        if (tab[i].offset > hdr.size || tab[i].size > hdr.size - tab[i].offset) {
+            ESP_LOGW(TAG, "Asset %.*s is out of bounds, using built-in assets", PACK_NAME_LEN, tab[i].name);
+            esp_partition_munmap(map);
+            return false;
+        }
+    }
+
+    pack = mapped;
+    index_tab = tab;
+    entry_count = hdr.count;
+    ESP_LOGI(TAG, "Asset pack: %u entries, %lu KB mapped", hdr.count, (unsigned long)(hdr.size / 1024));
+    return true;
+}
+
+void ui_assets_init(void) {
+    if (!pack) map_pack();
+}
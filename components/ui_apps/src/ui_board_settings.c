@@ -1,6 +1,13 @@
 #include "ui_private.h"
+#include "ui_assets.h"
 #include "esp_log.h"
-#include "ui_launcher.h"
+#include "esp_timer.h"
+#include "ui_trace.h"
+#include "ui_mem.h"
+#include "ui_cpu.h"
+#include "ui_app.h"
+#include "ui_status_bar.h"
+#include "ui_sdlist.h"
 
 static const char *TAG = "ui_board_set";
 
@@ -10,11 +17,11 @@ LV_IMG_DECLARE(swipeR34);
 void __real_ui_home_create(lv_obj_t * parent);
 
 // Helper for neon buttons (copied/adapted from ui_home logic)
-static void create_neon_btn(lv_obj_t * parent, const char * icon, const char * text, lv_color_t color, lv_event_cb_t event_cb) {
+static lv_obj_t * create_neon_btn(lv_obj_t * parent, const char * icon, const char * text, lv_color_t color, lv_event_cb_t event_cb, void * user_data) {
     lv_obj_t * btn = lv_button_create(parent);
     lv_obj_set_height(btn, 95);
     lv_obj_set_width(btn, LV_PCT(30));
-    lv_obj_add_event_cb(btn, event_cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_add_event_cb(btn, event_cb, LV_EVENT_CLICKED, user_data);
     lv_obj_set_flex_flow(btn, LV_FLEX_FLOW_COLUMN);
     lv_obj_set_flex_align(btn, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
     lv_obj_set_style_pad_all(btn, 4, 0);
@@ -36,75 +43,277 @@ static void create_neon_btn(lv_obj_t * parent, const char * icon, const char * t
     // Icon
     lv_obj_t * lbl_icon = lv_label_create(btn);
     lv_label_set_text(lbl_icon, icon);
-    lv_obj_set_style_text_font(lbl_icon, &lv_font_montserrat_30, 0);
+    lv_obj_set_style_text_font(lbl_icon, ui_assets_font(30), 0);
     lv_obj_set_style_text_color(lbl_icon, lv_color_white(), 0);
 
     // Label
     lv_obj_t * lbl_text = lv_label_create(btn);
     lv_label_set_text(lbl_text, text);
-    lv_obj_set_style_text_font(lbl_text, &lv_font_montserrat_18, 0);
+    lv_obj_set_style_text_font(lbl_text, ui_assets_font(18), 0);
     lv_obj_set_style_text_color(lbl_text, lv_color_white(), 0);
+    return btn;
 }
 
 // --- View Switching Logic ---
 // We must replicate the safe switching logic because the BSP's internal one is static/private
 
+typedef struct {
+    const char *name;
+    void (*create)(lv_obj_t *);
+} hub_view_t;
+
+enum { VIEW_PMIC, VIEW_SET_PM, VIEW_MEDIA, VIEW_DISPLAY, VIEW_SYSINFO, VIEW_WIFI, VIEW_HEAP, VIEW_CPU, VIEW_COUNT };
+
+static const hub_view_t views[VIEW_COUNT] = {
+    [VIEW_PMIC]    = { "PM Status",  ui_pmic_create },
+    [VIEW_SET_PM]  = { "Set PM",     ui_settings_create },
+    [VIEW_MEDIA]   = { "SD Card",    ui_sdlist_page_create },
+    [VIEW_DISPLAY] = { "Display",    ui_display_create },
+    [VIEW_SYSINFO] = { "System OTA", ui_sys_info_create },
+    [VIEW_WIFI]    = { "Wi-Fi",      ui_network_create },
+    [VIEW_HEAP]    = { "Heap",       ui_mem_page_create },
+    [VIEW_CPU]     = { "CPU",        ui_cpu_page_create },
+};
+
 static lv_timer_t * switch_timer = NULL;
+static lv_obj_t * settings_screen = NULL;   // Screen the views are built on, while the app is open
 static void (*target_create_func)(lv_obj_t*) = NULL;
+static const hub_view_t * shown_view = NULL;   // Hub view on screen, NULL for the hub itself
+static int64_t view_build_us = 0;             // Build time of the last view, for the latency log
+
+static void spec_cancel(void);
+static void view_shown(const hub_view_t * view);
+
+// Runs right after a view is built, visible or not
+static void view_post_create(void (*func)(lv_obj_t*)) {
+    if (func == ui_display_create) {
+         if (lv_display_get_default() && lbl_disp_info) {
+            int32_t w = lv_display_get_horizontal_resolution(lv_display_get_default());
+            int32_t h = lv_display_get_vertical_resolution(lv_display_get_default());
+            lv_label_set_text_fmt(lbl_disp_info, "Driver Resolution: 450x600\nActual Pixel Resolution: %" LV_PRId32 "x%" LV_PRId32 "\nDriver: RM690B0\nInterface: QSPI", w, h);
+        }
+    }
+}
+
+static void switch_view(void (*func)(lv_obj_t*)) {
+    ESP_LOGI(TAG, "Switching view...");
+    ui_trace_t span = ui_trace_begin();
+    clear_current_view();
+    shown_view = NULL;
+    
+    lv_obj_t * scr = lv_screen_active();
+    if(!scr) {
+        scr = lv_obj_create(NULL);
+        lv_screen_load(scr);
+    }
+    
+    // Ensure dark background
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x101010), 0);
+    
+    // Create the new view
+    int64_t t0 = esp_timer_get_time();
+    func(scr);
+    view_post_create(func);
+    view_build_us = esp_timer_get_time() - t0;
+    for (int i = 0; i < VIEW_COUNT; i++) {
+        if (views[i].create == func) view_shown(&views[i]);
+    }
+    
+    ui_trace_end(TAG, UI_TRACE_LAYOUT, span);
+}
 
 static void switch_timer_cb(lv_timer_t * timer) {
     if (target_create_func) {
-        ESP_LOGI(TAG, "Switching view...");
-        clear_current_view();
-        
-        lv_obj_t * scr = lv_screen_active();
-        if(!scr) {
-            scr = lv_obj_create(NULL);
-            lv_screen_load(scr);
-        }
-        
-        // Ensure dark background
-        lv_obj_set_style_bg_color(scr, lv_color_hex(0x101010), 0);
-        
-        // Create the new view
-        target_create_func(scr);
-        
-        // Post-creation hooks
-        if (target_create_func == ui_media_create) {
-            populate_sd_files_list();
-        } else if (target_create_func == ui_display_create) {
-             if (lv_display_get_default() && lbl_disp_info) {
-                int32_t w = lv_display_get_horizontal_resolution(lv_display_get_default());
-                int32_t h = lv_display_get_vertical_resolution(lv_display_get_default());
-                lv_label_set_text_fmt(lbl_disp_info, "Driver Resolution: 450x600\nActual Pixel Resolution: %" LV_PRId32 "x%" LV_PRId32 "\nDriver: RM690B0\nInterface: QSPI", w, h);
-            }
-        }
-        
+        switch_view(target_create_func);
         target_create_func = NULL;
     }
     switch_timer = NULL;
 }
 
 static void request_switch(void (*func)(lv_obj_t*)) {
+    spec_cancel();
     if (switch_timer) lv_timer_del(switch_timer);
     target_create_func = func;
     switch_timer = lv_timer_create(switch_timer_cb, 10, NULL);
     lv_timer_set_repeat_count(switch_timer, 1);
 }
 
+// --- Speculative construction ---
+// A hub button starts building its view hidden on PRESSED, so CLICKED only has
+// to reveal it. If the press ends any other way (drag, swipe, press lost) the
+// hidden view is torn down again and the hub stays as it was.
+//
+// While a view is pending, home_cont is parked so clear_current_view() only
+// sees the pending view: cancelling is then just clear_current_view().
+
+static const hub_view_t * spec_view = NULL;
+static lv_obj_t * spec_hub = NULL;          // Hub container, parked out of home_cont
+static uint32_t spec_first_child = 0;       // First screen child belonging to the pending view
+static int64_t press_us = 0;
+
+static void spec_begin(const hub_view_t * view) {
+    spec_cancel();
+    if (switch_timer) return;               // A switch is already on its way, leave it alone
+
+    lv_obj_t * scr = lv_screen_active();
+    ui_trace_t span = ui_trace_begin();
+    int64_t t0 = esp_timer_get_time();
+
+    spec_view = view;
+    spec_hub = home_cont;
+    home_cont = NULL;
+    spec_first_child = lv_obj_get_child_count(scr);
+
+    view->create(scr);
+    view_post_create(view->create);
+    for (uint32_t i = spec_first_child; i < lv_obj_get_child_count(scr); i++) {
+        lv_obj_add_flag(lv_obj_get_child(scr, (int32_t)i), LV_OBJ_FLAG_HIDDEN);
+    }
+
+    view_build_us = esp_timer_get_time() - t0;
+    ui_trace_end(TAG, UI_TRACE_LAYOUT, span);
+}
+
+static void spec_cancel(void) {
+    if (!spec_view) return;
+    ESP_LOGI(TAG, "Press aborted, dropping pending %s view", spec_view->name);
+
+    lv_obj_t * scr = settings_screen;       // Not the active one once the app has exited
+    clear_current_view();
+    // Anything the BSP doesn't track goes by hand
+    while (lv_obj_get_child_count(scr) > spec_first_child) {
+        lv_obj_delete(lv_obj_get_child(scr, -1));
+    }
+    home_cont = spec_hub;
+    spec_hub = NULL;
+    spec_view = NULL;
+}
+
+static void spec_commit(void) {
+    const hub_view_t * view = spec_view;
+    lv_obj_t * scr = lv_screen_active();
+
+    for (uint32_t i = spec_first_child; i < lv_obj_get_child_count(scr); i++) {
+        lv_obj_remove_flag(lv_obj_get_child(scr, (int32_t)i), LV_OBJ_FLAG_HIDDEN);
+    }
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x101010), 0);
+
+    // The hub owns the button being clicked, delete it once the event is done
+    lv_obj_delete_async(spec_hub);
+    spec_hub = NULL;
+    spec_view = NULL;
+    view_shown(view);
+}
+
+// Pending async cancel, cleared when CLICKED gets there first
+static void spec_release_cb(void * user_data) {
+    spec_cancel();
+}
+
+// --- Tap-to-content latency ---
+// Measured from the press LVGL saw to the end of the first refresh showing the
+// view. The SD file list streams in from its worker, so it doesn't hold that up.
+
+typedef struct {
+    uint32_t taps;
+    uint32_t last_ms;
+    uint32_t max_ms;
+    uint64_t sum_ms;
+} view_latency_t;
+
+static view_latency_t latency[VIEW_COUNT];
+static const hub_view_t * latency_view = NULL;
+static int64_t latency_click_us = 0;
+static bool latency_speculative = false;
+static bool refr_hooked = false;
+
+static void log_latency(const hub_view_t * view, int64_t now) {
+    uint32_t tap_ms = (uint32_t)((now - press_us) / 1000);
+    view_latency_t * l = &latency[view - views];
+    l->taps++;
+    l->last_ms = tap_ms;
+    l->sum_ms += tap_ms;
+    if (tap_ms > l->max_ms) l->max_ms = tap_ms;
+
+    ESP_LOGI(TAG, "%s: tap-to-content %lu ms (release-to-content %lu ms, built %s in %lu ms), avg %lu max %lu over %lu",
+             view->name, (unsigned long)tap_ms, (unsigned long)((now - latency_click_us) / 1000),
+             latency_speculative ? "on press" : "after release", (unsigned long)(view_build_us / 1000),
+             (unsigned long)(l->sum_ms / l->taps), (unsigned long)l->max_ms, (unsigned long)l->taps);
+}
+
+static void view_refr_cb(lv_event_t * e) {
+    const hub_view_t * view = latency_view;
+    if (view) {
+        if (shown_view == view) {
+            latency_view = NULL;
+            log_latency(view, esp_timer_get_time());
+        } else if (!switch_timer) {
+            latency_view = NULL;               // Went elsewhere before it was shown
+        }
+    }
+}
+
+static void view_shown(const hub_view_t * view) {
+    if (!refr_hooked && lv_display_get_default()) {
+        lv_display_add_event_cb(lv_display_get_default(), view_refr_cb, LV_EVENT_REFR_READY, NULL);
+        refr_hooked = true;
+    }
+    shown_view = view;
+}
+
+static void latency_arm(const hub_view_t * view, bool speculative) {
+    latency_view = view;
+    latency_click_us = esp_timer_get_time();
+    latency_speculative = speculative;
+}
+
 // --- Button Event Handlers ---
-static void btn_pmic_cb(lv_event_t * e)     { request_switch(ui_pmic_create); }
-static void btn_settings_cb(lv_event_t * e) { request_switch(ui_settings_create); } // Note: this is "Set PM" in UI
-static void btn_media_cb(lv_event_t * e)    { request_switch(ui_media_create); }
-static void btn_display_cb(lv_event_t * e)  { request_switch(ui_display_create); }
-static void btn_sysinfo_cb(lv_event_t * e)  { request_switch(ui_sys_info_create); }
-static void btn_ota_cb(lv_event_t * e)      { request_switch(ui_network_create); }
-
-#include "ui_launcher.h"
+static void btn_view_cb(lv_event_t * e) {
+    const hub_view_t * view = lv_event_get_user_data(e);
+
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_PRESSED:
+        press_us = esp_timer_get_time();
+        spec_begin(view);
+        break;
+    case LV_EVENT_RELEASED:
+        // CLICKED, if it comes, follows in the same input read; drop the view after that
+        if (spec_view == view) lv_async_call(spec_release_cb, NULL);
+        break;
+    case LV_EVENT_PRESS_LOST:
+        spec_cancel();
+        break;
+    case LV_EVENT_CLICKED:
+        if (spec_view == view) {
+            lv_async_call_cancel(spec_release_cb, NULL);
+            latency_arm(view, true);
+            spec_commit();
+        } else {
+            // Nothing built on press (a switch was in flight), build it the usual way
+            latency_arm(view, false);
+            request_switch(view->create);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void btn_trace_cb(lv_event_t * e)    { ui_trace_overlay_toggle(); }
+
+// Hub button that opens one of the views; also listens to the press itself
+static void create_view_btn(lv_obj_t * parent, const char * icon, lv_color_t color, int view) {
+    void * user_data = (void *)&views[view];
+    lv_obj_t * btn = create_neon_btn(parent, icon, views[view].name, color, btn_view_cb, user_data);
+    lv_obj_add_event_cb(btn, btn_view_cb, LV_EVENT_PRESSED, user_data);
+    lv_obj_add_event_cb(btn, btn_view_cb, LV_EVENT_RELEASED, user_data);
+    lv_obj_add_event_cb(btn, btn_view_cb, LV_EVENT_PRESS_LOST, user_data);
+}
+
 static void evt_swipe_right(lv_event_t * e) {
     if (lv_indev_get_gesture_dir(lv_indev_get_act()) == LV_DIR_RIGHT) {
         ESP_LOGI(TAG, "Swipe Right: Back to Launcher");
-        ui_launcher_show();
+        ui_app_exit();
     }
 }
 
@@ -143,7 +352,7 @@ static void ui_board_create(lv_obj_t * parent) {
     // Title: "Board Settings"
     lv_obj_t * lbl_title = lv_label_create(home_cont);
     lv_label_set_text(lbl_title, "Board Settings");
-    lv_obj_set_style_text_font(lbl_title, &lv_font_montserrat_30, 0);
+    lv_obj_set_style_text_font(lbl_title, ui_assets_font(30), 0);
     lv_obj_set_style_text_color(lbl_title, lv_color_hex(0xFFD700), 0);
     lv_obj_set_style_pad_bottom(lbl_title, 20, 0);
 
@@ -159,9 +368,9 @@ static void ui_board_create(lv_obj_t * parent) {
     lv_obj_remove_flag(btn_row1, LV_OBJ_FLAG_CLICKABLE);
     lv_obj_remove_flag(btn_row1, LV_OBJ_FLAG_SCROLLABLE);
 
-    create_neon_btn(btn_row1, LV_SYMBOL_CHARGE, "PM Status", lv_color_hex(0xFF3300), btn_pmic_cb);
-    create_neon_btn(btn_row1, LV_SYMBOL_SETTINGS, "Set PM", lv_color_hex(0x007FFF), btn_settings_cb);
-    create_neon_btn(btn_row1, LV_SYMBOL_SD_CARD, "SD Card", lv_color_hex(0x00FFFF), btn_media_cb);
+    create_view_btn(btn_row1, LV_SYMBOL_CHARGE, lv_color_hex(0xFF3300), VIEW_PMIC);
+    create_view_btn(btn_row1, LV_SYMBOL_SETTINGS, lv_color_hex(0x007FFF), VIEW_SET_PM);
+    create_view_btn(btn_row1, LV_SYMBOL_SD_CARD, lv_color_hex(0x00FFFF), VIEW_MEDIA);
 
     // 3. Button Container (Row 2)
     lv_obj_t * btn_row2 = lv_obj_create(home_cont);
@@ -175,9 +384,25 @@ static void ui_board_create(lv_obj_t * parent) {
     lv_obj_remove_flag(btn_row2, LV_OBJ_FLAG_CLICKABLE);
     lv_obj_remove_flag(btn_row2, LV_OBJ_FLAG_SCROLLABLE);
 
-    create_neon_btn(btn_row2, LV_SYMBOL_EYE_OPEN, "Display", lv_color_hex(0x39FF14), btn_display_cb);
-    create_neon_btn(btn_row2, LV_SYMBOL_FILE, "System OTA", lv_color_hex(0x9D00FF), btn_sysinfo_cb);
-    create_neon_btn(btn_row2, LV_SYMBOL_WIFI, "Wi-Fi", lv_color_hex(0xFF00FF), btn_ota_cb);
+    create_view_btn(btn_row2, LV_SYMBOL_EYE_OPEN, lv_color_hex(0x39FF14), VIEW_DISPLAY);
+    create_view_btn(btn_row2, LV_SYMBOL_FILE, lv_color_hex(0x9D00FF), VIEW_SYSINFO);
+    create_view_btn(btn_row2, LV_SYMBOL_WIFI, lv_color_hex(0xFF00FF), VIEW_WIFI);
+
+    // 4. Button Container (Row 3) - diagnostics
+    lv_obj_t * btn_row3 = lv_obj_create(home_cont);
+    lv_obj_set_width(btn_row3, LV_PCT(100));
+    lv_obj_set_height(btn_row3, LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_opa(btn_row3, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(btn_row3, 0, 0);
+    lv_obj_set_flex_flow(btn_row3, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(btn_row3, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_gap(btn_row3, 8, 0);
+    lv_obj_remove_flag(btn_row3, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_remove_flag(btn_row3, LV_OBJ_FLAG_SCROLLABLE);
+
+    create_neon_btn(btn_row3, LV_SYMBOL_LIST, "Trace", lv_color_hex(0xFFD700), btn_trace_cb, NULL);
+    create_view_btn(btn_row3, LV_SYMBOL_SAVE, lv_color_hex(0xFF8C00), VIEW_HEAP);
+    create_view_btn(btn_row3, LV_SYMBOL_CHARGE, lv_color_hex(0x00FFFF), VIEW_CPU);
 }
 
 // This wrapper replaces show_home_view() from the BSP library
@@ -188,3 +413,41 @@ void __wrap_show_home_view(lv_event_t * e) {
     ESP_LOGI(TAG, "Intercepted show_home_view -> switching to Board Settings");
     request_switch(ui_board_create);
 }
+
+// --- App registry entry ---
+
+static void settings_create(void) {
+    // Give the view switcher its own screen to build on
+    ui_status_bar_set_visible(false);   // Apps draw their own top bar
+    settings_screen = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(settings_screen, lv_color_hex(0x000000), 0); // Default black
+    lv_screen_load(settings_screen);
+    // Build the hub now rather than on the switch timer, so the launch
+    // transition snapshots it; nothing on this fresh screen is in use yet
+    switch_view(ui_board_create);
+}
+
+static void settings_destroy(void) {
+    // Runs after the exit gesture is done, with the launcher already loaded
+    spec_cancel();
+    if (switch_timer) {
+        lv_timer_del(switch_timer);     // It would build on the launcher screen
+        switch_timer = NULL;
+    }
+    clear_current_view();
+    shown_view = NULL;
+    if (settings_screen) {
+        lv_obj_del(settings_screen);
+        settings_screen = NULL;
+    }
+}
+
+const ui_app_t ui_app_settings = {
+    .name = "Settings",
+    .icon = LV_SYMBOL_SETTINGS,
+    .color = 0xFF3300,
+    .mem_app = UI_MEM_APP_SETTINGS,
+    .mem_budget = 64 * 1024,        // Heap/CPU pages keep only small label buffers
+    .create = settings_create,
+    .destroy = settings_destroy,
+};
@@ -0,0 +1,235 @@
+#include "ui_boot.h"
+#include "ui_console.h"
+#include "lvgl_mgr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_app_desc.h"
+#include "nvs.h"
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+
+static const char *TAG = "ui_boot";
+
+#define BAR_COLS 40
+#define NVS_NAMESPACE "ui_boot"
+
+typedef enum {
+    STEP_PENDING = 0,
+    STEP_OK,
+    STEP_FAILED,
+    STEP_SKIPPED,
+} step_state_t;
+
+typedef struct {
+    const char *name;
+    ui_boot_lane_t lane;
+    int core;
+    step_state_t state;
+    esp_err_t err;
+    int64_t ready_us;           // Lane got to the step
+    int64_t start_us;           // Deps met and LVGL lock taken
+    int64_t end_us;
+} step_record_t;
+
+static step_record_t records[UI_BOOT_MAX_STEPS];
+static size_t record_count = 0;
+static int64_t run_start_us = 0;
+static int64_t run_end_us = 0;
+
+// Lives on after the run: the side lane may still be leaving xEventGroupSetBits()
+static StaticEventGroup_t done_storage;
+static EventGroupHandle_t done = NULL;      // Bit i: step i finished, whatever the outcome
+static uint32_t failed_mask = 0;            // Steps that failed or were skipped
+static portMUX_TYPE failed_lock = portMUX_INITIALIZER_UNLOCKED;
+static const ui_boot_step_t *run_steps = NULL;
+
+#define ALL_LANES (-1)
+
+static void run_lane(int lane) {
+    for (size_t i = 0; i < record_count; i++) {
+        const ui_boot_step_t *s = &run_steps[i];
+        if (lane != ALL_LANES && (int)s->lane != lane) continue;
+        step_record_t *r = &records[i];
+
+        r->ready_us = esp_timer_get_time();
+        if (s->deps) xEventGroupWaitBits(done, s->deps, pdFALSE, pdTRUE, portMAX_DELAY);
+        r->core = xPortGetCoreID();
+
+        taskENTER_CRITICAL(&failed_lock);
+        bool skip = (s->deps & failed_mask) != 0;
+        taskEXIT_CRITICAL(&failed_lock);
+
+        if (skip) {
+            r->state = STEP_SKIPPED;
+            r->start_us = r->end_us = esp_timer_get_time();
+        } else {
+            if (s->lvgl) lvgl_mgr_lock();
+            r->start_us = esp_timer_get_time();
+            r->err = s->fn();
+            r->end_us = esp_timer_get_time();
+            if (s->lvgl) lvgl_mgr_unlock();
+            r->state = r->err == ESP_OK ? STEP_OK : STEP_FAILED;
+        }
+
+        if (r->state != STEP_OK) {
+            taskENTER_CRITICAL(&failed_lock);
+            failed_mask |= UI_BOOT_DEP(i);
+            taskEXIT_CRITICAL(&failed_lock);
+        }
+        xEventGroupSetBits(done, UI_BOOT_DEP(i));
+    }
+}
+
+static void side_task_fn(void *arg) {
+    run_lane(UI_BOOT_LANE_SIDE);
+    vTaskDelete(NULL);
+}
+
+esp_err_t ui_boot_run(const ui_boot_step_t *steps, size_t count) {
+    if (count > UI_BOOT_MAX_STEPS) {
+        ESP_LOGE(TAG, "%u steps, at most %d supported", (unsigned)count, UI_BOOT_MAX_STEPS);
+        return ESP_ERR_INVALID_ARG;
+    }
+    // Lanes run in table order, so a dependency on a later step would deadlock
+    for (size_t i = 0; i < count; i++) {
+        if (steps[i].deps & ~(UI_BOOT_DEP(i) - 1)) {
+            ESP_LOGE(TAG, "Step %s depends on itself or a later step", steps[i].name);
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    if (!done) done = xEventGroupCreateStatic(&done_storage);
+    xEventGroupClearBits(done, UI_BOOT_DEP(UI_BOOT_MAX_STEPS) - 1);
+    failed_mask = 0;
+    run_steps = steps;
+    record_count = count;
+    bool side = false;
+    for (size_t i = 0; i < count; i++) {
+        records[i] = (step_record_t){ .name = steps[i].name, .lane = steps[i].lane, .core = -1 };
+        side |= steps[i].lane == UI_BOOT_LANE_SIDE;
+    }
+
+    run_start_us = esp_timer_get_time();
+    int lane = UI_BOOT_LANE_MAIN;
+    if (side) {
+#if portNUM_PROCESSORS > 1
+        BaseType_t core = !xPortGetCoreID();
+#else
+        BaseType_t core = tskNO_AFFINITY;
+#endif
+        if (xTaskCreatePinnedToCore(side_task_fn, "ui_boot", 4096, NULL, uxTaskPriorityGet(NULL), NULL, core) != pdPASS) {
+            ESP_LOGW(TAG, "No side lane task, running every step in table order");
+            for (size_t i = 0; i < count; i++) records[i].lane = UI_BOOT_LANE_MAIN;
+            lane = ALL_LANES;
+        }
+    }
+    run_lane(lane);
+    xEventGroupWaitBits(done, UI_BOOT_DEP(count) - 1, pdFALSE, pdTRUE, portMAX_DELAY);
+    run_end_us = esp_timer_get_time();
+
+    ui_boot_report(stdout);
+    ui_console_register('b', "boot timeline", ui_boot_report);
+
+    for (size_t i = 0; i < count; i++) {
+        if (records[i].state == STEP_FAILED) return records[i].err;
+    }
+    return ESP_OK;
+}
+
+void ui_boot_report(FILE *out) {
+    if (!record_count) {
+        fprintf(out, "No boot run recorded\n");
+        return;
+    }
+
+    int64_t wall = run_end_us - run_start_us;
+    int64_t serial = 0;
+    for (size_t i = 0; i < record_count; i++) serial += records[i].end_us - records[i].start_us;
+
+    fprintf(out, "Boot timeline, ms since reset: steps %lu-%lu ms, %lu ms wall for %lu ms of work\n",
+            (unsigned long)(run_start_us / 1000), (unsigned long)(run_end_us / 1000),
+            (unsigned long)(wall / 1000), (unsigned long)(serial / 1000));
+    fprintf(out, "%-12s %4s %4s %6s %6s %6s %6s  %s\n", "step", "lane", "core", "start", "end", "ms", "wait",
+            "'.' waiting on deps/lock, '#' running");
+
+    for (size_t i = 0; i < record_count; i++) {
+        const step_record_t *r = &records[i];
+        char bar[BAR_COLS + 1];
+        for (int c = 0; c < BAR_COLS; c++) {
+            int64_t t = run_start_us + (wall * c + wall / 2) / BAR_COLS;   // Column centre
+            bar[c] = (t >= r->start_us && t < r->end_us) ? '#' : (t >= r->ready_us && t < r->start_us) ? '.' : ' ';
+        }
+        bar[BAR_COLS] = '\0';
+
+        fprintf(out, "%-12s %4s %4d %6lu %6lu %6lu %6lu  |%s|", r->name,
+                r->lane == UI_BOOT_LANE_MAIN ? "main" : "side", r->core,
+                (unsigned long)(r->start_us / 1000), (unsigned long)(r->end_us / 1000),
+                (unsigned long)((r->end_us - r->start_us) / 1000),
+                (unsigned long)((r->start_us - r->ready_us) / 1000), bar);
+        if (r->state == STEP_FAILED) fprintf(out, " failed: %s", esp_err_to_name(r->err));
+        if (r->state == STEP_SKIPPED) fprintf(out, " skipped");
+        if (r->state == STEP_PENDING) fprintf(out, " not run");
+        fprintf(out, "\n");
+    }
+}
+
+// --- Boot cost across firmware images ---
+
+typedef struct {
+    char build[17];             // First 16 hex digits of the ELF SHA-256
+    uint32_t boot_ms;           // Launcher ready, ms since reset
+    uint32_t internal_kb;       // Free internal heap at that point
+    uint32_t psram_kb;          // Free PSRAM at that point
+} boot_cost_t;
+
+static bool load_cost(nvs_handle_t h, const char *key, boot_cost_t *out) {
+    size_t len = sizeof(*out);
+    return nvs_get_blob(h, key, out, &len) == ESP_OK && len == sizeof(*out);
+}
+
+void ui_boot_log_cost(void) {
+    boot_cost_t now = {
+        .boot_ms = (uint32_t)(esp_timer_get_time() / 1000),
+        .internal_kb = (uint32_t)(heap_caps_get_free_size(MALLOC_CAP_INTERNAL) / 1024),
+        .psram_kb = (uint32_t)(heap_caps_get_free_size(MALLOC_CAP_SPIRAM) / 1024),
+    };
+    esp_app_get_elf_sha256(now.build, sizeof(now.build));
+    ESP_LOGI(TAG, "Launcher UI initialized %lu ms after boot, idle heap: internal %lu KB, PSRAM %lu KB",
+             (unsigned long)now.boot_ms, (unsigned long)now.internal_kb, (unsigned long)now.psram_kb);
+
+    nvs_handle_t h;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &h);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Boot cost not recorded: %s", esp_err_to_name(err));
+        return;
+    }
+
+    // "cur" is the first boot of the image that booted last, "prev" that of
+    // the image before it. Written once per image, not on every boot.
+    boot_cost_t cur, prev;
+    bool have_cur = load_cost(h, "cur", &cur);
+    bool have_prev = load_cost(h, "prev", &prev);
+    if (!have_cur || strcmp(cur.build, now.build) != 0) {
+        if (have_cur) {
+            prev = cur;
+            have_prev = true;
+            err = nvs_set_blob(h, "prev", &prev, sizeof(prev));
+        }
+        if (err == ESP_OK) err = nvs_set_blob(h, "cur", &now, sizeof(now));
+        if (err == ESP_OK) err = nvs_commit(h);
+        if (err != ESP_OK) ESP_LOGW(TAG, "Saving the boot cost failed: %s", esp_err_to_name(err));
+    }
+    nvs_close(h);
+
+    if (!have_prev) {
+        ESP_LOGI(TAG, "No earlier firmware recorded; build %s is the baseline", now.build);
+        return;
+    }
+    ESP_LOGI(TAG, "vs build %s: boot %+ld ms (%lu), internal %+ld KB (%lu), PSRAM %+ld KB (%lu)", prev.build,
+             (long)now.boot_ms - (long)prev.boot_ms, (unsigned long)prev.boot_ms,
+             (long)now.internal_kb - (long)prev.internal_kb, (unsigned long)prev.internal_kb,
+             (long)now.psram_kb - (long)prev.psram_kb, (unsigned long)prev.psram_kb);
+}
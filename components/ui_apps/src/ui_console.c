@@ -0,0 +1,88 @@
+#include "ui_console.h"
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdbool.h>
+
+#if CONFIG_UI_CONSOLE_CMDS
+
+static const char *TAG = "ui_console";
+
+#define CONSOLE_MAX_CMDS 16
+
+typedef struct {
+    char key;
+    const char *help;
+    ui_console_cmd_t cmd;
+} console_entry_t;
+
+// Boot steps on both cores register commands, so the table is under a spinlock.
+// Entries never change once added: the task reads them after taking the count.
+static console_entry_t cmds[CONSOLE_MAX_CMDS];
+static int cmd_count = 0;
+static bool task_started = false;
+static portMUX_TYPE cmds_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static int count(void) {
+    taskENTER_CRITICAL(&cmds_lock);
+    int n = cmd_count;
+    taskEXIT_CRITICAL(&cmds_lock);
+    return n;
+}
+
+static void print_help(FILE *out) {
+    int n = count();
+    for (int i = 0; i < n; i++) {
+        fprintf(out, "  %c  %s\n", cmds[i].key, cmds[i].help);
+    }
+}
+
+// Console is read without a driver, so fgetc() returns EOF when idle - poll slowly
+static void console_task_fn(void *arg) {
+    (void)arg;
+    for (;;) {
+        int c = fgetc(stdin);
+        if (c == EOF) {
+            vTaskDelay(pdMS_TO_TICKS(250));
+            continue;
+        }
+        if (c == '?') {
+            print_help(stdout);
+            continue;
+        }
+        int n = count();
+        for (int i = 0; i < n; i++) {
+            if (cmds[i].key == c) {
+                cmds[i].cmd(stdout);
+                break;
+            }
+        }
+    }
+}
+
+void ui_console_register(char key, const char *help, ui_console_cmd_t cmd) {
+    taskENTER_CRITICAL(&cmds_lock);
+    bool full = cmd_count >= CONSOLE_MAX_CMDS;
+    if (!full) cmds[cmd_count++] = (console_entry_t){ .key = key, .help = help, .cmd = cmd };
+    bool start = !full && !task_started;
+    if (start) task_started = true;
+    taskEXIT_CRITICAL(&cmds_lock);
+
+    if (full) {
+        ESP_LOGW(TAG, "Command table full, '%c' not registered", key);
+        return;
+    }
+    if (start) {
+        xTaskCreate(console_task_fn, "ui_console", 4096, NULL, 1, NULL);
+        ESP_LOGI(TAG, "Serial commands enabled, '?' for help");
+    }
+}
+
+#else
+
+void ui_console_register(char key, const char *help, ui_console_cmd_t cmd) {
+    (void)key; (void)help; (void)cmd;
+}
+
+#endif
@@ -0,0 +1,252 @@
+#include "ui_cpu.h"
+#include "ui_assets.h"
+#include "ui_console.h"
+#include "ui_private.h"
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_freertos_hooks.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <string.h>
+
+static const char *TAG = "ui_cpu";
+
+#define PAGE_PERIOD_MS      1000
+#define PAGE_TASK_ROWS      12
+#define CONSOLE_WINDOW_MS   1000
+
+LV_IMG_DECLARE(swipeR34);
+
+#if CONFIG_FREERTOS_USE_TRACE_FACILITY && CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+
+static volatile uint32_t idle_wakeups[UI_CPU_MAX_CORES];
+
+// Runs once per idle-loop pass: after every switch back to idle and every tick
+static bool idle_hook_core0(void) { idle_wakeups[0]++; return true; }
+#if portNUM_PROCESSORS > 1
+static bool idle_hook_core1(void) { idle_wakeups[1]++; return true; }
+#endif
+
+static void console_cmd(FILE *out);
+
+void ui_cpu_init(void) {
+    static bool initialized = false;
+    if (initialized) return;
+    initialized = true;
+
+    esp_register_freertos_idle_hook_for_cpu(idle_hook_core0, 0);
+#if portNUM_PROCESSORS > 1
+    esp_register_freertos_idle_hook_for_cpu(idle_hook_core1, 1);
+#endif
+    ui_console_register('p', "CPU load and tasks over 1 s", console_cmd);
+}
+
+static int find_prev(const ui_cpu_window_t *win, TaskHandle_t h) {
+    for (uint32_t i = 0; i < win->count; i++) {
+        if (win->handle[i] == h) return (int)i;
+    }
+    return -1;
+}
+
+bool ui_cpu_sample(ui_cpu_window_t *win, ui_cpu_snapshot_t *out) {
+    static TaskStatus_t status[UI_CPU_MAX_TASKS];   // Callers run on the LVGL or console task
+    uint32_t total_time = 0;
+
+    UBaseType_t n = uxTaskGetSystemState(status, UI_CPU_MAX_TASKS, &total_time);
+    if (n == 0) {
+        ESP_LOGW(TAG, "More than %d tasks, raise UI_CPU_MAX_TASKS", UI_CPU_MAX_TASKS);
+        return false;
+    }
+
+    bool ready = win->valid;
+    uint32_t elapsed = total_time - win->total_time;    // Run-time clock ticks (us)
+    if (ready && elapsed == 0) return false;
+
+    if (ready) {
+        memset(out, 0, sizeof(*out));
+        out->window_ms = elapsed / 1000;
+
+        for (int c = 0; c < portNUM_PROCESSORS && c < UI_CPU_MAX_CORES; c++) {
+            TaskHandle_t idle = xTaskGetIdleTaskHandleForCore(c);
+            uint32_t idle_delta = 0;
+            for (UBaseType_t i = 0; i < n; i++) {
+                if (status[i].xHandle != idle) continue;
+                int p = find_prev(win, idle);
+                idle_delta = status[i].ulRunTimeCounter - (p >= 0 ? win->runtime[p] : 0);
+            }
+            if (idle_delta > elapsed) idle_delta = elapsed;
+            out->core_load_pct[c] = (uint8_t)(100 - (uint64_t)idle_delta * 100 / elapsed);
+            out->idle_wakeups_per_sec[c] =
+                (uint32_t)((uint64_t)(idle_wakeups[c] - win->idle_wakeups[c]) * 1000000 / elapsed);
+        }
+
+        uint64_t capacity = (uint64_t)elapsed * portNUM_PROCESSORS;
+        for (UBaseType_t i = 0; i < n; i++) {
+            int p = find_prev(win, status[i].xHandle);
+            uint32_t delta = status[i].ulRunTimeCounter - (p >= 0 ? win->runtime[p] : 0);
+
+            // Insertion sort, busiest first
+            ui_cpu_task_t t = {
+                .core = status[i].xCoreID == tskNO_AFFINITY ? -1 : (int8_t)status[i].xCoreID,
+                .priority = (uint8_t)status[i].uxCurrentPriority,
+                .share_permille = (uint16_t)((uint64_t)delta * 1000 / capacity),
+                .stack_free = status[i].usStackHighWaterMark,   // StackType_t is a byte on ESP-IDF
+            };
+            snprintf(t.name, sizeof(t.name), "%s", status[i].pcTaskName);
+            uint32_t pos = out->task_count;
+            while (pos > 0 && out->tasks[pos - 1].share_permille < t.share_permille) {
+                out->tasks[pos] = out->tasks[pos - 1];
+                pos--;
+            }
+            out->tasks[pos] = t;
+            out->task_count++;
+        }
+    }
+
+    // New baseline
+    win->valid = true;
+    win->total_time = total_time;
+    for (int c = 0; c < UI_CPU_MAX_CORES; c++) win->idle_wakeups[c] = idle_wakeups[c];
+    win->count = n;
+    for (UBaseType_t i = 0; i < n; i++) {
+        win->handle[i] = status[i].xHandle;
+        win->runtime[i] = status[i].ulRunTimeCounter;
+    }
+    return ready;
+}
+
+static void console_cmd(FILE *out) {
+    static ui_cpu_window_t win;
+    static ui_cpu_snapshot_t snap;
+    win.valid = false;
+    ui_cpu_sample(&win, &snap);
+    vTaskDelay(pdMS_TO_TICKS(CONSOLE_WINDOW_MS));
+    if (ui_cpu_sample(&win, &snap)) {
+        ui_cpu_print(&snap, out);
+    }
+}
+
+#else  // Run-time stats disabled in sdkconfig
+
+void ui_cpu_init(void) {
+    ESP_LOGW(TAG, "Enable FREERTOS_USE_TRACE_FACILITY and FREERTOS_GENERATE_RUN_TIME_STATS for CPU stats");
+}
+
+bool ui_cpu_sample(ui_cpu_window_t *win, ui_cpu_snapshot_t *out) {
+    (void)win; (void)out;
+    return false;
+}
+
+#endif
+
+void ui_cpu_print(const ui_cpu_snapshot_t *snap, FILE *out) {
+    fprintf(out, "CPU over %lu ms:", (unsigned long)snap->window_ms);
+    for (int c = 0; c < UI_CPU_MAX_CORES; c++) {
+        fprintf(out, "  core%d %u%% (%lu idle wakeups/s)", c, snap->core_load_pct[c],
+                (unsigned long)snap->idle_wakeups_per_sec[c]);
+    }
+    fprintf(out, "\n%-16s %4s %4s %7s %10s\n", "task", "core", "prio", "cpu%", "stack free");
+    for (uint32_t i = 0; i < snap->task_count; i++) {
+        const ui_cpu_task_t *t = &snap->tasks[i];
+        char core[4];
+        if (t->core < 0) strcpy(core, "any"); else snprintf(core, sizeof(core), "%d", t->core);
+        fprintf(out, "%-16s %4s %4u %5u.%u %10lu\n", t->name, core, t->priority,
+                t->share_permille / 10, t->share_permille % 10, (unsigned long)t->stack_free);
+    }
+}
+
+// --- Hub page ---
+
+static lv_timer_t *page_timer = NULL;
+static lv_obj_t *core_bar[UI_CPU_MAX_CORES];
+static lv_obj_t *core_label[UI_CPU_MAX_CORES];
+static lv_obj_t *lbl_tasks = NULL;
+
+static void page_refresh(lv_timer_t *t) {
+    (void)t;
+    static ui_cpu_window_t win;
+    static ui_cpu_snapshot_t snap;
+    static char buf[PAGE_TASK_ROWS * 48 + 64];
+
+    if (!lbl_tasks) return;
+    if (!t) win.valid = false;      // First call from page creation: fresh baseline
+    if (!ui_cpu_sample(&win, &snap)) {
+        lv_label_set_text(lbl_tasks, "Sampling...");
+        return;
+    }
+
+    for (int c = 0; c < UI_CPU_MAX_CORES; c++) {
+        lv_bar_set_value(core_bar[c], snap.core_load_pct[c], LV_ANIM_OFF);
+        lv_label_set_text_fmt(core_label[c], "Core %d  %u%%  %lu wake/s", c, snap.core_load_pct[c],
+                              (unsigned long)snap.idle_wakeups_per_sec[c]);
+    }
+
+    size_t len = snprintf(buf, sizeof(buf), "%-14s %4s %4s %6s %7s", "Task", "Core", "Prio", "CPU%", "Stack");
+    for (uint32_t i = 0; i < snap.task_count && i < PAGE_TASK_ROWS && len < sizeof(buf); i++) {
+        const ui_cpu_task_t *tk = &snap.tasks[i];
+        len += snprintf(buf + len, sizeof(buf) - len, "\n%-14.14s %4s %4u %4u.%u %7lu",
+                        tk->name, tk->core < 0 ? "any" : (tk->core ? "1" : "0"), tk->priority,
+                        tk->share_permille / 10, tk->share_permille % 10, (unsigned long)tk->stack_free);
+    }
+    lv_label_set_text(lbl_tasks, buf);
+}
+
+static void page_delete_cb(lv_event_t *e) {
+    (void)e;
+    if (page_timer) {
+        lv_timer_del(page_timer);
+        page_timer = NULL;
+    }
+    lbl_tasks = NULL;
+}
+
+static void page_swipe_cb(lv_event_t *e) {
+    if (lv_indev_get_gesture_dir(lv_indev_get_act()) == LV_DIR_RIGHT) {
+        show_home_view(e);     // Back to the Board Settings hub
+    }
+}
+
+void ui_cpu_page_create(lv_obj_t *parent) {
+    // home_cont is the container clear_current_view() deletes on the next switch
+    home_cont = lv_obj_create(parent);
+    lv_obj_set_size(home_cont, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_style_bg_opa(home_cont, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(home_cont, 0, 0);
+    lv_obj_set_style_pad_all(home_cont, 20, 0);
+    lv_obj_set_style_pad_gap(home_cont, 10, 0);
+    lv_obj_set_flex_flow(home_cont, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(home_cont, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_add_event_cb(home_cont, page_swipe_cb, LV_EVENT_GESTURE, NULL);
+    lv_obj_add_event_cb(home_cont, page_delete_cb, LV_EVENT_DELETE, NULL);
+    lv_obj_clear_flag(home_cont, LV_OBJ_FLAG_GESTURE_BUBBLE);
+
+    lv_obj_t *img_swipe = lv_image_create(home_cont);
+    lv_image_set_src(img_swipe, &swipeR34);
+    lv_obj_add_flag(img_swipe, LV_OBJ_FLAG_FLOATING);
+    lv_obj_align(img_swipe, LV_ALIGN_TOP_LEFT, 5, 5);
+
+    lv_obj_t *title = lv_label_create(home_cont);
+    lv_label_set_text(title, "CPU");
+    lv_obj_set_style_text_font(title, ui_assets_font(30), 0);
+    lv_obj_set_style_text_color(title, lv_color_hex(0xFFD700), 0);
+
+    for (int c = 0; c < UI_CPU_MAX_CORES; c++) {
+        core_label[c] = lv_label_create(home_cont);
+        lv_obj_set_style_text_font(core_label[c], ui_assets_font(16), 0);
+        lv_obj_set_style_text_color(core_label[c], lv_color_white(), 0);
+        lv_label_set_text_fmt(core_label[c], "Core %d", c);
+
+        core_bar[c] = lv_bar_create(home_cont);
+        lv_obj_set_size(core_bar[c], LV_PCT(100), 16);
+        lv_bar_set_range(core_bar[c], 0, 100);
+        lv_obj_set_style_bg_color(core_bar[c], c ? lv_color_hex(0x00FFFF) : lv_color_hex(0xFF3300),
+                                  LV_PART_INDICATOR);
+    }
+
+    lbl_tasks = lv_label_create(home_cont);
+    lv_obj_set_style_text_font(lbl_tasks, ui_assets_font(14), 0);
+    lv_obj_set_style_text_color(lbl_tasks, lv_color_hex(0x39FF14), 0);
+
+    page_timer = lv_timer_create(page_refresh, PAGE_PERIOD_MS, NULL);
+    page_refresh(NULL);
+}
@@ -0,0 +1,358 @@
+#include "ui_decode.h"
+#include "ui_decode_core.h"
+#include "ui_fill.h"
+#include "ui_imgcache.h"
+#include "lvgl_mgr.h"
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+#if CONFIG_LV_USE_LODEPNG
+#include "libs/lodepng/lodepng.h"   // LVGL's copy; allocates with lv_malloc()
+#endif
+
+static const char *TAG = "ui_decode";
+
+#define MAX_JOBS        24
+#define WORKER_STACK    6144
+#define WORKER_PRIO     2           // Below the LVGL task
+#define PROGRESS_STEPS  8           // Progress callbacks per pass when previewing
+#define CACHE_BAND      32          // Rows per read when loading from the image cache
+
+typedef struct {
+    uint32_t id;                    // 0 = free slot; slots change hands under the LVGL lock
+    bool cancelled;
+    uint32_t flags;
+    char path[UI_DECODE_PATH_MAX];
+    lv_draw_buf_t *dst;
+    ui_decode_cb_t cb;
+    void *user;
+
+    // Worker side
+    ui_decode_info_t info;
+    uint16_t band;                  // Rows between progress callbacks
+    int64_t start_us;
+    uint32_t coarse_ms;             // Coarse pass complete, 0 if there was none
+    uint8_t scale_num;
+} job_t;
+
+static job_t jobs[MAX_JOBS];
+static uint32_t next_id = 1;
+static QueueHandle_t queue = NULL;          // job_t *, in submit order
+static SemaphoreHandle_t busy = NULL;       // Held by the worker while it writes a destination buffer
+
+static uint32_t elapsed_ms(const job_t *job) {
+    return (uint32_t)((esp_timer_get_time() - job->start_us) / 1000);
+}
+
+// Takes the LVGL lock: never call with `busy` held
+static void notify(job_t *job, ui_decode_status_t status) {
+    lvgl_mgr_lock();
+    if (!job->cancelled) {
+        job->info.status = status;
+        job->info.elapsed_ms = elapsed_ms(job);
+        job->cb(job->id, &job->info, job->user);
+    }
+    lvgl_mgr_unlock();
+}
+
+// --- Sink: rows into the caller's buffer ---
+
+// Letterbox: black for RGB565, transparent for ARGB8565
+static void clear_dst(lv_draw_buf_t *dst) {
+    if (dst->header.cf == LV_COLOR_FORMAT_RGB565) {
+        ui_fill_rect((uint16_t *)dst->data, dst->header.stride, dst->header.w, dst->header.h, 0x0000);
+        return;
+    }
+    for (uint32_t y = 0; y < dst->header.h; y++) memset(dst->data + y * dst->header.stride, 0, dst->header.w * 3);
+}
+
+static bool sink_begin(void *ctx, const decode_geom_t *g) {
+    job_t *job = ctx;
+    lv_draw_buf_t *dst = job->dst;
+    int32_t x = (int32_t)(dst->header.w - g->out_w) / 2;
+    int32_t y = (int32_t)(dst->header.h - g->out_h) / 2;
+    job->info.src_w = g->src_w;
+    job->info.src_h = g->src_h;
+    job->info.area = (lv_area_t){ x, y, x + g->out_w - 1, y + g->out_h - 1 };
+    job->band = g->out_h / PROGRESS_STEPS ? g->out_h / PROGRESS_STEPS : 1;
+    job->scale_num = g->scale_num;
+
+    xSemaphoreTake(busy, portMAX_DELAY);
+    bool ok = !job->cancelled;
+    if (ok) clear_dst(dst);
+    xSemaphoreGive(busy);
+    return ok;
+}
+
+static bool sink_row(void *ctx, const decode_geom_t *g, uint16_t y, const uint16_t *px, const uint8_t *alpha,
+                     bool final) {
+    job_t *job = ctx;
+    lv_draw_buf_t *dst = job->dst;
+
+    xSemaphoreTake(busy, portMAX_DELAY);
+    bool ok = !job->cancelled;
+    if (ok && dst->header.cf == LV_COLOR_FORMAT_RGB565) {
+        uint8_t *row = dst->data + (job->info.area.y1 + y) * dst->header.stride + job->info.area.x1 * 2;
+        memcpy(row, px, g->out_w * sizeof(uint16_t));
+    } else if (ok) {
+        // ARGB8565: RGB565 little-endian, then alpha
+        uint8_t *row = dst->data + (job->info.area.y1 + y) * dst->header.stride + job->info.area.x1 * 3;
+        for (uint16_t x = 0; x < g->out_w; x++, row += 3) {
+            row[0] = (uint8_t)px[x];
+            row[1] = (uint8_t)(px[x] >> 8);
+            row[2] = alpha ? alpha[x] : 0xFF;
+        }
+    }
+    xSemaphoreGive(busy);
+    if (!ok) return false;
+
+    uint16_t rows = y + 1;
+    job->info.rows = rows;
+    job->info.coarse = !final;
+    if (!final && rows == g->out_h) job->coarse_ms = elapsed_ms(job);
+    // The last row of the final pass is reported as DONE
+    if ((job->flags & UI_DECODE_PREVIEW) && (rows % job->band == 0 || rows == g->out_h) && !(final && rows == g->out_h)) {
+        notify(job, UI_DECODE_PROGRESS);
+    }
+    return true;
+}
+
+// --- Formats ---
+
+static bool has_ext(const char *path, const char *ext) {
+    const char *dot = strrchr(path, '.');
+    return dot && strcasecmp(dot + 1, ext) == 0;
+}
+
+static decode_err_t decode_png(job_t *job, const decode_sink_t *sink) {
+#if CONFIG_LV_USE_LODEPNG
+    FILE *f = fopen(job->path, "rb");
+    if (!f) return DECODE_ERR_FORMAT;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *file = size > 0 ? heap_caps_malloc(size, MALLOC_CAP_SPIRAM) : NULL;
+    bool read = file && fread(file, 1, size, f) == (size_t)size;
+    fclose(f);
+    if (!read) {
+        heap_caps_free(file);
+        return file ? DECODE_ERR_FORMAT : DECODE_ERR_NOMEM;
+    }
+
+    // PNG signature, then the IHDR chunk: width and height, big-endian
+    uint32_t w = 0, h = 0;
+    if (size >= 24 && memcmp(file + 12, "IHDR", 4) == 0) {
+        w = (uint32_t)file[16] << 24 | file[17] << 16 | file[18] << 8 | file[19];
+        h = (uint32_t)file[20] << 24 | file[21] << 16 | file[22] << 8 | file[23];
+    }
+    if (!w || !h || w > UINT16_MAX || h > UINT16_MAX || (uint64_t)w * h > UI_DECODE_PNG_MAX_PIXELS) {
+        ESP_LOGW(TAG, "%s: %lux%lu PNG not decoded (limit %u pixels)", job->path,
+                 (unsigned long)w, (unsigned long)h, UI_DECODE_PNG_MAX_PIXELS);
+        heap_caps_free(file);
+        return DECODE_ERR_FORMAT;
+    }
+
+    unsigned char *rgba = NULL;
+    unsigned pw, ph;
+    unsigned e = lodepng_decode32(&rgba, &pw, &ph, file, (size_t)size);
+    heap_caps_free(file);
+    if (e) {
+        ESP_LOGW(TAG, "%s: lodepng error %u", job->path, e);
+        if (rgba) lv_free(rgba);
+        return DECODE_ERR_FORMAT;
+    }
+    decode_err_t err = decode_rgba(rgba, (uint16_t)pw, (uint16_t)ph, job->dst->header.w, job->dst->header.h, sink);
+    lv_free(rgba);
+    return err;
+#else
+    return DECODE_ERR_FORMAT;
+#endif
+}
+
+static decode_err_t decode_job(job_t *job) {
+    decode_sink_t sink = {
+        .begin = sink_begin,
+        .row = sink_row,
+        .ctx = job,
+        .coarse_pass = (job->flags & UI_DECODE_PREVIEW) != 0,
+        .alpha = job->dst->header.cf == LV_COLOR_FORMAT_ARGB8565,
+    };
+    if (has_ext(job->path, "jpg") || has_ext(job->path, "jpeg")) {
+        FILE *f = fopen(job->path, "rb");
+        if (!f) return DECODE_ERR_FORMAT;
+        decode_err_t err = decode_jpeg_file(f, job->dst->header.w, job->dst->header.h, &sink);
+        fclose(f);
+        return err;
+    }
+    if (has_ext(job->path, "png")) return decode_png(job, &sink);
+    return DECODE_ERR_FORMAT;
+}
+
+// --- Image cache ---
+
+// Straight read of a cached copy into the destination, a band of rows at a
+// time. DECODE_ERR_FORMAT means a miss (or a bad read): decode instead.
+static decode_err_t load_cached(job_t *job) {
+    ui_imgcache_meta_t meta;
+    lv_draw_buf_t *dst = job->dst;
+    FILE *f = ui_imgcache_open(job->path, dst, &meta);
+    if (!f) return DECODE_ERR_FORMAT;
+
+    uint32_t row = dst->header.w * lv_color_format_get_size(dst->header.cf);
+    bool ok = true, cancelled = false;
+    for (uint32_t y = 0; ok && y < dst->header.h; y += CACHE_BAND) {
+        uint32_t n = dst->header.h - y < CACHE_BAND ? dst->header.h - y : CACHE_BAND;
+        xSemaphoreTake(busy, portMAX_DELAY);
+        cancelled = job->cancelled;
+        ok = !cancelled;
+        if (ok && dst->header.stride == row) {
+            ok = fread(dst->data + y * row, row, n, f) == n;
+        } else {
+            for (uint32_t i = 0; ok && i < n; i++) ok = fread(dst->data + (y + i) * dst->header.stride, row, 1, f) == 1;
+        }
+        xSemaphoreGive(busy);
+    }
+    ui_imgcache_close(f, job->path, dst, &meta, elapsed_ms(job), ok || cancelled);
+    if (cancelled) return DECODE_ERR_ABORTED;
+    if (!ok) return DECODE_ERR_FORMAT;
+
+    job->info.src_w = meta.src_w;
+    job->info.src_h = meta.src_h;
+    job->info.area = meta.area;
+    job->info.rows = (uint16_t)lv_area_get_height(&meta.area);
+    job->info.cached = true;
+    return DECODE_OK;
+}
+
+// Copy of the result, taken before DONE so the caller can reuse its buffer
+// while the copy is written to the card
+static uint8_t *snapshot(job_t *job) {
+    uint8_t *copy = heap_caps_malloc(job->dst->data_size, MALLOC_CAP_SPIRAM);
+    if (!copy) return NULL;
+    xSemaphoreTake(busy, portMAX_DELAY);
+    bool ok = !job->cancelled;
+    if (ok) memcpy(copy, job->dst->data, job->dst->data_size);
+    xSemaphoreGive(busy);
+    if (!ok) {
+        heap_caps_free(copy);
+        return NULL;
+    }
+    return copy;
+}
+
+static void store_snapshot(job_t *job, uint8_t *copy, uint32_t decode_ms) {
+    lv_draw_buf_t img = *job->dst;
+    img.data = copy;
+    ui_imgcache_meta_t meta = { job->info.src_w, job->info.src_h, job->info.area, decode_ms };
+    ui_imgcache_store(job->path, &img, &meta);
+    heap_caps_free(copy);
+}
+
+// --- Worker ---
+
+static void worker_fn(void *arg) {
+    for (;;) {
+        job_t *job;
+        xQueueReceive(queue, &job, portMAX_DELAY);
+
+        job->start_us = esp_timer_get_time();
+        job->coarse_ms = 0;
+        bool cache = (job->flags & UI_DECODE_CACHED) != 0;
+        decode_err_t err = DECODE_ERR_FORMAT;
+        if (job->cancelled) err = DECODE_ERR_ABORTED;
+        else if (cache) err = load_cached(job);
+
+        if (err == DECODE_OK) {
+            ESP_LOGD(TAG, "%s: from cache in %lu ms", job->path, (unsigned long)elapsed_ms(job));
+            notify(job, UI_DECODE_DONE);
+        } else if (err != DECODE_ERR_ABORTED) {
+            err = decode_job(job);
+            uint32_t ms = elapsed_ms(job);
+            if (err == DECODE_OK) {
+                uint8_t *copy = cache ? snapshot(job) : NULL;
+                const lv_area_t *a = &job->info.area;
+                if (job->coarse_ms) {
+                    ESP_LOGI(TAG, "%s: %ux%u -> %ldx%ld at %u/8 in %lu ms, coarse pass at %lu ms", job->path,
+                             job->info.src_w, job->info.src_h, (long)lv_area_get_width(a), (long)lv_area_get_height(a),
+                             job->scale_num, (unsigned long)ms, (unsigned long)job->coarse_ms);
+                } else {
+                    ESP_LOGI(TAG, "%s: %ux%u -> %ldx%ld at %u/8 in %lu ms", job->path,
+                             job->info.src_w, job->info.src_h, (long)lv_area_get_width(a), (long)lv_area_get_height(a),
+                             job->scale_num, (unsigned long)ms);
+                }
+                notify(job, UI_DECODE_DONE);
+                if (copy) store_snapshot(job, copy, ms);
+            } else if (err != DECODE_ERR_ABORTED) {
+                ESP_LOGW(TAG, "%s: decode failed (%s)", job->path, err == DECODE_ERR_NOMEM ? "out of memory" : "format");
+                notify(job, UI_DECODE_FAILED);
+            }
+        }
+
+        lvgl_mgr_lock();
+        job->id = 0;
+        lvgl_mgr_unlock();
+    }
+}
+
+static bool start_worker(void) {
+    if (queue) return true;
+    queue = xQueueCreate(MAX_JOBS, sizeof(job_t *));
+    busy = xSemaphoreCreateMutex();
+    if (!queue || !busy ||
+        xTaskCreatePinnedToCore(worker_fn, "ui_decode", WORKER_STACK, NULL, WORKER_PRIO, NULL, tskNO_AFFINITY) != pdPASS) {
+        ESP_LOGE(TAG, "Decode worker not started");
+        if (queue) vQueueDelete(queue);
+        if (busy) vSemaphoreDelete(busy);
+        queue = NULL;
+        busy = NULL;
+        return false;
+    }
+    return true;
+}
+
+// --- API ---
+
+uint32_t ui_decode_submit(const char *path, lv_draw_buf_t *dst, uint32_t flags, ui_decode_cb_t cb, void *user) {
+    bool cf_ok = dst->header.cf == LV_COLOR_FORMAT_RGB565 || dst->header.cf == LV_COLOR_FORMAT_ARGB8565;
+    if (strlen(path) >= UI_DECODE_PATH_MAX || !cf_ok || !start_worker()) return 0;
+
+    job_t *job = NULL;
+    for (int i = 0; i < MAX_JOBS; i++) {
+        if (!jobs[i].id) {
+            job = &jobs[i];
+            break;
+        }
+    }
+    if (!job) return 0;
+
+    *job = (job_t){ .id = next_id++, .flags = flags, .dst = dst, .cb = cb, .user = user };
+    if (!next_id) next_id = 1;
+    strcpy(job->path, path);
+    if (xQueueSend(queue, &job, 0) != pdTRUE) {
+        job->id = 0;
+        return 0;
+    }
+    return job->id;
+}
+
+void ui_decode_cancel(uint32_t id) {
+    if (!id) return;
+    for (int i = 0; i < MAX_JOBS; i++) {
+        if (jobs[i].id == id) {
+            jobs[i].cancelled = true;
+            // Wait out a row copy in progress; later rows see the flag
+            xSemaphoreTake(busy, portMAX_DELAY);
+            xSemaphoreGive(busy);
+            return;
+        }
+    }
+}
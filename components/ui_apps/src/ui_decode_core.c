@@ -0,0 +1,229 @@
+#include "ui_decode_core.h"
+#include <jpeglib.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RGB565(r, g, b) (uint16_t)((((r) & 0xF8) << 8) | (((g) & 0xFC) << 3) | ((b) >> 3))
+
+void decode_fit(uint16_t src_w, uint16_t src_h, uint16_t box_w, uint16_t box_h, uint16_t *out_w, uint16_t *out_h) {
+    uint32_t w = src_w, h = src_h;
+    if (w > box_w || h > box_h) {
+        if (w * box_h > h * box_w) {        // Width-limited
+            h = h * box_w / w;
+            w = box_w;
+        } else {
+            w = w * box_h / h;
+            h = box_h;
+        }
+    }
+    *out_w = (uint16_t)(w ? w : 1);
+    *out_h = (uint16_t)(h ? h : 1);
+}
+
+// Centre of output cell i mapped back to the source
+static inline uint32_t sample_at(uint32_t i, uint32_t in, uint32_t out) {
+    return (2 * i + 1) * in / (2 * out);
+}
+
+// --- Nearest-sampling row resampler for decoders that produce RGB565 rows in order ---
+
+typedef struct {
+    const decode_sink_t *sink;
+    const decode_geom_t *g;
+    uint16_t in_w, in_h;        // Rows as the decoder produces them
+    uint16_t *xmap;             // Source column per output column, NULL if in_w == out_w
+    uint16_t *line;
+    uint16_t next_y;
+    bool final;
+} resampler_t;
+
+// Source row @p sy is in @p px; emit every output row that samples it
+static bool resample_row(resampler_t *r, uint32_t sy, const uint16_t *px) {
+    while (r->next_y < r->g->out_h && sample_at(r->next_y, r->in_h, r->g->out_h) == sy) {
+        const uint16_t *out = px;
+        if (r->xmap) {
+            for (uint16_t x = 0; x < r->g->out_w; x++) r->line[x] = px[r->xmap[x]];
+            out = r->line;
+        }
+        if (!r->sink->row(r->sink->ctx, r->g, r->next_y, out, NULL, r->final)) return false;
+        r->next_y++;
+    }
+    return true;
+}
+
+// --- JPEG ---
+
+typedef struct {
+    struct jpeg_error_mgr pub;
+    jmp_buf jb;
+} jpeg_err_t;
+
+static void jpeg_err_exit(j_common_ptr ci) {
+    longjmp(((jpeg_err_t *)ci->err)->jb, 1);
+}
+
+static void jpeg_err_message(j_common_ptr ci, int level) {
+    (void)ci;
+    (void)level;                        // Warnings (e.g. truncated data) still give a picture
+}
+
+static bool jpeg_read_pass(struct jpeg_decompress_struct *ci, resampler_t *rs, uint16_t *rowbuf) {
+    rs->next_y = 0;
+    while (ci->output_scanline < ci->output_height) {
+        uint32_t sy = ci->output_scanline;
+        JSAMPROW row = (JSAMPROW)rowbuf;
+        jpeg_read_scanlines(ci, &row, 1);
+        if (!resample_row(rs, sy, rowbuf)) return false;
+    }
+    return true;
+}
+
+typedef struct {
+    struct jpeg_decompress_struct ci;
+    jpeg_err_t err;
+    decode_geom_t g;
+    resampler_t rs;
+    uint16_t *rowbuf;
+    decode_err_t result;
+} jpeg_job_t;
+
+// Unwind through the setjmp in decode_jpeg_file(), as libjpeg errors do
+static void jpeg_job_fail(jpeg_job_t *j, decode_err_t err) {
+    j->result = err;
+    longjmp(j->err.jb, 1);
+}
+
+static void jpeg_job_free(jpeg_job_t *j) {
+    jpeg_destroy_decompress(&j->ci);
+    free(j->rowbuf);
+    free(j->rs.xmap);
+    free(j->rs.line);
+    free(j);
+}
+
+decode_err_t decode_jpeg_file(FILE *f, uint16_t box_w, uint16_t box_h, const decode_sink_t *sink) {
+    // Heap, not stack: the decompressor state is large and must survive longjmp
+    jpeg_job_t *j = calloc(1, sizeof(*j));
+    if (!j) return DECODE_ERR_NOMEM;
+    j->result = DECODE_ERR_FORMAT;
+
+    j->ci.err = jpeg_std_error(&j->err.pub);
+    j->err.pub.error_exit = jpeg_err_exit;
+    j->err.pub.emit_message = jpeg_err_message;
+    if (setjmp(j->err.jb)) {
+        decode_err_t res = j->result;
+        jpeg_job_free(j);
+        return res;
+    }
+    jpeg_create_decompress(&j->ci);
+    jpeg_stdio_src(&j->ci, f);
+    jpeg_read_header(&j->ci, TRUE);
+    if (j->ci.image_width > UINT16_MAX || j->ci.image_height > UINT16_MAX) jpeg_job_fail(j, DECODE_ERR_FORMAT);
+
+    decode_geom_t *g = &j->g;
+    g->src_w = (uint16_t)j->ci.image_width;
+    g->src_h = (uint16_t)j->ci.image_height;
+    decode_fit(g->src_w, g->src_h, box_w, box_h, &g->out_w, &g->out_h);
+
+    // Smallest n/8 whose output still covers the fitted size
+    uint8_t n = 1;
+    while (n < 8 && ((uint32_t)g->src_w * n + 7) / 8 < g->out_w) n++;
+    while (n < 8 && ((uint32_t)g->src_h * n + 7) / 8 < g->out_h) n++;
+    g->scale_num = n;
+    g->progressive = sink->coarse_pass && jpeg_has_multiple_scans(&j->ci);
+
+    j->ci.scale_num = n;
+    j->ci.scale_denom = 8;
+    j->ci.out_color_space = JCS_RGB565;
+    j->ci.dither_mode = JDITHER_NONE;
+    j->ci.dct_method = JDCT_IFAST;
+    j->ci.do_fancy_upsampling = n == 8;  // Scaled output is already a box filter
+    j->ci.buffered_image = g->progressive;
+    jpeg_calc_output_dimensions(&j->ci);
+
+    resampler_t *rs = &j->rs;
+    rs->sink = sink;
+    rs->g = g;
+    rs->in_w = (uint16_t)j->ci.output_width;
+    rs->in_h = (uint16_t)j->ci.output_height;
+    if (g->out_w > rs->in_w) g->out_w = rs->in_w;
+    if (g->out_h > rs->in_h) g->out_h = rs->in_h;
+
+    j->rowbuf = malloc((size_t)rs->in_w * sizeof(uint16_t));
+    if (rs->in_w != g->out_w) {
+        rs->xmap = malloc((size_t)g->out_w * sizeof(uint16_t));
+        rs->line = malloc((size_t)g->out_w * sizeof(uint16_t));
+    }
+    if (!j->rowbuf || (rs->in_w != g->out_w && (!rs->xmap || !rs->line))) jpeg_job_fail(j, DECODE_ERR_NOMEM);
+    for (uint16_t x = 0; rs->xmap && x < g->out_w; x++) rs->xmap[x] = (uint16_t)sample_at(x, rs->in_w, g->out_w);
+
+    if (sink->begin && !sink->begin(sink->ctx, g)) jpeg_job_fail(j, DECODE_ERR_ABORTED);
+    jpeg_start_decompress(&j->ci);
+
+    if (!g->progressive) {
+        rs->final = true;
+        if (!jpeg_read_pass(&j->ci, rs, j->rowbuf)) jpeg_job_fail(j, DECODE_ERR_ABORTED);
+    } else {
+        // Coarse pass from the first complete scan, then one pass over everything
+        int ret;
+        do {
+            ret = jpeg_consume_input(&j->ci);
+        } while (ret != JPEG_SCAN_COMPLETED && ret != JPEG_REACHED_EOI && ret != JPEG_SUSPENDED);
+
+        if (!jpeg_input_complete(&j->ci)) {
+            jpeg_start_output(&j->ci, j->ci.input_scan_number);
+            rs->final = false;
+            if (!jpeg_read_pass(&j->ci, rs, j->rowbuf)) jpeg_job_fail(j, DECODE_ERR_ABORTED);
+            jpeg_finish_output(&j->ci);
+            while (!jpeg_input_complete(&j->ci) && jpeg_consume_input(&j->ci) != JPEG_SUSPENDED) {}
+        }
+        jpeg_start_output(&j->ci, j->ci.input_scan_number);
+        rs->final = true;
+        if (!jpeg_read_pass(&j->ci, rs, j->rowbuf)) jpeg_job_fail(j, DECODE_ERR_ABORTED);
+        jpeg_finish_output(&j->ci);
+    }
+    jpeg_finish_decompress(&j->ci);
+
+    jpeg_job_free(j);
+    return DECODE_OK;
+}
+
+// --- RGBA ---
+
+decode_err_t decode_rgba(const uint8_t *rgba, uint16_t w, uint16_t h, uint16_t box_w, uint16_t box_h,
+                         const decode_sink_t *sink) {
+    decode_geom_t g = { .src_w = w, .src_h = h, .scale_num = 8 };
+    decode_fit(w, h, box_w, box_h, &g.out_w, &g.out_h);
+
+    uint16_t *line = malloc((size_t)g.out_w * sizeof(uint16_t));
+    uint16_t *xmap = malloc((size_t)g.out_w * sizeof(uint16_t));
+    uint8_t *aline = sink->alpha ? malloc(g.out_w) : NULL;
+    decode_err_t res = DECODE_ERR_NOMEM;
+    if (!line || !xmap || (sink->alpha && !aline)) goto out;
+    for (uint16_t x = 0; x < g.out_w; x++) xmap[x] = (uint16_t)sample_at(x, w, g.out_w);
+
+    res = DECODE_ERR_ABORTED;
+    if (sink->begin && !sink->begin(sink->ctx, &g)) goto out;
+    for (uint16_t y = 0; y < g.out_h; y++) {
+        const uint8_t *src = rgba + (size_t)sample_at(y, h, g.out_h) * w * 4;
+        for (uint16_t x = 0; x < g.out_w; x++) {
+            const uint8_t *p = src + (size_t)xmap[x] * 4;
+            if (aline) {
+                line[x] = RGB565(p[0], p[1], p[2]);
+                aline[x] = p[3];
+            } else {
+                uint32_t a = p[3];
+                line[x] = RGB565(p[0] * a / 255, p[1] * a / 255, p[2] * a / 255);
+            }
+        }
+        if (!sink->row(sink->ctx, &g, y, line, aline, true)) goto out;
+    }
+    res = DECODE_OK;
+
+out:
+    free(line);
+    free(xmap);
+    free(aline);
+    return res;
+}
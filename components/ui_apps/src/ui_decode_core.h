@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * Image decode to display size, independent of LVGL and FreeRTOS.
+ *
+ * JPEGs go through libjpeg-turbo with a scaled IDCT (n/8): the smallest
+ * scale that still covers the target size is decoded, straight to RGB565,
+ * and rows are nearest-sampled down to the fitted size. Progressive JPEGs
+ * can emit a coarse first pass (first scan only) before the full one.
+ * Decoded RGBA (PNG) is fitted the same way, either blended over black or
+ * with its alpha row alongside. Output rows are handed to a sink one at a
+ * time, so no full-resolution frame is ever held.
+ *
+ * ui_decode.c runs this on a worker task; tools/decode_bench.c runs it on
+ * the host to measure throughput.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    DECODE_OK = 0,
+    DECODE_ERR_FORMAT,          // Not decodable (corrupt, unsupported)
+    DECODE_ERR_NOMEM,
+    DECODE_ERR_ABORTED,         // The sink returned false
+} decode_err_t;
+
+typedef struct {
+    uint16_t src_w, src_h;      // Image as stored
+    uint16_t out_w, out_h;      // Fitted into the target box, aspect kept, never upscaled
+    uint8_t scale_num;          // JPEG IDCT scale in eighths (8 = full size)
+    bool progressive;           // A coarse pass comes before the final one
+} decode_geom_t;
+
+typedef struct {
+    // Geometry is known; called once before any row. false aborts.
+    bool (*begin)(void *ctx, const decode_geom_t *g);
+    // Output row @p y: out_w RGB565 pixels, plus out_w alpha values if the
+    // sink asked for alpha and the image has it (else NULL, opaque).
+    // final is false on the coarse pass.
+    bool (*row)(void *ctx, const decode_geom_t *g, uint16_t y, const uint16_t *px, const uint8_t *alpha, bool final);
+    void *ctx;
+    bool coarse_pass;           // Emit the first scan of progressive JPEGs
+    bool alpha;                 // Keep alpha separate instead of blending over black
+} decode_sink_t;
+
+/**
+ * @brief Fit @p src_w x @p src_h into @p box_w x @p box_h (aspect kept, no upscale)
+ */
+void decode_fit(uint16_t src_w, uint16_t src_h, uint16_t box_w, uint16_t box_h, uint16_t *out_w, uint16_t *out_h);
+
+/**
+ * @brief Decode a JPEG from @p f into rows of at most @p box_w x @p box_h
+ */
+decode_err_t decode_jpeg_file(FILE *f, uint16_t box_w, uint16_t box_h, const decode_sink_t *sink);
+
+/**
+ * @brief Fit an RGBA8888 image (e.g. a decoded PNG) into rows
+ */
+decode_err_t decode_rgba(const uint8_t *rgba, uint16_t w, uint16_t h, uint16_t box_w, uint16_t box_h,
+                         const decode_sink_t *sink);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,186 @@
+#include "ui_delta_core.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    ST_CTRL = 0,                // Reading the three varints
+    ST_DIFF,
+    ST_EXTRA,
+} state_t;
+
+struct delta {
+    delta_hdr_t hdr;
+    delta_io_t io;
+    delta_err_t err;
+    state_t state;
+
+    // Control record being parsed
+    uint64_t ctrl[3];
+    uint8_t field, shift;
+
+    uint64_t diff_left, extra_left;
+    int64_t seek;
+    uint32_t old_pos;
+    uint32_t written;           // Handed to write_new()
+
+    uint32_t out_len;
+    uint8_t out[DELTA_OUT_BUF];
+    uint8_t old[DELTA_OLD_BUF];
+};
+
+static uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static void put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+delta_err_t delta_parse_header(const uint8_t *buf, delta_hdr_t *out) {
+    if (get_u32(buf) != DELTA_MAGIC || (buf[4] | buf[5] << 8) != DELTA_VERSION) return DELTA_ERR_FORMAT;
+    out->old_size = get_u32(buf + 8);
+    out->new_size = get_u32(buf + 12);
+    out->body_size = get_u32(buf + 16);
+    memcpy(out->old_sha256, buf + 24, 32);
+    memcpy(out->new_sha256, buf + 56, 32);
+    return DELTA_OK;
+}
+
+void delta_write_header(const delta_hdr_t *hdr, uint8_t *buf) {
+    memset(buf, 0, DELTA_HDR_SIZE);
+    put_u32(buf, DELTA_MAGIC);
+    buf[4] = DELTA_VERSION;
+    put_u32(buf + 8, hdr->old_size);
+    put_u32(buf + 12, hdr->new_size);
+    put_u32(buf + 16, hdr->body_size);
+    memcpy(buf + 24, hdr->old_sha256, 32);
+    memcpy(buf + 56, hdr->new_sha256, 32);
+}
+
+size_t delta_put_varint(uint8_t *out, uint64_t v) {
+    size_t n = 0;
+    do {
+        out[n++] = (uint8_t)(v & 0x7f) | (v > 0x7f ? 0x80 : 0);
+        v >>= 7;
+    } while (v);
+    return n;
+}
+
+delta_t *delta_create(const delta_hdr_t *hdr, const delta_io_t *io) {
+    delta_t *d = calloc(1, sizeof(delta_t));
+    if (!d) return NULL;
+    d->hdr = *hdr;
+    d->io = *io;
+    return d;
+}
+
+void delta_destroy(delta_t *d) {
+    free(d);
+}
+
+static bool flush(delta_t *d) {
+    if (!d->out_len) return true;
+    if (!d->io.write_new(d->io.ctx, d->out, d->out_len)) return false;
+    d->written += d->out_len;
+    d->out_len = 0;
+    return true;
+}
+
+static uint32_t produced(const delta_t *d) {
+    return d->written + d->out_len;
+}
+
+// Control record complete: check it against both images before any byte of it is applied
+static delta_err_t begin_record(delta_t *d) {
+    d->diff_left = d->ctrl[0];
+    d->extra_left = d->ctrl[1];
+    d->seek = (int64_t)(d->ctrl[2] >> 1) ^ -(int64_t)(d->ctrl[2] & 1);
+    uint64_t total = (uint64_t)produced(d) + d->diff_left + d->extra_left;
+    if (total > d->hdr.new_size || d->old_pos + d->diff_left > d->hdr.old_size) return DELTA_ERR_RANGE;
+    int64_t next = (int64_t)d->old_pos + (int64_t)d->diff_left + d->seek;
+    if (next < 0 || next > (int64_t)d->hdr.old_size) return DELTA_ERR_RANGE;
+    d->state = d->diff_left ? ST_DIFF : d->extra_left ? ST_EXTRA : ST_CTRL;
+    if (d->state == ST_CTRL) d->old_pos = (uint32_t)next;
+    return DELTA_OK;
+}
+
+static void end_record(delta_t *d) {
+    d->old_pos = (uint32_t)((int64_t)d->old_pos + d->seek);
+    d->state = ST_CTRL;
+}
+
+delta_err_t delta_feed(delta_t *d, const uint8_t *data, size_t len) {
+    size_t i = 0;
+    while (i < len && d->err == DELTA_OK) {
+        switch (d->state) {
+        case ST_CTRL: {
+            uint8_t b = data[i++];
+            if (d->shift >= 64) {
+                d->err = DELTA_ERR_FORMAT;
+                break;
+            }
+            d->ctrl[d->field] |= (uint64_t)(b & 0x7f) << d->shift;
+            d->shift += 7;
+            if (b & 0x80) break;
+            d->shift = 0;
+            if (++d->field < 3) break;
+            d->field = 0;
+            d->err = begin_record(d);
+            memset(d->ctrl, 0, sizeof(d->ctrl));
+            break;
+        }
+        case ST_DIFF: {
+            // Bounded by what was fed, the old read buffer and the space left in out
+            size_t n = len - i;
+            if (n > d->diff_left) n = (size_t)d->diff_left;
+            if (n > DELTA_OLD_BUF) n = DELTA_OLD_BUF;
+            if (n > DELTA_OUT_BUF - d->out_len) n = DELTA_OUT_BUF - d->out_len;
+            if (!d->io.read_old(d->io.ctx, d->old_pos, d->old, (uint32_t)n)) {
+                d->err = DELTA_ERR_IO;
+                break;
+            }
+            uint8_t *o = d->out + d->out_len;
+            for (size_t k = 0; k < n; k++) o[k] = (uint8_t)(d->old[k] + data[i + k]);
+            i += n;
+            d->out_len += (uint32_t)n;
+            d->old_pos += (uint32_t)n;
+            d->diff_left -= n;
+            if (!d->diff_left) {
+                if (d->extra_left) {
+                    d->state = ST_EXTRA;
+                } else {
+                    end_record(d);
+                }
+            }
+            break;
+        }
+        case ST_EXTRA: {
+            size_t n = len - i;
+            if (n > d->extra_left) n = (size_t)d->extra_left;
+            if (n > DELTA_OUT_BUF - d->out_len) n = DELTA_OUT_BUF - d->out_len;
+            memcpy(d->out + d->out_len, data + i, n);
+            i += n;
+            d->out_len += (uint32_t)n;
+            d->extra_left -= n;
+            if (!d->extra_left) end_record(d);
+            break;
+        }
+        }
+        if (d->err == DELTA_OK && d->out_len == DELTA_OUT_BUF && !flush(d)) d->err = DELTA_ERR_IO;
+    }
+    return d->err;
+}
+
+delta_err_t delta_finish(delta_t *d) {
+    if (d->err != DELTA_OK) return d->err;
+    if (!flush(d)) return d->err = DELTA_ERR_IO;
+    if (d->state != ST_CTRL || d->field || d->shift || d->written != d->hdr.new_size) return d->err = DELTA_ERR_SHORT;
+    return DELTA_OK;
+}
+
+uint32_t delta_written(const delta_t *d) {
+    return d->written;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+/**
+ * Streaming firmware patch applier for delta OTA, independent of ESP-IDF.
+ *
+ * A patch (tools/ota_delta.c) is a fixed header followed by a zlib stream
+ * of bsdiff-style records, interleaved so it can be applied in one pass:
+ *
+ *   diff_len, extra_len, seek      varints (seek zigzag-signed)
+ *   diff_len bytes                 new[i] = old[pos + i] + diff[i]
+ *   extra_len bytes                copied as they are
+ *
+ * after which the old position moves by diff_len + seek. Moved code differs
+ * from the old image mostly by small pointer offsets, so the diff bytes are
+ * nearly all zero and compress well.
+ *
+ * The caller inflates the stream and feeds the result in chunks of any
+ * size; the new image comes out in order through write_new() in
+ * DELTA_OUT_BUF pieces, and the old one is read through read_old() in
+ * DELTA_OLD_BUF pieces, so RAM use does not depend on the image size.
+ * Hashing both images is left to the caller: the header carries their
+ * SHA-256.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DELTA_MAGIC     0x50444955  // "UIDP"
+#define DELTA_VERSION   1
+#define DELTA_HDR_SIZE  88
+#define DELTA_OUT_BUF   4096        // New image handed out in pieces this size
+#define DELTA_OLD_BUF   1024        // Old image read in pieces up to this size
+
+typedef enum {
+    DELTA_OK = 0,
+    DELTA_ERR_FORMAT,           // Bad header or record
+    DELTA_ERR_RANGE,            // Record reads or writes past an image
+    DELTA_ERR_IO,               // read_old() or write_new() failed
+    DELTA_ERR_SHORT,            // Stream ended before the new image was complete
+} delta_err_t;
+
+/**
+ * @brief Patch header, little-endian on the wire
+ */
+typedef struct {
+    uint32_t old_size;          // Image the patch applies to
+    uint32_t new_size;
+    uint32_t body_size;         // Compressed bytes after the header
+    uint8_t old_sha256[32];
+    uint8_t new_sha256[32];
+} delta_hdr_t;
+
+typedef struct {
+    // Read @p len bytes of the old image at @p off; false on error
+    bool (*read_old)(void *ctx, uint32_t off, void *buf, uint32_t len);
+    // Next @p len bytes of the new image; false on error
+    bool (*write_new)(void *ctx, const void *buf, uint32_t len);
+    void *ctx;
+} delta_io_t;
+
+typedef struct delta delta_t;
+
+/**
+ * @brief Parse the first DELTA_HDR_SIZE bytes of a patch
+ */
+delta_err_t delta_parse_header(const uint8_t *buf, delta_hdr_t *out);
+
+/**
+ * @brief Write a header (patch builder side)
+ */
+void delta_write_header(const delta_hdr_t *hdr, uint8_t *buf);
+
+delta_t *delta_create(const delta_hdr_t *hdr, const delta_io_t *io);
+void delta_destroy(delta_t *d);
+
+/**
+ * @brief Apply the next @p len bytes of the inflated body
+ * @return DELTA_OK, or the first error (sticky)
+ */
+delta_err_t delta_feed(delta_t *d, const uint8_t *data, size_t len);
+
+/**
+ * @brief Flush the last piece of the new image
+ * @return DELTA_ERR_SHORT unless exactly new_size bytes were produced
+ */
+delta_err_t delta_finish(delta_t *d);
+
+/**
+ * @brief Bytes of the new image produced so far
+ */
+uint32_t delta_written(const delta_t *d);
+
+/**
+ * @brief Append a varint; returns bytes written (at most 10) (patch builder side)
+ */
+size_t delta_put_varint(uint8_t *out, uint64_t v);
+
+#ifdef __cplusplus
+}
+#endif
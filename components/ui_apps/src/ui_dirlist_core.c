@@ -0,0 +1,219 @@
+#include "ui_dirlist_core.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define CHUNK_BYTES   (16 * 1024)   // Name arena block; a FAT long name is at most 255 bytes
+
+typedef struct chunk {
+    struct chunk *next;
+    size_t used;
+    uint8_t data[CHUNK_BYTES];
+} chunk_t;
+
+typedef int (*cmp_fn)(const void *, const void *);
+
+struct dirlist {
+    chunk_t *chunks;                    // Newest first
+    const dirlist_entry_t **all;        // [0, sorted) in order, [sorted, count) pending
+    size_t count, sorted, cap;
+    const dirlist_entry_t **scratch;    // Merge target, swapped with `all`
+    const dirlist_entry_t **view;       // == all when there is no filter
+    size_t view_count, view_cap;
+    dirlist_order_t order;
+    char filter[DIRLIST_FILTER_MAX];    // ",jpg,png," lower case, "" for none
+};
+
+// --- Order ---
+
+static const char *ext_of(const char *name) {
+    const char *dot = strrchr(name, '.');
+    return dot ? dot + 1 : "";
+}
+
+static int cmp_entries(const dirlist_entry_t *a, const dirlist_entry_t *b, dirlist_order_t order) {
+    if (a->dir != b->dir) return a->dir ? -1 : 1;
+    if (order == DIRLIST_ORDER_TYPE && !a->dir) {
+        int e = strcasecmp(ext_of(a->name), ext_of(b->name));
+        if (e) return e;
+    }
+    int n = strcasecmp(a->name, b->name);
+    return order == DIRLIST_ORDER_NAME_DESC ? -n : n;
+}
+
+static int cmp_name(const void *a, const void *b) {
+    return cmp_entries(*(const dirlist_entry_t *const *)a, *(const dirlist_entry_t *const *)b, DIRLIST_ORDER_NAME);
+}
+
+static int cmp_name_desc(const void *a, const void *b) {
+    return cmp_entries(*(const dirlist_entry_t *const *)a, *(const dirlist_entry_t *const *)b,
+                       DIRLIST_ORDER_NAME_DESC);
+}
+
+static int cmp_type(const void *a, const void *b) {
+    return cmp_entries(*(const dirlist_entry_t *const *)a, *(const dirlist_entry_t *const *)b, DIRLIST_ORDER_TYPE);
+}
+
+static const cmp_fn comparators[DIRLIST_ORDER_COUNT] = { cmp_name, cmp_name_desc, cmp_type };
+
+// --- View ---
+
+static bool passes(const dirlist_t *l, const dirlist_entry_t *e) {
+    if (!l->filter[0] || e->dir) return true;
+    const char *ext = ext_of(e->name);
+    size_t len = strlen(ext);
+    if (!len || len + 2 > DIRLIST_FILTER_MAX) return false;
+    char key[DIRLIST_FILTER_MAX];
+    key[0] = ',';
+    for (size_t i = 0; i < len; i++) key[i + 1] = (char)tolower((unsigned char)ext[i]);
+    key[len + 1] = ',';
+    key[len + 2] = '\0';
+    return strstr(l->filter, key) != NULL;
+}
+
+static bool rebuild_view(dirlist_t *l) {
+    if (!l->filter[0]) {
+        if (l->view != l->all) free(l->view);
+        l->view = l->all;
+        l->view_cap = 0;
+        l->view_count = l->sorted;
+        return true;
+    }
+    if (l->view == l->all) {
+        l->view = NULL;
+        l->view_cap = 0;
+    }
+    if (l->view_cap < l->sorted) {
+        const dirlist_entry_t **v = realloc(l->view, l->cap * sizeof(*v));
+        if (!v) return false;
+        l->view = v;
+        l->view_cap = l->cap;
+    }
+    size_t n = 0;
+    for (size_t i = 0; i < l->sorted; i++) {
+        if (passes(l, l->all[i])) l->view[n++] = l->all[i];
+    }
+    l->view_count = n;
+    return true;
+}
+
+// --- API ---
+
+dirlist_t *dirlist_create(void) {
+    return calloc(1, sizeof(dirlist_t));
+}
+
+void dirlist_clear(dirlist_t *l) {
+    while (l->chunks) {
+        chunk_t *next = l->chunks->next;
+        free(l->chunks);
+        l->chunks = next;
+    }
+    l->count = l->sorted = 0;
+    l->view_count = 0;
+}
+
+void dirlist_destroy(dirlist_t *l) {
+    if (!l) return;
+    dirlist_clear(l);
+    if (l->view != l->all) free(l->view);
+    free(l->all);
+    free(l->scratch);
+    free(l);
+}
+
+bool dirlist_add(dirlist_t *l, const char *name, bool dir) {
+    size_t len = strlen(name) + 1;
+    size_t need = sizeof(dirlist_entry_t) + len;
+    if (need > CHUNK_BYTES) return false;
+    if (!l->chunks || l->chunks->used + need > CHUNK_BYTES) {
+        chunk_t *c = malloc(sizeof(chunk_t));
+        if (!c) return false;
+        c->next = l->chunks;
+        c->used = 0;
+        l->chunks = c;
+    }
+    if (l->count == l->cap) {
+        size_t cap = l->cap ? l->cap * 2 : 256;
+        const dirlist_entry_t **all = realloc(l->all, cap * sizeof(*all));
+        if (!all) return false;
+        bool aliased = l->view == l->all;
+        l->all = all;
+        if (aliased) l->view = all;
+        const dirlist_entry_t **scratch = realloc(l->scratch, cap * sizeof(*scratch));
+        if (!scratch) return false;
+        l->scratch = scratch;
+        l->cap = cap;
+    }
+
+    dirlist_entry_t *e = (dirlist_entry_t *)(l->chunks->data + l->chunks->used);
+    l->chunks->used += need;
+    e->dir = dir;
+    memcpy(e->name, name, len);
+    l->all[l->count++] = e;
+    return true;
+}
+
+size_t dirlist_read(dirlist_t *l, DIR *d, size_t max) {
+    size_t n = 0;
+    struct dirent *de;
+    while (n < max && (de = readdir(d)) != NULL) {
+        if (de->d_name[0] == '.') continue;
+        if (!dirlist_add(l, de->d_name, de->d_type == DT_DIR)) break;
+        n++;
+    }
+    return n;
+}
+
+bool dirlist_commit(dirlist_t *l) {
+    size_t pending = l->count - l->sorted;
+    if (!pending) return true;
+    cmp_fn cmp = comparators[l->order];
+    qsort(l->all + l->sorted, pending, sizeof(l->all[0]), cmp);
+
+    if (l->sorted) {
+        // Merge [0, sorted) and [sorted, count) into scratch, then swap
+        const dirlist_entry_t **a = l->all, **b = l->all + l->sorted, **out = l->scratch;
+        const dirlist_entry_t **a_end = b, **b_end = l->all + l->count;
+        while (a < a_end && b < b_end) *out++ = cmp(b, a) < 0 ? *b++ : *a++;
+        while (a < a_end) *out++ = *a++;
+        while (b < b_end) *out++ = *b++;
+        bool aliased = l->view == l->all;
+        const dirlist_entry_t **t = l->all;
+        l->all = l->scratch;
+        l->scratch = t;
+        if (aliased) l->view = l->all;
+    }
+    l->sorted = l->count;
+    return rebuild_view(l);
+}
+
+bool dirlist_set_order(dirlist_t *l, dirlist_order_t order) {
+    if (order >= DIRLIST_ORDER_COUNT) return false;
+    l->order = order;
+    qsort(l->all, l->sorted, sizeof(l->all[0]), comparators[order]);
+    return rebuild_view(l);
+}
+
+bool dirlist_set_filter(dirlist_t *l, const char *exts) {
+    l->filter[0] = '\0';
+    if (exts && exts[0]) {
+        size_t len = strlen(exts);
+        if (len + 3 > sizeof(l->filter)) return false;
+        l->filter[0] = ',';
+        for (size_t i = 0; i < len; i++) l->filter[i + 1] = (char)tolower((unsigned char)exts[i]);
+        l->filter[len + 1] = ',';
+        l->filter[len + 2] = '\0';
+    }
+    return rebuild_view(l);
+}
+
+size_t dirlist_count(const dirlist_t *l) {
+    return l->sorted;
+}
+
+size_t dirlist_view(const dirlist_t *l, const dirlist_entry_t *const **view) {
+    *view = l->view;
+    return l->view_count;
+}
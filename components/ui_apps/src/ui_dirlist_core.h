@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * Incremental directory listing, independent of LVGL and FreeRTOS.
+ *
+ * Entries are read from an open DIR a batch at a time. Each batch is
+ * sorted on its own and merged into the sorted list, and the filtered view
+ * is rebuilt, so a caller can show the first batch as soon as it is read
+ * and the rest as it streams in. The first batch is DIRLIST_FIRST_BATCH
+ * entries whatever the directory size; batches then double up to
+ * DIRLIST_MAX_BATCH.
+ *
+ * Names live in an append-only chunk arena: entry pointers stay valid
+ * until dirlist_clear() or dirlist_destroy().
+ *
+ * ui_sdlist.c runs this on a worker task; tools/dirlist_bench.c runs it on
+ * the host against a synthetic directory.
+ */
+
+#include <dirent.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DIRLIST_FIRST_BATCH   32
+#define DIRLIST_MAX_BATCH     1024
+#define DIRLIST_FILTER_MAX    48
+
+typedef struct {
+    bool dir;
+    char name[];
+} dirlist_entry_t;
+
+typedef enum {
+    DIRLIST_ORDER_NAME = 0,     // Folders first, then A-Z (case-insensitive)
+    DIRLIST_ORDER_NAME_DESC,    // Folders first, then Z-A
+    DIRLIST_ORDER_TYPE,         // Folders first, then by extension, then name
+    DIRLIST_ORDER_COUNT,
+} dirlist_order_t;
+
+typedef struct dirlist dirlist_t;
+
+dirlist_t *dirlist_create(void);
+void dirlist_destroy(dirlist_t *l);
+
+/**
+ * @brief Drop every entry (keeps order and filter)
+ */
+void dirlist_clear(dirlist_t *l);
+
+/**
+ * @brief Read up to @p max entries from @p d into the pending batch
+ * Skips "." and "..", and hidden (dot) entries.
+ * @return Entries read; 0 at the end of the directory or out of memory
+ */
+size_t dirlist_read(dirlist_t *l, DIR *d, size_t max);
+
+/**
+ * @brief Add one entry to the pending batch
+ */
+bool dirlist_add(dirlist_t *l, const char *name, bool dir);
+
+/**
+ * @brief Sort the pending batch, merge it in and rebuild the view
+ */
+bool dirlist_commit(dirlist_t *l);
+
+/**
+ * @brief Re-sort everything committed and rebuild the view
+ */
+bool dirlist_set_order(dirlist_t *l, dirlist_order_t order);
+
+/**
+ * @brief Show only files with one of these extensions, e.g. "jpg,jpeg,png"
+ * Folders are always shown. NULL or "" shows everything.
+ */
+bool dirlist_set_filter(dirlist_t *l, const char *exts);
+
+/**
+ * @brief Committed entries, before filtering
+ */
+size_t dirlist_count(const dirlist_t *l);
+
+/**
+ * @brief Sorted, filtered entries; valid until the next call that changes the list
+ */
+size_t dirlist_view(const dirlist_t *l, const dirlist_entry_t *const **view);
+
+#ifdef __cplusplus
+}
+#endif
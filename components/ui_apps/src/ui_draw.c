@@ -0,0 +1,116 @@
+#include "ui_draw.h"
+#include "ui_console.h"
+#include "ui_maze.h"
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "lvgl.h"
+#include "lvgl_mgr.h"
+
+static const char *TAG = "ui_draw";
+
+#if CONFIG_LV_OS_FREERTOS
+#define DRAW_UNITS LV_DRAW_SW_DRAW_UNIT_CNT
+#else
+#define DRAW_UNITS 1    // Without an OS layer LVGL draws on its own task
+#endif
+
+#define BAND_COUNT (DRAW_UNITS < UI_DRAW_MAX_BANDS ? DRAW_UNITS : UI_DRAW_MAX_BANDS)
+
+// Hidden canvases whose draw buffers are views into a row range of another
+// canvas's buffer. Created at init so they never land in a screen's arena.
+static lv_obj_t *band_canvas[UI_DRAW_MAX_BANDS];
+static lv_draw_buf_t band_buf[UI_DRAW_MAX_BANDS];
+
+static void console_cmd(FILE *out) {
+    ui_draw_bench_t r;
+    lvgl_mgr_lock();
+    ui_draw_bench(CONFIG_UI_DRAW_BENCH_FRAMES, &r);
+    lvgl_mgr_unlock();
+    fprintf(out, "units,screen_us,maze_view_us,maze_map_us\n");
+    fprintf(out, "%lu,%lu,%lu,%lu\n", (unsigned long)r.units, (unsigned long)r.screen_us,
+            (unsigned long)r.maze_view_us, (unsigned long)r.maze_map_us);
+}
+
+void ui_draw_init(void) {
+    static bool initialized = false;
+    if (initialized) return;
+    initialized = true;
+
+    for (uint32_t b = 0; BAND_COUNT > 1 && b < BAND_COUNT; b++) {
+        band_canvas[b] = lv_canvas_create(lv_layer_sys());
+        lv_obj_add_flag(band_canvas[b], LV_OBJ_FLAG_HIDDEN);
+    }
+
+#if CONFIG_LV_OS_FREERTOS
+    ESP_LOGI(TAG, "%d software draw unit(s)", DRAW_UNITS);
+#else
+    ESP_LOGI(TAG, "LVGL built without an OS layer: drawing stays on the LVGL task");
+#endif
+    ui_console_register('d', "draw benchmark (this build's draw units)", console_cmd);
+}
+
+uint32_t ui_draw_unit_count(void) {
+    return DRAW_UNITS;
+}
+
+uint32_t ui_draw_band_count(void) {
+    return band_canvas[0] ? BAND_COUNT : 1;
+}
+
+lv_obj_t *ui_draw_band(lv_obj_t *canvas, uint32_t b, int32_t *y0, int32_t *y1) {
+    lv_draw_buf_t *buf = lv_canvas_get_draw_buf(canvas);
+    uint32_t bands = ui_draw_band_count();
+    int32_t h = buf ? (int32_t)buf->header.h : 0;
+    if (bands <= 1 || b >= bands || !buf) {
+        *y0 = 0;
+        *y1 = h - 1;
+        return canvas;
+    }
+
+    // Whole rows are contiguous, so a band is an exact, aligned sub-buffer
+    *y0 = (int32_t)(h * b / bands);
+    *y1 = (int32_t)(h * (b + 1) / bands) - 1;
+    uint32_t stride = buf->header.stride;
+    uint8_t *data = buf->data + (size_t)*y0 * stride;
+    uint32_t rows = (uint32_t)(*y1 - *y0 + 1);
+
+    lv_draw_buf_t *band = &band_buf[b];
+    if (band->data != data || band->header.h != rows || band->header.w != buf->header.w ||
+        band->header.stride != stride || band->header.cf != buf->header.cf) {
+        lv_draw_buf_init(band, buf->header.w, rows, buf->header.cf, stride, data, rows * stride);
+        lv_canvas_set_draw_buf(band_canvas[b], band);
+    }
+    return band_canvas[b];
+}
+
+static uint32_t bench_screen(int frames) {
+    lv_obj_t *scr = lv_screen_active();
+    uint64_t total_us = 0;
+
+    lv_obj_invalidate(scr);
+    lv_refr_now(NULL);      // Warm up caches (fonts, shadows) outside the timed loop
+    for (int i = 0; i < frames; i++) {
+        lv_obj_invalidate(scr);
+        int64_t t0 = esp_timer_get_time();
+        lv_refr_now(NULL);
+        total_us += esp_timer_get_time() - t0;
+    }
+    return frames ? (uint32_t)(total_us / frames) : 0;
+}
+
+void ui_draw_bench(int frames, ui_draw_bench_t *result) {
+    ui_draw_bench_t r = { .units = DRAW_UNITS };
+    r.screen_us = bench_screen(frames);
+    ui_maze_draw_bench(frames, &r.maze_view_us, &r.maze_map_us);
+
+    ESP_LOGI(TAG, "Draw bench, %d frames each, avg us:", frames);
+    ESP_LOGI(TAG, "  units  screen  maze-view  maze-map");
+    ESP_LOGI(TAG, "  %5lu  %6lu  %9lu  %8lu", (unsigned long)r.units, (unsigned long)r.screen_us,
+             (unsigned long)r.maze_view_us, (unsigned long)r.maze_map_us);
+    if (DRAW_UNITS == 1) {
+        ESP_LOGI(TAG, "Single draw unit; compare with a LV_DRAW_SW_DRAW_UNIT_CNT > 1 build");
+    }
+
+    if (result) *result = r;
+}
@@ -0,0 +1,117 @@
+#include "ui_fill.h"
+#include "ui_fill_core.h"
+#include "ui_console.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+
+static const char *TAG = "ui_fill";
+
+#define BENCH_INTERNAL  (32 * 1024)
+#define BENCH_PSRAM     (480 * 480 * 2)     // About one full-screen canvas
+#define BENCH_MIN_US    50000
+
+void ui_fill_canvas(lv_obj_t *canvas, lv_color_t color) {
+    lv_draw_buf_t *buf = lv_canvas_get_draw_buf(canvas);
+    if (!buf) return;
+    if (buf->header.cf != LV_COLOR_FORMAT_RGB565) {
+        lv_canvas_fill_bg(canvas, color, LV_OPA_COVER);
+        return;
+    }
+    ui_fill_rect((uint16_t *)buf->data, buf->header.stride, buf->header.w, buf->header.h,
+                 lv_color_to_u16(color));
+    lv_obj_invalidate(canvas);
+}
+
+// --- Bit-exact check ---
+
+static void log_fail(void *ctx, const char *msg) {
+    ESP_LOGE(TAG, "FAIL %s", msg);
+}
+
+bool ui_fill_check(void) {
+    // 16-byte aligned bases, so the check's pixel offsets hit every vector-store alignment
+    uint32_t caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+    fill_check_bufs_t b = {
+        .got = heap_caps_aligned_alloc(16, FILL_CHECK_PX * sizeof(uint16_t), caps),
+        .want = heap_caps_aligned_alloc(16, FILL_CHECK_PX * sizeof(uint16_t), caps),
+        .lut = heap_caps_malloc(256 * sizeof(uint16_t), caps),
+        .idx = heap_caps_malloc(FILL_CHECK_PX, caps),
+    };
+    bool ok = b.got && b.want && b.lut && b.idx;
+    if (!ok) {
+        ESP_LOGE(TAG, "FAIL: out of memory");
+    } else {
+        ok = fill_check(&b, log_fail, NULL);
+        if (ok) ESP_LOGI(TAG, "Fill kernels match the scalar reference (%s)", fill_kernels_name());
+    }
+    heap_caps_free(b.got);
+    heap_caps_free(b.want);
+    heap_caps_free(b.lut);
+    heap_caps_free(b.idx);
+    return ok;
+}
+
+// --- Bandwidth ---
+
+typedef enum { K_REF_SPAN, K_SPAN, K_REF_LUT, K_LUT, K_COUNT } kernel_t;
+
+static uint32_t bench_mbps(kernel_t k, uint16_t *buf, size_t bytes, const uint8_t *idx, const uint16_t *lut) {
+    size_t n = bytes / 2;
+    uint64_t total = 0;
+    int64_t t0 = esp_timer_get_time();
+    int64_t dt;
+    do {
+        switch (k) {
+            case K_REF_SPAN: fill_ref_hspan(buf, n, (uint16_t)total); break;
+            case K_SPAN:     ui_fill_hspan(buf, n, (uint16_t)total); break;
+            case K_REF_LUT:  fill_ref_lut(buf, idx, n, lut); break;
+            case K_LUT:      ui_fill_lut_expand(buf, idx, n, lut); break;
+            default: break;
+        }
+        total += bytes;
+        dt = esp_timer_get_time() - t0;
+    } while (dt < BENCH_MIN_US);
+    return (uint32_t)(total / (uint64_t)dt);     // Bytes per us == MB/s
+}
+
+void ui_fill_bench(FILE *out) {
+    static const struct { const char *name; size_t bytes; uint32_t caps; } bufs[] = {
+        { "internal", BENCH_INTERNAL, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT },
+        { "psram", BENCH_PSRAM, MALLOC_CAP_SPIRAM },
+    };
+    uint16_t *lut = heap_caps_malloc(256 * sizeof(uint16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!lut) return;
+    uint32_t seed = 0x12345678;
+    for (int i = 0; i < 256; i++) lut[i] = (uint16_t)fill_rng(&seed);
+
+    fprintf(out, "Fill bandwidth, MB/s (%s kernels)\n", fill_kernels_name());
+    fprintf(out, "%-9s %7s %8s %6s %7s %6s\n", "buffer", "KB", "ref-span", "span", "ref-lut", "lut");
+    for (size_t b = 0; b < sizeof(bufs) / sizeof(bufs[0]); b++) {
+        uint16_t *buf = heap_caps_aligned_alloc(16, bufs[b].bytes, bufs[b].caps);
+        // LUT source lives in the same memory as the destination, like a decoded image
+        uint8_t *idx = heap_caps_malloc(bufs[b].bytes / 2, bufs[b].caps);
+        if (!buf || !idx) {
+            fprintf(out, "%-9s no memory\n", bufs[b].name);
+        } else {
+            for (size_t i = 0; i < bufs[b].bytes / 2; i++) idx[i] = (uint8_t)i;
+            uint32_t mbps[K_COUNT];
+            for (int k = 0; k < K_COUNT; k++) mbps[k] = bench_mbps(k, buf, bufs[b].bytes, idx, lut);
+            fprintf(out, "%-9s %7u %8lu %6lu %7lu %6lu\n", bufs[b].name, (unsigned)(bufs[b].bytes / 1024),
+                    (unsigned long)mbps[K_REF_SPAN], (unsigned long)mbps[K_SPAN],
+                    (unsigned long)mbps[K_REF_LUT], (unsigned long)mbps[K_LUT]);
+        }
+        heap_caps_free(buf);
+        heap_caps_free(idx);
+    }
+    heap_caps_free(lut);
+}
+
+static void console_cmd(FILE *out) {
+    ui_fill_check();
+    ui_fill_bench(out);
+}
+
+void ui_fill_init(void) {
+    ui_console_register('f', "fill kernel check and bandwidth", console_cmd);
+}
@@ -0,0 +1,211 @@
+#include "ui_fill_core.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+#if CONFIG_IDF_TARGET_ESP32S3 && CONFIG_UI_FILL_SIMD
+#define USE_PIE 1
+#define PIE_MIN_PX 32           // Below this the alignment head/tail dominates
+#else
+#define USE_PIE 0
+#endif
+
+// --- Kernels ---
+
+static inline void hspan_words(uint16_t *dst, size_t n, uint16_t color) {
+    if (n && ((uintptr_t)dst & 2)) {
+        *dst++ = color;
+        n--;
+    }
+    uint32_t c2 = color | ((uint32_t)color << 16);
+    uint32_t *d32 = (uint32_t *)dst;
+    size_t pairs = n / 2;
+    while (pairs >= 4) {
+        d32[0] = c2;
+        d32[1] = c2;
+        d32[2] = c2;
+        d32[3] = c2;
+        d32 += 4;
+        pairs -= 4;
+    }
+    while (pairs--) *d32++ = c2;
+    if (n & 1) *(uint16_t *)d32 = color;
+}
+
+#if USE_PIE
+// 128-bit stores need a 16-byte aligned address; align with scalar stores,
+// then broadcast the color into q0 and store 64 bytes per loop iteration
+static void hspan_pie(uint16_t *dst, size_t n, uint16_t color) {
+    while (n && ((uintptr_t)dst & 15)) {
+        *dst++ = color;
+        n--;
+    }
+    size_t blocks = n / 32;     // 4 x 8 pixels
+    if (blocks) {
+        uint16_t c = color;     // ee.vldbc.16 broadcasts from memory
+        __asm__ volatile(
+            "ee.vldbc.16 q0, %[c]\n"
+            "loopnez %[n], 1f\n"
+            "ee.vst.128.ip q0, %[p], 16\n"
+            "ee.vst.128.ip q0, %[p], 16\n"
+            "ee.vst.128.ip q0, %[p], 16\n"
+            "ee.vst.128.ip q0, %[p], 16\n"
+            "1:\n"
+            : [p] "+r"(dst)
+            : [c] "r"(&c), [n] "r"(blocks)
+            : "memory");
+        n -= blocks * 32;
+    }
+    hspan_words(dst, n, color);
+}
+#endif
+
+void ui_fill_hspan(uint16_t *dst, size_t n, uint16_t color) {
+#if USE_PIE
+    if (n >= PIE_MIN_PX) {
+        hspan_pie(dst, n, color);
+        return;
+    }
+#endif
+    hspan_words(dst, n, color);
+}
+
+void ui_fill_vspan(uint16_t *dst, int32_t stride, int32_t h, uint16_t color) {
+    uint8_t *row = (uint8_t *)dst;
+    while (h-- > 0) {
+        *(uint16_t *)row = color;
+        row += stride;
+    }
+}
+
+void ui_fill_rect(uint16_t *dst, int32_t stride, int32_t w, int32_t h, uint16_t color) {
+    if (w <= 0 || h <= 0) return;
+    if (w == 1) {
+        ui_fill_vspan(dst, stride, h, color);
+        return;
+    }
+    if (stride == w * 2) {
+        ui_fill_hspan(dst, (size_t)w * h, color);   // Contiguous: one long span
+        return;
+    }
+    uint8_t *row = (uint8_t *)dst;
+    while (h-- > 0) {
+        ui_fill_hspan((uint16_t *)row, w, color);
+        row += stride;
+    }
+}
+
+void ui_fill_lut_expand(uint16_t *dst, const uint8_t *src, size_t n, const uint16_t lut[256]) {
+    if (n && ((uintptr_t)dst & 2)) {
+        *dst++ = lut[*src++];
+        n--;
+    }
+    uint32_t *d32 = (uint32_t *)dst;
+    while (n >= 4) {
+        d32[0] = lut[src[0]] | ((uint32_t)lut[src[1]] << 16);
+        d32[1] = lut[src[2]] | ((uint32_t)lut[src[3]] << 16);
+        d32 += 2;
+        src += 4;
+        n -= 4;
+    }
+    dst = (uint16_t *)d32;
+    while (n--) *dst++ = lut[*src++];
+}
+
+const char *fill_kernels_name(void) {
+    return USE_PIE ? "PIE" : "32-bit";
+}
+
+// --- Scalar reference ---
+
+void fill_ref_hspan(uint16_t *dst, size_t n, uint16_t color) {
+    for (size_t i = 0; i < n; i++) dst[i] = color;
+}
+
+void fill_ref_rect(uint16_t *dst, int32_t stride, int32_t w, int32_t h, uint16_t color) {
+    for (int32_t y = 0; y < h; y++) {
+        uint16_t *row = (uint16_t *)((uint8_t *)dst + y * stride);
+        for (int32_t x = 0; x < w; x++) row[x] = color;
+    }
+}
+
+void fill_ref_lut(uint16_t *dst, const uint8_t *src, size_t n, const uint16_t lut[256]) {
+    for (size_t i = 0; i < n; i++) dst[i] = lut[src[i]];
+}
+
+// --- Bit-exact check ---
+
+uint32_t fill_rng(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static bool compare(const fill_check_bufs_t *b, const char *what, int off, int w, int h, int stride,
+                    fill_fail_cb_t fail, void *ctx) {
+    if (memcmp(b->got, b->want, FILL_CHECK_PX * sizeof(uint16_t)) == 0) return true;
+    for (int i = 0; i < FILL_CHECK_PX; i++) {
+        if (b->got[i] != b->want[i]) {
+            char msg[112];
+            snprintf(msg, sizeof(msg), "%s off %d w %d h %d stride %d: px %d = 0x%04x, want 0x%04x",
+                     what, off, w, h, stride, i, b->got[i], b->want[i]);
+            fail(ctx, msg);
+            break;
+        }
+    }
+    return false;
+}
+
+static void clear(const fill_check_bufs_t *b) {
+    memset(b->got, 0xA5, FILL_CHECK_PX * sizeof(uint16_t));
+    memset(b->want, 0xA5, FILL_CHECK_PX * sizeof(uint16_t));
+}
+
+bool fill_check(const fill_check_bufs_t *b, fill_fail_cb_t fail, void *ctx) {
+    static const int lens[] = { 0, 1, 2, 3, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 640, 1000 };
+    static const int widths[] = { 1, 2, 3, 8, 9, 17, 33, 64, 100 };
+    static const int heights[] = { 1, 3, 7 };
+    static const int pads[] = { 0, 1, 5 };
+    uint32_t seed = 0x12345678;
+    bool ok = true;
+
+    for (int i = 0; i < 256; i++) b->lut[i] = (uint16_t)fill_rng(&seed);
+    for (int i = 0; i < FILL_CHECK_PX; i++) b->idx[i] = (uint8_t)fill_rng(&seed);
+
+    // Offsets 0..7 pixels from the 16-byte aligned bases hit every vector-store alignment
+    for (int off = 0; off < 8; off++) {
+        for (size_t l = 0; l < sizeof(lens) / sizeof(lens[0]); l++) {
+            int n = lens[l];
+            uint16_t color = (uint16_t)fill_rng(&seed);
+            clear(b);
+            ui_fill_hspan(b->got + off, n, color);
+            fill_ref_hspan(b->want + off, n, color);
+            ok &= compare(b, "hspan", off, n, 1, 0, fail, ctx);
+
+            clear(b);
+            ui_fill_lut_expand(b->got + off, b->idx + off, n, b->lut);
+            fill_ref_lut(b->want + off, b->idx + off, n, b->lut);
+            ok &= compare(b, "lut", off, n, 1, 0, fail, ctx);
+        }
+
+        for (size_t wi = 0; wi < sizeof(widths) / sizeof(widths[0]); wi++) {
+            for (size_t hi = 0; hi < sizeof(heights) / sizeof(heights[0]); hi++) {
+                for (size_t pi = 0; pi < sizeof(pads) / sizeof(pads[0]); pi++) {
+                    int w = widths[wi], h = heights[hi];
+                    int stride = (w + pads[pi]) * 2;
+                    uint16_t color = (uint16_t)fill_rng(&seed);
+                    clear(b);
+                    ui_fill_rect(b->got + off, stride, w, h, color);
+                    fill_ref_rect(b->want + off, stride, w, h, color);
+                    ok &= compare(b, "rect", off, w, h, stride, fail, ctx);
+                }
+            }
+        }
+    }
+    return ok;
+}
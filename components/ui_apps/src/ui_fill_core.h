@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * RGB565 fill kernels and their scalar reference, independent of ESP-IDF
+ * and LVGL.
+ *
+ * The kernels keep the names ui_fill.h gives them to the rest of the app,
+ * so LVGL's blender and the apps call them directly. On the ESP32-S3 with
+ * CONFIG_UI_FILL_SIMD, long spans use 128-bit PIE stores; everywhere else
+ * (including the host) the portable 32-bit paired stores.
+ *
+ * fill_check() compares every kernel bit-exactly with the reference. It
+ * runs on the target from ui_fill.c ('f' on the console) and on the host
+ * from tools/fill_test.c.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FILL_CHECK_PX   2048
+
+// --- Kernels (declared for the app in ui_fill.h) ---
+
+void ui_fill_hspan(uint16_t *dst, size_t n, uint16_t color);
+void ui_fill_vspan(uint16_t *dst, int32_t stride, int32_t h, uint16_t color);
+void ui_fill_rect(uint16_t *dst, int32_t stride, int32_t w, int32_t h, uint16_t color);
+void ui_fill_lut_expand(uint16_t *dst, const uint8_t *src, size_t n, const uint16_t lut[256]);
+
+/**
+ * @brief "PIE" or "32-bit": which stores the kernels use in this build
+ */
+const char *fill_kernels_name(void);
+
+// --- Scalar reference ---
+
+void fill_ref_hspan(uint16_t *dst, size_t n, uint16_t color);
+void fill_ref_rect(uint16_t *dst, int32_t stride, int32_t w, int32_t h, uint16_t color);
+void fill_ref_lut(uint16_t *dst, const uint8_t *src, size_t n, const uint16_t lut[256]);
+
+// --- Bit-exact check ---
+
+/**
+ * @brief Caller-owned work buffers for fill_check()
+ */
+typedef struct {
+    uint16_t *got, *want;       // FILL_CHECK_PX pixels each, 16-byte aligned
+    uint16_t *lut;              // 256 entries
+    uint8_t *idx;               // FILL_CHECK_PX indices
+} fill_check_bufs_t;
+
+// One line describing a mismatch
+typedef void (*fill_fail_cb_t)(void *ctx, const char *msg);
+
+/**
+ * @brief Compare every kernel with the reference
+ * Sweeps lengths, all 8 pixel offsets from a 16-byte boundary, and rect
+ * widths, heights and strides, checking the guard pixels around each write.
+ * Reports the first differing pixel of each failing case through @p fail.
+ * @return true if all kernels matched
+ */
+bool fill_check(const fill_check_bufs_t *b, fill_fail_cb_t fail, void *ctx);
+
+/**
+ * @brief xorshift32 step, for test colors and indices
+ */
+uint32_t fill_rng(uint32_t *state);
+
+#ifdef __cplusplus
+}
+#endif
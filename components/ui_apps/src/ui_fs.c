@@ -0,0 +1,379 @@
+#include "ui_fs.h"
+#include "ui_rafs_core.h"
+#include "ui_console.h"
+#include "lvgl.h"
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char *TAG = "ui_fs";
+
+#define WORKER_STACK    3072
+#define WORKER_PRIO     3           // Above the decode worker it reads ahead for, below the LVGL task
+#define WAIT_MS         5           // Re-check a block in flight at least this often
+
+#if CONFIG_UI_FS_BLOCKS_PSRAM
+#define BLOCK_CAPS      (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#define BLOCK_MEM       "PSRAM"
+#else
+#define BLOCK_CAPS      (MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL)
+#define BLOCK_MEM       "internal DMA"
+#endif
+
+static rafs_t *fs = NULL;
+static SemaphoreHandle_t mutex = NULL;
+static SemaphoreHandle_t ready = NULL;      // Given whenever a block finishes loading
+static TaskHandle_t worker = NULL;
+
+// --- Backend: VFS file descriptors, FreeRTOS locking ---
+
+static void *be_open(void *ctx, const char *path, uint32_t *size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return NULL;
+    }
+    *size = (uint32_t)st.st_size;
+    return (void *)(intptr_t)(fd + 1);
+}
+
+static int be_pread(void *ctx, void *h, void *buf, uint32_t len, uint32_t off) {
+    return (int)pread((int)(intptr_t)h - 1, buf, len, off);
+}
+
+static void be_close(void *ctx, void *h) {
+    close((int)(intptr_t)h - 1);
+}
+
+static void *be_alloc(void *ctx, size_t size) {
+    return heap_caps_aligned_alloc(64, size, BLOCK_CAPS);
+}
+
+static void be_free(void *ctx, void *p) {
+    heap_caps_free(p);
+}
+
+// SD reads into anything else are bounced a sector at a time by the driver
+static bool be_direct_ok(void *ctx, const void *buf) {
+    return esp_ptr_dma_capable(buf) && ((uintptr_t)buf & 3) == 0;
+}
+
+static void be_lock(void *ctx) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+}
+
+static void be_unlock(void *ctx) {
+    xSemaphoreGive(mutex);
+}
+
+// One binary semaphore for every waiter: the timeout covers a wake-up taken by another
+static void be_wait(void *ctx) {
+    xSemaphoreGive(mutex);
+    xSemaphoreTake(ready, pdMS_TO_TICKS(WAIT_MS));
+    xSemaphoreTake(mutex, portMAX_DELAY);
+}
+
+static void be_signal(void *ctx) {
+    xSemaphoreGive(ready);
+}
+
+static void be_kick(void *ctx) {
+    xTaskNotifyGive(worker);
+}
+
+static void worker_fn(void *arg) {
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (rafs_service(fs)) {
+        }
+    }
+}
+
+// --- "S:" driver ---
+
+typedef struct {
+    rafs_file_t *rf;            // Read-only opens
+    FILE *fp;                   // Write opens, straight to the VFS
+} fs_file_t;
+
+static void *fs_open(lv_fs_drv_t *drv, const char *path, lv_fs_mode_t mode) {
+    fs_file_t *f = calloc(1, sizeof(fs_file_t));
+    if (!f) return NULL;
+    if (mode & LV_FS_MODE_WR) {
+        f->fp = fopen(path, mode & LV_FS_MODE_RD ? "rb+" : "wb");
+    } else {
+        f->rf = rafs_open(fs, path);
+    }
+    if (!f->fp && !f->rf) {
+        free(f);
+        return NULL;
+    }
+    return f;
+}
+
+static lv_fs_res_t fs_close(lv_fs_drv_t *drv, void *file_p) {
+    fs_file_t *f = file_p;
+    if (f->rf) rafs_close(f->rf);
+    if (f->fp) fclose(f->fp);
+    free(f);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_read(lv_fs_drv_t *drv, void *file_p, void *buf, uint32_t btr, uint32_t *br) {
+    fs_file_t *f = file_p;
+    if (f->fp) {
+        *br = fread(buf, 1, btr, f->fp);
+        return ferror(f->fp) ? LV_FS_RES_FS_ERR : LV_FS_RES_OK;
+    }
+    int n = rafs_read(f->rf, buf, btr);
+    *br = n > 0 ? (uint32_t)n : 0;
+    return n < 0 ? LV_FS_RES_FS_ERR : LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_write(lv_fs_drv_t *drv, void *file_p, const void *buf, uint32_t btw, uint32_t *bw) {
+    fs_file_t *f = file_p;
+    if (!f->fp) return LV_FS_RES_DENIED;
+    *bw = fwrite(buf, 1, btw, f->fp);
+    return *bw == btw ? LV_FS_RES_OK : LV_FS_RES_FS_ERR;
+}
+
+static lv_fs_res_t fs_seek(lv_fs_drv_t *drv, void *file_p, uint32_t pos, lv_fs_whence_t whence) {
+    fs_file_t *f = file_p;
+    if (f->fp) {
+        int w = whence == LV_FS_SEEK_CUR ? SEEK_CUR : whence == LV_FS_SEEK_END ? SEEK_END : SEEK_SET;
+        return fseek(f->fp, (long)pos, w) == 0 ? LV_FS_RES_OK : LV_FS_RES_FS_ERR;
+    }
+    uint32_t base = whence == LV_FS_SEEK_CUR ? rafs_tell(f->rf) : whence == LV_FS_SEEK_END ? rafs_size(f->rf) : 0;
+    return rafs_seek(f->rf, base + pos) ? LV_FS_RES_OK : LV_FS_RES_INV_PARAM;
+}
+
+static lv_fs_res_t fs_tell(lv_fs_drv_t *drv, void *file_p, uint32_t *pos) {
+    fs_file_t *f = file_p;
+    *pos = f->fp ? (uint32_t)ftell(f->fp) : rafs_tell(f->rf);
+    return LV_FS_RES_OK;
+}
+
+static void *fs_dir_open(lv_fs_drv_t *drv, const char *path) {
+    return opendir(path);
+}
+
+// Same convention as LVGL's stdio driver: directories are prefixed with '/'
+static lv_fs_res_t fs_dir_read(lv_fs_drv_t *drv, void *dir_p, char *fn, uint32_t fn_len) {
+    struct dirent *e;
+    do {
+        e = readdir(dir_p);
+        if (!e) {
+            if (fn_len) fn[0] = '\0';
+            return LV_FS_RES_OK;
+        }
+    } while (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0);
+    snprintf(fn, fn_len, "%s%s", e->d_type == DT_DIR ? "/" : "", e->d_name);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_dir_close(lv_fs_drv_t *drv, void *dir_p) {
+    closedir(dir_p);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_drv_t fs_drv;
+
+// --- Benchmark ---
+
+#define BENCH_PATH      "/sdcard/.fsbench.bin"
+#define BENCH_SIZE      (4 * 1024 * 1024)
+#define BENCH_RANDOM    256         // Reads per random pass
+#define BENCH_BUF       (32 * 1024)
+#define STDIO_BUF       8192        // What CONFIG_LV_FS_STDIO_CACHE_SIZE gave each file
+
+typedef struct {
+    const char *name;
+    uint32_t chunk;
+    bool random;
+} pattern_t;
+
+static const pattern_t patterns[] = {
+    { "seq 4K",  4096,       false },
+    { "seq 32K", BENCH_BUF,  false },
+    { "rand 4K", 4096,       true },
+};
+
+static bool bench_file(FILE *out) {
+    struct stat st;
+    if (stat(BENCH_PATH, &st) == 0 && st.st_size == BENCH_SIZE) return true;
+
+    fprintf(out, "Writing %d MB to %s...\n", BENCH_SIZE / (1024 * 1024), BENCH_PATH);
+    FILE *f = fopen(BENCH_PATH, "wb");
+    uint8_t *chunk = heap_caps_malloc(BENCH_BUF, MALLOC_CAP_SPIRAM);
+    bool ok = f && chunk;
+    for (uint32_t off = 0; ok && off < BENCH_SIZE; off += BENCH_BUF) {
+        for (uint32_t i = 0; i < BENCH_BUF; i++) chunk[i] = (uint8_t)((off + i) * 31u >> 7);
+        ok = fwrite(chunk, 1, BENCH_BUF, f) == BENCH_BUF;
+    }
+    heap_caps_free(chunk);
+    if (f && fclose(f) != 0) ok = false;
+    if (!ok) {
+        fprintf(out, "Writing the scratch file failed (is the card mounted?)\n");
+        unlink(BENCH_PATH);
+    }
+    return ok;
+}
+
+// Same offsets for both readers
+static uint32_t next_offset(uint32_t *seed, uint32_t chunk) {
+    *seed = *seed * 1103515245u + 12345u;
+    return (*seed >> 8) % (BENCH_SIZE / chunk) * chunk;
+}
+
+static int64_t run_rafs(const pattern_t *p, uint8_t *buf) {
+    rafs_file_t *f = rafs_open(fs, BENCH_PATH);
+    if (!f) return -1;
+    uint32_t seed = 1;
+    int64_t t0 = esp_timer_get_time();
+    uint32_t reads = p->random ? BENCH_RANDOM : BENCH_SIZE / p->chunk;
+    for (uint32_t i = 0; i < reads; i++) {
+        if (p->random) rafs_seek(f, next_offset(&seed, p->chunk));
+        if (rafs_read(f, buf, p->chunk) != (int)p->chunk) break;
+    }
+    int64_t us = esp_timer_get_time() - t0;
+    rafs_close(f);
+    return us;
+}
+
+static int64_t run_stdio(const pattern_t *p, uint8_t *buf) {
+    FILE *f = fopen(BENCH_PATH, "rb");
+    if (!f) return -1;
+    setvbuf(f, NULL, _IOFBF, STDIO_BUF);
+    uint32_t seed = 1;
+    int64_t t0 = esp_timer_get_time();
+    uint32_t reads = p->random ? BENCH_RANDOM : BENCH_SIZE / p->chunk;
+    for (uint32_t i = 0; i < reads; i++) {
+        if (p->random) fseek(f, (long)next_offset(&seed, p->chunk), SEEK_SET);
+        if (fread(buf, 1, p->chunk, f) != p->chunk) break;
+    }
+    int64_t us = esp_timer_get_time() - t0;
+    fclose(f);
+    return us;
+}
+
+static double mb_s(uint32_t bytes, int64_t us) {
+    return us > 0 ? bytes / (double)us * 1e6 / (1024 * 1024) : 0;
+}
+
+void ui_fs_bench(FILE *out) {
+    if (!fs) {
+        fprintf(out, "S: driver not started\n");
+        return;
+    }
+    if (!bench_file(out)) return;
+    uint8_t *buf = heap_caps_aligned_alloc(64, BENCH_BUF, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    if (!buf) {
+        fprintf(out, "No %d KB DMA buffer for the benchmark\n", BENCH_BUF / 1024);
+        return;
+    }
+
+    fprintf(out, "S: pool %d x %d KB (%s), read-ahead %d blocks; stdio with an %d KB buffer\n", CONFIG_UI_FS_BLOCKS,
+            CONFIG_UI_FS_BLOCK_KB, BLOCK_MEM, CONFIG_UI_FS_READAHEAD,
+            STDIO_BUF / 1024);
+    fprintf(out, "%-8s %10s %10s\n", "pattern", "S: MB/s", "stdio MB/s");
+    rafs_stats_t total = { 0 };
+    for (size_t i = 0; i < sizeof(patterns) / sizeof(patterns[0]); i++) {
+        const pattern_t *p = &patterns[i];
+        uint32_t bytes = p->random ? BENCH_RANDOM * p->chunk : BENCH_SIZE;
+        rafs_reset_stats(fs);
+        int64_t us_rafs = run_rafs(p, buf);
+        rafs_stats_t s;
+        rafs_get_stats(fs, &s);
+        total.hit_bytes += s.hit_bytes;
+        total.direct_bytes += s.direct_bytes;
+        total.backend_bytes += s.backend_bytes;
+        total.ahead_loaded += s.ahead_loaded;
+        total.ahead_used += s.ahead_used;
+        total.waits += s.waits;
+        int64_t us_stdio = run_stdio(p, buf);
+        fprintf(out, "%-8s %10.2f %10.2f\n", p->name, mb_s(bytes, us_rafs), mb_s(bytes, us_stdio));
+    }
+    fprintf(out, "  %llu KB from the pool, %llu KB direct, %llu KB off the card; read-ahead %lu blocks, %lu used, "
+            "%lu waits\n", (unsigned long long)(total.hit_bytes / 1024), (unsigned long long)(total.direct_bytes / 1024),
+            (unsigned long long)(total.backend_bytes / 1024), (unsigned long)total.ahead_loaded,
+            (unsigned long)total.ahead_used, (unsigned long)total.waits);
+    rafs_reset_stats(fs);
+    heap_caps_free(buf);
+}
+
+// --- Init ---
+
+void ui_fs_init(void) {
+    if (fs) return;
+
+    rafs_config_t cfg = {
+        .block_size = CONFIG_UI_FS_BLOCK_KB * 1024,
+        .blocks = CONFIG_UI_FS_BLOCKS,
+        .readahead = CONFIG_UI_FS_READAHEAD,
+    };
+    rafs_backend_t be = {
+        .open = be_open,
+        .pread = be_pread,
+        .close = be_close,
+        .alloc = be_alloc,
+        .free = be_free,
+        .direct_ok = be_direct_ok,
+        .lock = be_lock,
+        .unlock = be_unlock,
+        .wait = be_wait,
+        .signal = be_signal,
+        .kick = be_kick,
+    };
+    const char *fail = NULL;
+    mutex = xSemaphoreCreateMutex();
+    ready = xSemaphoreCreateBinary();
+    if (!mutex || !ready) {
+        fail = "no memory for its semaphores";
+    } else if (!(fs = rafs_create(&cfg, &be))) {
+        fail = (cfg.block_size & (cfg.block_size - 1)) ? "block size must be a power of two"
+                                                        : "no memory for the block table";
+    } else if (xTaskCreatePinnedToCore(worker_fn, "ui_fs", WORKER_STACK, NULL, WORKER_PRIO, &worker,
+                                       tskNO_AFFINITY) != pdPASS) {
+        fail = "read-ahead task not created";
+    }
+    if (fail) {
+        ESP_LOGE(TAG, "S: driver not started: %s", fail);
+        rafs_destroy(fs);
+        if (mutex) vSemaphoreDelete(mutex);
+        if (ready) vSemaphoreDelete(ready);
+        fs = NULL;
+        mutex = ready = NULL;
+        return;
+    }
+
+    lv_fs_drv_init(&fs_drv);
+    fs_drv.letter = UI_FS_LETTER;
+    fs_drv.open_cb = fs_open;
+    fs_drv.close_cb = fs_close;
+    fs_drv.read_cb = fs_read;
+    fs_drv.write_cb = fs_write;
+    fs_drv.seek_cb = fs_seek;
+    fs_drv.tell_cb = fs_tell;
+    fs_drv.dir_open_cb = fs_dir_open;
+    fs_drv.dir_read_cb = fs_dir_read;
+    fs_drv.dir_close_cb = fs_dir_close;
+    lv_fs_drv_register(&fs_drv);
+
+    ui_console_register('r', "S: drive sequential/random read MB/s vs stdio", ui_fs_bench);
+    ESP_LOGI(TAG, "S: %d x %d KB blocks, read-ahead %d", CONFIG_UI_FS_BLOCKS, CONFIG_UI_FS_BLOCK_KB,
+             CONFIG_UI_FS_READAHEAD);
+}
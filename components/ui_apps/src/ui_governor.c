@@ -0,0 +1,214 @@
+#include "ui_governor.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "hal_mgr.h"
+
+static const char *TAG = "ui_governor";
+
+// Idle thresholds (ms since last touch)
+#define GOV_IDLE_AFTER_MS       15000
+#define GOV_DIM_AFTER_MS        60000
+
+// Display refresh periods per mode
+#define GOV_IDLE_REFR_MS        100
+#define GOV_DIM_REFR_MS         250
+
+// Sampling period per mode - the governor's own timer backs off too
+#define GOV_SAMPLE_ACTIVE_MS    1000
+#define GOV_SAMPLE_IDLE_MS      5000
+
+// Backlight level while dimmed (percent)
+#define GOV_DIM_BRIGHTNESS      10
+
+#define GOV_MAX_TIMERS          8
+
+static lv_display_t *gov_disp = NULL;
+static lv_timer_t *refr_timer = NULL;
+static uint32_t refr_period_active = 0;
+static lv_timer_t *sample_timer = NULL;
+static ui_gov_mode_t gov_mode = UI_GOV_ACTIVE;
+static uint32_t last_activity_tick = 0;
+static uint8_t saved_brightness = 100;
+
+static lv_timer_t *paused_timers[GOV_MAX_TIMERS];
+static uint32_t paused_timer_count = 0;
+
+// Raw counters for the current sample window
+static uint32_t win_start_tick = 0;
+static uint32_t win_refr = 0;
+static uint32_t win_render = 0;
+static uint64_t win_busy_us = 0;
+static int64_t refr_start_us = 0;
+
+static ui_gov_stats_t last_stats;
+
+const char *ui_governor_mode_name(ui_gov_mode_t mode) {
+    switch (mode) {
+        case UI_GOV_ACTIVE: return "active";
+        case UI_GOV_IDLE:   return "idle";
+        case UI_GOV_DIM:    return "dim";
+    }
+    return "?";
+}
+
+static void set_registered_timers_paused(bool paused) {
+    for (uint32_t i = 0; i < paused_timer_count; i++) {
+        if (paused) {
+            lv_timer_pause(paused_timers[i]);
+        } else {
+            lv_timer_resume(paused_timers[i]);
+        }
+    }
+}
+
+static void enter_mode(ui_gov_mode_t mode) {
+    if (mode == gov_mode) return;
+    ui_gov_mode_t prev = gov_mode;
+    gov_mode = mode;
+
+    switch (mode) {
+        case UI_GOV_ACTIVE:
+            if (refr_timer) {
+                lv_timer_set_period(refr_timer, refr_period_active);
+                lv_timer_ready(refr_timer);   // Don't wait out the slow period
+            }
+            set_registered_timers_paused(false);
+            if (prev == UI_GOV_DIM) hal_mgr_set_brightness(saved_brightness);
+            if (sample_timer) lv_timer_set_period(sample_timer, GOV_SAMPLE_ACTIVE_MS);
+            break;
+        case UI_GOV_IDLE:
+            if (refr_timer) lv_timer_set_period(refr_timer, GOV_IDLE_REFR_MS);
+            set_registered_timers_paused(true);
+            if (sample_timer) lv_timer_set_period(sample_timer, GOV_SAMPLE_IDLE_MS);
+            break;
+        case UI_GOV_DIM:
+            if (refr_timer) lv_timer_set_period(refr_timer, GOV_DIM_REFR_MS);
+            set_registered_timers_paused(true);
+            saved_brightness = hal_mgr_get_brightness();
+            hal_mgr_set_brightness(GOV_DIM_BRIGHTNESS);
+            break;
+    }
+
+    ESP_LOGI(TAG, "Mode %s -> %s (last window: %lu refr/s, %lu renders/s, %lu us busy/s)",
+             ui_governor_mode_name(prev), ui_governor_mode_name(mode),
+             (unsigned long)last_stats.refr_wakeups_per_sec, (unsigned long)last_stats.renders_per_sec,
+             (unsigned long)last_stats.refr_busy_us_per_sec);
+}
+
+void ui_governor_notify_activity(void) {
+    last_activity_tick = lv_tick_get();
+    enter_mode(UI_GOV_ACTIVE);
+}
+
+// Any press on any pointer device ramps straight back to full rate
+static void indev_event_cb(lv_event_t *e) {
+    if (lv_event_get_code(e) == LV_EVENT_PRESSED) {
+        ui_governor_notify_activity();
+    }
+}
+
+static void disp_event_cb(lv_event_t *e) {
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_REFR_START:
+            win_refr++;
+            refr_start_us = esp_timer_get_time();
+            break;
+        case LV_EVENT_RENDER_START:
+            win_render++;
+            break;
+        case LV_EVENT_REFR_READY:
+            if (refr_start_us) {
+                win_busy_us += (uint64_t)(esp_timer_get_time() - refr_start_us);
+                refr_start_us = 0;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void sample_timer_cb(lv_timer_t *t) {
+    (void)t;
+    uint32_t elapsed = lv_tick_elaps(win_start_tick);
+    if (elapsed == 0) elapsed = 1;
+
+    last_stats.mode = gov_mode;
+    last_stats.refr_wakeups_per_sec = (uint32_t)((uint64_t)win_refr * 1000 / elapsed);
+    last_stats.renders_per_sec = (uint32_t)((uint64_t)win_render * 1000 / elapsed);
+    last_stats.refr_busy_us_per_sec = (uint32_t)(win_busy_us * 1000 / elapsed);
+
+    win_start_tick = lv_tick_get();
+    win_refr = 0;
+    win_render = 0;
+    win_busy_us = 0;
+
+    uint32_t idle = lv_tick_elaps(last_activity_tick);
+    last_stats.idle_ms = idle;
+
+    if (idle >= GOV_DIM_AFTER_MS) {
+        enter_mode(UI_GOV_DIM);
+    } else if (idle >= GOV_IDLE_AFTER_MS) {
+        enter_mode(UI_GOV_IDLE);
+    }
+}
+
+void ui_governor_init(void) {
+    if (sample_timer) return;
+
+    gov_disp = lv_display_get_default();
+    if (!gov_disp) {
+        ESP_LOGE(TAG, "No default display - governor disabled");
+        return;
+    }
+
+    refr_timer = lv_display_get_refr_timer(gov_disp);
+    refr_period_active = refr_timer ? lv_timer_get_period(refr_timer) : 0;
+    lv_display_add_event_cb(gov_disp, disp_event_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(gov_disp, disp_event_cb, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(gov_disp, disp_event_cb, LV_EVENT_REFR_READY, NULL);
+
+    for (lv_indev_t *indev = lv_indev_get_next(NULL); indev; indev = lv_indev_get_next(indev)) {
+        lv_indev_add_event_cb(indev, indev_event_cb, LV_EVENT_PRESSED, NULL);
+    }
+
+    last_activity_tick = lv_tick_get();
+    win_start_tick = last_activity_tick;
+    saved_brightness = hal_mgr_get_brightness();
+    sample_timer = lv_timer_create(sample_timer_cb, GOV_SAMPLE_ACTIVE_MS, NULL);
+
+    ESP_LOGI(TAG, "Governor started (refresh %lu ms active, idle after %d ms, dim after %d ms)",
+             (unsigned long)refr_period_active, GOV_IDLE_AFTER_MS, GOV_DIM_AFTER_MS);
+}
+
+void ui_governor_register_timer(lv_timer_t *timer) {
+    if (!timer) return;
+    for (uint32_t i = 0; i < paused_timer_count; i++) {
+        if (paused_timers[i] == timer) return;
+    }
+    if (paused_timer_count >= GOV_MAX_TIMERS) {
+        ESP_LOGW(TAG, "Timer table full, not governing timer %p", (void *)timer);
+        return;
+    }
+    paused_timers[paused_timer_count++] = timer;
+    if (gov_mode != UI_GOV_ACTIVE) lv_timer_pause(timer);
+}
+
+void ui_governor_unregister_timer(lv_timer_t *timer) {
+    for (uint32_t i = 0; i < paused_timer_count; i++) {
+        if (paused_timers[i] == timer) {
+            paused_timers[i] = paused_timers[--paused_timer_count];
+            return;
+        }
+    }
+}
+
+ui_gov_mode_t ui_governor_get_mode(void) {
+    return gov_mode;
+}
+
+void ui_governor_get_stats(ui_gov_stats_t *out) {
+    if (!out) return;
+    *out = last_stats;
+    out->mode = gov_mode;
+    out->idle_ms = lv_tick_elaps(last_activity_tick);
+}
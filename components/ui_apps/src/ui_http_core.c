@@ -0,0 +1,614 @@
+#include "ui_http_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define KEY_MAX     (HTTP_HOST_MAX + 8)     // "host:port"
+
+enum {
+    R_HEADERS = 0,
+    R_BODY_LEN,
+    R_BODY_CLOSE,               // No length: body runs until the connection closes
+    R_CHUNK_SIZE,
+    R_CHUNK_EXT,                // ";ext" after a chunk size, skipped
+    R_CHUNK_DATA,
+    R_CHUNK_CRLF,
+    R_TRAILER,
+    R_DONE,
+};
+
+// --- Response parser ---
+
+void http_resp_init(http_resp_t *r, bool head) {
+    memset(r, 0, offsetof(http_resp_t, hdr));
+    r->head = head;
+    r->hdr[0] = '\0';
+}
+
+bool http_resp_done(const http_resp_t *r) {
+    return r->state == R_DONE;
+}
+
+const char *http_resp_header(const http_resp_t *r, const char *name) {
+    if (!r->status) return NULL;
+    size_t n = strlen(name);
+    const char *p = r->hdr + strlen(r->hdr);     // Skip the status line
+    const char *end = r->hdr + r->hdr_len;
+    while (p < end) {
+        if (!*p) {
+            p++;
+            continue;
+        }
+        if (strncasecmp(p, name, n) == 0 && p[n] == ':') {
+            const char *v = p + n + 1;
+            while (*v == ' ' || *v == '\t') v++;
+            return v;
+        }
+        p += strlen(p);
+    }
+    return NULL;
+}
+
+// Chunked must be the last transfer coding
+static bool ends_with_chunked(const char *v) {
+    size_t n = strlen(v);
+    return n >= 7 && strcasecmp(v + n - 7, "chunked") == 0;
+}
+
+// Headers complete: split them into NUL-terminated lines and decide how the body is delimited
+static http_err_t end_headers(http_resp_t *r) {
+    for (uint16_t i = 0; i < r->hdr_len; i++) {
+        if (r->hdr[i] == '\r' || r->hdr[i] == '\n') r->hdr[i] = '\0';
+    }
+    for (uint16_t i = r->hdr_len; i > 0; i--) {
+        // Trailing blanks of each line
+        if ((r->hdr[i - 1] == ' ' || r->hdr[i - 1] == '\t') && !r->hdr[i]) r->hdr[i - 1] = '\0';
+    }
+    int minor, status;
+    if (sscanf(r->hdr, "HTTP/1.%d %3d", &minor, &status) != 2 || status < 100 || status > 999) {
+        return HTTP_ERR_PROTOCOL;
+    }
+    if (status < 200) {
+        // Interim response (100 Continue): the real one follows
+        r->hdr_len = 0;
+        return HTTP_OK;
+    }
+    r->status = status;
+    r->close = minor == 0;
+
+    const char *v = http_resp_header(r, "Connection");
+    if (v && strcasecmp(v, "close") == 0) r->close = true;
+    if (v && strcasecmp(v, "keep-alive") == 0) r->close = false;
+    v = http_resp_header(r, "Transfer-Encoding");
+    r->chunked = v && ends_with_chunked(v);
+    v = http_resp_header(r, "Content-Length");
+    if (v && !r->chunked) {
+        char *e;
+        unsigned long long len = strtoull(v, &e, 10);
+        if (e == v || *e) return HTTP_ERR_PROTOCOL;
+        r->has_len = true;
+        r->left = len;
+    }
+
+    if (r->head || status == 204 || status == 304 || (r->has_len && !r->left)) {
+        r->state = R_DONE;
+    } else if (r->chunked) {
+        r->state = R_CHUNK_SIZE;
+    } else if (r->has_len) {
+        r->state = R_BODY_LEN;
+    } else {
+        r->state = R_BODY_CLOSE;
+        r->close = true;
+    }
+    return HTTP_OK;
+}
+
+static int hex_digit(uint8_t c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    c |= 0x20;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+http_err_t http_resp_feed(http_resp_t *r, const uint8_t *data, size_t len, size_t *used, http_body_cb_t cb, void *arg) {
+    size_t i = 0;
+    http_err_t err = HTTP_OK;
+    while (i < len && r->state != R_DONE && err == HTTP_OK) {
+        switch (r->state) {
+        case R_HEADERS: {
+            if (r->hdr_len >= HTTP_HDR_MAX - 1) {
+                err = HTTP_ERR_PROTOCOL;
+                break;
+            }
+            char c = (char)data[i++];
+            r->hdr[r->hdr_len++] = c;
+            r->hdr[r->hdr_len] = '\0';
+            if (c != '\n') break;
+            // Blank line ends the headers (bare LF tolerated)
+            uint16_t n = r->hdr_len;
+            if ((n >= 4 && memcmp(r->hdr + n - 4, "\r\n\r\n", 4) == 0) ||
+                (n >= 2 && r->hdr[n - 2] == '\n')) {
+                err = end_headers(r);
+            }
+            break;
+        }
+        case R_BODY_LEN:
+        case R_BODY_CLOSE:
+        case R_CHUNK_DATA: {
+            size_t n = len - i;
+            if (r->state != R_BODY_CLOSE && n > r->left) n = (size_t)r->left;
+            if (cb && !cb(arg, data + i, n)) err = HTTP_ERR_ABORTED;
+            i += n;
+            r->body_len += (uint32_t)n;
+            if (r->state == R_BODY_CLOSE) break;
+            r->left -= n;
+            if (!r->left) r->state = r->state == R_BODY_LEN ? R_DONE : R_CHUNK_CRLF;
+            break;
+        }
+        case R_CHUNK_SIZE: {
+            uint8_t c = data[i++];
+            int d = hex_digit(c);
+            if (d >= 0) {
+                if (r->left >> 60) {
+                    err = HTTP_ERR_PROTOCOL;
+                    break;
+                }
+                r->left = r->left << 4 | (uint64_t)d;
+                r->line_len++;
+            } else if (c == ';' || c == ' ' || c == '\t') {
+                r->state = R_CHUNK_EXT;
+            } else if (c == '\n') {
+                if (!r->line_len) {
+                    err = HTTP_ERR_PROTOCOL;
+                    break;
+                }
+                r->state = r->left ? R_CHUNK_DATA : R_TRAILER;
+                r->line_len = 0;
+            } else if (c != '\r') {
+                err = HTTP_ERR_PROTOCOL;
+            }
+            break;
+        }
+        case R_CHUNK_EXT:
+            if (data[i++] != '\n') break;
+            if (!r->line_len) {
+                err = HTTP_ERR_PROTOCOL;
+                break;
+            }
+            r->state = r->left ? R_CHUNK_DATA : R_TRAILER;
+            r->line_len = 0;
+            break;
+        case R_CHUNK_CRLF: {
+            uint8_t c = data[i++];
+            if (c == '\n') {
+                r->state = R_CHUNK_SIZE;
+            } else if (c != '\r') {
+                err = HTTP_ERR_PROTOCOL;
+            }
+            break;
+        }
+        case R_TRAILER: {
+            uint8_t c = data[i++];
+            if (c == '\n') {
+                if (!r->line_len) r->state = R_DONE;
+                r->line_len = 0;
+            } else if (c != '\r') {
+                r->line_len++;
+            }
+            break;
+        }
+        }
+    }
+    *used = i;
+    return err;
+}
+
+http_err_t http_resp_eof(http_resp_t *r) {
+    if (r->state == R_BODY_CLOSE) r->state = R_DONE;
+    return r->state == R_DONE ? HTTP_OK : HTTP_ERR_IO;
+}
+
+http_err_t http_parse_url(const char *url, bool *tls, char *host, uint16_t *port, const char **path) {
+    const char *p;
+    if (strncmp(url, "https://", 8) == 0) {
+        *tls = true;
+        *port = 443;
+        p = url + 8;
+    } else if (strncmp(url, "http://", 7) == 0) {
+        *tls = false;
+        *port = 80;
+        p = url + 7;
+    } else {
+        return HTTP_ERR_URL;
+    }
+    size_t n = strcspn(p, ":/?#");
+    if (!n || n >= HTTP_HOST_MAX) return HTTP_ERR_URL;
+    memcpy(host, p, n);
+    host[n] = '\0';
+    p += n;
+    if (*p == ':') {
+        char *e;
+        unsigned long v = strtoul(p + 1, &e, 10);
+        if (e == p + 1 || !v || v > 65535) return HTTP_ERR_URL;
+        *port = (uint16_t)v;
+        p = e;
+    }
+    *path = p;
+    return HTTP_OK;
+}
+
+// --- Pool ---
+
+typedef struct {
+    void *conn;                 // Idle connection, NULL if the slot is free
+    char key[KEY_MAX];
+    bool tls;
+    uint64_t idle_since_us;
+} slot_t;
+
+typedef struct {
+    char key[KEY_MAX];          // Empty if unused
+    uint8_t *blob;
+    size_t len;
+    uint64_t used_us;
+} session_t;
+
+struct http_pool {
+    http_pool_config_t cfg;
+    http_backend_t be;
+    http_pool_stats_t stats;
+    slot_t *slots;
+    session_t *sessions;
+};
+
+// Receive buffer and parser of one request
+typedef struct {
+    http_resp_t resp;
+    uint8_t rx[HTTP_RX_BUF];
+} exchange_t;
+
+static uint64_t now_us(http_pool_t *p) {
+    return p->be.now_us(p->be.ctx);
+}
+
+static uint64_t cpu_us(http_pool_t *p) {
+    return p->be.cpu_us ? p->be.cpu_us(p->be.ctx) : 0;
+}
+
+http_pool_t *http_pool_create(const http_pool_config_t *cfg, const http_backend_t *be) {
+    http_pool_t *p = calloc(1, sizeof(http_pool_t));
+    if (!p) return NULL;
+    p->cfg = *cfg;
+    p->be = *be;
+    p->slots = cfg->slots ? calloc(cfg->slots, sizeof(slot_t)) : NULL;
+    p->sessions = cfg->sessions ? calloc(cfg->sessions, sizeof(session_t)) : NULL;
+    if ((cfg->slots && !p->slots) || (cfg->sessions && !p->sessions)) {
+        free(p->slots);
+        free(p->sessions);
+        free(p);
+        return NULL;
+    }
+    return p;
+}
+
+void http_pool_destroy(http_pool_t *p) {
+    if (!p) return;
+    http_pool_flush(p);
+    http_pool_forget_sessions(p);
+    free(p->slots);
+    free(p->sessions);
+    free(p);
+}
+
+void http_pool_flush(http_pool_t *p) {
+    p->be.lock(p->be.ctx);
+    for (uint8_t i = 0; i < p->cfg.slots; i++) {
+        if (!p->slots[i].conn) continue;
+        p->be.close(p->be.ctx, p->slots[i].conn);
+        p->slots[i].conn = NULL;
+    }
+    p->be.unlock(p->be.ctx);
+}
+
+// Take an idle connection for @p key, closing any that have been idle too long
+static void *take_idle(http_pool_t *p, const char *key, bool tls) {
+    void *conn = NULL;
+    uint64_t now = now_us(p);
+    p->be.lock(p->be.ctx);
+    for (uint8_t i = 0; i < p->cfg.slots; i++) {
+        slot_t *s = &p->slots[i];
+        if (!s->conn) continue;
+        if (now - s->idle_since_us > (uint64_t)p->cfg.idle_ms * 1000) {
+            p->be.close(p->be.ctx, s->conn);
+            s->conn = NULL;
+        } else if (!conn && s->tls == tls && strcmp(s->key, key) == 0) {
+            conn = s->conn;
+            s->conn = NULL;
+        }
+    }
+    p->be.unlock(p->be.ctx);
+    return conn;
+}
+
+uint32_t http_pool_expire(http_pool_t *p) {
+    uint64_t now = now_us(p), limit = (uint64_t)p->cfg.idle_ms * 1000, next = UINT64_MAX;
+    p->be.lock(p->be.ctx);
+    for (uint8_t i = 0; i < p->cfg.slots; i++) {
+        slot_t *s = &p->slots[i];
+        if (!s->conn) continue;
+        uint64_t age = now - s->idle_since_us;
+        if (age > limit) {
+            p->be.close(p->be.ctx, s->conn);
+            s->conn = NULL;
+        } else if (limit - age < next) {
+            next = limit - age;
+        }
+    }
+    p->be.unlock(p->be.ctx);
+    return next == UINT64_MAX ? 0 : (uint32_t)(next / 1000) + 1;
+}
+
+// Before connecting with every slot taken, close the longest idle connection so at most
+// slots connections (plus those in use) are open at once
+static void make_room(http_pool_t *p) {
+    void *evicted = NULL;
+    p->be.lock(p->be.ctx);
+    slot_t *oldest = NULL;
+    for (uint8_t i = 0; i < p->cfg.slots; i++) {
+        slot_t *s = &p->slots[i];
+        if (!s->conn) {
+            oldest = NULL;
+            break;
+        }
+        if (!oldest || s->idle_since_us < oldest->idle_since_us) oldest = s;
+    }
+    if (oldest) {
+        evicted = oldest->conn;
+        oldest->conn = NULL;
+    }
+    p->be.unlock(p->be.ctx);
+    if (evicted) p->be.close(p->be.ctx, evicted);
+}
+
+// Pool a connection whose response completed, evicting the longest idle one if full
+static void release(http_pool_t *p, void *conn, const char *key, bool tls) {
+    void *evicted = NULL;
+    p->be.lock(p->be.ctx);
+    slot_t *s = NULL;
+    for (uint8_t i = 0; i < p->cfg.slots; i++) {
+        slot_t *c = &p->slots[i];
+        if (!c->conn) {
+            s = c;
+            break;
+        }
+        if (!s || c->idle_since_us < s->idle_since_us) s = c;
+    }
+    if (s) {
+        evicted = s->conn;
+        s->conn = conn;
+        s->tls = tls;
+        snprintf(s->key, sizeof(s->key), "%s", key);
+        s->idle_since_us = now_us(p);
+    } else {
+        evicted = conn;
+    }
+    p->be.unlock(p->be.ctx);
+    if (evicted) p->be.close(p->be.ctx, evicted);
+}
+
+static void put_session(http_pool_t *p, const char *key, const uint8_t *blob, size_t len) {
+    session_t *s = NULL;
+    for (uint8_t i = 0; i < p->cfg.sessions; i++) {
+        session_t *c = &p->sessions[i];
+        if (strcmp(c->key, key) == 0) {
+            s = c;
+            break;
+        }
+        if (!s || (s->key[0] && (!c->key[0] || c->used_us < s->used_us))) s = c;
+    }
+    if (!s) return;
+    uint8_t *copy = malloc(len);
+    if (!copy) return;
+    memcpy(copy, blob, len);
+    free(s->blob);
+    s->blob = copy;
+    s->len = len;
+    s->used_us = now_us(p);
+    snprintf(s->key, sizeof(s->key), "%s", key);
+}
+
+void http_pool_put_session(http_pool_t *p, const char *key, const uint8_t *blob, size_t len) {
+    if (!len || len > HTTP_SESSION_MAX) return;
+    p->be.lock(p->be.ctx);
+    put_session(p, key, blob, len);
+    p->be.unlock(p->be.ctx);
+}
+
+void http_pool_forget_sessions(http_pool_t *p) {
+    p->be.lock(p->be.ctx);
+    for (uint8_t i = 0; i < p->cfg.sessions; i++) {
+        free(p->sessions[i].blob);
+        memset(&p->sessions[i], 0, sizeof(session_t));
+    }
+    p->be.unlock(p->be.ctx);
+}
+
+// Copy of the session saved for @p key (caller frees), NULL if none
+static uint8_t *get_session(http_pool_t *p, const char *key, size_t *len) {
+    uint8_t *copy = NULL;
+    p->be.lock(p->be.ctx);
+    for (uint8_t i = 0; i < p->cfg.sessions; i++) {
+        session_t *s = &p->sessions[i];
+        if (strcmp(s->key, key) != 0) continue;
+        copy = malloc(s->len);
+        if (copy) {
+            memcpy(copy, s->blob, s->len);
+            *len = s->len;
+            s->used_us = now_us(p);
+        }
+        break;
+    }
+    p->be.unlock(p->be.ctx);
+    return copy;
+}
+
+static void remember_session(http_pool_t *p, void *conn, const char *key) {
+    if (!p->cfg.sessions) return;
+    uint8_t *buf = malloc(HTTP_SESSION_MAX);
+    if (!buf) return;
+    size_t len = p->be.save_session(p->be.ctx, conn, buf, HTTP_SESSION_MAX);
+    if (len) {
+        http_pool_put_session(p, key, buf, len);
+        if (p->be.session_saved) p->be.session_saved(p->be.ctx, key, buf, len);
+    }
+    free(buf);
+}
+
+static void *open_conn(http_pool_t *p, const char *host, uint16_t port, bool tls, const char *key,
+                       http_result_t *r) {
+    size_t slen = 0;
+    uint8_t *sess = tls ? get_session(p, key, &slen) : NULL;
+    bool resumed = false;
+    uint64_t t0 = now_us(p), c0 = cpu_us(p);
+    void *conn = p->be.connect(p->be.ctx, host, port, tls, sess, slen, &resumed);
+    uint64_t dt = now_us(p) - t0;
+    uint32_t dc = (uint32_t)(cpu_us(p) - c0);   // Backend counters may be 32-bit and wrap
+    free(sess);
+    if (!conn || !tls) return conn;
+
+    r->handshake = resumed ? HTTP_HS_RESUMED : HTTP_HS_FULL;
+    r->handshake_us = (uint32_t)dt;
+    r->handshake_cpu_us = dc;
+    p->be.lock(p->be.ctx);
+    if (resumed) {
+        p->stats.resumed++;
+    } else {
+        p->stats.full++;
+    }
+    p->stats.handshake_us[resumed] += dt;
+    p->stats.handshake_cpu_us[resumed] += dc;
+    p->be.unlock(p->be.ctx);
+    return conn;
+}
+
+// Send the request and parse the response; *got_any is set once a response byte arrived
+static http_err_t exchange(http_pool_t *p, void *conn, const char *req, size_t req_len, uint32_t timeout_ms,
+                           exchange_t *x, http_body_cb_t on_body, void *arg, bool *got_any) {
+    for (size_t off = 0; off < req_len;) {
+        int n = p->be.send(p->be.ctx, conn, req + off, req_len - off);
+        if (n <= 0) return HTTP_ERR_IO;
+        off += (size_t)n;
+    }
+    for (;;) {
+        int n = p->be.recv(p->be.ctx, conn, x->rx, sizeof(x->rx), timeout_ms);
+        if (n < 0) return HTTP_ERR_IO;
+        if (n == 0) {
+            x->resp.close = true;
+            return http_resp_eof(&x->resp);
+        }
+        *got_any = true;
+        size_t used;
+        http_err_t err = http_resp_feed(&x->resp, x->rx, (size_t)n, &used, on_body, arg);
+        if (err != HTTP_OK) return err;
+        if (used < (size_t)n) x->resp.close = true;  // Bytes past the response: not reusable
+        if (http_resp_done(&x->resp)) return HTTP_OK;
+    }
+}
+
+static http_err_t request(http_pool_t *p, const char *url, const char *headers, uint32_t timeout_ms,
+                          http_body_cb_t on_body, void *arg, http_result_t *res) {
+    http_result_t r = { 0 };
+    uint64_t t0 = now_us(p);
+    bool tls;
+    char host[HTTP_HOST_MAX], key[KEY_MAX];
+    uint16_t port;
+    const char *path;
+    exchange_t *x = NULL;
+    char *req = NULL;
+
+    http_err_t err = http_parse_url(url, &tls, host, &port, &path);
+    if (err != HTTP_OK) goto out;
+    snprintf(key, sizeof(key), "%s:%u", host, port);
+
+    size_t cap = strlen(path) + strlen(host) + (headers ? strlen(headers) : 0) + 128;
+    req = malloc(cap);
+    x = malloc(sizeof(exchange_t));
+    if (!req || !x) {
+        err = HTTP_ERR_NO_MEM;
+        goto out;
+    }
+    char port_str[8] = "";
+    if (port != (tls ? 443 : 80)) snprintf(port_str, sizeof(port_str), ":%u", port);
+    int req_len = snprintf(req, cap, "GET %s%s HTTP/1.1\r\nHost: %s%s\r\nUser-Agent: ui_apps\r\n%s\r\n",
+                           *path == '/' ? "" : "/", path, host, port_str, headers ? headers : "");
+
+    for (int attempt = 0;; attempt++) {
+        void *conn = take_idle(p, key, tls);
+        bool pooled = conn != NULL;
+        if (!conn) make_room(p);
+        if (!conn && !(conn = open_conn(p, host, port, tls, key, &r))) {
+            err = HTTP_ERR_CONNECT;
+            break;
+        }
+        http_resp_init(&x->resp, false);
+        bool got_any = false;
+        err = exchange(p, conn, req, (size_t)req_len, timeout_ms, x, on_body, arg, &got_any);
+        if (err == HTTP_ERR_IO && pooled && !got_any && attempt == 0) {
+            // The server closed it while it was pooled; nothing was delivered, so try a new one
+            p->be.close(p->be.ctx, conn);
+            p->be.lock(p->be.ctx);
+            p->stats.retries++;
+            p->be.unlock(p->be.ctx);
+            continue;
+        }
+        // Streams usually end with the connection dropping; the session is as good
+        if ((err == HTTP_OK || got_any) && r.handshake == HTTP_HS_FULL) remember_session(p, conn, key);
+        if (err == HTTP_OK && !x->resp.close && p->cfg.slots) {
+            release(p, conn, key, tls);
+        } else {
+            p->be.close(p->be.ctx, conn);
+        }
+        if (pooled) {
+            p->be.lock(p->be.ctx);
+            p->stats.reused++;
+            p->be.unlock(p->be.ctx);
+        }
+        r.status = x->resp.status;
+        r.body_len = x->resp.body_len;
+        break;
+    }
+
+out:
+    free(req);
+    free(x);
+    r.total_us = (uint32_t)(now_us(p) - t0);
+    p->be.lock(p->be.ctx);
+    p->stats.requests++;
+    if (err != HTTP_OK) p->stats.errors++;
+    p->be.unlock(p->be.ctx);
+    if (res) *res = r;
+    return err;
+}
+
+http_err_t http_get(http_pool_t *p, const char *url, const char *headers, http_body_cb_t on_body, void *arg,
+                    http_result_t *res) {
+    return request(p, url, headers, p->cfg.timeout_ms, on_body, arg, res);
+}
+
+http_err_t http_stream(http_pool_t *p, const char *url, const char *headers, uint32_t idle_ms, http_body_cb_t on_body,
+                       void *arg, http_result_t *res) {
+    return request(p, url, headers, idle_ms, on_body, arg, res);
+}
+
+void http_pool_get_stats(http_pool_t *p, http_pool_stats_t *out) {
+    p->be.lock(p->be.ctx);
+    *out = p->stats;
+    p->be.unlock(p->be.ctx);
+}
+
+void http_pool_reset_stats(http_pool_t *p) {
+    p->be.lock(p->be.ctx);
+    memset(&p->stats, 0, sizeof(p->stats));
+    p->be.unlock(p->be.ctx);
+}
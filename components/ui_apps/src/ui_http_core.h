@@ -0,0 +1,201 @@
+#pragma once
+
+/**
+ * HTTP/1.1 GET client with a keep-alive connection pool and a TLS session
+ * cache, independent of ESP-IDF.
+ *
+ * Each request first looks for an idle connection to the same host and
+ * port and only opens a new one if there is none (or the idle one has been
+ * pooled longer than idle_ms, when servers typically drop it). New TLS
+ * connections offer the last session saved for that host, so the server
+ * can resume it with an abbreviated handshake: no certificate chain to
+ * verify and no key exchange, which is most of a handshake's CPU time and
+ * peak RAM. Sessions come from full handshakes and are also handed to
+ * session_saved() so the caller can keep them across reboots.
+ *
+ * A request on a pooled connection that the server already closed is
+ * retried once on a new connection. Responses are parsed as they arrive
+ * (Content-Length, chunked or until close) and the body is passed to the
+ * caller in slices of the receive buffer, without copying.
+ *
+ * Transport and clock come from a backend: ui_net.c provides mbedtls with
+ * the certificate bundle, tools/tls_bench.c provides OpenSSL against a
+ * local server.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HTTP_HOST_MAX       64      // Longest host name
+#define HTTP_HDR_MAX        1024    // Status line and headers of a response must fit
+#define HTTP_RX_BUF         2048    // Receive buffer per request
+#define HTTP_SESSION_MAX    3072    // Largest saved TLS session (includes the server certificate)
+
+typedef enum {
+    HTTP_OK = 0,
+    HTTP_ERR_URL = -1,          // Not http:// or https://, or host too long
+    HTTP_ERR_CONNECT = -2,      // TCP or TLS setup failed
+    HTTP_ERR_IO = -3,           // Connection dropped mid-response
+    HTTP_ERR_PROTOCOL = -4,     // Malformed response, or headers over HTTP_HDR_MAX
+    HTTP_ERR_ABORTED = -5,      // Body callback returned false
+    HTTP_ERR_NO_MEM = -6,
+} http_err_t;
+
+typedef enum {
+    HTTP_HS_NONE = 0,           // Pooled connection reused (or plain HTTP)
+    HTTP_HS_FULL,
+    HTTP_HS_RESUMED,            // Abbreviated handshake from a saved session
+} http_handshake_t;
+
+typedef struct {
+    // Connect, offering @p session (NULL for none) if @p tls; NULL on failure.
+    // Sets *resumed when the server accepted the session.
+    void *(*connect)(void *ctx, const char *host, uint16_t port, bool tls, const uint8_t *session,
+                     size_t session_len, bool *resumed);
+    // Bytes sent / received, 0 when the peer closed, < 0 on error
+    int (*send)(void *ctx, void *conn, const void *buf, size_t len);
+    // Waits up to @p timeout_ms for data; a timeout is an error
+    int (*recv)(void *ctx, void *conn, void *buf, size_t len, uint32_t timeout_ms);
+    // Serialise the connection's TLS session; its length, 0 if there is none
+    size_t (*save_session)(void *ctx, void *conn, uint8_t *buf, size_t cap);
+    void (*close)(void *ctx, void *conn);
+    // A new session for @p key ("host:port") was saved; NULL if not persisted
+    void (*session_saved)(void *ctx, const char *key, const uint8_t *blob, size_t len);
+    void (*lock)(void *ctx);
+    void (*unlock)(void *ctx);
+    uint64_t (*now_us)(void *ctx);
+    // CPU time of the calling task; NULL if not available
+    uint64_t (*cpu_us)(void *ctx);
+    void *ctx;
+} http_backend_t;
+
+typedef struct {
+    uint8_t slots;              // Idle connections kept, 0 = close after each request
+    uint8_t sessions;           // Hosts whose TLS session is kept, 0 = never resume
+    uint32_t idle_ms;           // Pooled connections older than this are closed, not reused
+    uint32_t timeout_ms;        // Longest wait for response bytes in http_get()
+} http_pool_config_t;
+
+typedef struct {
+    uint32_t requests;
+    uint32_t reused;            // Served on a pooled connection
+    uint32_t full, resumed;     // Handshakes
+    uint32_t retries;           // Pooled connection found closed
+    uint32_t errors;
+    uint64_t handshake_us[2];   // Wall time of full / resumed handshakes (TCP connect included)
+    uint64_t handshake_cpu_us[2];
+} http_pool_stats_t;
+
+typedef struct {
+    int status;                 // HTTP status, 0 if none was received
+    uint32_t body_len;
+    http_handshake_t handshake;
+    uint32_t handshake_us, handshake_cpu_us;
+    uint32_t total_us;
+} http_result_t;
+
+// Receives the body in order; return false to stop the transfer
+typedef bool (*http_body_cb_t)(void *arg, const uint8_t *data, size_t len);
+
+/**
+ * @brief Incremental response parser (used by http_get(); exposed for streams)
+ */
+typedef struct {
+    uint8_t state;
+    bool head;                  // No body expected (HEAD, 1xx, 204, 304)
+    bool chunked, has_len, close;
+    int status;
+    uint64_t left;              // Body or chunk bytes still to come
+    uint32_t body_len;
+    uint16_t hdr_len;
+    uint16_t line_len;          // Chunk size and trailer lines
+    char hdr[HTTP_HDR_MAX];
+} http_resp_t;
+
+void http_resp_init(http_resp_t *r, bool head);
+
+/**
+ * @brief Parse the next @p len received bytes
+ * @param used Set to the bytes consumed; less than @p len only once the response is complete
+ * @return HTTP_OK, HTTP_ERR_PROTOCOL or HTTP_ERR_ABORTED
+ */
+http_err_t http_resp_feed(http_resp_t *r, const uint8_t *data, size_t len, size_t *used, http_body_cb_t cb, void *arg);
+
+/**
+ * @brief The connection closed; completes a response delimited by close
+ */
+http_err_t http_resp_eof(http_resp_t *r);
+
+bool http_resp_done(const http_resp_t *r);
+
+/**
+ * @brief Value of response header @p name (case-insensitive), NUL-terminated; NULL if absent
+ */
+const char *http_resp_header(const http_resp_t *r, const char *name);
+
+/**
+ * @brief Split an http:// or https:// URL; @p host holds HTTP_HOST_MAX bytes
+ * @return HTTP_OK or HTTP_ERR_URL
+ */
+http_err_t http_parse_url(const char *url, bool *tls, char *host, uint16_t *port, const char **path);
+
+typedef struct http_pool http_pool_t;
+
+http_pool_t *http_pool_create(const http_pool_config_t *cfg, const http_backend_t *be);
+
+/**
+ * @brief Close pooled connections and free the pool; no request may be running
+ */
+void http_pool_destroy(http_pool_t *p);
+
+/**
+ * @brief GET @p url and stream the body to @p on_body
+ * @param headers Extra request headers, each ending in "\r\n" (may be NULL)
+ * @param res Filled whether or not the request succeeds (may be NULL)
+ * @return HTTP_OK once the whole response was received, whatever its status
+ */
+http_err_t http_get(http_pool_t *p, const char *url, const char *headers, http_body_cb_t on_body, void *arg,
+                    http_result_t *res);
+
+/**
+ * @brief As http_get() for a response that stays open and trickles in (a
+ *        Server-Sent Events stream), waiting up to @p idle_ms between bytes
+ * Returns when the server ends the response, the connection drops or
+ * @p on_body returns false.
+ */
+http_err_t http_stream(http_pool_t *p, const char *url, const char *headers, uint32_t idle_ms, http_body_cb_t on_body,
+                       void *arg, http_result_t *res);
+
+/**
+ * @brief Close every idle pooled connection (before Wi-Fi goes down, say)
+ */
+void http_pool_flush(http_pool_t *p);
+
+/**
+ * @brief Close pooled connections idle longer than idle_ms
+ * Pooled connections hold their TLS buffers, so call this when it says.
+ * @return Milliseconds until the next one expires, 0 if none is pooled
+ */
+uint32_t http_pool_expire(http_pool_t *p);
+
+/**
+ * @brief Seed the session cache, e.g. with sessions persisted by session_saved()
+ */
+void http_pool_put_session(http_pool_t *p, const char *key, const uint8_t *blob, size_t len);
+
+/**
+ * @brief Drop every saved session
+ */
+void http_pool_forget_sessions(http_pool_t *p);
+
+void http_pool_get_stats(http_pool_t *p, http_pool_stats_t *out);
+void http_pool_reset_stats(http_pool_t *p);
+
+#ifdef __cplusplus
+}
+#endif
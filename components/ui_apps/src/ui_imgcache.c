@@ -0,0 +1,305 @@
+#include "ui_imgcache.h"
+#include "ui_console.h"
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include <dirent.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <utime.h>
+
+static const char *TAG = "ui_imgcache";
+
+#define TRAILER_MAGIC   0x43494955u         // "UIIC"
+#define INDEX_GROW      64
+#define VALID_TIME      1704067200          // 2024-01-01: before this the clock isn't set
+#define NAME_MAX_LEN    80
+
+// Appended after the pixels; LVGL's binary image decoder ignores it
+typedef struct {
+    uint32_t magic;
+    uint16_t src_w, src_h;
+    int16_t x1, y1, x2, y2;
+    uint32_t decode_ms;
+} trailer_t;
+
+typedef struct {
+    uint32_t hash;                  // Source path, size and mtime
+    uint16_t w, h;
+    uint8_t cf;
+    uint32_t size;                  // File bytes
+    uint32_t used;                  // LRU stamp: file mtime after the scan, then a running counter
+} entry_t;
+
+static ui_imgcache_stats_t stats;
+
+#if CONFIG_UI_IMAGE_CACHE
+
+#define CACHE_DIR       CONFIG_UI_IMAGE_CACHE_DIR
+#define BUDGET          ((uint64_t)CONFIG_UI_IMAGE_CACHE_MB * 1024 * 1024)
+
+// Worker-only state
+static entry_t *index_ = NULL;
+static uint32_t count = 0, capacity = 0;
+static uint32_t clock_ = 0;
+static bool scanned = false;
+
+static uint32_t fnv1a(uint32_t h, const void *data, size_t len) {
+    const uint8_t *p = data;
+    while (len--) h = (h ^ *p++) * 16777619u;
+    return h;
+}
+
+static bool source_hash(const char *src, uint32_t *hash) {
+    struct stat st;
+    if (stat(src, &st) != 0) return false;
+    uint32_t h = fnv1a(2166136261u, src, strlen(src));
+    uint64_t size = (uint64_t)st.st_size, mtime = (uint64_t)st.st_mtime;
+    h = fnv1a(h, &size, sizeof(size));
+    *hash = fnv1a(h, &mtime, sizeof(mtime));
+    return true;
+}
+
+static void entry_path(const entry_t *e, char *buf, size_t len, const char *suffix) {
+    snprintf(buf, len, "%s/%08lx_%ux%u_%02x.%s", CACHE_DIR, (unsigned long)e->hash, e->w, e->h, e->cf, suffix);
+}
+
+static entry_t *find(uint32_t hash, uint16_t w, uint16_t h, uint8_t cf) {
+    for (uint32_t i = 0; i < count; i++) {
+        entry_t *e = &index_[i];
+        if (e->hash == hash && e->w == w && e->h == h && e->cf == cf) return e;
+    }
+    return NULL;
+}
+
+static bool append(const entry_t *e) {
+    if (count == capacity) {
+        entry_t *grown = heap_caps_realloc(index_, (capacity + INDEX_GROW) * sizeof(entry_t), MALLOC_CAP_SPIRAM);
+        if (!grown) return false;
+        index_ = grown;
+        capacity += INDEX_GROW;
+    }
+    index_[count++] = *e;
+    stats.files = count;
+    stats.bytes += e->size;
+    return true;
+}
+
+// Deletes the file too; e points into the index and is invalid afterwards
+static void remove_entry(entry_t *e) {
+    char path[NAME_MAX_LEN];
+    entry_path(e, path, sizeof(path), "bin");
+    unlink(path);
+    stats.bytes -= e->size;
+    *e = index_[--count];
+    stats.files = count;
+}
+
+// Rebuild the index from the folder, once per boot (the card may be mounted late)
+static bool ready(void) {
+    if (scanned) return true;
+    if (mkdir(CACHE_DIR, 0775) != 0 && errno != EEXIST) return false;
+    DIR *dir = opendir(CACHE_DIR);
+    if (!dir) return false;
+
+    struct dirent *de;
+    char path[NAME_MAX_LEN];
+    while ((de = readdir(dir)) != NULL) {
+        entry_t e = { 0 };
+        unsigned long hash;
+        unsigned w, h, cf;
+        char ext[4];
+        snprintf(path, sizeof(path), "%s/%s", CACHE_DIR, de->d_name);
+        if (sscanf(de->d_name, "%8lx_%ux%u_%2x.%3s", &hash, &w, &h, &cf, ext) != 5) continue;
+        if (strcmp(ext, "bin") != 0) {
+            unlink(path);               // Store interrupted by a reset or card removal
+            continue;
+        }
+        struct stat st;
+        if (stat(path, &st) != 0) continue;
+        e.hash = (uint32_t)hash;
+        e.w = (uint16_t)w;
+        e.h = (uint16_t)h;
+        e.cf = (uint8_t)cf;
+        e.size = (uint32_t)st.st_size;
+        e.used = (uint32_t)st.st_mtime;
+        if (e.used > clock_) clock_ = e.used;
+        if (!append(&e)) break;
+    }
+    closedir(dir);
+    scanned = true;
+    ESP_LOGI(TAG, "%lu entries, %llu KB in %s", (unsigned long)count, (unsigned long long)(stats.bytes / 1024), CACHE_DIR);
+    return true;
+}
+
+static void touch(entry_t *e) {
+    e->used = ++clock_;
+    // Carry the order across reboots through the mtime, once SNTP has set the clock
+    if (time(NULL) > VALID_TIME) {
+        char path[NAME_MAX_LEN];
+        entry_path(e, path, sizeof(path), "bin");
+        utime(path, NULL);
+    }
+}
+
+static void evict_for(uint32_t size) {
+    while (count && stats.bytes + size > BUDGET) {
+        entry_t *lru = &index_[0];
+        for (uint32_t i = 1; i < count; i++) {
+            if (index_[i].used < lru->used) lru = &index_[i];
+        }
+        remove_entry(lru);
+        stats.evictions++;
+    }
+}
+
+#endif // CONFIG_UI_IMAGE_CACHE
+
+FILE *ui_imgcache_open(const char *src, const lv_draw_buf_t *dst, ui_imgcache_meta_t *meta) {
+#if CONFIG_UI_IMAGE_CACHE
+    uint32_t hash;
+    entry_t *e = ready() && source_hash(src, &hash) ? find(hash, dst->header.w, dst->header.h, dst->header.cf) : NULL;
+    if (!e) {
+        stats.misses++;
+        return NULL;
+    }
+
+    char path[NAME_MAX_LEN];
+    entry_path(e, path, sizeof(path), "bin");
+    FILE *f = fopen(path, "rb");
+    lv_image_header_t hdr;
+    trailer_t tr;
+    uint32_t data = (uint32_t)dst->header.w * lv_color_format_get_size(dst->header.cf) * dst->header.h;
+    bool ok = f && fread(&hdr, sizeof(hdr), 1, f) == 1 && hdr.magic == LV_IMAGE_HEADER_MAGIC &&
+              hdr.cf == dst->header.cf && hdr.w == dst->header.w && hdr.h == dst->header.h &&
+              fseek(f, sizeof(hdr) + data, SEEK_SET) == 0 && fread(&tr, sizeof(tr), 1, f) == 1 &&
+              tr.magic == TRAILER_MAGIC && fseek(f, sizeof(hdr), SEEK_SET) == 0;
+    if (!ok) {
+        ESP_LOGW(TAG, "%s: bad cache file, dropped", path);
+        if (f) fclose(f);
+        remove_entry(e);
+        stats.misses++;
+        return NULL;
+    }
+    touch(e);
+    meta->src_w = tr.src_w;
+    meta->src_h = tr.src_h;
+    meta->area = (lv_area_t){ tr.x1, tr.y1, tr.x2, tr.y2 };
+    meta->decode_ms = tr.decode_ms;
+    return f;
+#else
+    return NULL;
+#endif
+}
+
+void ui_imgcache_close(FILE *f, const char *src, const lv_draw_buf_t *dst, const ui_imgcache_meta_t *meta,
+                       uint32_t load_ms, bool ok) {
+    fclose(f);
+#if CONFIG_UI_IMAGE_CACHE
+    if (ok) {
+        stats.hits++;
+        stats.hit_decode_ms += meta->decode_ms;
+        stats.hit_load_ms += load_ms;
+        return;
+    }
+    stats.misses++;
+    uint32_t hash;
+    entry_t *e = source_hash(src, &hash) ? find(hash, dst->header.w, dst->header.h, dst->header.cf) : NULL;
+    if (e) remove_entry(e);
+#endif
+}
+
+void ui_imgcache_store(const char *src, const lv_draw_buf_t *img, const ui_imgcache_meta_t *meta) {
+#if CONFIG_UI_IMAGE_CACHE
+    uint32_t hash;
+    if (!ready() || !source_hash(src, &hash)) return;
+
+    uint32_t row = (uint32_t)img->header.w * lv_color_format_get_size(img->header.cf);
+    entry_t e = {
+        .hash = hash,
+        .w = (uint16_t)img->header.w,
+        .h = (uint16_t)img->header.h,
+        .cf = (uint8_t)img->header.cf,
+        .size = sizeof(lv_image_header_t) + row * img->header.h + sizeof(trailer_t),
+    };
+    if (e.size > BUDGET) return;
+    entry_t *old = find(e.hash, e.w, e.h, e.cf);
+    if (old) remove_entry(old);
+    evict_for(e.size);
+
+    // Written under a temporary name, so a reset mid-write never leaves a short .bin
+    char tmp[NAME_MAX_LEN], path[NAME_MAX_LEN];
+    entry_path(&e, tmp, sizeof(tmp), "tmp");
+    entry_path(&e, path, sizeof(path), "bin");
+    FILE *f = fopen(tmp, "wb");
+    if (!f) {
+        ESP_LOGW(TAG, "%s: can't create", tmp);
+        return;
+    }
+    lv_image_header_t hdr = {
+        .magic = LV_IMAGE_HEADER_MAGIC,
+        .cf = e.cf,
+        .w = e.w,
+        .h = e.h,
+        .stride = row,
+    };
+    trailer_t tr = {
+        .magic = TRAILER_MAGIC,
+        .src_w = meta->src_w,
+        .src_h = meta->src_h,
+        .x1 = (int16_t)meta->area.x1,
+        .y1 = (int16_t)meta->area.y1,
+        .x2 = (int16_t)meta->area.x2,
+        .y2 = (int16_t)meta->area.y2,
+        .decode_ms = meta->decode_ms,
+    };
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+    if (ok && img->header.stride == row) {
+        ok = fwrite(img->data, row, e.h, f) == e.h;
+    } else {
+        for (uint16_t y = 0; ok && y < e.h; y++) ok = fwrite(img->data + y * img->header.stride, row, 1, f) == 1;
+    }
+    ok = ok && fwrite(&tr, sizeof(tr), 1, f) == 1;
+    ok = fclose(f) == 0 && ok;
+    if (!ok || rename(tmp, path) != 0) {
+        ESP_LOGW(TAG, "%s: write failed (card full?)", path);
+        unlink(tmp);
+        return;
+    }
+    e.used = ++clock_;
+    if (append(&e)) stats.stores++;
+    ESP_LOGD(TAG, "stored %s (%lu bytes) for %s", path, (unsigned long)e.size, src);
+#endif
+}
+
+void ui_imgcache_get_stats(ui_imgcache_stats_t *out) {
+    *out = stats;
+}
+
+void ui_imgcache_report(FILE *out) {
+#if CONFIG_UI_IMAGE_CACHE
+    ui_imgcache_stats_t s = stats;
+    uint32_t lookups = s.hits + s.misses;
+    fprintf(out, "Image cache %s: %lu files, %llu of %u KB\n", CACHE_DIR, (unsigned long)s.files,
+            (unsigned long long)(s.bytes / 1024), CONFIG_UI_IMAGE_CACHE_MB * 1024);
+    fprintf(out, "  %lu hits, %lu misses (%lu%% hit rate), %lu stores, %lu evictions\n", (unsigned long)s.hits,
+            (unsigned long)s.misses, (unsigned long)(lookups ? s.hits * 100 / lookups : 0), (unsigned long)s.stores,
+            (unsigned long)s.evictions);
+    if (s.hits) {
+        int64_t saved = (int64_t)s.hit_decode_ms - (int64_t)s.hit_load_ms;
+        fprintf(out, "  decode time saved %lld ms (hits load in %llu ms on average, decoding took %llu ms)\n",
+                (long long)saved, (unsigned long long)(s.hit_load_ms / s.hits),
+                (unsigned long long)(s.hit_decode_ms / s.hits));
+    }
+#else
+    fprintf(out, "Image cache disabled (CONFIG_UI_IMAGE_CACHE)\n");
+#endif
+}
+
+void ui_imgcache_init(void) {
+    ui_console_register('i', "image cache hit rate and decode time saved", ui_imgcache_report);
+}
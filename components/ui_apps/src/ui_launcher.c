@@ -1,67 +1,28 @@
 #include "ui_launcher.h"
-#include "ui_maze.h"
-#include "ui_sports.h"
-#include "ui_weather.h"
+#include "ui_assets.h"
+#include "ui_app.h"
 #include "ui_private.h"
-#include "esp_log.h"
+#define UI_LOG_LEVEL CONFIG_UI_LOG_LEVEL_LAUNCHER
+#include "ui_log.h"
 
-#include "wifi_mgr.h"
-#include <time.h>
-#include <sys/time.h>
+#include "ui_status_bar.h"
+#include "ui_trace.h"
+#include "ui_arena.h"
 
 static const char *TAG = "ui_launcher";
 
 static lv_obj_t *launcher_screen = NULL;
-static lv_obj_t * lbl_header_time = NULL;
-static lv_obj_t * lbl_header_wifi = NULL;
-static lv_timer_t * status_timer = NULL;
-
-static void status_bar_timer_cb(lv_timer_t * t) {
-    if (!lbl_header_time || !lbl_header_wifi) return;
-    
-    // Update Time
-    time_t now;
-    struct tm timeinfo;
-    time(&now);
-    localtime_r(&now, &timeinfo);
-    
-    // Check WiFi connection first, then time sync status
-    if (!wifi_mgr_is_connected()) {
-        lv_label_set_text(lbl_header_time, "waiting for Wi-Fi connection . . .");
-    } else if (timeinfo.tm_year > (2020 - 1900)) {
-        lv_label_set_text_fmt(lbl_header_time, "%02d/%02d/%04d %02d:%02d", 
-            timeinfo.tm_mon + 1, timeinfo.tm_mday, timeinfo.tm_year + 1900,
-            timeinfo.tm_hour, timeinfo.tm_min);
-    } else {
-        lv_label_set_text(lbl_header_time, "http d/t syncing . . .");
-    }
-    
-    // Update WiFi Icon
-    if (wifi_mgr_is_connected()) {
-        lv_label_set_text(lbl_header_wifi, LV_SYMBOL_WIFI);
-        lv_obj_set_style_text_color(lbl_header_wifi, lv_palette_main(LV_PALETTE_GREEN), 0);
-    } else {
-        lv_label_set_text(lbl_header_wifi, LV_SYMBOL_WIFI);
-        lv_obj_set_style_text_color(lbl_header_wifi, lv_palette_main(LV_PALETTE_RED), 0);
-    }
-}
 
 static void launcher_cleanup_cb(lv_event_t * e) {
-    if (status_timer) {
-        lv_timer_del(status_timer);
-        status_timer = NULL;
-    }
-    lbl_header_time = NULL;
-    lbl_header_wifi = NULL;
-    ESP_LOGI(TAG, "Launcher cleanup complete");
+    UI_LOGI(TAG, "Launcher cleanup complete");
 }
 
 // Helper function to create neon-style buttons matching HAL BSP theme
-static void create_neon_btn(lv_obj_t * parent, const char * icon, const char * text, lv_color_t color, lv_event_cb_t event_cb) {
+static void create_neon_btn(lv_obj_t * parent, const char * icon, const char * text, lv_color_t color, lv_event_cb_t event_cb, void * user_data) {
     lv_obj_t * btn = lv_button_create(parent);
     lv_obj_set_height(btn, 95);
     lv_obj_set_flex_grow(btn, 1); // Allow button to grow in row layout
-    lv_obj_add_event_cb(btn, event_cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_add_event_cb(btn, event_cb, LV_EVENT_CLICKED, user_data);
     lv_obj_set_flex_flow(btn, LV_FLEX_FLOW_COLUMN);
     lv_obj_set_flex_align(btn, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
     lv_obj_set_style_pad_all(btn, 4, 0);
@@ -83,73 +44,50 @@ static void create_neon_btn(lv_obj_t * parent, const char * icon, const char * t
     // Icon
     lv_obj_t * lbl_icon = lv_label_create(btn);
     lv_label_set_text(lbl_icon, icon);
-    lv_obj_set_style_text_font(lbl_icon, &lv_font_montserrat_30, 0);
+    lv_obj_set_style_text_font(lbl_icon, ui_assets_font(30), 0);
     lv_obj_set_style_text_color(lbl_icon, lv_color_white(), 0);
 
     // Label
     lv_obj_t * lbl_text = lv_label_create(btn);
     lv_label_set_text(lbl_text, text);
-    lv_obj_set_style_text_font(lbl_text, &lv_font_montserrat_18, 0);
+    lv_obj_set_style_text_font(lbl_text, ui_assets_font(18), 0);
     lv_obj_set_style_text_color(lbl_text, lv_color_white(), 0);
 }
 
-// Button event handlers
-static void btn_maze_event_cb(lv_event_t *e) {
+// Button event handler, user data is the app's registry entry
+static void btn_app_event_cb(lv_event_t *e) {
     if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
-        ESP_LOGI(TAG, "Maze button clicked");
-        ui_maze_show();
+        const ui_app_t *app = lv_event_get_user_data(e);
+        UI_LOGI(TAG, "%s button clicked", app->name);
+        ui_app_launch(app);
     }
 }
 
-static void btn_sports_event_cb(lv_event_t *e) {
-    if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
-        ESP_LOGI(TAG, "Sports button clicked");
-        ui_sports_show();
-    }
-}
-
-static void btn_weather_event_cb(lv_event_t *e) {
-    if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
-        ESP_LOGI(TAG, "Weather button clicked");
-        ui_weather_show();
-    }
-}
-
-static void btn_settings_event_cb(lv_event_t *e) {
-    if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
-        ESP_LOGI(TAG, "Settings button clicked");
-        
-        // Create a new screen for the HAL BSP home view
-        // This prevents destroyng the active screen before the new one is ready
-        // and provides a valid screen for the view switcher to use
-        lv_obj_t * next_screen = lv_obj_create(NULL);
-        lv_obj_set_style_bg_color(next_screen, lv_color_hex(0x000000), 0); // Default black
-        lv_screen_load(next_screen);
-
-        // Call the HAL BSP's home view (hardware settings)
-        // This sets up the timer to build the UI on lv_screen_active() (which is now next_screen)
-        show_home_view(e);
-        
-        // Properly destroy launcher with delay to avoid deleting the object 
-        // currently processing this event
-        if (launcher_screen) {
-            ESP_LOGI(TAG, "Scheduling launcher screen destruction");
-            lv_obj_delete_delayed(launcher_screen, 100);
-            launcher_screen = NULL;
-        }
+void ui_launcher_destroy(void) {
+    if (launcher_screen) {
+        UI_LOGI(TAG, "Destroying launcher screen");
+        lv_obj_del(launcher_screen);
+        launcher_screen = NULL;
     }
 }
 
-void ui_launcher_destroy(void) {
+void ui_launcher_destroy_async(void) {
+    // Delay the delete so we don't free the object currently processing the event
     if (launcher_screen) {
-        ESP_LOGI(TAG, "Destroying launcher screen");
-        lv_obj_del(launcher_screen);
+        UI_LOGI(TAG, "Scheduling launcher screen destruction");
+        lv_obj_delete_delayed(launcher_screen, 100);
         launcher_screen = NULL;
     }
 }
 
 void ui_launcher_init(void) {
-    ESP_LOGI(TAG, "Initializing launcher screen");
+    UI_LOGI(TAG, "Initializing launcher screen");
+    ui_trace_t span = ui_trace_begin();
+    
+    // Status bar updates on minute boundaries and Wi-Fi events only.
+    // It outlives this screen, so create it before opening the arena.
+    ui_status_bar_init();
+    ui_arena_t *arena = ui_arena_begin("launcher");
     
     // Create the container screen
     launcher_screen = lv_obj_create(NULL);
@@ -159,33 +97,14 @@ void ui_launcher_init(void) {
     lv_obj_set_flex_align(launcher_screen, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
     lv_obj_add_event_cb(launcher_screen, launcher_cleanup_cb, LV_EVENT_DELETE, NULL);
 
-    // Header Row
+    // Header Row - spacer under the shared status bar (lives on the top layer)
     lv_obj_t * header_row = lv_obj_create(launcher_screen);
     lv_obj_remove_flag(header_row, LV_OBJ_FLAG_SCROLLABLE);            // Disable scrolling
-    lv_obj_set_size(header_row, LV_PCT(100), 40);
+    lv_obj_set_size(header_row, LV_PCT(100), UI_STATUS_BAR_HEIGHT);
     lv_obj_set_style_bg_opa(header_row, LV_OPA_TRANSP, 0);
     lv_obj_set_style_border_width(header_row, 0, 0);
-    lv_obj_set_flex_flow(header_row, LV_FLEX_FLOW_ROW);
-    lv_obj_set_flex_align(header_row, LV_FLEX_ALIGN_SPACE_BETWEEN, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-    lv_obj_set_style_pad_left(header_row, 10, 0);
-    lv_obj_set_style_pad_right(header_row, 10, 0);
-    
-    // Time Label
-    lbl_header_time = lv_label_create(header_row);
-    lv_label_set_text(lbl_header_time, "waiting for Wi-Fi connection . . .");
-    lv_obj_set_style_text_font(lbl_header_time, &lv_font_montserrat_22, 0);
-    lv_obj_set_style_text_color(lbl_header_time, lv_color_white(), 0);
     
-    // WiFi Label
-    lbl_header_wifi = lv_label_create(header_row);
-    lv_label_set_text(lbl_header_wifi, LV_SYMBOL_WIFI);
-    lv_obj_set_style_text_font(lbl_header_wifi, &lv_font_montserrat_24, 0);
-    lv_obj_set_style_text_color(lbl_header_wifi, lv_palette_main(LV_PALETTE_RED), 0);
-    
-    // Start Timer
-    if (status_timer) lv_timer_del(status_timer);
-    status_timer = lv_timer_create(status_bar_timer_cb, 1000, NULL);
-    status_bar_timer_cb(NULL);
+    ui_status_bar_set_visible(true);
     
     // Create Main Content Container (Dark Grey Background) - vertically centered
     lv_obj_t * main_cont = lv_obj_create(launcher_screen);
@@ -201,7 +120,7 @@ void ui_launcher_init(void) {
     // Title: "LilyGo T4-S3 & Me" (Gold Color) - Centered between status bar and buttons
     lv_obj_t * lbl_title = lv_label_create(main_cont);
     lv_label_set_text(lbl_title, "LilyGo T4-S3 & Me");
-    lv_obj_set_style_text_font(lbl_title, &lv_font_montserrat_30, 0);
+    lv_obj_set_style_text_font(lbl_title, ui_assets_font(30), 0);
     lv_obj_set_style_text_color(lbl_title, lv_color_hex(0xFFD700), 0); // Gold
 
     // Button Row Container - Vertically centered
@@ -215,30 +134,24 @@ void ui_launcher_init(void) {
     lv_obj_set_flex_align(btn_row, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
     lv_obj_set_style_pad_gap(btn_row, 10, 0);
     
-    // Maze Button
-    create_neon_btn(btn_row, LV_SYMBOL_SHUFFLE, "Maze", lv_palette_main(LV_PALETTE_BLUE), btn_maze_event_cb);
-    
-    // Sports Button
-    create_neon_btn(btn_row, LV_SYMBOL_GPS, "Sports", lv_palette_main(LV_PALETTE_GREEN), btn_sports_event_cb);
-    
-    // Weather Button
-    create_neon_btn(btn_row, LV_SYMBOL_TINT, "Weather", lv_palette_main(LV_PALETTE_CYAN), btn_weather_event_cb);
-    
-    // Settings Button
-    create_neon_btn(btn_row, LV_SYMBOL_SETTINGS, "Settings", lv_color_hex(0xFF3300), btn_settings_event_cb);
+    // One button per registered app
+    for (size_t i = 0; i < ui_app_count(); i++) {
+        const ui_app_t *app = ui_app_get(i);
+        create_neon_btn(btn_row, app->icon, app->name, lv_color_hex(app->color), btn_app_event_cb, (void *)app);
+    }
     
     // Load the screen
     lv_screen_load(launcher_screen);
+    ui_arena_end(arena, launcher_screen);
     
-    ESP_LOGI(TAG, "Launcher screen initialized");
+    ui_trace_end(TAG, UI_TRACE_LAYOUT, span);
+    UI_LOGI(TAG, "Launcher screen initialized");
 }
 
 void ui_launcher_show(void) {
-    ESP_LOGI(TAG, "Showing launcher screen");
-    
-    // Clean up HAL BSP views if they exist
-    clear_current_view();
-    
+    UI_LOGI(TAG, "Showing launcher screen");
+
+    // HAL BSP views belong to the Settings app, which clears them in its destroy hook.
     // Always recreate launcher for clean state
     ui_launcher_destroy();
     ui_launcher_init();
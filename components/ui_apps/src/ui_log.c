@@ -0,0 +1,132 @@
+#include "ui_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+#if CONFIG_UI_LOG_DEFERRED
+
+static const char *TAG = "ui_log";
+
+#define LOG_ENTRIES     CONFIG_UI_LOG_DEFERRED_ENTRIES
+#define LOG_MASK        (LOG_ENTRIES - 1)
+#define DRAIN_BATCH_MS  50
+_Static_assert((LOG_ENTRIES & LOG_MASK) == 0, "UI_LOG_DEFERRED_ENTRIES must be a power of two");
+
+// Fixed-size slot; seq published last (release) like the trace ring
+typedef struct {
+    atomic_uint seq;
+    uint32_t ts_us;
+    const char *tag;
+    const char *fmt;
+    uint8_t level;
+    uint8_t nargs;
+    uint32_t args[UI_LOG_MAX_ARGS];
+} log_entry_t;
+
+static log_entry_t ring[LOG_ENTRIES];
+static atomic_uint ring_head = 0;
+static unsigned drain_next = 0;         // Only touched by the drain task
+static uint32_t dropped = 0;
+static TaskHandle_t drain_task = NULL;
+
+void ui_log_deferred(esp_log_level_t level, const char *tag, const char *fmt, uint32_t nargs, ...) {
+    unsigned idx = atomic_fetch_add_explicit(&ring_head, 1, memory_order_relaxed);
+    log_entry_t *e = &ring[idx & LOG_MASK];
+    atomic_store_explicit(&e->seq, 0, memory_order_relaxed);
+
+    if (nargs > UI_LOG_MAX_ARGS) nargs = UI_LOG_MAX_ARGS;
+    e->ts_us = (uint32_t)esp_timer_get_time();
+    e->tag = tag;
+    e->fmt = fmt;
+    e->level = (uint8_t)level;
+    e->nargs = (uint8_t)nargs;
+
+    va_list ap;
+    va_start(ap, nargs);
+    for (uint32_t i = 0; i < nargs; i++) {
+        e->args[i] = va_arg(ap, uint32_t);
+    }
+    va_end(ap);
+
+    atomic_store_explicit(&e->seq, idx + 1, memory_order_release);
+    if (drain_task) xTaskNotifyGive(drain_task);
+}
+
+// One line per record: #UL <ts_us> <level> <tag addr> <fmt addr> <args...>
+// The decoder looks up tag/fmt (and %s arguments) in the firmware ELF.
+static void emit(uint32_t ts_us, uint8_t level, const char *tag, const char *fmt,
+                 uint8_t nargs, const uint32_t *args) {
+    printf("#UL %08lx %u %08lx %08lx", (unsigned long)ts_us, level,
+           (unsigned long)(uintptr_t)tag, (unsigned long)(uintptr_t)fmt);
+    for (uint8_t i = 0; i < nargs; i++) {
+        printf(" %08lx", (unsigned long)args[i]);
+    }
+    printf("\n");
+}
+
+static void drain_task_fn(void *arg) {
+    (void)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        vTaskDelay(pdMS_TO_TICKS(DRAIN_BATCH_MS));   // Batch a burst into one wakeup
+
+        unsigned head = atomic_load_explicit(&ring_head, memory_order_acquire);
+        if (head - drain_next > LOG_ENTRIES) {
+            unsigned lost = head - drain_next - LOG_ENTRIES;
+            dropped += lost;
+            printf("#UL dropped %u\n", lost);
+            drain_next = head - LOG_ENTRIES;
+        }
+
+        while (drain_next != head) {
+            log_entry_t *e = &ring[drain_next & LOG_MASK];
+            unsigned seq = atomic_load_explicit(&e->seq, memory_order_acquire);
+            if (seq != drain_next + 1) {
+                if (seq == 0) break;          // Still being written - pick it up next time
+                dropped++;                    // Lapped while we were printing
+                drain_next++;
+                continue;
+            }
+            uint32_t args[UI_LOG_MAX_ARGS];
+            uint32_t ts_us = e->ts_us;
+            uint8_t level = e->level;
+            const char *tag = e->tag;
+            const char *fmt = e->fmt;
+            uint8_t nargs = e->nargs;
+            for (uint8_t i = 0; i < nargs; i++) args[i] = e->args[i];
+            if (atomic_load_explicit(&e->seq, memory_order_acquire) == seq) {
+                emit(ts_us, level, tag, fmt, nargs, args);
+            } else {
+                dropped++;
+            }
+            drain_next++;
+        }
+    }
+}
+
+void ui_log_init(void) {
+    if (drain_task) return;
+    xTaskCreate(drain_task_fn, "ui_log", 3072, NULL, 1, &drain_task);
+    ESP_LOGI(TAG, "Deferred logging: %d entries, decode '#UL' lines with tools/ui_log_decode.py", LOG_ENTRIES);
+}
+
+uint32_t ui_log_get_dropped(void) {
+    return dropped;
+}
+
+#else  // !CONFIG_UI_LOG_DEFERRED
+
+void ui_log_deferred(esp_log_level_t level, const char *tag, const char *fmt, uint32_t nargs, ...) {
+    (void)level; (void)tag; (void)fmt; (void)nargs;
+}
+
+void ui_log_init(void) {}
+
+uint32_t ui_log_get_dropped(void) {
+    return 0;
+}
+
+#endif
@@ -6,15 +6,28 @@
   Get to the opening on the edge of the maze.
 
   Touch controls:
-      center of touch screen -- move forward
+      center of touch screen -- move forward (hold to keep walking)
    left side of touch screen -- turn left
   right side of touch screen -- turn right
 ****************************************************/
 
 #include "ui_maze.h"
-#include "ui_launcher.h"
-#include "esp_log.h"
+#include "ui_assets.h"
+#include "ui_status_bar.h"
+#include "ui_governor.h"
+#include "ui_trace.h"
+#include "ui_maze_view.h"
+#include "ui_arena.h"
+#include "ui_mem.h"
+#include "ui_app.h"
+#include "ui_draw.h"
+#include "ui_fill.h"
+#define UI_LOG_LEVEL CONFIG_UI_LOG_LEVEL_MAZE
+#include "ui_log.h"
 #include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "lvgl.h"
 #include <stdio.h>
 #include <string.h>
@@ -45,6 +58,7 @@ static int tutorial_step = 0;  // 0=forward, 1=right, 2=back, 3=left
 // Canvas rendering with layer API (required in LVGL 9)
 static void *canvas_buffer = NULL;
 static void *player_marker_buffer = NULL;
+static void *map_buffer = NULL;
 static lv_layer_t layer;
 
 static int level = 0;
@@ -55,6 +69,39 @@ static uint32_t maze_col = 7;
 static int facing = 0;  // 0=north 1=east 2=south 3=west
 static bool suppress_throat_horiz = false;  // Hide inner top/bottom lines after stepping forward
 
+// Touch-to-photon accounting (see ui_maze_get_input_stats)
+static ui_maze_input_stats_t input_stats;
+static uint64_t hit_latency_sum_us = 0;
+static uint64_t miss_latency_sum_us = 0;
+static int64_t touch_press_us = 0;      // Set while a touch action is being handled
+static int64_t latency_start_us = 0;    // Press time of the frame waiting to be flushed
+static bool latency_hit = false;
+
+// Hold-to-walk: steps are due on a fixed cadence from walk_start_us; the
+// timer applies every due step and draws once, so slow frames are skipped
+// instead of slowing the walk down.
+#define WALK_MAX_CATCHUP 4              // Don't teleport after a long stall
+static lv_timer_t *walk_timer = NULL;
+static int walk_dir = 0;                // +1 forward, -1 backward, 0 idle
+static int64_t walk_start_us = 0;       // First repeat step is due here
+static uint32_t walk_steps_done = 0;    // Repeat steps taken this hold
+static uint64_t walk_held_us = 0;       // Time spent repeating (for steps/sec)
+
+#if CONFIG_UI_MAZE_PRERENDER
+// Candidate next frames rendered while idle: forward, right, left, back
+#define PRERENDER_SLOTS 4
+typedef struct {
+    void *buf;
+    maze_pose_t pose;
+    bool ready;
+} prerender_slot_t;
+static prerender_slot_t pre_slots[PRERENDER_SLOTS];
+static int pre_count = 0;               // Candidates for the current pose
+static bool pre_pending = false;        // Start speculating after the next flush
+static lv_obj_t *pre_canvas = NULL;     // Hidden canvas used only as a render target
+static lv_timer_t *pre_timer = NULL;
+#endif
+
 // Top controls height (buttons + small margin)
 #define TOP_CONTROLS_H 60
 // Display dimensions - scaled from 320x170 to full width and remaining height
@@ -71,6 +118,8 @@ static inline int SCALE_Y(int y) { return (canvas_h ? (y * canvas_h) / 170 : ((y
 // Early forward declarations to satisfy references in size-changed handler
 static void draw_3d_view(void);
 static void touch_event_handler(lv_event_t *e);
+static void prerender_alloc(lv_obj_t *panel, int w, int h);
+static void prerender_free(void);
 
 // Content size change handler: reallocate canvas buffer to fill content_panel
 static void content_size_changed_cb(lv_event_t *e) {
@@ -86,12 +135,12 @@ static void content_size_changed_cb(lv_event_t *e) {
     // Allocate/resize canvas buffer
     size_t buf_size = (size_t)w * (size_t)h * sizeof(lv_color_t);
     if (canvas_buffer) {
-        heap_caps_free(canvas_buffer);
+        ui_mem_free(canvas_buffer);
         canvas_buffer = NULL;
     }
-    canvas_buffer = heap_caps_malloc(buf_size, MALLOC_CAP_SPIRAM);
+    canvas_buffer = ui_mem_malloc(UI_MEM_APP_MAZE, buf_size, MALLOC_CAP_SPIRAM);
     if (!canvas_buffer) {
-        ESP_LOGE(TAG, "Failed to allocate canvas buffer for %dx%d", w, h);
+        UI_LOGE(TAG, "Failed to allocate canvas buffer for %dx%d", w, h);
         return;
     }
     memset(canvas_buffer, 0, buf_size);
@@ -105,12 +154,15 @@ static void content_size_changed_cb(lv_event_t *e) {
         lv_obj_set_style_border_opa(render_container, LV_OPA_TRANSP, 0);
         lv_obj_set_style_outline_width(render_container, 0, 0);
         lv_obj_set_style_outline_opa(render_container, LV_OPA_TRANSP, 0);
-        // Handle only CLICKED to avoid duplicate actions from PRESSED+CLICKED
-        lv_obj_add_event_cb(render_container, touch_event_handler, LV_EVENT_CLICKED, NULL);
+        // Act on PRESSED (not CLICKED) so the move starts at touch-down
+        lv_obj_add_event_cb(render_container, touch_event_handler, LV_EVENT_PRESSED, NULL);
+        lv_obj_add_event_cb(render_container, touch_event_handler, LV_EVENT_RELEASED, NULL);
+        lv_obj_add_event_cb(render_container, touch_event_handler, LV_EVENT_PRESS_LOST, NULL);
     }
     lv_canvas_set_buffer(render_container, canvas_buffer, w, h, LV_COLOR_FORMAT_RGB565);
     lv_obj_set_size(render_container, w, h);
     lv_obj_align(render_container, LV_ALIGN_CENTER, 0, 0);
+    prerender_alloc(panel, w, h);
     
     if (!showing_map) {
         draw_3d_view();
@@ -121,113 +173,25 @@ static void content_size_changed_cb(lv_event_t *e) {
 #define LINE_COLOR lv_color_hex(0x00FFFF)  // Cyan
 #define BG_COLOR lv_color_hex(0x003030)    // Dark cyan
 #define MAP_COLOR lv_color_hex(0x000070)   // Dark blue (near navy) for map
-#define PERSPECTIVE_SHORTEN 10             // Shorten connectors by 10px at vanishing point
-
-// Maze data - 32x32 bit arrays (each row is a 32-bit word, 1=wall, 0=empty)
-static uint32_t maze[3][32] = {
-    { // Level 1
-        0b11111111111111111111111111111111,
-        0b10001000000000000000000000000001,
-        0b10101010101111111111111111111111,
-        0b10101000000000000000000000000001,
-        0b10101010101111111101111111111101,
-        0b10101000000000000000100001000101,
-        0b10101010101111111110101011010101,
-        0b10101010100000000000101001010101,
-        0b10100000001111111110101101010101,
-        0b10111111111000000000101001010001,
-        0b10000000000011111111101011011111,
-        0b11111110111110000000101000010001,
-        0b10000000000010111111101111110101,
-        0b10111110111010100000001000000101,
-        0b10100010100010101111111011111101,
-        0b10101010101110100000000010000001,
-        0b10101010101000111111111110111111,
-        0b10101010101010000000000000100001,
-        0b10101010101010111111111111101101,
-        0b10101010101010000000000000001001,
-        0b10101010101011111111111111111011,
-        0b10001000101000000000001000001001,
-        0b11111111101011111111101010101101,
-        0b10000000001010001000101010100101,
-        0b10111111111010101010101010110001,
-        0b10000100011010101010101010011111,
-        0b10110001010000101010100001000000,
-        0b10011111010111101010111111011111,
-        0b10100010010100001010000001000001,
-        0b10101011110101111011111101111101,
-        0b10001000000100000010000000000001,
-        0b11111111111111111111111111111111
-    },
-    { // Level 2
-        0b11111111111111111111111111111111,
-        0b10010000000000001000000000000001,
-        0b10111101111110111111101111111011,
-        0b10100000000010000001000000010001,
-        0b10111111011111010101010101010101,
-        0b10000000000000010000000100000101,
-        0b10111111111111111111111111111001,
-        0b10001000100000000000100010001011,
-        0b10101010101111111110101010101011,
-        0b10100010001000000010001000100001,
-        0b10111111111011111011111111111101,
-        0b10000000100010001000000000000001,
-        0b10111110101010101111111111111111,
-        0b10000010101010100000000100010001,
-        0b11111010101010111111110101010101,
-        0b10000010101010100000000001000101,
-        0b10111110101000101111111111111101,
-        0b10000010101111111000100010000101,
-        0b11111010001000000010001000100001,
-        0b10000011111111111111111111111101,
-        0b10111110000100000000100010000001,
-        0b10000000110101111110101010111111,
-        0b10111111100101000000101010000001,
-        0b10000010000101011111101011111101,
-        0b11111010111101000000001000000001,
-        0b10001010100011111111101111111111,
-        0b10101010101000000000101000010000,
-        0b10101010101111111111101011010101,
-        0b10100010001000000000001001000101,
-        0b10111110101011111111111111111101,
-        0b10000000100000000000000000000001,
-        0b11111111111111111111111111111111
-    },
-    { // Level 3
-        0b11111111111111111111111111111111,
-        0b10010000000000001000000000000001,
-        0b10111101111110111111101111111011,
-        0b10100000000010000001000000010001,
-        0b10111111011111010101010101011101,
-        0b10000000000000010000000100000101,
-        0b10111111111111111111111111111001,
-        0b10001000100000000000100010001011,
-        0b10101010101111111110101010101011,
-        0b10100010001000000010001000100001,
-        0b10111111111011111011111111111101,
-        0b10000000100010001000000000000001,
-        0b10111110101010101111111111111111,
-        0b10000010101010100000000100010001,
-        0b11111010101010111111110101010101,
-        0b10000010101010100000000001000101,
-        0b10111110101000101111111111111101,
-        0b10000010101111111000100010000101,
-        0b11111010001000000010001000100001,
-        0b10000011111111111111111111111101,
-        0b10111110000100000000100010000001,
-        0b10000000110101111110101010111111,
-        0b10111111100101000000101010000001,
-        0b10000010000101011111101011111101,
-        0b11111010111101000000001000000001,
-        0b10001010100011111111101111111111,
-        0b10101010101000000000101000010001,
-        0b10101010101111111111101011010101,
-        0b10100010101000000000001001000101,
-        0b10111110101011111111111111111100,
-        0b10000000100000000000000000000001,
-        0b11111111111111111111111111111111
+#define MAP_CELL_PX 18                     // Pixels per cell on the map
+#define MAP_SIZE_PX (MAZE_SIZE * MAP_CELL_PX)  // 576 pixels
+
+// Built-in levels are in ui_maze_view.c; "level/maze" in the asset pack
+// (assets/levels/maze.txt) replaces them when present.
+_Static_assert(LEVEL_COUNT == MAZE_VIEW_LEVELS && MAZE_SIZE == 32, "ui_maze_view.c holds the built-in levels");
+
+static const uint32_t (*maze)[32] = maze_view_builtin;
+
+// Point maze at the pack's levels if they are there and the right size (zero copy)
+static void maze_levels_resolve(void) {
+    const void *data;
+    size_t size;
+    if (ui_assets_find("level/maze", &data, &size) && size == sizeof(maze_view_builtin)) {
+        maze = data;
+    } else {
+        maze = maze_view_builtin;
     }
-};
+}
 
 // Forward declarations
 static void draw_3d_view(void);
@@ -240,95 +204,15 @@ static void move_forward(void);
 static void move_backward(void);
 static void turn_left(void);
 static void turn_right(void);
-static void check_level_complete(void);
+static void walk_stop(void);
+static bool check_level_complete(void);
 static void next_level(void);
 static void start_tutorial(void);
 static void stop_tutorial(void);
 
 // Helper function to check if there's a wall at a position
 static bool check_wall_at(int row, uint32_t col) {
-    if (row < 0 || row >= maze_tall || col >= 32) {
-        return true;  // Out of bounds = wall
-    }
-    return (maze[level][row] & (1UL << (31 - col))) != 0;
-}
-
-// Check wall using relative offsets from player: forward (>0 toward facing), right (>0 to the right)
-static inline bool check_wall_rel(int off_forward, int off_right) {
-    int r = maze_row;
-    int c = (int)maze_col;
-
-    switch (facing) {
-        case 0: // North
-            r -= off_forward;
-            c += off_right;
-            break;
-        case 1: // East
-            r += off_right;
-            c += off_forward;
-            break;
-        case 2: // South
-            r += off_forward;
-            c -= off_right;
-            break;
-        case 3: // West
-            r -= off_right;
-            c -= off_forward;
-            break;
-    }
-    return check_wall_at(r, (uint32_t)c);
-}
-
-// Occupancy pattern structure for systematic pattern detection
-typedef struct {
-    // Layer 0: Current position (immediate left/right walls)
-    bool L0, R0;
-    // Layer 1: 1 step ahead
-    bool L1, C1, R1;
-    // Layer 2: 2 steps ahead
-    bool L2, C2, R2;
-    // Layer 3: 3 steps ahead
-    bool L3, C3, R3;
-    // Layer 4: 4 steps ahead
-    bool L4, C4, R4;
-    // Layer 5: 5 steps ahead
-    bool L5, C5, R5;
-} occupancy_pattern_t;
-
-// Get occupancy pattern around player (systematic 5-layer × 3-width grid)
-static occupancy_pattern_t get_occupancy_pattern(void) {
-    occupancy_pattern_t pattern = {0};
-    
-    // Layer 0: Immediate sides (current position)
-    pattern.L0 = check_wall_rel(0, -1);
-    pattern.R0 = check_wall_rel(0, 1);
-    
-    // Layer 1: 1 step ahead
-    pattern.L1 = check_wall_rel(1, -1);
-    pattern.C1 = check_wall_rel(1, 0);
-    pattern.R1 = check_wall_rel(1, 1);
-    
-    // Layer 2: 2 steps ahead
-    pattern.L2 = check_wall_rel(2, -1);
-    pattern.C2 = check_wall_rel(2, 0);
-    pattern.R2 = check_wall_rel(2, 1);
-    
-    // Layer 3: 3 steps ahead
-    pattern.L3 = check_wall_rel(3, -1);
-    pattern.C3 = check_wall_rel(3, 0);
-    pattern.R3 = check_wall_rel(3, 1);
-    
-    // Layer 4: 4 steps ahead
-    pattern.L4 = check_wall_rel(4, -1);
-    pattern.C4 = check_wall_rel(4, 0);
-    pattern.R4 = check_wall_rel(4, 1);
-    
-    // Layer 5: 5 steps ahead
-    pattern.L5 = check_wall_rel(5, -1);
-    pattern.C5 = check_wall_rel(5, 0);
-    pattern.R5 = check_wall_rel(5, 1);
-    
-    return pattern;
+    return maze_view_wall_at(maze[level], row, (int)col);
 }
 
 // Update stats label with direction and position
@@ -350,208 +234,321 @@ static void update_stats_label(void) {
 }
 
 // Draw a line using layer API
-static void draw_canvas_line(int x1, int y1, int x2, int y2, lv_color_t color, int width) {
+// @p y_off is subtracted from the scaled y, for layers over a row band
+static void draw_canvas_line(lv_layer_t *l, int x1, int y1, int x2, int y2, int y_off, lv_color_t color, int width) {
     lv_draw_line_dsc_t line_dsc;
     lv_draw_line_dsc_init(&line_dsc);
     line_dsc.color = color;
     line_dsc.width = width;
     line_dsc.p1.x = SCALE_X(x1);
-    line_dsc.p1.y = SCALE_Y(y1);
+    line_dsc.p1.y = SCALE_Y(y1) - y_off;
     line_dsc.p2.x = SCALE_X(x2);
-    line_dsc.p2.y = SCALE_Y(y2);
-    lv_draw_line(&layer, &line_dsc);
+    line_dsc.p2.y = SCALE_Y(y2) - y_off;
+    lv_draw_line(l, &line_dsc);
 }
 
-// Draw a line shortened by `shorten_px` at the endpoint (x2,y2), pulling back toward (x1,y1)
-static void draw_canvas_line_shortened_to(int x1, int y1, int x2, int y2, int shorten_px, lv_color_t color, int width) {
-    int dx = x2 - x1;
-    int dy = y2 - y1;
-    int len = (int)sqrtf((float)(dx * dx + dy * dy));
-    if (len <= 0) {
-        draw_canvas_line(x1, y1, x2, y2, color, width);
-        return;
+static maze_pose_t current_pose(void) {
+    maze_pose_t pose = {
+        .level = level,
+        .row = maze_row,
+        .col = (int)maze_col,
+        .facing = facing,
+        .suppress_throat_horiz = suppress_throat_horiz,
+    };
+    return pose;
+}
+
+// Rasterize a display list (320x170 design space) into the 3D canvas
+static void render_view(lv_obj_t *canvas, const maze_view_t *view) {
+    // Clear canvas
+    ui_fill_canvas(canvas, lv_color_black());
+
+    // Most walls overlap their neighbours, so within one layer the lines are
+    // drawn one after another. With several draw units the canvas is split
+    // into one row band per unit, each drawn through a layer that
+    // lv_canvas_init_layer() clips to the band, and a line is only queued in
+    // the bands it crosses. The layers are finished one after another; the
+    // draw bench on 1- and N-unit builds shows what the split buys. With one
+    // unit the only band is the whole canvas.
+    uint32_t bands = ui_draw_band_count();
+    for (uint32_t b = 0; b < bands; b++) {
+        int32_t y0, y1;
+        lv_obj_t *target = ui_draw_band(canvas, b, &y0, &y1);
+        lv_canvas_init_layer(target, &layer);
+        for (uint8_t i = 0; i < view->count; i++) {
+            const maze_seg_t *seg = &view->segs[i];
+            int top = SCALE_Y(seg->y1 < seg->y2 ? seg->y1 : seg->y2) - seg->width;
+            int bottom = SCALE_Y(seg->y1 < seg->y2 ? seg->y2 : seg->y1) + seg->width;
+            if (bottom < y0 || top > y1) continue;
+            draw_canvas_line(&layer, seg->x1, seg->y1, seg->x2, seg->y2, y0, LINE_COLOR, seg->width);
+        }
+        lv_canvas_finish_layer(target, &layer);
     }
-    int end_x = x2 - (dx * shorten_px) / len;
-    int end_y = y2 - (dy * shorten_px) / len;
-    draw_canvas_line(x1, y1, end_x, end_y, color, width);
+    if (bands > 1) lv_obj_invalidate(canvas);
 }
 
+// Draw a level's walls into a MAP_SIZE_PX square canvas
+static void render_map(lv_obj_t *canvas, int lvl) {
+    lv_layer_t map_layer;
+    lv_canvas_init_layer(canvas, &map_layer);
 
-// Draw the 3D perspective view
-static void draw_3d_view(void) {
-    if (!render_container) return;
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = MAP_COLOR;
+    rect_dsc.bg_opa = LV_OPA_COVER;
+    rect_dsc.border_opa = LV_OPA_TRANSP;
 
-    ESP_LOGI(TAG, "draw_3d_view called - pos: (%d,%lu) facing: %d", maze_row, (unsigned long)maze_col, facing);
-    
-    // Clear canvas
-    lv_canvas_fill_bg(render_container, lv_color_black(), LV_OPA_COVER);
-    
-    // Initialize layer for drawing
-    lv_canvas_init_layer(render_container, &layer);
-    
-    // Get systematic occupancy pattern (5 layers × 3 width)
-    occupancy_pattern_t pattern = get_occupancy_pattern();
-    
-    // Legacy aliases for readability during transition
-    bool wall_ahead      = pattern.C1;
-    bool wall_left_near  = pattern.L0;
-    bool wall_right_near = pattern.R0;
-    
-    // Replace perspective lines with two rectangle walls toward center (four vertical lines)
-    // Opening geometry: centered around screen mid (160,85)
-    const int inner_top_y = 30;     // closer to top for larger near opening
-    const int inner_bottom_y = 140; // closer to bottom for larger near opening
-    const int opening_h = (inner_bottom_y - inner_top_y); // visible vertical span
-    const int opening_w = opening_h + 30;                 // widen by ~15px each side (adds +10 more from previous)
-    const int opening_center_x = 160;                     // screen center
-    const int inner_left_x = opening_center_x - (opening_w / 2);
-    const int inner_right_x = opening_center_x + (opening_w / 2);
-
-    ESP_LOGI(TAG, "Drawing wireframe based on 2D occupancy pattern");
-    ESP_LOGI(TAG, "L0: L=%d R=%d | L1: L=%d C=%d R=%d | L2: C=%d | L3: L=%d C=%d R=%d",
-             pattern.L0, pattern.R0,
-             pattern.L1, pattern.C1, pattern.R1,
-             pattern.C2,
-             pattern.L3, pattern.C3, pattern.R3);
-    // Remove far side small rectangles; use classic diagonals to corners
-
-    // Invariant: R9C8 facing North (row=8,col=7,facing=0) with open corridors left/right/ahead
-    // must render inner verticals, and top/bottom horizontals extended to display edges,
-    // with no horizontal segment between inner verticals. Do not change this geometry.
-    bool is_r9c8n = (maze_row == 8 && maze_col == 7 && facing == 0);
-    if (is_r9c8n && !wall_ahead && !wall_left_near && !wall_right_near) {
-        ESP_LOGI(TAG, "R9C8N invariant view active");
-    }
-    // Draw corridor frame unconditionally when the path ahead is open
-    if (!wall_ahead) {
-        // Inner verticals (throat)
-        draw_canvas_line(inner_left_x, inner_top_y, inner_left_x, inner_bottom_y, LINE_COLOR, 2);
-        draw_canvas_line(inner_right_x, inner_top_y, inner_right_x, inner_bottom_y, LINE_COLOR, 2);
-
-        // Optionally add inner top/bottom to form full throat rectangle (R9C8 view)
-        if (!suppress_throat_horiz) {
-            // Extend horizontals only to display edges (no segment between inner verticals)
-            draw_canvas_line(0, inner_top_y, inner_left_x, inner_top_y, LINE_COLOR, 2);                 // top left extension
-            draw_canvas_line(inner_right_x, inner_top_y, 320, inner_top_y, LINE_COLOR, 2);              // top right extension
-            draw_canvas_line(0, inner_bottom_y, inner_left_x, inner_bottom_y, LINE_COLOR, 2);           // bottom left extension
-            draw_canvas_line(inner_right_x, inner_bottom_y, 320, inner_bottom_y, LINE_COLOR, 2);        // bottom right extension
+    // Cells don't overlap, so with several draw units these spread freely
+    for (int row = 0; row < MAZE_SIZE; row++) {
+        for (int col = 0; col < MAZE_SIZE; col++) {
+            if (maze_view_wall_at(maze[lvl], row, col)) {
+                lv_area_t area;
+                area.x1 = col * MAP_CELL_PX;
+                area.y1 = row * MAP_CELL_PX;
+                area.x2 = area.x1 + MAP_CELL_PX - 2;
+                area.y2 = area.y1 + MAP_CELL_PX - 2;
+                lv_draw_rect(&map_layer, &rect_dsc, &area);
+            }
         }
+    }
 
-        // Perspective connectors: join inner corners to screen center (vanishing point)
-        const int vanish_x = 160;
-        const int vanish_y = 85;
-        draw_canvas_line_shortened_to(inner_left_x,  inner_top_y,    vanish_x, vanish_y, PERSPECTIVE_SHORTEN, LINE_COLOR, 2);
-        draw_canvas_line_shortened_to(inner_right_x, inner_top_y,    vanish_x, vanish_y, PERSPECTIVE_SHORTEN, LINE_COLOR, 2);
-        draw_canvas_line_shortened_to(inner_left_x,  inner_bottom_y, vanish_x, vanish_y, PERSPECTIVE_SHORTEN, LINE_COLOR, 2);
-        draw_canvas_line_shortened_to(inner_right_x, inner_bottom_y, vanish_x, vanish_y, PERSPECTIVE_SHORTEN, LINE_COLOR, 2);
-
-        // Far-end vertical connectors showing corridor depth
-        // Depth factors reverse-engineered from original Arduino code's hard-coded coordinates
-        // Original coordinates: depth1=(80,242), depth2=(120,200), depth3=(150,170), depth4=(158,162)
-        // With throat at (20,300) and vanishing point at (160,85):
-        const double t1 = 0.43;  // 1 cube ahead: x=80 from 20, matches original depth 1
-        const double t2 = 0.71;  // 2 cubes ahead: x=120 from 20, matches original depth 2
-        const double t3 = 0.93;  // 3 cubes ahead: x=150 from 20, matches original depth 3
-        const double t4 = 0.99;  // 4 cubes ahead: x=158 from 20, matches original depth 4 (far end)
-        
-        // Draw depth markers showing corridor depth
-        // Draw at each depth where there's still corridor (not blocked)
-        // Draw individual lines even if only one side has a wall (shows depth better)
-        
-        // At 1 step ahead
-        if (!pattern.C1) {
-            int lx1 = (int)(inner_left_x  + t1 * (vanish_x - inner_left_x));
-            int rx1 = (int)(inner_right_x + t1 * (vanish_x - inner_right_x));
-            int y1_top = (int)(inner_top_y     + t1 * (vanish_y - inner_top_y));
-            int y1_bot = (int)(inner_bottom_y  + t1 * (vanish_y - inner_bottom_y));
-            if (pattern.L1) draw_canvas_line(lx1, y1_top, lx1, y1_bot, LINE_COLOR, 2);
-            if (pattern.R1) draw_canvas_line(rx1, y1_top, rx1, y1_bot, LINE_COLOR, 2);
+    lv_canvas_finish_layer(canvas, &map_layer);
+}
+
+// --- Speculative pre-rendering ---
+// After each frame only a handful of poses can come next. They are rendered
+// into spare buffers once the current frame has been flushed; a matching tap
+// then just swaps buffers instead of rasterizing on the touch path.
+
+static bool pose_equal(const maze_pose_t *a, const maze_pose_t *b) {
+    return a->level == b->level && a->row == b->row && a->col == b->col &&
+           a->facing == b->facing && a->suppress_throat_horiz == b->suppress_throat_horiz;
+}
+
+#if CONFIG_UI_MAZE_PRERENDER
+
+static const int dir_drow[4] = {-1, 0, 1, 0};
+static const int dir_dcol[4] = {0, 1, 0, -1};
+
+// Mirror move_forward/turn_right/turn_left/move_backward, most likely first
+static int predict_poses(const maze_pose_t *cur, maze_pose_t out[PRERENDER_SLOTS]) {
+    int n = 0;
+    maze_pose_t p = *cur;
+
+    p.row = cur->row + dir_drow[cur->facing];
+    p.col = cur->col + dir_dcol[cur->facing];
+    p.suppress_throat_horiz = true;
+    if (!maze_view_wall_at(maze[cur->level], p.row, p.col)) out[n++] = p;
+
+    p = *cur;
+    p.facing = (cur->facing + 1) % 4;
+    p.suppress_throat_horiz = false;
+    out[n++] = p;
+
+    p.facing = (cur->facing + 3) % 4;
+    out[n++] = p;
+
+    p = *cur;
+    p.row = cur->row - dir_drow[cur->facing];
+    p.col = cur->col - dir_dcol[cur->facing];
+    p.suppress_throat_horiz = false;
+    if (!maze_view_wall_at(maze[cur->level], p.row, p.col)) out[n++] = p;
+
+    return n;
+}
+
+// Render one candidate per tick so touch input can interleave
+static void prerender_timer_cb(lv_timer_t *timer) {
+    if (!showing_map && pre_canvas) {
+        for (int i = 0; i < pre_count; i++) {
+            prerender_slot_t *slot = &pre_slots[i];
+            if (slot->ready || !slot->buf) continue;
+
+            ui_trace_t span = ui_trace_begin();
+            maze_view_t view;
+            maze_view_build(maze[slot->pose.level], &slot->pose, &view);
+            lv_canvas_set_buffer(pre_canvas, slot->buf, canvas_w, canvas_h, LV_COLOR_FORMAT_RGB565);
+            render_view(pre_canvas, &view);
+            slot->ready = true;
+            input_stats.prerendered++;
+            ui_trace_end("maze_pre", UI_TRACE_RENDER, span);
+            return;
         }
-        // At 2 steps ahead
-        if (!pattern.C2) {
-            int lx2 = (int)(inner_left_x  + t2 * (vanish_x - inner_left_x));
-            int rx2 = (int)(inner_right_x + t2 * (vanish_x - inner_right_x));
-            int y2_top = (int)(inner_top_y     + t2 * (vanish_y - inner_top_y));
-            int y2_bot = (int)(inner_bottom_y  + t2 * (vanish_y - inner_bottom_y));
-            if (pattern.L2) draw_canvas_line(lx2, y2_top, lx2, y2_bot, LINE_COLOR, 2);
-            if (pattern.R2) draw_canvas_line(rx2, y2_top, rx2, y2_bot, LINE_COLOR, 2);
+    }
+    lv_timer_pause(timer);
+}
+
+// Current pose changed: drop stale candidates and queue new ones
+static void prerender_restart(void) {
+    for (int i = 0; i < pre_count; i++) {
+        if (pre_slots[i].ready) input_stats.wasted++;
+        pre_slots[i].ready = false;
+    }
+    maze_pose_t cur = current_pose();
+    maze_pose_t next[PRERENDER_SLOTS];
+    pre_count = predict_poses(&cur, next);
+    for (int i = 0; i < pre_count; i++) {
+        pre_slots[i].pose = next[i];
+    }
+    pre_pending = true;
+}
+
+// Swap a ready candidate in as the displayed buffer
+static bool prerender_promote(const maze_pose_t *pose) {
+    for (int i = 0; i < pre_count; i++) {
+        prerender_slot_t *slot = &pre_slots[i];
+        if (!slot->ready || !pose_equal(&slot->pose, pose)) continue;
+
+        void *shown = canvas_buffer;
+        canvas_buffer = slot->buf;
+        slot->buf = shown;
+        slot->ready = false;
+        lv_canvas_set_buffer(render_container, canvas_buffer, canvas_w, canvas_h, LV_COLOR_FORMAT_RGB565);
+        return true;
+    }
+    return false;
+}
+
+static void prerender_alloc(lv_obj_t *panel, int w, int h) {
+    prerender_free();
+    size_t buf_size = (size_t)w * (size_t)h * sizeof(lv_color_t);
+    for (int i = 0; i < PRERENDER_SLOTS; i++) {
+        pre_slots[i].buf = ui_mem_malloc(UI_MEM_APP_MAZE, buf_size, MALLOC_CAP_SPIRAM);
+        if (!pre_slots[i].buf) {
+            UI_LOGW(TAG, "Pre-render: only %d spare buffers", i);
+            break;
         }
-        // At 3 steps ahead
-        if (!pattern.C3) {
-            int lx3 = (int)(inner_left_x  + t3 * (vanish_x - inner_left_x));
-            int rx3 = (int)(inner_right_x + t3 * (vanish_x - inner_right_x));
-            int y3_top = (int)(inner_top_y     + t3 * (vanish_y - inner_top_y));
-            int y3_bot = (int)(inner_bottom_y  + t3 * (vanish_y - inner_bottom_y));
-            if (pattern.L3) draw_canvas_line(lx3, y3_top, lx3, y3_bot, LINE_COLOR, 2);
-            if (pattern.R3) draw_canvas_line(rx3, y3_top, rx3, y3_bot, LINE_COLOR, 2);
+    }
+    if (!pre_canvas) {
+        pre_canvas = lv_canvas_create(panel);
+        lv_obj_add_flag(pre_canvas, LV_OBJ_FLAG_HIDDEN);
+    }
+    if (!pre_timer) {
+        pre_timer = lv_timer_create(prerender_timer_cb, 1, NULL);
+        lv_timer_pause(pre_timer);
+    }
+}
+
+static void prerender_free(void) {
+    for (int i = 0; i < PRERENDER_SLOTS; i++) {
+        if (pre_slots[i].buf) {
+            ui_mem_free(pre_slots[i].buf);
+            pre_slots[i].buf = NULL;
         }
-        // At 4 steps ahead (far end - connects diagonal endpoints)
-        if (!pattern.C4) {
-            int lx4 = (int)(inner_left_x  + t4 * (vanish_x - inner_left_x));
-            int rx4 = (int)(inner_right_x + t4 * (vanish_x - inner_right_x));
-            int y4_top = (int)(inner_top_y     + t4 * (vanish_y - inner_top_y));
-            int y4_bot = (int)(inner_bottom_y  + t4 * (vanish_y - inner_bottom_y));
-            // Draw very close to vanishing point - thinner line
-            draw_canvas_line(lx4, y4_top, lx4, y4_bot, LINE_COLOR, 1);
-            draw_canvas_line(rx4, y4_top, rx4, y4_bot, LINE_COLOR, 1);
+        pre_slots[i].ready = false;
+    }
+    pre_count = 0;
+    pre_pending = false;
+    if (pre_timer) lv_timer_pause(pre_timer);
+}
+
+#else
+
+static void prerender_restart(void) {}
+static bool prerender_promote(const maze_pose_t *pose) { (void)pose; return false; }
+static void prerender_alloc(lv_obj_t *panel, int w, int h) { (void)panel; (void)w; (void)h; }
+static void prerender_free(void) {}
+
+#endif
+
+// The frame for a touch action has reached the panel
+static void maze_refr_ready_cb(lv_event_t *e) {
+    (void)e;
+    if (latency_start_us) {
+        uint32_t us = (uint32_t)(esp_timer_get_time() - latency_start_us);
+        latency_start_us = 0;
+        if (latency_hit) {
+            hit_latency_sum_us += us;
+            if (us > input_stats.hit_latency_max_us) input_stats.hit_latency_max_us = us;
+        } else {
+            miss_latency_sum_us += us;
+            if (us > input_stats.miss_latency_max_us) input_stats.miss_latency_max_us = us;
         }
+        UI_LOGD(TAG, "Tap-to-flush %lu us (%s)", (unsigned long)us, latency_hit ? "hit" : "miss");
     }
-    
-    // Near side walls: draw outer verticals only when wall is present
-    if (wall_left_near) {
-        draw_canvas_line(0, 0, 0, 170, LINE_COLOR, 2);
-        // Trapezoid is formed by outer vertical, inner vertical, and diagonals to vanishing point
-        // (diagonals are already drawn from inner corners to center above)
+#if CONFIG_UI_MAZE_PRERENDER
+    if (pre_pending && pre_timer) {
+        pre_pending = false;
+        lv_timer_resume(pre_timer);
+        lv_timer_ready(pre_timer);
     }
-    if (wall_right_near) {
-        draw_canvas_line(320, 0, 320, 170, LINE_COLOR, 2);
-        // Trapezoid is formed by outer vertical, inner vertical, and diagonals to vanishing point
-        // (diagonals are already drawn from inner corners to center above)
+#endif
+}
+
+void ui_maze_get_input_stats(ui_maze_input_stats_t *out) {
+    *out = input_stats;
+    out->walk_steps_per_sec = walk_held_us ? (float)input_stats.walk_steps * 1e6f / (float)walk_held_us : 0.0f;
+    out->hit_latency_avg_us = input_stats.hits ? (uint32_t)(hit_latency_sum_us / input_stats.hits) : 0;
+    out->miss_latency_avg_us = input_stats.misses ? (uint32_t)(miss_latency_sum_us / input_stats.misses) : 0;
+}
+
+static void log_input_stats(void) {
+    ui_maze_input_stats_t st;
+    ui_maze_get_input_stats(&st);
+    if (st.walk_steps) {
+        UI_LOGI(TAG, "Walk: %lu steps at %.2f steps/s (target %.2f), %lu frames skipped",
+                (unsigned long)st.walk_steps, st.walk_steps_per_sec,
+                1000.0f / CONFIG_UI_MAZE_WALK_CADENCE_MS, (unsigned long)st.walk_dropped_frames);
     }
+    if (st.hits + st.misses == 0) return;
+    UI_LOGI(TAG, "Input: %lu hits / %lu misses (%lu%%), tap-to-flush hit avg %lu max %lu us, "
+            "miss avg %lu max %lu us, %lu pre-rendered, %lu wasted",
+            (unsigned long)st.hits, (unsigned long)st.misses,
+            (unsigned long)(st.hits * 100 / (st.hits + st.misses)),
+            (unsigned long)st.hit_latency_avg_us, (unsigned long)st.hit_latency_max_us,
+            (unsigned long)st.miss_latency_avg_us, (unsigned long)st.miss_latency_max_us,
+            (unsigned long)st.prerendered, (unsigned long)st.wasted);
+}
 
-    // Turn-and-step cues removed; handled by conditional diagonals above
+// Logs of one move: the touch, then draw_3d_view(). Shared with
+// ui_maze_log_bench() so it times the same records.
+#define MOVE_FMT_TOUCH      "Touch at X:%d Y:%d"
+#define MOVE_FMT_DRAW       "draw_3d_view called - pos: (%d,%lu) facing: %d"
+#define MOVE_FMT_OCCUPANCY  "L0: L=%d R=%d | L1: L=%d C=%d R=%d | L2: C=%d | L3: L=%d C=%d R=%d"
+#define MOVE_FMT_DONE       "draw_3d_view complete (%u segments)"
 
-    // Removed small diagonal frames; extend view via corner diagonals
+// Draw the 3D perspective view
+// Geometry lives in ui_maze_view.c; the R9C8-facing-North invariant is
+// enforced there by maze_view_check_r9c8n() (see ui_maze_render_check()).
+static void draw_3d_view(void) {
+    if (!render_container) return;
+    ui_trace_t span = ui_trace_begin();
 
-    // Throat continuity lines are handled above when forward is open
-    
-    // Far-end square removed to avoid confusion; render only actual wall faces
+    UI_LOGD(TAG, MOVE_FMT_DRAW, maze_row, (unsigned long)maze_col, facing);
 
-    // Removed conditional far-3 wall; use far-end square above for open corridor depth
-    
-    // Wall ahead as a large wireframe rectangle
-    if (wall_ahead) {
-        ESP_LOGI(TAG, "Drawing wall ahead (scaled 90%% with perspective connectors)");
-        // Use explicit screen extents to avoid any mismatch
-        const int screen_w = 320;
-        const int screen_h = 170;
-        int wall_w = (screen_w * 90) / 100;
-        int wall_h = (screen_h * 90) / 100;
-        int wall_x = (screen_w - wall_w) / 2;
-        int wall_y = (screen_h - wall_h) / 2;
-        // Wall rectangle (scaled to 90% of canvas and centered)
-        draw_canvas_line(wall_x,        wall_y,        wall_x+wall_w, wall_y,        LINE_COLOR, 2); // top
-        draw_canvas_line(wall_x,        wall_y+wall_h, wall_x+wall_w, wall_y+wall_h, LINE_COLOR, 2); // bottom
-        draw_canvas_line(wall_x,        wall_y,        wall_x,        wall_y+wall_h, LINE_COLOR, 2); // left
-        draw_canvas_line(wall_x+wall_w, wall_y,        wall_x+wall_w, wall_y+wall_h, LINE_COLOR, 2); // right
-        // Draw perspective connectors from wall corners to vanishing point
-        const int vanish_x = 160;
-        const int vanish_y = 85;
-        draw_canvas_line_shortened_to(wall_x,           wall_y,           vanish_x, vanish_y, PERSPECTIVE_SHORTEN, LINE_COLOR, 2); // top-left corner
-        draw_canvas_line_shortened_to(wall_x+wall_w,    wall_y,           vanish_x, vanish_y, PERSPECTIVE_SHORTEN, LINE_COLOR, 2); // top-right corner
-        draw_canvas_line_shortened_to(wall_x,           wall_y+wall_h,    vanish_x, vanish_y, PERSPECTIVE_SHORTEN, LINE_COLOR, 2); // bottom-left corner
-        draw_canvas_line_shortened_to(wall_x+wall_w,    wall_y+wall_h,    vanish_x, vanish_y, PERSPECTIVE_SHORTEN, LINE_COLOR, 2); // bottom-right corner
+    maze_pose_t pose = current_pose();
+    bool hit = prerender_promote(&pose);
+    if (touch_press_us) {
+        latency_start_us = touch_press_us;
+        latency_hit = hit;
+        if (hit) input_stats.hits++; else input_stats.misses++;
     }
-    
-    // Side wall overlays can be added here if needed based on wall_left/wall_right
-    
-    // Finish layer and render to canvas
-    lv_canvas_finish_layer(render_container, &layer);
-    
+    if (hit) {
+        update_stats_label();
+        prerender_restart();
+        ui_trace_end(TAG, UI_TRACE_RENDER, span);
+        UI_LOGD(TAG, "draw_3d_view served from pre-render");
+        return;
+    }
+
+    maze_view_t view;
+    maze_view_build(maze[level], &pose, &view);
+
+    const occupancy_pattern_t *pattern = &view.pattern;
+    UI_LOGD(TAG, MOVE_FMT_OCCUPANCY,
+             pattern->L0, pattern->R0,
+             pattern->L1, pattern->C1, pattern->R1,
+             pattern->C2,
+             pattern->L3, pattern->C3, pattern->R3);
+
+    render_view(render_container, &view);
+
     // Update stats display
     update_stats_label();
+    prerender_restart();
     
-    ESP_LOGI(TAG, "draw_3d_view complete");
+    ui_trace_end(TAG, UI_TRACE_RENDER, span);
+    UI_LOGD(TAG, MOVE_FMT_DONE, view.count);
 }
 
 // Update player marker position on map
@@ -602,6 +599,7 @@ static void update_player_marker(void) {
 
 // Draw the 2D map view - full 32x32 maze on scrollable panel
 static void draw_map_view(void) {
+    ui_trace_t span = ui_trace_begin();
 
     // Hide 3D canvas and show map panel
     lv_obj_add_flag(render_container, LV_OBJ_FLAG_HIDDEN);
@@ -623,13 +621,12 @@ static void draw_map_view(void) {
         lv_obj_set_style_outline_opa(map_panel, LV_OPA_TRANSP, 0);
         
         // Create full-size canvas for entire 32x32 maze
-        int cell_size = 18;  // Pixels per cell
-        int full_map_size = 32 * cell_size;  // 576 pixels
+        int full_map_size = MAP_SIZE_PX;
         size_t map_buf_size = full_map_size * full_map_size * sizeof(lv_color_t);
         
-        void *map_buffer = heap_caps_malloc(map_buf_size, MALLOC_CAP_SPIRAM);
+        map_buffer = ui_mem_malloc(UI_MEM_APP_MAZE, map_buf_size, MALLOC_CAP_SPIRAM);
         if (!map_buffer) {
-            ESP_LOGE(TAG, "Failed to allocate map buffer");
+            UI_LOGE(TAG, "Failed to allocate map buffer");
             return;
         }
         memset(map_buffer, 0, map_buf_size);
@@ -647,36 +644,14 @@ static void draw_map_view(void) {
         
         // Draw entire 32x32 maze
         if (render_container) lv_obj_add_flag(render_container, LV_OBJ_FLAG_HIDDEN);
-        lv_layer_t map_layer;
-        lv_canvas_init_layer(map_canvas, &map_layer);
-
-        lv_draw_rect_dsc_t rect_dsc;
-        lv_draw_rect_dsc_init(&rect_dsc);
-        rect_dsc.bg_color = MAP_COLOR;
-        rect_dsc.bg_opa = LV_OPA_COVER;
-        rect_dsc.border_opa = LV_OPA_TRANSP;
-
-        for (int row = 0; row < 32; row++) {
-            for (uint32_t col = 0; col < 32; col++) {
-                if (check_wall_at(row, col)) {
-                    lv_area_t area;
-                    area.x1 = (int)(col * cell_size);
-                    area.y1 = (int)(row * cell_size);
-                    area.x2 = area.x1 + cell_size - 2;
-                    area.y2 = area.y1 + cell_size - 2;
-                    lv_draw_rect(&map_layer, &rect_dsc, &area);
-                }
-            }
-        }
-
-        lv_canvas_finish_layer(map_canvas, &map_layer);
+        render_map(map_canvas, level);
         
         // Create player marker as canvas with directional triangle
         int marker_size = 18;  // Match cell size
         size_t marker_buf_size = marker_size * marker_size * sizeof(lv_color_t);
-        player_marker_buffer = heap_caps_malloc(marker_buf_size, MALLOC_CAP_SPIRAM);
+        player_marker_buffer = ui_mem_malloc(UI_MEM_APP_MAZE, marker_buf_size, MALLOC_CAP_SPIRAM);
         if (!player_marker_buffer) {
-            ESP_LOGE(TAG, "Failed to allocate player marker buffer");
+            UI_LOGE(TAG, "Failed to allocate player marker buffer");
             return;
         }
         memset(player_marker_buffer, 0, marker_buf_size);
@@ -738,10 +713,12 @@ static void draw_map_view(void) {
     int player_y_scroll = maze_row * cell_size - (CANVAS_HEIGHT / 2);
     int player_x_scroll = maze_col * cell_size - (CANVAS_WIDTH / 2);
     lv_obj_scroll_to(map_panel, player_x_scroll, player_y_scroll, LV_ANIM_ON);
+    ui_trace_end(TAG, UI_TRACE_RENDER, span);
 }
 
 // Movement functions
-static void move_forward(void) {
+// step_* only update the pose; move_* also check the exit and redraw
+static bool step_forward(void) {
     bool can_move = false;
     
     switch (facing) {
@@ -774,16 +751,11 @@ static void move_forward(void) {
     if (can_move) {
         // After stepping forward, suppress inner horizontals to show R8C8-style view
         suppress_throat_horiz = true;
-        check_level_complete();
-        if (showing_map) {
-            update_player_marker();
-        } else {
-            draw_3d_view();
-        }
     }
+    return can_move;
 }
 
-static void move_backward(void) {
+static bool step_backward(void) {
     bool can_move = false;
     
     switch (facing) {
@@ -816,12 +788,86 @@ static void move_backward(void) {
     if (can_move) {
         // Restore throat horizontals when backing up
         suppress_throat_horiz = false;
-        if (showing_map) {
-            update_player_marker();
-        } else {
-            draw_3d_view();
+    }
+    return can_move;
+}
+
+static void redraw_after_move(void) {
+    if (showing_map) {
+        update_player_marker();
+    } else {
+        draw_3d_view();
+    }
+}
+
+static void move_forward(void) {
+    if (step_forward()) {
+        check_level_complete();
+        redraw_after_move();
+    }
+}
+
+static void move_backward(void) {
+    if (step_backward()) {
+        redraw_after_move();
+    }
+}
+
+// Apply every step due since the last tick, then draw once
+static void walk_timer_cb(lv_timer_t *timer) {
+    (void)timer;
+    int64_t now = esp_timer_get_time();
+    if (walk_dir == 0 || now < walk_start_us) return;
+
+    uint32_t due = (uint32_t)((now - walk_start_us) / (CONFIG_UI_MAZE_WALK_CADENCE_MS * 1000)) + 1;
+    if (due - walk_steps_done > WALK_MAX_CATCHUP) {
+        walk_steps_done = due - WALK_MAX_CATCHUP;   // Drop the backlog, keep the cadence
+    }
+
+    uint32_t stepped = 0;
+    bool stop = false;
+    while (walk_steps_done < due) {
+        walk_steps_done++;
+        if (!(walk_dir > 0 ? step_forward() : step_backward())) {
+            stop = true;    // Walked into a wall
+            break;
+        }
+        stepped++;
+        if (walk_dir > 0 && check_level_complete()) {
+            stop = true;
+            break;
         }
     }
+
+    if (stepped) {
+        input_stats.walk_steps += stepped;
+        input_stats.walk_dropped_frames += stepped - 1;
+        redraw_after_move();
+    }
+    if (stop) walk_stop();
+}
+
+static void walk_start(int dir) {
+    walk_dir = dir;
+    walk_start_us = esp_timer_get_time() + CONFIG_UI_MAZE_WALK_HOLD_DELAY_MS * 1000;
+    walk_steps_done = 0;
+    if (!walk_timer) {
+        // Tick faster than the cadence so steps land close to their due time
+        walk_timer = lv_timer_create(walk_timer_cb, CONFIG_UI_MAZE_WALK_CADENCE_MS / 4, NULL);
+    } else {
+        lv_timer_resume(walk_timer);
+        lv_timer_reset(walk_timer);
+    }
+}
+
+static void walk_stop(void) {
+    if (walk_dir == 0) return;
+    int64_t now = esp_timer_get_time();
+    if (walk_steps_done > 0 && now > walk_start_us) {
+        walk_held_us += (uint64_t)(now - walk_start_us);
+    }
+    walk_dir = 0;
+    if (walk_timer) lv_timer_pause(walk_timer);
 }
 
 static void turn_left(void) {
@@ -861,15 +907,15 @@ static void level_complete_timer_cb(lv_timer_t *timer) {
     next_level();
 }
 
-static void check_level_complete(void) {
+static bool check_level_complete(void) {
     // Check if player reached the edge
     if (maze_col == 0 || maze_col == 31 || maze_row == 0 || maze_row == maze_tall - 1) {
-        ESP_LOGI(TAG, "Level %d complete!", level + 1);
+        UI_LOGI(TAG, "Level %d complete!", level + 1);
         
         // Flash the screen
         lv_obj_t *congrats = lv_label_create(maze_screen);
         lv_label_set_text_fmt(congrats, "LEVEL %d\nCOMPLETE!", level + 1);
-        lv_obj_set_style_text_font(congrats, &lv_font_montserrat_28, 0);
+        lv_obj_set_style_text_font(congrats, ui_assets_font(28), 0);
         lv_obj_set_style_text_color(congrats, lv_color_hex(0xFFFF00), 0);  // Yellow
         lv_obj_set_style_text_align(congrats, LV_TEXT_ALIGN_CENTER, 0);
         lv_obj_align(congrats, LV_ALIGN_CENTER, 0, 0);
@@ -877,7 +923,9 @@ static void check_level_complete(void) {
         // Move to next level after a delay
         lv_timer_t *timer = lv_timer_create(level_complete_timer_cb, 2000, congrats);
         lv_timer_set_repeat_count(timer, 1);
+        return true;
     }
+    return false;
 }
 
 static void next_level(void) {
@@ -898,8 +946,12 @@ static void next_level(void) {
 // Touch event handler
 static void touch_event_handler(lv_event_t *e) {
     lv_event_code_t code = lv_event_get_code(e);
-    // Process only CLICKED to prevent double move/turn
-    if (code != LV_EVENT_CLICKED) return;
+    if (code == LV_EVENT_RELEASED || code == LV_EVENT_PRESS_LOST) {
+        walk_stop();
+        return;
+    }
+    // Act only on PRESSED to prevent double move/turn
+    if (code != LV_EVENT_PRESSED) return;
     
     // Stop tutorial on first touch
     if (tutorial_active) {
@@ -915,14 +967,16 @@ static void touch_event_handler(lv_event_t *e) {
     lv_point_t point;
     lv_indev_get_point(indev, &point);
     
-    ESP_LOGI(TAG, "Touch at X:%d Y:%d", point.x, point.y);
+    UI_LOGD(TAG, MOVE_FMT_TOUCH, point.x, point.y);
     
     // Touch screen divided into 4 zones:
     // Left side (x < 200) = turn left
     // Right side (x > 400) = turn right
     // Center top (200-400, y < CANVAS_HEIGHT/2 + TOP_CONTROLS_H) = move forward
     // Center bottom (200-400, y >= CANVAS_HEIGHT/2 + TOP_CONTROLS_H) = back up
+    // Holding either center zone keeps walking until release
     
+    touch_press_us = esp_timer_get_time();
     if (point.x < 200) {
         turn_left();   // Left side
     } else if (point.x > 400) {
@@ -932,10 +986,13 @@ static void touch_event_handler(lv_event_t *e) {
         int center_y = (LV_VER_RES / 2);
         if (point.y < center_y) {
             move_forward();  // Center top
+            walk_start(1);
         } else {
             move_backward(); // Center bottom
+            walk_start(-1);
         }
     }
+    touch_press_us = 0;
 }
 
 // Map button event handler
@@ -943,10 +1000,11 @@ static void btn_map_event_cb(lv_event_t *e) {
     if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
         // Map button: enter map view only; hide Map button
         if (!showing_map) {
+            walk_stop();
             showing_map = true;
             draw_map_view();
             if (btn_map) lv_obj_add_flag(btn_map, LV_OBJ_FLAG_HIDDEN);
-            ESP_LOGI(TAG, "Switched to map view (Map button hidden)");
+            UI_LOGI(TAG, "Switched to map view (Map button hidden)");
         }
     }
 }
@@ -963,12 +1021,11 @@ static void btn_back_event_cb(lv_event_t *e) {
             lv_obj_clear_flag(render_container, LV_OBJ_FLAG_HIDDEN);
             draw_3d_view();
             if (btn_map) lv_obj_clear_flag(btn_map, LV_OBJ_FLAG_HIDDEN);
-            ESP_LOGI(TAG, "Switched back to 3D view");
+            UI_LOGI(TAG, "Switched back to 3D view");
         } else {
             // In 3D view: go back to UI Launcher
-            ESP_LOGI(TAG, "Exiting to launcher");
-            ui_maze_cleanup();
-            ui_launcher_show();
+            UI_LOGI(TAG, "Exiting to launcher");
+            ui_app_exit();
         }
     }
 }
@@ -1003,13 +1060,14 @@ static void start_tutorial(void) {
     // Create tutorial label
     tutorial_label = lv_label_create(maze_screen);
     lv_label_set_text(tutorial_label, "Forward");
-    lv_obj_set_style_text_font(tutorial_label, &lv_font_montserrat_24, 0);
+    lv_obj_set_style_text_font(tutorial_label, ui_assets_font(24), 0);
     lv_obj_set_style_text_color(tutorial_label, lv_color_hex(0xFFFF00), 0);  // Yellow
     lv_obj_set_style_text_align(tutorial_label, LV_TEXT_ALIGN_CENTER, 0);
     lv_obj_align(tutorial_label, LV_ALIGN_TOP_MID, 0, 80);
     
     // Start timer for 500ms cycles
     tutorial_timer = lv_timer_create(tutorial_timer_cb, 500, NULL);
+    ui_governor_register_timer(tutorial_timer);  // Blink is cosmetic - pause it when idle
 }
 
 static void stop_tutorial(void) {
@@ -1018,6 +1076,7 @@ static void stop_tutorial(void) {
     tutorial_active = false;
     
     if (tutorial_timer) {
+        ui_governor_unregister_timer(tutorial_timer);
         lv_timer_del(tutorial_timer);
         tutorial_timer = NULL;
     }
@@ -1031,20 +1090,37 @@ static void stop_tutorial(void) {
 // Cleanup function
 void ui_maze_cleanup(void) {
     stop_tutorial();
-    // Free canvas buffers
-    if (canvas_buffer) {
-        heap_caps_free(canvas_buffer);
-        canvas_buffer = NULL;
+    if (maze_screen) {
+        log_input_stats();
+        lv_display_remove_event_cb_with_user_data(lv_display_get_default(), maze_refr_ready_cb, NULL);
     }
-    if (player_marker_buffer) {
-        heap_caps_free(player_marker_buffer);
-        player_marker_buffer = NULL;
+    walk_stop();
+    if (walk_timer) {
+        lv_timer_del(walk_timer);
+        walk_timer = NULL;
     }
-    
+    prerender_free();
+#if CONFIG_UI_MAZE_PRERENDER
+    if (pre_timer) {
+        lv_timer_del(pre_timer);
+        pre_timer = NULL;
+    }
+    pre_canvas = NULL;
+#endif
+    latency_start_us = 0;
+    // Delete the canvases before the buffers they point at
     if (maze_screen) {
         lv_obj_del(maze_screen);
         maze_screen = NULL;
     }
+
+    // Free canvas buffers
+    ui_mem_free(canvas_buffer);
+    canvas_buffer = NULL;
+    ui_mem_free(player_marker_buffer);
+    player_marker_buffer = NULL;
+    ui_mem_free(map_buffer);
+    map_buffer = NULL;
     
     render_container = NULL;
     top_bar = NULL;
@@ -1063,7 +1139,11 @@ void ui_maze_cleanup(void) {
 
 // Main show function
 void ui_maze_show(void) {
-    ESP_LOGI(TAG, "Showing 3D Maze game");
+    UI_LOGI(TAG, "Showing 3D Maze game");
+    maze_levels_resolve();
+    ui_trace_t span = ui_trace_begin();
+    
+    ui_status_bar_set_visible(false);   // Apps draw their own top bar
     
     // Clean up previous instance if exists
     ui_maze_cleanup();
@@ -1075,8 +1155,16 @@ void ui_maze_show(void) {
     facing = 0;
     showing_map = false;
     suppress_throat_horiz = false;
+    memset(&input_stats, 0, sizeof(input_stats));
+    hit_latency_sum_us = 0;
+    miss_latency_sum_us = 0;
+    walk_held_us = 0;
     
-    // Create main container
+    // Display-level hook lives outside the screen arena
+    lv_display_add_event_cb(lv_display_get_default(), maze_refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+
+    // Create main container; its LVGL allocations come from one arena
+    ui_arena_t *arena = ui_arena_begin("maze");
     maze_screen = lv_obj_create(NULL);
     lv_obj_set_size(maze_screen, LV_HOR_RES, LV_VER_RES);
     lv_obj_set_style_bg_color(maze_screen, lv_color_black(), 0);
@@ -1129,7 +1217,7 @@ void ui_maze_show(void) {
     // Stats label - direction and position (center of top bar)
     stats_label = lv_label_create(top_bar);
     lv_obj_set_style_text_color(stats_label, lv_color_hex(0x00FFFF), 0);  // Cyan
-    lv_obj_set_style_text_font(stats_label, &lv_font_montserrat_16, 0);
+    lv_obj_set_style_text_font(stats_label, ui_assets_font(16), 0);
     update_stats_label();
     
     // Map Button - Neon style
@@ -1185,4 +1273,353 @@ void ui_maze_show(void) {
     
     // Start tutorial overlay
     start_tutorial();
+    ui_arena_end(arena, maze_screen);
+    ui_trace_end(TAG, UI_TRACE_LAYOUT, span);
 }
+
+// --- Draw unit benchmark ---
+
+// Fixed workload for ui_draw_bench(): level 1 poses in scan order and full
+// map redraws, each into an offscreen canvas
+void ui_maze_draw_bench(int frames, uint32_t *view_us, uint32_t *map_us) {
+    maze_levels_resolve();
+    *view_us = 0;
+    *map_us = 0;
+    size_t view_size = (size_t)CANVAS_WIDTH * CANVAS_HEIGHT * sizeof(lv_color_t);
+    size_t map_size = (size_t)MAP_SIZE_PX * MAP_SIZE_PX * sizeof(lv_color_t);
+    void *view_buf = heap_caps_malloc(view_size, MALLOC_CAP_SPIRAM);
+    void *map_buf = heap_caps_malloc(map_size, MALLOC_CAP_SPIRAM);
+    if (!view_buf || !map_buf) {
+        UI_LOGE(TAG, "Draw bench: no PSRAM for offscreen canvases");
+        heap_caps_free(view_buf);
+        heap_caps_free(map_buf);
+        return;
+    }
+
+    lv_obj_t *offscreen = lv_obj_create(NULL);    // Never loaded
+    lv_obj_t *canvas = lv_canvas_create(offscreen);
+    lv_canvas_set_buffer(canvas, view_buf, CANVAS_WIDTH, CANVAS_HEIGHT, LV_COLOR_FORMAT_RGB565);
+    lv_obj_t *map = lv_canvas_create(offscreen);
+    lv_canvas_set_buffer(map, map_buf, MAP_SIZE_PX, MAP_SIZE_PX, LV_COLOR_FORMAT_RGB565);
+
+    uint64_t total_us = 0;
+    int n = 0;
+    for (int r = 1; r < MAZE_SIZE - 1 && n < frames; r++) {
+        for (int c = 1; c < MAZE_SIZE - 1 && n < frames; c++) {
+            if (maze_view_wall_at(maze[0], r, c)) continue;
+            maze_pose_t pose = { .level = 0, .row = r, .col = c, .facing = n % 4, .suppress_throat_horiz = false };
+            maze_view_t view;
+            maze_view_build(maze[0], &pose, &view);
+            int64_t t0 = esp_timer_get_time();
+            render_view(canvas, &view);
+            total_us += esp_timer_get_time() - t0;
+            n++;
+        }
+    }
+    *view_us = n ? (uint32_t)(total_us / n) : 0;
+
+    total_us = 0;
+    for (int i = 0; i < frames; i++) {
+        int64_t t0 = esp_timer_get_time();
+        ui_fill_canvas(map, lv_color_black());
+        render_map(map, i % LEVEL_COUNT);
+        total_us += esp_timer_get_time() - t0;
+    }
+    *map_us = frames ? (uint32_t)(total_us / frames) : 0;
+
+    lv_obj_del(offscreen);
+    heap_caps_free(view_buf);
+    heap_caps_free(map_buf);
+}
+
+// --- Per-move log cost ---
+
+typedef enum {
+    MOVE_LOGS_OFF,              // As built at the default level: compiled out
+    MOVE_LOGS_DEFERRED,         // Debug level with CONFIG_UI_LOG_DEFERRED
+    MOVE_LOGS_SYNC,             // The synchronous ESP_LOGI they used to be
+    MOVE_LOGS_MODES,
+} move_logs_t;
+
+#define BENCH_LOG(mode, fmt, ...) do { \
+        if ((mode) == MOVE_LOGS_DEFERRED) { \
+            ui_log_deferred(ESP_LOG_DEBUG, TAG, fmt, UI_LOG_NARGS(__VA_ARGS__), __VA_ARGS__); \
+        } else if ((mode) == MOVE_LOGS_SYNC) { \
+            ESP_LOGI(TAG, fmt, __VA_ARGS__); \
+        } \
+    } while (0)
+
+// Scripted route moves on level 1 (restarting at the exit); returns the average
+static uint32_t bench_moves(lv_obj_t *canvas, move_logs_t mode, int moves, uint32_t *max_us) {
+    maze_pose_t pose;
+    maze_view_route_start(0, &pose);
+    uint64_t total_us = 0;
+    *max_us = 0;
+
+    for (int i = 0; i < moves; i++) {
+        int64_t t0 = esp_timer_get_time();
+        BENCH_LOG(mode, MOVE_FMT_TOUCH, 300, 100);
+        BENCH_LOG(mode, MOVE_FMT_DRAW, pose.row, (unsigned long)pose.col, pose.facing);
+        maze_view_t view;
+        maze_view_build(maze[0], &pose, &view);
+        const occupancy_pattern_t *o = &view.pattern;
+        BENCH_LOG(mode, MOVE_FMT_OCCUPANCY, o->L0, o->R0, o->L1, o->C1, o->R1, o->C2, o->L3, o->C3, o->R3);
+        render_view(canvas, &view);
+        BENCH_LOG(mode, MOVE_FMT_DONE, view.count);
+        uint32_t us = (uint32_t)(esp_timer_get_time() - t0);
+        total_us += us;
+        if (us > *max_us) *max_us = us;
+
+        if (!maze_view_route_next(maze[0], &pose)) maze_view_route_start(0, &pose);
+    }
+    return moves ? (uint32_t)(total_us / moves) : 0;
+}
+
+void ui_maze_log_bench(int moves) {
+    static const char *const mode_name[MOVE_LOGS_MODES] = { "no logs", "deferred", "ESP_LOGI" };
+    uint32_t avg_us[MOVE_LOGS_MODES] = { 0 }, max_us[MOVE_LOGS_MODES] = { 0 };
+
+    maze_levels_resolve();
+    size_t buf_size = (size_t)CANVAS_WIDTH * CANVAS_HEIGHT * sizeof(lv_color_t);
+    void *buf = heap_caps_malloc(buf_size, MALLOC_CAP_SPIRAM);
+    if (!buf) {
+        UI_LOGE(TAG, "Log bench: no PSRAM for offscreen canvas");
+        return;
+    }
+    lv_obj_t *offscreen = lv_obj_create(NULL);    // Never loaded
+    lv_obj_t *canvas = lv_canvas_create(offscreen);
+    lv_canvas_set_buffer(canvas, buf, CANVAS_WIDTH, CANVAS_HEIGHT, LV_COLOR_FORMAT_RGB565);
+
+    uint32_t dropped = ui_log_get_dropped();
+    for (int m = 0; m < MOVE_LOGS_MODES; m++) {
+#if !CONFIG_UI_LOG_DEFERRED
+        if (m == MOVE_LOGS_DEFERRED) continue;    // ui_log_deferred() does nothing
+#endif
+        avg_us[m] = bench_moves(canvas, (move_logs_t)m, moves, &max_us[m]);
+        vTaskDelay(pdMS_TO_TICKS(200));           // Let the deferred records drain first
+    }
+
+    lv_obj_del(offscreen);
+    heap_caps_free(buf);
+
+    for (int m = 0; m < MOVE_LOGS_MODES; m++) {
+        UI_LOGI(TAG, "Log bench, %d moves with %-8s: avg %lu us max %lu us (%+ld us vs no logs)",
+                moves, mode_name[m], (unsigned long)avg_us[m], (unsigned long)max_us[m],
+                (long)avg_us[m] - (long)avg_us[MOVE_LOGS_OFF]);
+    }
+#if CONFIG_UI_LOG_DEFERRED
+    UI_LOGI(TAG, "Log bench: %lu deferred records dropped (ring of %d)",
+            (unsigned long)(ui_log_get_dropped() - dropped), CONFIG_UI_LOG_DEFERRED_ENTRIES);
+#else
+    (void)dropped;
+    UI_LOGI(TAG, "Log bench: CONFIG_UI_LOG_DEFERRED is off, deferred mode not measured");
+#endif
+}
+
+// --- Render regression check ---
+
+#if CONFIG_UI_MAZE_RENDER_CHECK
+
+// Sparse-sampled canvas hash of the scripted route, per built-in level.
+// Depends on LVGL's rasterizer and the panel size, so it is recorded on the
+// board: run the check and paste the printed values. 0 = not recorded yet;
+// the value is logged and not compared. The display-list goldens are in
+// ui_maze_view.c.
+static const uint32_t golden_route_pixel_hash[LEVEL_COUNT] = {
+    0, 0, 0,
+};
+
+static size_t allocated_blocks(void) {
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+    return info.allocated_blocks;
+}
+
+// Every pose of a level: geometry hash, R9C8N invariant and build time
+static bool check_level_geometry(int lvl, bool builtin) {
+    uint32_t h = 2166136261u;
+    uint32_t poses = 0, max_us = 0;
+    uint64_t total_us = 0;
+    bool ok = true;
+
+    for (int r = 0; r < MAZE_SIZE; r++) {
+        for (int c = 0; c < MAZE_SIZE; c++) {
+            if (maze_view_wall_at(maze[lvl], r, c)) continue;
+            for (int f = 0; f < 4; f++) {
+                for (int s = 0; s < 2; s++) {
+                    maze_pose_t pose = { .level = lvl, .row = r, .col = c, .facing = f, .suppress_throat_horiz = s };
+                    maze_view_t view;
+                    int64_t t0 = esp_timer_get_time();
+                    maze_view_build(maze[lvl], &pose, &view);
+                    uint32_t us = (uint32_t)(esp_timer_get_time() - t0);
+                    total_us += us;
+                    if (us > max_us) max_us = us;
+                    poses++;
+
+                    if (!maze_view_check_r9c8n(&pose, &view)) {
+                        UI_LOGE(TAG, "FAIL level %d: R9C8N invariant broken (facing %d, throat %d)", lvl + 1, f, s);
+                        ok = false;
+                    }
+                    h = maze_view_fold(h, maze_view_hash(&view));
+                }
+            }
+        }
+    }
+
+    if (builtin && h != maze_view_golden_level[lvl]) {
+        UI_LOGE(TAG, "FAIL level %d: geometry hash 0x%08lx, golden 0x%08lx",
+                lvl + 1, (unsigned long)h, (unsigned long)maze_view_golden_level[lvl]);
+        ok = false;
+    }
+    if (max_us > CONFIG_UI_MAZE_RENDER_CHECK_MAX_BUILD_US) {
+        UI_LOGE(TAG, "FAIL level %d: display-list build max %lu us > %d us",
+                lvl + 1, (unsigned long)max_us, CONFIG_UI_MAZE_RENDER_CHECK_MAX_BUILD_US);
+        ok = false;
+    }
+    UI_LOGI(TAG, "Level %d geometry: %lu poses, hash 0x%08lx, build avg %lu us max %lu us",
+            lvl + 1, (unsigned long)poses, (unsigned long)h,
+            (unsigned long)(total_us / (poses ? poses : 1)), (unsigned long)max_us);
+    return ok;
+}
+
+// Scripted route to the level's exit rasterized into an offscreen canvas:
+// display-list and pixel hashes, frame time, allocations per frame and
+// leaked allocations
+static bool check_level_route(int lvl, lv_obj_t *canvas, bool builtin) {
+    maze_pose_t pose;
+    size_t buf_size = (size_t)CANVAS_WIDTH * CANVAS_HEIGHT * sizeof(lv_color_t);
+    uint32_t route_hash = 2166136261u;
+    uint32_t pixel_hash = 2166136261u;
+    uint32_t max_us = 0;
+    uint64_t total_us = 0;
+    int32_t max_allocs = 0;
+    uint32_t total_allocs = 0;
+    size_t blocks_before = allocated_blocks();
+    bool ok = true;
+    int frames = 0;
+
+    maze_view_route_start(lvl, &pose);
+    for (int step = 0; step < MAZE_VIEW_ROUTE_STEPS; step++) {
+        maze_view_t view;
+        ui_mem_alloc_count_begin();
+        int64_t t0 = esp_timer_get_time();
+        maze_view_build(maze[lvl], &pose, &view);
+        render_view(canvas, &view);
+        uint32_t us = (uint32_t)(esp_timer_get_time() - t0);
+        int32_t allocs = ui_mem_alloc_count_end();
+        total_us += us;
+        if (us > max_us) max_us = us;
+        if (allocs > max_allocs) max_allocs = allocs;
+        if (allocs > 0) total_allocs += allocs;
+        frames++;
+
+        route_hash = maze_view_fold(route_hash, maze_view_hash(&view));
+        const uint32_t *px = (const uint32_t *)lv_canvas_get_buf(canvas);
+        for (size_t i = 0; i < buf_size / 4; i += 61) {   // Sparse sample keeps the check fast
+            pixel_hash = maze_view_fold(pixel_hash, px[i]);
+        }
+
+        if (!maze_view_route_next(maze[lvl], &pose)) break;
+    }
+
+    if (!maze_view_route_done(&pose)) {
+        UI_LOGE(TAG, "FAIL level %d: route stops at R%dC%d after %d frames, no exit",
+                lvl + 1, pose.row + 1, pose.col + 1, frames);
+        ok = false;
+    }
+
+    if (builtin && route_hash != maze_view_golden_route[lvl]) {
+        UI_LOGE(TAG, "FAIL level %d: route display-list hash 0x%08lx, golden 0x%08lx",
+                lvl + 1, (unsigned long)route_hash, (unsigned long)maze_view_golden_route[lvl]);
+        ok = false;
+    }
+    if (builtin && golden_route_pixel_hash[lvl] == 0) {
+        UI_LOGW(TAG, "Level %d: no golden pixel hash recorded yet, this board gives 0x%08lx",
+                lvl + 1, (unsigned long)pixel_hash);
+    } else if (builtin && pixel_hash != golden_route_pixel_hash[lvl]) {
+        UI_LOGE(TAG, "FAIL level %d: route pixel hash 0x%08lx, golden 0x%08lx",
+                lvl + 1, (unsigned long)pixel_hash, (unsigned long)golden_route_pixel_hash[lvl]);
+        ok = false;
+    }
+    size_t blocks_after = allocated_blocks();
+    if (blocks_after > blocks_before) {
+        UI_LOGE(TAG, "FAIL level %d: %u allocations still alive after route",
+                lvl + 1, (unsigned)(blocks_after - blocks_before));
+        ok = false;
+    }
+    if (max_us > CONFIG_UI_MAZE_RENDER_CHECK_MAX_FRAME_US) {
+        UI_LOGE(TAG, "FAIL level %d: frame max %lu us > %d us",
+                lvl + 1, (unsigned long)max_us, CONFIG_UI_MAZE_RENDER_CHECK_MAX_FRAME_US);
+        ok = false;
+    }
+    if (max_allocs > CONFIG_UI_MAZE_RENDER_CHECK_MAX_FRAME_ALLOCS) {
+        UI_LOGE(TAG, "FAIL level %d: %ld allocations in one frame > %d",
+                lvl + 1, (long)max_allocs, CONFIG_UI_MAZE_RENDER_CHECK_MAX_FRAME_ALLOCS);
+        ok = false;
+    }
+    UI_LOGI(TAG, "Level %d route: %d frames, avg %lu us max %lu us, allocs/frame avg %lu max %ld, "
+            "display-list hash 0x%08lx, pixel hash 0x%08lx",
+            lvl + 1, frames, (unsigned long)(total_us / frames), (unsigned long)max_us,
+            (unsigned long)(total_allocs / frames), (long)max_allocs,
+            (unsigned long)route_hash, (unsigned long)pixel_hash);
+    return ok;
+}
+
+bool ui_maze_render_check(void) {
+    bool ok = true;
+    UI_LOGI(TAG, "Render check starting");
+    maze_levels_resolve();
+    // The goldens describe the built-in levels, not an asset pack's
+    bool builtin = maze == maze_view_builtin;
+    if (!builtin) UI_LOGW(TAG, "Levels from the asset pack: hashes are logged, not compared");
+
+    for (int lvl = 0; lvl < LEVEL_COUNT; lvl++) {
+        ok &= check_level_geometry(lvl, builtin);
+    }
+
+    size_t buf_size = (size_t)CANVAS_WIDTH * CANVAS_HEIGHT * sizeof(lv_color_t);
+    void *buf = heap_caps_malloc(buf_size, MALLOC_CAP_SPIRAM);
+    if (buf) {
+        lv_obj_t *offscreen = lv_obj_create(NULL);    // Never loaded
+        lv_obj_t *canvas = lv_canvas_create(offscreen);
+        lv_canvas_set_buffer(canvas, buf, CANVAS_WIDTH, CANVAS_HEIGHT, LV_COLOR_FORMAT_RGB565);
+        lv_obj_set_size(canvas, CANVAS_WIDTH, CANVAS_HEIGHT);
+        for (int lvl = 0; lvl < LEVEL_COUNT; lvl++) {
+            ok &= check_level_route(lvl, canvas, builtin);
+        }
+        lv_obj_del(offscreen);
+        heap_caps_free(buf);
+    } else {
+        UI_LOGE(TAG, "FAIL: no PSRAM for offscreen canvas");
+        ok = false;
+    }
+
+    if (ok) {
+        UI_LOGI(TAG, "Render check PASSED");
+    } else {
+        UI_LOGE(TAG, "Render check FAILED");
+#if CONFIG_UI_MAZE_RENDER_CHECK_ABORT
+        abort();
+#endif
+    }
+    return ok;
+}
+
+#else
+
+bool ui_maze_render_check(void) {
+    return true;
+}
+
+#endif
+
+const ui_app_t ui_app_maze = {
+    .name = "Maze",
+    .icon = LV_SYMBOL_SHUFFLE,
+    .color = 0x2196F3,              // LV_PALETTE_BLUE
+    .mem_app = UI_MEM_APP_MAZE,
+    // View canvas + 4 pre-render slots at up to 600x390, 576x576 map, marker
+    .mem_budget = 3200 * 1024,
+    .create = ui_maze_show,
+    .destroy = ui_maze_cleanup,
+};
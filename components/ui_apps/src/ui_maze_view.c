@@ -0,0 +1,431 @@
+#include "ui_maze_view.h"
+#include <math.h>
+#include <stddef.h>
+
+#define PERSPECTIVE_SHORTEN 10             // Shorten connectors by 10px at vanishing point
+
+// Opening geometry: centered around screen mid (160,85)
+#define INNER_TOP_Y         30             // closer to top for larger near opening
+#define INNER_BOTTOM_Y      140            // closer to bottom for larger near opening
+#define OPENING_H           (INNER_BOTTOM_Y - INNER_TOP_Y)   // visible vertical span
+#define OPENING_W           (OPENING_H + 30)                 // widen by ~15px each side
+#define OPENING_CENTER_X    160
+#define INNER_LEFT_X        (OPENING_CENTER_X - (OPENING_W / 2))
+#define INNER_RIGHT_X       (OPENING_CENTER_X + (OPENING_W / 2))
+#define VANISH_X            160
+#define VANISH_Y            85
+
+bool maze_view_wall_at(const uint32_t *rows, int row, int col) {
+    if (row < 0 || row >= 32 || col < 0 || col >= 32) {
+        return true;  // Out of bounds = wall
+    }
+    return (rows[row] & (1UL << (31 - col))) != 0;
+}
+
+// Check wall using relative offsets from player: forward (>0 toward facing), right (>0 to the right)
+static bool wall_rel(const uint32_t *rows, const maze_pose_t *p, int off_forward, int off_right) {
+    int r = p->row;
+    int c = p->col;
+
+    switch (p->facing) {
+        case 0: // North
+            r -= off_forward;
+            c += off_right;
+            break;
+        case 1: // East
+            r += off_right;
+            c += off_forward;
+            break;
+        case 2: // South
+            r += off_forward;
+            c -= off_right;
+            break;
+        case 3: // West
+            r -= off_right;
+            c -= off_forward;
+            break;
+    }
+    return maze_view_wall_at(rows, r, c);
+}
+
+static occupancy_pattern_t get_occupancy_pattern(const uint32_t *rows, const maze_pose_t *p) {
+    occupancy_pattern_t pattern = {0};
+
+    pattern.L0 = wall_rel(rows, p, 0, -1);
+    pattern.R0 = wall_rel(rows, p, 0, 1);
+
+    pattern.L1 = wall_rel(rows, p, 1, -1);
+    pattern.C1 = wall_rel(rows, p, 1, 0);
+    pattern.R1 = wall_rel(rows, p, 1, 1);
+
+    pattern.L2 = wall_rel(rows, p, 2, -1);
+    pattern.C2 = wall_rel(rows, p, 2, 0);
+    pattern.R2 = wall_rel(rows, p, 2, 1);
+
+    pattern.L3 = wall_rel(rows, p, 3, -1);
+    pattern.C3 = wall_rel(rows, p, 3, 0);
+    pattern.R3 = wall_rel(rows, p, 3, 1);
+
+    pattern.L4 = wall_rel(rows, p, 4, -1);
+    pattern.C4 = wall_rel(rows, p, 4, 0);
+    pattern.R4 = wall_rel(rows, p, 4, 1);
+
+    pattern.L5 = wall_rel(rows, p, 5, -1);
+    pattern.C5 = wall_rel(rows, p, 5, 0);
+    pattern.R5 = wall_rel(rows, p, 5, 1);
+
+    return pattern;
+}
+
+static void add_line(maze_view_t *v, int x1, int y1, int x2, int y2, int width) {
+    if (v->count >= MAZE_VIEW_MAX_SEGS) return;
+    maze_seg_t *s = &v->segs[v->count++];
+    s->x1 = (int16_t)x1;
+    s->y1 = (int16_t)y1;
+    s->x2 = (int16_t)x2;
+    s->y2 = (int16_t)y2;
+    s->width = (uint8_t)width;
+}
+
+// Line shortened by `shorten_px` at the endpoint (x2,y2), pulling back toward (x1,y1)
+static void add_line_shortened_to(maze_view_t *v, int x1, int y1, int x2, int y2, int shorten_px, int width) {
+    int dx = x2 - x1;
+    int dy = y2 - y1;
+    int len = (int)sqrtf((float)(dx * dx + dy * dy));
+    if (len <= 0) {
+        add_line(v, x1, y1, x2, y2, width);
+        return;
+    }
+    int end_x = x2 - (dx * shorten_px) / len;
+    int end_y = y2 - (dy * shorten_px) / len;
+    add_line(v, x1, y1, end_x, end_y, width);
+}
+
+// Vertical depth marker t of the way from the throat towards the vanishing point
+static void add_depth_markers(maze_view_t *v, double t, bool left, bool right, int width) {
+    int lx = (int)(INNER_LEFT_X  + t * (VANISH_X - INNER_LEFT_X));
+    int rx = (int)(INNER_RIGHT_X + t * (VANISH_X - INNER_RIGHT_X));
+    int y_top = (int)(INNER_TOP_Y    + t * (VANISH_Y - INNER_TOP_Y));
+    int y_bot = (int)(INNER_BOTTOM_Y + t * (VANISH_Y - INNER_BOTTOM_Y));
+    if (left)  add_line(v, lx, y_top, lx, y_bot, width);
+    if (right) add_line(v, rx, y_top, rx, y_bot, width);
+}
+
+void maze_view_build(const uint32_t *rows, const maze_pose_t *pose, maze_view_t *out) {
+    out->count = 0;
+    out->pattern = get_occupancy_pattern(rows, pose);
+    const occupancy_pattern_t *pattern = &out->pattern;
+
+    bool wall_ahead      = pattern->C1;
+    bool wall_left_near  = pattern->L0;
+    bool wall_right_near = pattern->R0;
+
+    // Draw corridor frame unconditionally when the path ahead is open
+    if (!wall_ahead) {
+        // Inner verticals (throat)
+        add_line(out, INNER_LEFT_X, INNER_TOP_Y, INNER_LEFT_X, INNER_BOTTOM_Y, 2);
+        add_line(out, INNER_RIGHT_X, INNER_TOP_Y, INNER_RIGHT_X, INNER_BOTTOM_Y, 2);
+
+        // Optionally add inner top/bottom to form full throat rectangle (R9C8 view)
+        if (!pose->suppress_throat_horiz) {
+            // Extend horizontals only to display edges (no segment between inner verticals)
+            add_line(out, 0, INNER_TOP_Y, INNER_LEFT_X, INNER_TOP_Y, 2);                     // top left extension
+            add_line(out, INNER_RIGHT_X, INNER_TOP_Y, MAZE_VIEW_W, INNER_TOP_Y, 2);          // top right extension
+            add_line(out, 0, INNER_BOTTOM_Y, INNER_LEFT_X, INNER_BOTTOM_Y, 2);               // bottom left extension
+            add_line(out, INNER_RIGHT_X, INNER_BOTTOM_Y, MAZE_VIEW_W, INNER_BOTTOM_Y, 2);    // bottom right extension
+        }
+
+        // Perspective connectors: join inner corners to screen center (vanishing point)
+        add_line_shortened_to(out, INNER_LEFT_X,  INNER_TOP_Y,    VANISH_X, VANISH_Y, PERSPECTIVE_SHORTEN, 2);
+        add_line_shortened_to(out, INNER_RIGHT_X, INNER_TOP_Y,    VANISH_X, VANISH_Y, PERSPECTIVE_SHORTEN, 2);
+        add_line_shortened_to(out, INNER_LEFT_X,  INNER_BOTTOM_Y, VANISH_X, VANISH_Y, PERSPECTIVE_SHORTEN, 2);
+        add_line_shortened_to(out, INNER_RIGHT_X, INNER_BOTTOM_Y, VANISH_X, VANISH_Y, PERSPECTIVE_SHORTEN, 2);
+
+        // Far-end vertical connectors showing corridor depth
+        // Depth factors reverse-engineered from original Arduino code's hard-coded coordinates
+        // Original coordinates: depth1=(80,242), depth2=(120,200), depth3=(150,170), depth4=(158,162)
+        // With throat at (20,300) and vanishing point at (160,85):
+        const double t1 = 0.43;  // 1 cube ahead: x=80 from 20, matches original depth 1
+        const double t2 = 0.71;  // 2 cubes ahead: x=120 from 20, matches original depth 2
+        const double t3 = 0.93;  // 3 cubes ahead: x=150 from 20, matches original depth 3
+        const double t4 = 0.99;  // 4 cubes ahead: x=158 from 20, matches original depth 4 (far end)
+
+        // Draw at each depth where there's still corridor (not blocked),
+        // individual lines even if only one side has a wall (shows depth better)
+        if (!pattern->C1) add_depth_markers(out, t1, pattern->L1, pattern->R1, 2);
+        if (!pattern->C2) add_depth_markers(out, t2, pattern->L2, pattern->R2, 2);
+        if (!pattern->C3) add_depth_markers(out, t3, pattern->L3, pattern->R3, 2);
+        // Far end - very close to vanishing point, thinner line
+        if (!pattern->C4) add_depth_markers(out, t4, true, true, 1);
+    }
+
+    // Near side walls: draw outer verticals only when wall is present
+    // (trapezoid is closed by the inner verticals and the diagonals above)
+    if (wall_left_near) {
+        add_line(out, 0, 0, 0, MAZE_VIEW_H, 2);
+    }
+    if (wall_right_near) {
+        add_line(out, MAZE_VIEW_W, 0, MAZE_VIEW_W, MAZE_VIEW_H, 2);
+    }
+
+    // Wall ahead as a large wireframe rectangle
+    if (wall_ahead) {
+        // Wall rectangle (scaled to 90% of canvas and centered)
+        int wall_w = (MAZE_VIEW_W * 90) / 100;
+        int wall_h = (MAZE_VIEW_H * 90) / 100;
+        int wall_x = (MAZE_VIEW_W - wall_w) / 2;
+        int wall_y = (MAZE_VIEW_H - wall_h) / 2;
+        add_line(out, wall_x,        wall_y,        wall_x+wall_w, wall_y,        2); // top
+        add_line(out, wall_x,        wall_y+wall_h, wall_x+wall_w, wall_y+wall_h, 2); // bottom
+        add_line(out, wall_x,        wall_y,        wall_x,        wall_y+wall_h, 2); // left
+        add_line(out, wall_x+wall_w, wall_y,        wall_x+wall_w, wall_y+wall_h, 2); // right
+        // Perspective connectors from wall corners to vanishing point
+        add_line_shortened_to(out, wall_x,        wall_y,        VANISH_X, VANISH_Y, PERSPECTIVE_SHORTEN, 2); // top-left corner
+        add_line_shortened_to(out, wall_x+wall_w, wall_y,        VANISH_X, VANISH_Y, PERSPECTIVE_SHORTEN, 2); // top-right corner
+        add_line_shortened_to(out, wall_x,        wall_y+wall_h, VANISH_X, VANISH_Y, PERSPECTIVE_SHORTEN, 2); // bottom-left corner
+        add_line_shortened_to(out, wall_x+wall_w, wall_y+wall_h, VANISH_X, VANISH_Y, PERSPECTIVE_SHORTEN, 2); // bottom-right corner
+    }
+}
+
+static uint32_t fnv1a(uint32_t h, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        h ^= (v >> (i * 8)) & 0xFF;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+uint32_t maze_view_hash(const maze_view_t *view) {
+    uint32_t h = 2166136261u;
+    h = fnv1a(h, view->count);
+    for (uint8_t i = 0; i < view->count; i++) {
+        const maze_seg_t *s = &view->segs[i];
+        h = fnv1a(h, ((uint32_t)(uint16_t)s->x1 << 16) | (uint16_t)s->y1);
+        h = fnv1a(h, ((uint32_t)(uint16_t)s->x2 << 16) | (uint16_t)s->y2);
+        h = fnv1a(h, s->width);
+    }
+    return h;
+}
+
+static bool has_seg(const maze_view_t *v, int x1, int y1, int x2, int y2) {
+    for (uint8_t i = 0; i < v->count; i++) {
+        const maze_seg_t *s = &v->segs[i];
+        if (s->x1 == x1 && s->y1 == y1 && s->x2 == x2 && s->y2 == y2) return true;
+    }
+    return false;
+}
+
+bool maze_view_check_r9c8n(const maze_pose_t *pose, const maze_view_t *view) {
+    const occupancy_pattern_t *p = &view->pattern;
+    bool applies = pose->row == 8 && pose->col == 7 && pose->facing == 0 &&
+                   !pose->suppress_throat_horiz && !p->C1 && !p->L0 && !p->R0;
+    if (!applies) return true;
+
+    // Inner verticals
+    if (!has_seg(view, INNER_LEFT_X, INNER_TOP_Y, INNER_LEFT_X, INNER_BOTTOM_Y)) return false;
+    if (!has_seg(view, INNER_RIGHT_X, INNER_TOP_Y, INNER_RIGHT_X, INNER_BOTTOM_Y)) return false;
+
+    // Top/bottom horizontals out to the display edges
+    if (!has_seg(view, 0, INNER_TOP_Y, INNER_LEFT_X, INNER_TOP_Y)) return false;
+    if (!has_seg(view, INNER_RIGHT_X, INNER_TOP_Y, MAZE_VIEW_W, INNER_TOP_Y)) return false;
+    if (!has_seg(view, 0, INNER_BOTTOM_Y, INNER_LEFT_X, INNER_BOTTOM_Y)) return false;
+    if (!has_seg(view, INNER_RIGHT_X, INNER_BOTTOM_Y, MAZE_VIEW_W, INNER_BOTTOM_Y)) return false;
+
+    // No horizontal segment spanning between the inner verticals
+    for (uint8_t i = 0; i < view->count; i++) {
+        const maze_seg_t *s = &view->segs[i];
+        if (s->y1 != s->y2) continue;
+        int lo = s->x1 < s->x2 ? s->x1 : s->x2;
+        int hi = s->x1 < s->x2 ? s->x2 : s->x1;
+        if (hi > INNER_LEFT_X && lo < INNER_RIGHT_X) return false;
+    }
+    return true;
+}
+
+// --- Built-in levels and goldens ---
+
+const uint32_t maze_view_builtin[MAZE_VIEW_LEVELS][32] = {
+    { // Level 1
+        0b11111111111111111111111111111111,
+        0b10001000000000000000000000000001,
+        0b10101010101111111111111111111111,
+        0b10101000000000000000000000000001,
+        0b10101010101111111101111111111101,
+        0b10101000000000000000100001000101,
+        0b10101010101111111110101011010101,
+        0b10101010100000000000101001010101,
+        0b10100000001111111110101101010101,
+        0b10111111111000000000101001010001,
+        0b10000000000011111111101011011111,
+        0b11111110111110000000101000010001,
+        0b10000000000010111111101111110101,
+        0b10111110111010100000001000000101,
+        0b10100010100010101111111011111101,
+        0b10101010101110100000000010000001,
+        0b10101010101000111111111110111111,
+        0b10101010101010000000000000100001,
+        0b10101010101010111111111111101101,
+        0b10101010101010000000000000001001,
+        0b10101010101011111111111111111011,
+        0b10001000101000000000001000001001,
+        0b11111111101011111111101010101101,
+        0b10000000001010001000101010100101,
+        0b10111111111010101010101010110001,
+        0b10000100011010101010101010011111,
+        0b10110001010000101010100001000000,
+        0b10011111010111101010111111011111,
+        0b10100010010100001010000001000001,
+        0b10101011110101111011111101111101,
+        0b10001000000100000010000000000001,
+        0b11111111111111111111111111111111
+    },
+    { // Level 2
+        0b11111111111111111111111111111111,
+        0b10010000000000001000000000000001,
+        0b10111101111110111111101111111011,
+        0b10100000000010000001000000010001,
+        0b10111111011111010101010101010101,
+        0b10000000000000010000000100000101,
+        0b10111111111111111111111111111001,
+        0b10001000100000000000100010001011,
+        0b10101010101111111110101010101011,
+        0b10100010001000000010001000100001,
+        0b10111111111011111011111111111101,
+        0b10000000100010001000000000000001,
+        0b10111110101010101111111111111111,
+        0b10000010101010100000000100010001,
+        0b11111010101010111111110101010101,
+        0b10000010101010100000000001000101,
+        0b10111110101000101111111111111101,
+        0b10000010101111111000100010000101,
+        0b11111010001000000010001000100001,
+        0b10000011111111111111111111111101,
+        0b10111110000100000000100010000001,
+        0b10000000110101111110101010111111,
+        0b10111111100101000000101010000001,
+        0b10000010000101011111101011111101,
+        0b11111010111101000000001000000001,
+        0b10001010100011111111101111111111,
+        0b10101010101000000000101000010000,
+        0b10101010101111111111101011010101,
+        0b10100010001000000000001001000101,
+        0b10111110101011111111111111111101,
+        0b10000000100000000000000000000001,
+        0b11111111111111111111111111111111
+    },
+    { // Level 3
+        0b11111111111111111111111111111111,
+        0b10010000000000001000000000000001,
+        0b10111101111110111111101111111011,
+        0b10100000000010000001000000010001,
+        0b10111111011111010101010101011101,
+        0b10000000000000010000000100000101,
+        0b10111111111111111111111111111001,
+        0b10001000100000000000100010001011,
+        0b10101010101111111110101010101011,
+        0b10100010001000000010001000100001,
+        0b10111111111011111011111111111101,
+        0b10000000100010001000000000000001,
+        0b10111110101010101111111111111111,
+        0b10000010101010100000000100010001,
+        0b11111010101010111111110101010101,
+        0b10000010101010100000000001000101,
+        0b10111110101000101111111111111101,
+        0b10000010101111111000100010000101,
+        0b11111010001000000010001000100001,
+        0b10000011111111111111111111111101,
+        0b10111110000100000000100010000001,
+        0b10000000110101111110101010111111,
+        0b10111111100101000000101010000001,
+        0b10000010000101011111101011111101,
+        0b11111010111101000000001000000001,
+        0b10001010100011111111101111111111,
+        0b10101010101000000000101000010001,
+        0b10101010101111111111101011010101,
+        0b10100010101000000000001001000101,
+        0b10111110101011111111111111111100,
+        0b10000000100000000000000000000001,
+        0b11111111111111111111111111111111
+    }
+};
+
+// Folded maze_view_hash() of every open cell x facing x throat flag, per level.
+// If a geometry change is intended, run tools/maze_golden.c and paste the printed values.
+const uint32_t maze_view_golden_level[MAZE_VIEW_LEVELS] = {
+    0xa7b57b01, 0x01525a3d, 0x649c39cf,
+};
+
+// Folded maze_view_hash() of every frame of the scripted route to the exit, per level
+const uint32_t maze_view_golden_route[MAZE_VIEW_LEVELS] = {
+    0x2639a753, 0xcce4e77f, 0x289e0b25,
+};
+
+uint32_t maze_view_fold(uint32_t h, uint32_t v) {
+    return fnv1a(h, v);
+}
+
+void maze_view_route_start(int level, maze_pose_t *pose) {
+    *pose = (maze_pose_t){ .level = level, .row = 8, .col = 7, .facing = 0, .suppress_throat_horiz = false };
+}
+
+// One cell forward, per facing (0=north 1=east 2=south 3=west)
+static const int step_dr[4] = { -1, 0, 1, 0 };
+static const int step_dc[4] = { 0, 1, 0, -1 };
+
+static bool on_border(int row, int col) {
+    return row == 0 || col == 0 || row == 31 || col == 31;
+}
+
+// Steps from each open cell to the nearest open border cell (the exits),
+// by breadth-first search outwards from all of them; UINT16_MAX if none
+static void exit_distances(const uint32_t *rows, uint16_t dist[32 * 32]) {
+    uint16_t queue[32 * 32];
+    int head = 0, tail = 0;
+    for (int i = 0; i < 32 * 32; i++) {
+        dist[i] = UINT16_MAX;
+        if (on_border(i / 32, i % 32) && !maze_view_wall_at(rows, i / 32, i % 32)) {
+            dist[i] = 0;
+            queue[tail++] = (uint16_t)i;
+        }
+    }
+    while (head < tail) {
+        int cell = queue[head++];
+        for (int f = 0; f < 4; f++) {
+            int r = cell / 32 + step_dr[f], c = cell % 32 + step_dc[f];
+            if (maze_view_wall_at(rows, r, c) || dist[r * 32 + c] != UINT16_MAX) continue;
+            dist[r * 32 + c] = dist[cell] + 1;
+            queue[tail++] = (uint16_t)(r * 32 + c);
+        }
+    }
+}
+
+bool maze_view_route_next(const uint32_t *rows, maze_pose_t *pose) {
+    uint16_t dist[32 * 32];
+    exit_distances(rows, dist);
+    uint16_t here = dist[pose->row * 32 + pose->col];
+    if (here == 0 || here == UINT16_MAX) return false;     // At an exit, or walled in
+
+    // Closer to an exit: ahead if possible, else right, left, behind
+    static const int turn_order[4] = { 0, 1, 3, 2 };
+    int want = -1;
+    for (int i = 0; i < 4 && want < 0; i++) {
+        int f = (pose->facing + turn_order[i]) % 4;
+        int r = pose->row + step_dr[f], c = pose->col + step_dc[f];
+        if (!maze_view_wall_at(rows, r, c) && dist[r * 32 + c] < here) want = f;
+    }
+
+    if (want == pose->facing) {
+        pose->row += step_dr[want];
+        pose->col += step_dc[want];
+        pose->suppress_throat_horiz = true;
+    } else {
+        // One quarter turn per frame, as the player turns; behind goes right
+        pose->facing = (want - pose->facing + 4) % 4 == 3 ? (pose->facing + 3) % 4 : (pose->facing + 1) % 4;
+        pose->suppress_throat_horiz = false;
+    }
+    return true;
+}
+
+bool maze_view_route_done(const maze_pose_t *pose) {
+    return on_border(pose->row, pose->col);
+}
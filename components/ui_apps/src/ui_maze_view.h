@@ -0,0 +1,127 @@
+#pragma once
+
+/**
+ * Maze 3D view geometry, independent of LVGL.
+ *
+ * maze_view_build() turns a pose into a display list of line segments in the
+ * original 320x170 design space. ui_maze.c scales and rasterizes the list;
+ * the render check hashes it, so geometry changes are caught without pixels.
+ * The built-in levels and their display-list goldens live here too, so
+ * tools/maze_golden.c can check them on the host.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAZE_VIEW_W         320
+#define MAZE_VIEW_H         170
+#define MAZE_VIEW_MAX_SEGS  32
+#define MAZE_VIEW_LEVELS    3
+#define MAZE_VIEW_ROUTE_STEPS 256  // Longest built-in route is 193 frames
+
+typedef struct {
+    int level;
+    int row;
+    int col;
+    int facing;                  // 0=north 1=east 2=south 3=west
+    bool suppress_throat_horiz;  // Hide inner top/bottom lines after stepping forward
+} maze_pose_t;
+
+// Occupancy around the player (systematic 5-layer x 3-width grid)
+typedef struct {
+    // Layer 0: Current position (immediate left/right walls)
+    bool L0, R0;
+    // Layer 1: 1 step ahead
+    bool L1, C1, R1;
+    // Layer 2: 2 steps ahead
+    bool L2, C2, R2;
+    // Layer 3: 3 steps ahead
+    bool L3, C3, R3;
+    // Layer 4: 4 steps ahead
+    bool L4, C4, R4;
+    // Layer 5: 5 steps ahead
+    bool L5, C5, R5;
+} occupancy_pattern_t;
+
+typedef struct {
+    int16_t x1, y1, x2, y2;
+    uint8_t width;
+} maze_seg_t;
+
+typedef struct {
+    occupancy_pattern_t pattern;
+    uint8_t count;
+    maze_seg_t segs[MAZE_VIEW_MAX_SEGS];
+} maze_view_t;
+
+/**
+ * @brief Wall test on one level (out of bounds counts as wall)
+ */
+bool maze_view_wall_at(const uint32_t *rows, int row, int col);
+
+/**
+ * @brief Build the display list for a pose
+ * @param rows  32 row bitmasks of the pose's level
+ */
+void maze_view_build(const uint32_t *rows, const maze_pose_t *pose, maze_view_t *out);
+
+/**
+ * @brief FNV-1a hash of the display list (order sensitive)
+ */
+uint32_t maze_view_hash(const maze_view_t *view);
+
+/**
+ * @brief Check the R9C8-facing-North geometry invariant
+ * When the player stands at row 8/col 7 facing north with the corridor open
+ * left, right and ahead, the view must contain both inner verticals and the
+ * top/bottom horizontals out to the display edges, and no horizontal segment
+ * between the inner verticals. Returns true for any other pose.
+ */
+bool maze_view_check_r9c8n(const maze_pose_t *pose, const maze_view_t *view);
+
+/**
+ * @brief Built-in levels: 32 row bitmasks each, bit 31 is column 0, 1 = wall
+ */
+extern const uint32_t maze_view_builtin[MAZE_VIEW_LEVELS][32];
+
+/**
+ * @brief Display-list goldens for the built-in levels
+ * Level: every open cell x facing x throat flag. Route: every frame of the
+ * scripted route to the level's exit. Both fold maze_view_hash() with
+ * maze_view_fold().
+ */
+extern const uint32_t maze_view_golden_level[MAZE_VIEW_LEVELS];
+extern const uint32_t maze_view_golden_route[MAZE_VIEW_LEVELS];
+
+/**
+ * @brief Fold @p v into FNV-1a hash @p h (start from 2166136261)
+ */
+uint32_t maze_view_fold(uint32_t h, uint32_t v);
+
+/**
+ * @brief First pose of the scripted route on @p level
+ */
+void maze_view_route_start(int level, maze_pose_t *pose);
+
+/**
+ * @brief Next pose of the scripted route through a level
+ * The route takes a shortest path to the nearest exit (an open border cell,
+ * as in the game), one frame per step or quarter turn.
+ * @param rows  32 row bitmasks of the pose's level
+ * @return false, leaving @p pose as is, once it is on the exit or if no
+ *         exit can be reached from it
+ */
+bool maze_view_route_next(const uint32_t *rows, maze_pose_t *pose);
+
+/**
+ * @brief Whether @p pose is on an exit (the route is complete)
+ */
+bool maze_view_route_done(const maze_pose_t *pose);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,376 @@
+#include "ui_mem.h"
+#include "ui_assets.h"
+#include "ui_console.h"
+#include "ui_arena.h"
+#include "ui_private.h"
+#include "sdkconfig.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_memory_utils.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <string.h>
+
+static const char *TAG = "ui_mem";
+
+#define SAMPLE_COUNT        CONFIG_UI_MEM_SAMPLES
+#define TRACK_SLOTS         CONFIG_UI_MEM_TRACK_SLOTS
+#define PAGE_PERIOD_MS      1000
+#define CHART_POINTS        60
+
+LV_IMG_DECLARE(swipeR34);
+
+typedef struct {
+    void *ptr;
+    void *caller;
+    uint32_t size;
+    uint8_t app;
+    bool spiram;
+    bool leaked;
+} mem_record_t;
+
+static mem_record_t records[TRACK_SLOTS];
+static ui_mem_app_stats_t app_stats[UI_MEM_APP_COUNT];
+static uint32_t untracked = 0;          // Allocations made while the table was full
+
+static ui_mem_sample_t samples[SAMPLE_COUNT];
+static uint32_t sample_head = 0;        // Total samples taken
+static esp_timer_handle_t sample_timer = NULL;
+
+static portMUX_TYPE mem_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static const char *const app_names[UI_MEM_APP_COUNT] = {
+    "system", "launcher", "maze", "sports", "weather", "settings", "photos",
+};
+
+const char *ui_mem_app_name(ui_mem_app_t app) {
+    return (unsigned)app < UI_MEM_APP_COUNT ? app_names[app] : "?";
+}
+
+// --- Tagged allocations ---
+
+void *ui_mem_malloc(ui_mem_app_t app, size_t size, uint32_t caps) {
+    void *p = heap_caps_malloc(size, caps);
+    if (!p) {
+        ESP_LOGW(TAG, "%s: %u byte allocation failed (caps 0x%lx, largest %u)", ui_mem_app_name(app),
+                 (unsigned)size, (unsigned long)caps, (unsigned)heap_caps_get_largest_free_block(caps));
+        return NULL;
+    }
+    if ((unsigned)app >= UI_MEM_APP_COUNT) app = UI_MEM_APP_SYSTEM;
+    bool spiram = esp_ptr_external_ram(p);
+
+    taskENTER_CRITICAL(&mem_lock);
+    mem_record_t *rec = NULL;
+    for (int i = 0; i < TRACK_SLOTS; i++) {
+        if (!records[i].ptr) {
+            rec = &records[i];
+            break;
+        }
+    }
+    if (rec) {
+        *rec = (mem_record_t){
+            .ptr = p, .caller = __builtin_return_address(0), .size = (uint32_t)size,
+            .app = (uint8_t)app, .spiram = spiram, .leaked = false,
+        };
+        ui_mem_app_stats_t *st = &app_stats[app];
+        st->live_blocks++;
+        if (spiram) st->spiram_bytes += size; else st->internal_bytes += size;
+        size_t total = st->internal_bytes + st->spiram_bytes;
+        if (total > st->peak_bytes) st->peak_bytes = total;
+    } else {
+        untracked++;
+    }
+    taskEXIT_CRITICAL(&mem_lock);
+    return p;
+}
+
+void ui_mem_free(void *p) {
+    if (!p) return;
+    taskENTER_CRITICAL(&mem_lock);
+    for (int i = 0; i < TRACK_SLOTS; i++) {
+        mem_record_t *rec = &records[i];
+        if (rec->ptr != p) continue;
+        ui_mem_app_stats_t *st = &app_stats[rec->app];
+        st->live_blocks--;
+        if (rec->spiram) st->spiram_bytes -= rec->size; else st->internal_bytes -= rec->size;
+        if (rec->leaked) {
+            st->leaked_blocks--;        // Freed late after all
+            st->leaked_bytes -= rec->size;
+        }
+        rec->ptr = NULL;
+        break;
+    }
+    taskEXIT_CRITICAL(&mem_lock);
+    heap_caps_free(p);
+}
+
+uint32_t ui_mem_app_closed(ui_mem_app_t app) {
+    mem_record_t found[8];
+    uint32_t flagged = 0;
+
+    taskENTER_CRITICAL(&mem_lock);
+    for (int i = 0; i < TRACK_SLOTS; i++) {
+        mem_record_t *rec = &records[i];
+        if (!rec->ptr || rec->app != app || rec->leaked) continue;
+        rec->leaked = true;
+        app_stats[app].leaked_blocks++;
+        app_stats[app].leaked_bytes += rec->size;
+        if (flagged < sizeof(found) / sizeof(found[0])) found[flagged] = *rec;
+        flagged++;
+    }
+    taskEXIT_CRITICAL(&mem_lock);
+
+    for (uint32_t i = 0; i < flagged && i < sizeof(found) / sizeof(found[0]); i++) {
+        ESP_LOGW(TAG, "%s: %u bytes (%s) still allocated after cleanup, caller %p",
+                 ui_mem_app_name(app), (unsigned)found[i].size,
+                 found[i].spiram ? "PSRAM" : "internal", found[i].caller);
+    }
+    return flagged;
+}
+
+void ui_mem_get_app_stats(ui_mem_app_t app, ui_mem_app_stats_t *out) {
+    taskENTER_CRITICAL(&mem_lock);
+    *out = app_stats[app];
+    taskEXIT_CRITICAL(&mem_lock);
+}
+
+// --- Allocation counting (CONFIG_HEAP_USE_HOOKS) ---
+
+#if CONFIG_HEAP_USE_HOOKS
+static TaskHandle_t count_task = NULL;
+static uint32_t count_allocs = 0;
+
+// Called by the heap after every allocation, from any task, so it stays
+// short and in IRAM; only the counting task's allocations are counted
+void IRAM_ATTR esp_heap_trace_alloc_hook(void *ptr, size_t size, uint32_t caps) {
+    if (count_task && xTaskGetCurrentTaskHandle() == count_task) count_allocs++;
+}
+#endif
+
+void ui_mem_alloc_count_begin(void) {
+#if CONFIG_HEAP_USE_HOOKS
+    count_allocs = 0;
+    count_task = xTaskGetCurrentTaskHandle();
+#endif
+}
+
+int32_t ui_mem_alloc_count_end(void) {
+#if CONFIG_HEAP_USE_HOOKS
+    count_task = NULL;
+    return (int32_t)count_allocs;
+#else
+    return -1;
+#endif
+}
+
+// --- Heap sampling ---
+
+static uint8_t frag_pct(size_t free_bytes, size_t largest) {
+    return free_bytes ? (uint8_t)(100 - largest * 100 / free_bytes) : 0;
+}
+
+void ui_mem_sample(ui_mem_sample_t *out) {
+    out->t_s = (uint32_t)(esp_timer_get_time() / 1000000);
+    out->internal_free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    out->internal_largest = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    out->spiram_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    out->spiram_largest = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+    out->internal_frag_pct = frag_pct(out->internal_free, out->internal_largest);
+    out->spiram_frag_pct = frag_pct(out->spiram_free, out->spiram_largest);
+}
+
+static void sample_timer_cb(void *arg) {
+    (void)arg;
+    ui_mem_sample_t s;
+    ui_mem_sample(&s);
+    taskENTER_CRITICAL(&mem_lock);
+    samples[sample_head % SAMPLE_COUNT] = s;
+    sample_head++;
+    taskEXIT_CRITICAL(&mem_lock);
+}
+
+// Copy up to @p max most recent samples, oldest first
+static uint32_t copy_samples(ui_mem_sample_t *out, uint32_t max) {
+    taskENTER_CRITICAL(&mem_lock);
+    uint32_t n = sample_head < SAMPLE_COUNT ? sample_head : SAMPLE_COUNT;
+    if (n > max) n = max;
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = samples[(sample_head - n + i) % SAMPLE_COUNT];
+    }
+    taskEXIT_CRITICAL(&mem_lock);
+    return n;
+}
+
+void ui_mem_dump_csv(FILE *out) {
+    static ui_mem_sample_t snap[SAMPLE_COUNT];   // Console task stack is small
+    uint32_t n = copy_samples(snap, SAMPLE_COUNT);
+
+    fprintf(out, "# heap samples\n");
+    fprintf(out, "t_s,internal_free,internal_largest,internal_frag_pct,spiram_free,spiram_largest,spiram_frag_pct\n");
+    for (uint32_t i = 0; i < n; i++) {
+        const ui_mem_sample_t *s = &snap[i];
+        fprintf(out, "%lu,%u,%u,%u,%u,%u,%u\n", (unsigned long)s->t_s,
+                (unsigned)s->internal_free, (unsigned)s->internal_largest, s->internal_frag_pct,
+                (unsigned)s->spiram_free, (unsigned)s->spiram_largest, s->spiram_frag_pct);
+    }
+
+    fprintf(out, "# apps\n");
+    fprintf(out, "app,live_blocks,internal_bytes,spiram_bytes,peak_bytes,leaked_blocks,leaked_bytes\n");
+    for (int a = 0; a < UI_MEM_APP_COUNT; a++) {
+        ui_mem_app_stats_t st;
+        ui_mem_get_app_stats((ui_mem_app_t)a, &st);
+        fprintf(out, "%s,%lu,%u,%u,%u,%lu,%u\n", app_names[a], (unsigned long)st.live_blocks,
+                (unsigned)st.internal_bytes, (unsigned)st.spiram_bytes, (unsigned)st.peak_bytes,
+                (unsigned long)st.leaked_blocks, (unsigned)st.leaked_bytes);
+    }
+
+    fprintf(out, "# live blocks\n");
+    fprintf(out, "app,size,heap,caller,leaked\n");
+    for (int i = 0; i < TRACK_SLOTS; i++) {
+        taskENTER_CRITICAL(&mem_lock);
+        mem_record_t rec = records[i];
+        taskEXIT_CRITICAL(&mem_lock);
+        if (!rec.ptr) continue;
+        fprintf(out, "%s,%lu,%s,%p,%d\n", app_names[rec.app], (unsigned long)rec.size,
+                rec.spiram ? "spiram" : "internal", rec.caller, rec.leaked);
+    }
+    if (untracked) fprintf(out, "# %lu allocations not tracked (table full)\n", (unsigned long)untracked);
+}
+
+void ui_mem_init(void) {
+    if (sample_timer) return;
+    const esp_timer_create_args_t args = {
+        .callback = sample_timer_cb,
+        .name = "ui_mem",
+    };
+    if (esp_timer_create(&args, &sample_timer) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create sample timer");
+        return;
+    }
+    sample_timer_cb(NULL);
+    esp_timer_start_periodic(sample_timer, (uint64_t)CONFIG_UI_MEM_SAMPLE_PERIOD_S * 1000000);
+    ui_console_register('m', "memory telemetry as CSV", ui_mem_dump_csv);
+    ESP_LOGI(TAG, "Heap sampling every %d s (%d samples)", CONFIG_UI_MEM_SAMPLE_PERIOD_S, SAMPLE_COUNT);
+}
+
+// --- Hub page ---
+
+static lv_timer_t *page_timer = NULL;
+static lv_obj_t *lbl_heaps = NULL;
+static lv_obj_t *lbl_apps = NULL;
+static lv_obj_t *chart = NULL;
+static lv_chart_series_t *ser_internal = NULL;
+static lv_chart_series_t *ser_spiram = NULL;
+
+static void page_refresh(lv_timer_t *t) {
+    (void)t;
+    static char buf[512];
+    ui_mem_sample_t now;
+    ui_mem_sample(&now);
+
+    ui_arena_stats_t ast;
+    ui_arena_get_stats(&ast);
+    snprintf(buf, sizeof(buf),
+             "Internal  free %u KB  largest %u KB  frag %u%%\n"
+             "PSRAM     free %u KB  largest %u KB  frag %u%%\n"
+             "Arenas    %lu open  %lu pinned  %u KB held",
+             (unsigned)(now.internal_free / 1024), (unsigned)(now.internal_largest / 1024), now.internal_frag_pct,
+             (unsigned)(now.spiram_free / 1024), (unsigned)(now.spiram_largest / 1024), now.spiram_frag_pct,
+             (unsigned long)ast.arenas_open, (unsigned long)ast.arenas_pinned,
+             (unsigned)(ast.arena_held_bytes / 1024));
+    lv_label_set_text(lbl_heaps, buf);
+
+    size_t len = snprintf(buf, sizeof(buf), "App        blocks  int KB  psram KB  peak KB  leaked");
+    for (int a = 0; a < UI_MEM_APP_COUNT && len < sizeof(buf); a++) {
+        ui_mem_app_stats_t st;
+        ui_mem_get_app_stats((ui_mem_app_t)a, &st);
+        len += snprintf(buf + len, sizeof(buf) - len, "\n%-9s  %6lu  %6u  %8u  %7u  %s%lu",
+                        app_names[a], (unsigned long)st.live_blocks,
+                        (unsigned)(st.internal_bytes / 1024), (unsigned)(st.spiram_bytes / 1024),
+                        (unsigned)(st.peak_bytes / 1024),
+                        st.leaked_blocks ? LV_SYMBOL_WARNING " " : "", (unsigned long)st.leaked_blocks);
+    }
+    lv_label_set_text(lbl_apps, buf);
+
+    static ui_mem_sample_t hist[CHART_POINTS];
+    uint32_t n = copy_samples(hist, CHART_POINTS);
+    lv_chart_set_all_value(chart, ser_internal, LV_CHART_POINT_NONE);
+    lv_chart_set_all_value(chart, ser_spiram, LV_CHART_POINT_NONE);
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t idx = CHART_POINTS - n + i;   // Right-aligned, newest at the right edge
+        lv_chart_set_value_by_id(chart, ser_internal, idx, hist[i].internal_frag_pct);
+        lv_chart_set_value_by_id(chart, ser_spiram, idx, hist[i].spiram_frag_pct);
+    }
+    lv_chart_refresh(chart);
+}
+
+static void page_delete_cb(lv_event_t *e) {
+    (void)e;
+    if (page_timer) {
+        lv_timer_del(page_timer);
+        page_timer = NULL;
+    }
+    lbl_heaps = NULL;
+    lbl_apps = NULL;
+    chart = NULL;
+}
+
+static void page_swipe_cb(lv_event_t *e) {
+    if (lv_indev_get_gesture_dir(lv_indev_get_act()) == LV_DIR_RIGHT) {
+        show_home_view(e);     // Back to the Board Settings hub
+    }
+}
+
+void ui_mem_page_create(lv_obj_t *parent) {
+    // home_cont is the container clear_current_view() deletes on the next switch
+    home_cont = lv_obj_create(parent);
+    lv_obj_set_size(home_cont, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_style_bg_opa(home_cont, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(home_cont, 0, 0);
+    lv_obj_set_style_pad_all(home_cont, 20, 0);
+    lv_obj_set_style_pad_gap(home_cont, 12, 0);
+    lv_obj_set_flex_flow(home_cont, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(home_cont, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_add_event_cb(home_cont, page_swipe_cb, LV_EVENT_GESTURE, NULL);
+    lv_obj_add_event_cb(home_cont, page_delete_cb, LV_EVENT_DELETE, NULL);
+    lv_obj_clear_flag(home_cont, LV_OBJ_FLAG_GESTURE_BUBBLE);
+
+    lv_obj_t *img_swipe = lv_image_create(home_cont);
+    lv_image_set_src(img_swipe, &swipeR34);
+    lv_obj_add_flag(img_swipe, LV_OBJ_FLAG_FLOATING);
+    lv_obj_align(img_swipe, LV_ALIGN_TOP_LEFT, 5, 5);
+
+    lv_obj_t *title = lv_label_create(home_cont);
+    lv_label_set_text(title, "Heap");
+    lv_obj_set_style_text_font(title, ui_assets_font(30), 0);
+    lv_obj_set_style_text_color(title, lv_color_hex(0xFFD700), 0);
+
+    lbl_heaps = lv_label_create(home_cont);
+    lv_obj_set_style_text_font(lbl_heaps, ui_assets_font(16), 0);
+    lv_obj_set_style_text_color(lbl_heaps, lv_color_white(), 0);
+
+    // Fragmentation history, one point per sample
+    chart = lv_chart_create(home_cont);
+    lv_obj_set_size(chart, LV_PCT(100), 140);
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_point_count(chart, CHART_POINTS);
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 100);
+    lv_obj_set_style_size(chart, 0, 0, LV_PART_INDICATOR);     // No point markers
+    lv_obj_set_style_bg_color(chart, lv_color_hex(0x101010), 0);
+    ser_internal = lv_chart_add_series(chart, lv_color_hex(0xFF3300), LV_CHART_AXIS_PRIMARY_Y);
+    ser_spiram = lv_chart_add_series(chart, lv_color_hex(0x00FFFF), LV_CHART_AXIS_PRIMARY_Y);
+
+    lv_obj_t *legend = lv_label_create(home_cont);
+    lv_label_set_text(legend, "Fragmentation %: internal (red), PSRAM (cyan)");
+    lv_obj_set_style_text_font(legend, ui_assets_font(14), 0);
+    lv_obj_set_style_text_color(legend, lv_color_hex(0xAAAAAA), 0);
+
+    lbl_apps = lv_label_create(home_cont);
+    lv_obj_set_style_text_font(lbl_apps, ui_assets_font(14), 0);
+    lv_obj_set_style_text_color(lbl_apps, lv_color_hex(0x39FF14), 0);
+
+    page_timer = lv_timer_create(page_refresh, PAGE_PERIOD_MS, NULL);
+    page_refresh(NULL);
+}
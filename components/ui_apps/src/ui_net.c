@@ -0,0 +1,481 @@
+// The resumption check compares the negotiated session with the offered one
+#define MBEDTLS_ALLOW_PRIVATE_ACCESS
+
+#include "ui_net.h"
+#include "ui_http_core.h"
+#include "ui_console.h"
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_event.h"
+#include "esp_wifi.h"
+#include "esp_crt_bundle.h"
+#include "nvs.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/net_sockets.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "ui_net";
+
+#define IO_TIMEOUT_MS   10000
+#define NVS_NAMESPACE   "ui_net"
+#define BENCH_STACK     8192        // TLS handshakes run on the calling task
+#define BENCH_PRIO      2
+#define BENCH_ROUNDS    5
+
+typedef struct {
+    mbedtls_net_context net;
+    mbedtls_ssl_context ssl;
+    uint32_t timeout_ms;        // Of the current read; streams wait longer than requests
+    bool tls;
+} conn_t;
+
+// One TLS configuration for every connection; mbedtls only reads it once set up
+static mbedtls_ssl_config conf;
+static mbedtls_entropy_context entropy;
+static mbedtls_ctr_drbg_context drbg;
+static bool conf_ready = false;
+
+static http_pool_t *pool = NULL;
+static SemaphoreHandle_t pool_mutex = NULL;
+static esp_timer_handle_t expire_timer = NULL;
+static TaskHandle_t bench_task = NULL;
+
+static bool tls_conf_init(void) {
+    mbedtls_ssl_config_init(&conf);
+    mbedtls_entropy_init(&entropy);
+    mbedtls_ctr_drbg_init(&drbg);
+    int ret = mbedtls_ctr_drbg_seed(&drbg, mbedtls_entropy_func, &entropy, NULL, 0);
+    if (ret == 0) {
+        ret = mbedtls_ssl_config_defaults(&conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                          MBEDTLS_SSL_PRESET_DEFAULT);
+    }
+    if (ret == 0) ret = esp_crt_bundle_attach(&conf);
+    if (ret != 0) {
+        ESP_LOGE(TAG, "TLS setup failed: -0x%04x", -ret);
+        return false;
+    }
+    mbedtls_ssl_conf_authmode(&conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+    mbedtls_ssl_conf_rng(&conf, mbedtls_ctr_drbg_random, &drbg);
+    // TLS 1.3 hands out its tickets after the handshake; sessions are saved right after it
+    mbedtls_ssl_conf_max_tls_version(&conf, MBEDTLS_SSL_VERSION_TLS1_2);
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    mbedtls_ssl_conf_session_tickets(&conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
+    return true;
+}
+
+// --- http_backend_t over mbedtls and lwIP sockets ---
+
+// mbedtls passes the config's read timeout, shared by all connections; use the connection's
+static int tls_recv(void *ctx, unsigned char *buf, size_t len, uint32_t timeout) {
+    conn_t *c = ctx;
+    return mbedtls_net_recv_timeout(&c->net, buf, len, c->timeout_ms);
+}
+
+static int tls_send(void *ctx, const unsigned char *buf, size_t len) {
+    conn_t *c = ctx;
+    return mbedtls_net_send(&c->net, buf, len);
+}
+
+static void *be_connect(void *ctx, const char *host, uint16_t port, bool tls, const uint8_t *session,
+                        size_t session_len, bool *resumed) {
+    if (tls && !conf_ready) return NULL;
+    conn_t *c = calloc(1, sizeof(conn_t));
+    if (!c) return NULL;
+    c->tls = tls;
+    c->timeout_ms = IO_TIMEOUT_MS;
+    mbedtls_net_init(&c->net);
+    mbedtls_ssl_init(&c->ssl);
+
+    char port_str[6];
+    snprintf(port_str, sizeof(port_str), "%u", port);
+    int ret = mbedtls_net_connect(&c->net, host, port_str, MBEDTLS_NET_PROTO_TCP);
+    if (ret != 0) {
+        ESP_LOGW(TAG, "Connect to %s:%u failed: -0x%04x", host, port, -ret);
+        free(c);
+        return NULL;
+    }
+    if (!tls) return c;
+
+    mbedtls_ssl_session offered;
+    mbedtls_ssl_session_init(&offered);
+    bool offering = false;
+    ret = mbedtls_ssl_setup(&c->ssl, &conf);
+    if (ret == 0) ret = mbedtls_ssl_set_hostname(&c->ssl, host);
+    if (ret == 0 && session && mbedtls_ssl_session_load(&offered, session, session_len) == 0) {
+        offering = mbedtls_ssl_set_session(&c->ssl, &offered) == 0;
+    }
+    if (ret == 0) {
+        mbedtls_ssl_set_bio(&c->ssl, c, tls_send, NULL, tls_recv);
+        do {
+            ret = mbedtls_ssl_handshake(&c->ssl);
+        } while (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+    }
+    if (ret != 0) {
+        ESP_LOGW(TAG, "TLS handshake with %s failed: -0x%04x", host, -ret);
+        mbedtls_ssl_session_free(&offered);
+        mbedtls_ssl_free(&c->ssl);
+        mbedtls_net_free(&c->net);
+        free(c);
+        return NULL;
+    }
+    // A server that declines the session runs a full handshake with a fresh master secret
+    *resumed = offering && memcmp(c->ssl.session->master, offered.master, sizeof(offered.master)) == 0;
+    mbedtls_ssl_session_free(&offered);
+    return c;
+}
+
+static int be_send(void *ctx, void *conn, const void *buf, size_t len) {
+    conn_t *c = conn;
+    if (!c->tls) return mbedtls_net_send(&c->net, buf, len);
+    int n;
+    do {
+        n = mbedtls_ssl_write(&c->ssl, buf, len);
+    } while (n == MBEDTLS_ERR_SSL_WANT_WRITE || n == MBEDTLS_ERR_SSL_WANT_READ);
+    return n;
+}
+
+static int be_recv(void *ctx, void *conn, void *buf, size_t len, uint32_t timeout_ms) {
+    conn_t *c = conn;
+    c->timeout_ms = timeout_ms;
+    if (!c->tls) return mbedtls_net_recv_timeout(&c->net, buf, len, timeout_ms);
+    int n;
+    do {
+        n = mbedtls_ssl_read(&c->ssl, buf, len);
+    } while (n == MBEDTLS_ERR_SSL_WANT_READ || n == MBEDTLS_ERR_SSL_WANT_WRITE);
+    return n == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY ? 0 : n;
+}
+
+static size_t be_save_session(void *ctx, void *conn, uint8_t *buf, size_t cap) {
+    conn_t *c = conn;
+    mbedtls_ssl_session s;
+    mbedtls_ssl_session_init(&s);
+    size_t len = 0;
+    if (mbedtls_ssl_get_session(&c->ssl, &s) != 0 || mbedtls_ssl_session_save(&s, buf, cap, &len) != 0) {
+        len = 0;
+    }
+    mbedtls_ssl_session_free(&s);
+    return len;
+}
+
+// No close_notify: this also runs on the esp_timer task, and servers don't need it
+static void be_close(void *ctx, void *conn) {
+    conn_t *c = conn;
+    mbedtls_ssl_free(&c->ssl);
+    mbedtls_net_free(&c->net);
+    free(c);
+}
+
+static void be_lock(void *ctx) {
+    xSemaphoreTake(pool_mutex, portMAX_DELAY);
+}
+
+static void be_unlock(void *ctx) {
+    xSemaphoreGive(pool_mutex);
+}
+
+static uint64_t be_now_us(void *ctx) {
+    return (uint64_t)esp_timer_get_time();
+}
+
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+// Run-time clock ticks (us), counted at context switches
+static uint64_t be_cpu_us(void *ctx) {
+    return ulTaskGetRunTimeCounter(NULL);
+}
+#endif
+
+#if CONFIG_UI_NET_PERSIST_SESSIONS && CONFIG_UI_NET_SESSIONS > 0
+
+// One NVS blob per host, "host:port" NUL session, in CONFIG_UI_NET_SESSIONS hashed keys
+static void nvs_key_for(const char *key, char out[NVS_KEY_NAME_MAX_SIZE]) {
+    uint32_t h = 2166136261u;
+    for (const char *s = key; *s; s++) h = (h ^ (uint8_t)*s) * 16777619u;
+    snprintf(out, NVS_KEY_NAME_MAX_SIZE, "s%u", (unsigned)(h % CONFIG_UI_NET_SESSIONS));
+}
+
+// Only after full handshakes, so flash sees a write per host when its session expires
+static void be_session_saved(void *ctx, const char *key, const uint8_t *blob, size_t len) {
+    size_t klen = strlen(key) + 1;
+    uint8_t *rec = malloc(klen + len);
+    if (!rec) return;
+    memcpy(rec, key, klen);
+    memcpy(rec + klen, blob, len);
+
+    char name[NVS_KEY_NAME_MAX_SIZE];
+    nvs_key_for(key, name);
+    nvs_handle_t h;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &h);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(h, name, rec, klen + len);
+        if (err == ESP_OK) err = nvs_commit(h);
+        nvs_close(h);
+    }
+    if (err != ESP_OK) ESP_LOGW(TAG, "Saving the session for %s failed: %s", key, esp_err_to_name(err));
+    free(rec);
+}
+
+static void load_sessions(void) {
+    nvs_handle_t h;
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &h) != ESP_OK) return;    // Nothing saved yet
+    size_t cap = HTTP_HOST_MAX + 8 + HTTP_SESSION_MAX;
+    uint8_t *rec = malloc(cap);
+    nvs_iterator_t it = NULL;
+    esp_err_t err = rec ? nvs_entry_find(NVS_DEFAULT_PART_NAME, NVS_NAMESPACE, NVS_TYPE_BLOB, &it) : ESP_ERR_NO_MEM;
+    int loaded = 0;
+    while (err == ESP_OK) {
+        nvs_entry_info_t info;
+        nvs_entry_info(it, &info);
+        size_t len = cap;
+        if (nvs_get_blob(h, info.key, rec, &len) == ESP_OK) {
+            size_t klen = strnlen((const char *)rec, len);
+            if (klen + 1 < len) {
+                http_pool_put_session(pool, (const char *)rec, rec + klen + 1, len - klen - 1);
+                loaded++;
+            }
+        }
+        err = nvs_entry_next(&it);
+    }
+    nvs_release_iterator(it);
+    nvs_close(h);
+    free(rec);
+    if (loaded) ESP_LOGI(TAG, "Loaded %d saved TLS sessions", loaded);
+}
+
+#endif
+
+static http_backend_t backend(bool persist) {
+    http_backend_t be = {
+        .connect = be_connect,
+        .send = be_send,
+        .recv = be_recv,
+        .save_session = be_save_session,
+        .close = be_close,
+        .lock = be_lock,
+        .unlock = be_unlock,
+        .now_us = be_now_us,
+    };
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    be.cpu_us = be_cpu_us;
+#endif
+#if CONFIG_UI_NET_PERSIST_SESSIONS && CONFIG_UI_NET_SESSIONS > 0
+    if (persist) be.session_saved = be_session_saved;
+#endif
+    return be;
+}
+
+// --- Shared pool ---
+
+static esp_err_t to_esp_err(http_err_t err) {
+    switch (err) {
+    case HTTP_OK:           return ESP_OK;
+    case HTTP_ERR_URL:      return ESP_ERR_INVALID_ARG;
+    case HTTP_ERR_IO:       return ESP_ERR_TIMEOUT;
+    case HTTP_ERR_PROTOCOL: return ESP_ERR_INVALID_RESPONSE;
+    case HTTP_ERR_ABORTED:  return ESP_ERR_INVALID_STATE;
+    case HTTP_ERR_NO_MEM:   return ESP_ERR_NO_MEM;
+    default:                return ESP_FAIL;
+    }
+}
+
+// Idle connections hold their TLS buffers; close them once the server would have
+static void arm_expiry(void) {
+    uint32_t ms = http_pool_expire(pool);
+    esp_timer_stop(expire_timer);
+    if (ms) esp_timer_start_once(expire_timer, (uint64_t)ms * 1000);
+}
+
+static void expire_cb(void *arg) {
+    arm_expiry();
+}
+
+// Runs on the default event loop task
+static void wifi_event_handler(void *arg, esp_event_base_t base, int32_t id, void *data) {
+    ui_net_flush();
+}
+
+esp_err_t ui_net_get(const char *url, const char *headers, ui_net_body_cb_t on_body, void *arg, int *status) {
+    if (!pool) return ESP_ERR_INVALID_STATE;
+    http_result_t res;
+    http_err_t err = http_get(pool, url, headers, on_body, arg, &res);
+    arm_expiry();
+    if (status) *status = res.status;
+    if (err != HTTP_OK) ESP_LOGW(TAG, "GET %s failed (%d)", url, err);
+    return to_esp_err(err);
+}
+
+esp_err_t ui_net_stream(const char *url, const char *headers, uint32_t idle_ms, ui_net_body_cb_t on_body, void *arg,
+                        int *status) {
+    if (!pool) return ESP_ERR_INVALID_STATE;
+    http_result_t res;
+    http_err_t err = http_stream(pool, url, headers, idle_ms, on_body, arg, &res);
+    arm_expiry();
+    if (status) *status = res.status;
+    if (err != HTTP_OK && err != HTTP_ERR_ABORTED) ESP_LOGW(TAG, "Stream %s ended (%d)", url, err);
+    return to_esp_err(err);
+}
+
+void ui_net_flush(void) {
+    if (!pool) return;
+    http_pool_flush(pool);
+    esp_timer_stop(expire_timer);
+}
+
+// --- Console ---
+
+static void print_handshakes(FILE *out, const char *what, uint32_t n, uint64_t us, uint64_t cpu_us) {
+    if (!n) {
+        fprintf(out, "  %-8s 0\n", what);
+        return;
+    }
+    fprintf(out, "  %-8s %lu, avg %.1f ms (%.1f ms CPU)\n", what, (unsigned long)n, us / 1000.0 / n,
+            cpu_us / 1000.0 / n);
+}
+
+void ui_net_report(FILE *out) {
+    if (!pool) {
+        fprintf(out, "Network client not started\n");
+        return;
+    }
+#if CONFIG_UI_NET_PERSIST_SESSIONS
+    const char *persist = " (in NVS)";
+#else
+    const char *persist = "";
+#endif
+    http_pool_stats_t s;
+    http_pool_get_stats(pool, &s);
+    fprintf(out, "Pool: %d connections kept %d s, sessions of %d hosts%s\n", CONFIG_UI_NET_POOL_SLOTS,
+            CONFIG_UI_NET_IDLE_S, CONFIG_UI_NET_SESSIONS, persist);
+    fprintf(out, "  %lu requests, %lu on pooled connections, %lu retried, %lu failed\n", (unsigned long)s.requests,
+            (unsigned long)s.reused, (unsigned long)s.retries, (unsigned long)s.errors);
+    print_handshakes(out, "full", s.full, s.handshake_us[0], s.handshake_cpu_us[0]);
+    print_handshakes(out, "resumed", s.resumed, s.handshake_us[1], s.handshake_cpu_us[1]);
+}
+
+static bool discard_body(void *arg, const uint8_t *data, size_t len) {
+    return true;
+}
+
+// One refresh: every URL once. Returns false if a request failed.
+static bool bench_refresh(http_pool_t *p) {
+    char urls[] = CONFIG_UI_NET_BENCH_URLS;
+    char *save = NULL;
+    bool ok = true;
+    for (char *url = strtok_r(urls, " ", &save); url; url = strtok_r(NULL, " ", &save)) {
+        http_result_t res;
+        if (http_get(p, url, NULL, discard_body, NULL, &res) != HTTP_OK) {
+            printf("  %s failed\n", url);
+            ok = false;
+        }
+    }
+    // Refreshes are minutes apart, well past any server's keep-alive timeout
+    http_pool_flush(p);
+    return ok;
+}
+
+static void bench_setup(const char *name, uint8_t slots, uint8_t sessions) {
+    http_pool_config_t cfg = {
+        .slots = slots,
+        .sessions = sessions,
+        .idle_ms = CONFIG_UI_NET_IDLE_S * 1000,
+        .timeout_ms = IO_TIMEOUT_MS,
+    };
+    http_backend_t be = backend(false);
+    http_pool_t *p = http_pool_create(&cfg, &be);
+    if (!p) {
+        printf("%-8s no memory\n", name);
+        return;
+    }
+    bool ok = bench_refresh(p);     // Warm-up, saves the sessions
+    http_pool_reset_stats(p);
+
+    size_t free0 = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    heap_caps_monitor_local_minimum_free_size_start();
+    int64_t t0 = esp_timer_get_time();
+    uint64_t c0 = be.cpu_us ? be.cpu_us(NULL) : 0;
+    for (int i = 0; i < BENCH_ROUNDS && ok; i++) ok = bench_refresh(p);
+    uint32_t cpu = be.cpu_us ? (uint32_t)(be.cpu_us(NULL) - c0) : 0;
+    int64_t wall = esp_timer_get_time() - t0;
+    size_t min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+    heap_caps_monitor_local_minimum_free_size_stop();
+
+    http_pool_stats_t s;
+    http_pool_get_stats(p, &s);
+    http_pool_destroy(p);
+    if (!ok) {
+        printf("%-8s failed, see above\n", name);
+        return;
+    }
+    printf("%-8s %5.1f %7.1f %6.1f %7.1f %8.1f %8.1f\n", name, (double)s.full / BENCH_ROUNDS,
+           (double)s.resumed / BENCH_ROUNDS, (double)s.reused / BENCH_ROUNDS, cpu / 1000.0 / BENCH_ROUNDS,
+           wall / 1000.0 / BENCH_ROUNDS, (free0 > min_free ? free0 - min_free : 0) / 1024.0);
+}
+
+static void bench_task_fn(void *arg) {
+    printf("Per refresh of %s, %d refreshes after a warm-up:\n", CONFIG_UI_NET_BENCH_URLS, BENCH_ROUNDS);
+    printf("setup     full resumed pooled  CPU ms  wall ms  peak KB\n");
+    bench_setup("fresh", 0, 0);
+    bench_setup("resume", 0, CONFIG_UI_NET_SESSIONS);
+    bench_setup("pool", CONFIG_UI_NET_POOL_SLOTS, CONFIG_UI_NET_SESSIONS);
+    bench_task = NULL;
+    vTaskDelete(NULL);
+}
+
+static void console_bench(FILE *out) {
+    if (!*CONFIG_UI_NET_BENCH_URLS) {
+        fprintf(out, "Set CONFIG_UI_NET_BENCH_URLS to the URLs of one refresh\n");
+        return;
+    }
+    if (!conf_ready || bench_task) {
+        fprintf(out, bench_task ? "Benchmark already running\n" : "Network client not started\n");
+        return;
+    }
+    if (xTaskCreate(bench_task_fn, "ui_net_bench", BENCH_STACK, NULL, BENCH_PRIO, &bench_task) != pdPASS) {
+        fprintf(out, "No memory for the benchmark task\n");
+        bench_task = NULL;
+        return;
+    }
+    fprintf(out, "Running; the table follows when done\n");
+}
+
+void ui_net_init(void) {
+    if (pool) return;
+
+    conf_ready = tls_conf_init();
+    pool_mutex = xSemaphoreCreateMutex();
+    const esp_timer_create_args_t args = { .callback = expire_cb, .name = "ui_net_expire" };
+    if (!pool_mutex || esp_timer_create(&args, &expire_timer) != ESP_OK) {
+        ESP_LOGE(TAG, "No memory for the network client");
+        return;
+    }
+    http_pool_config_t cfg = {
+        .slots = CONFIG_UI_NET_POOL_SLOTS,
+        .sessions = CONFIG_UI_NET_SESSIONS,
+        .idle_ms = CONFIG_UI_NET_IDLE_S * 1000,
+        .timeout_ms = IO_TIMEOUT_MS,
+    };
+    http_backend_t be = backend(true);
+    pool = http_pool_create(&cfg, &be);
+    if (!pool) {
+        ESP_LOGE(TAG, "No memory for the connection pool");
+        return;
+    }
+#if CONFIG_UI_NET_PERSIST_SESSIONS && CONFIG_UI_NET_SESSIONS > 0
+    load_sessions();
+#endif
+
+    esp_err_t err = esp_event_handler_instance_register(WIFI_EVENT, WIFI_EVENT_STA_DISCONNECTED,
+                                                        wifi_event_handler, NULL, NULL);
+    if (err != ESP_OK) ESP_LOGE(TAG, "Failed to register Wi-Fi event handler: %s", esp_err_to_name(err));
+
+    ui_console_register('h', "HTTP pool and TLS handshakes", ui_net_report);
+    ui_console_register('H', "refresh benchmark over CONFIG_UI_NET_BENCH_URLS", console_bench);
+}
@@ -0,0 +1,342 @@
+#include "ui_ota.h"
+#include "ui_delta_core.h"
+#include "ui_console.h"
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_partition.h"
+#include "esp_ota_ops.h"
+#include "esp_app_desc.h"
+#include "esp_http_client.h"
+#include "esp_crt_bundle.h"
+#include "mbedtls/sha256.h"
+#include "rom/miniz.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "ui_ota";
+
+#define TASK_STACK      8192        // esp_http_client + TLS; the patcher state is on the heap
+#define TASK_PRIO       2
+#define CHUNK           4096        // Network reads and running-image hash reads
+#define HTTP_TIMEOUT_MS 10000
+
+typedef struct {
+    const esp_partition_t *running;
+    esp_ota_handle_t ota;
+    mbedtls_sha256_context sha;     // Over the new image as it is written
+    int64_t flash_us;
+} job_t;
+
+static ui_ota_delta_result_t last;
+static bool have_last = false;
+static TaskHandle_t task = NULL;
+
+static uint32_t ms_since(int64_t t0) {
+    return (uint32_t)((esp_timer_get_time() - t0) / 1000);
+}
+
+// --- delta_io_t over the OTA slots ---
+
+static bool read_old(void *ctx, uint32_t off, void *buf, uint32_t len) {
+    job_t *j = ctx;
+    return esp_partition_read(j->running, off, buf, len) == ESP_OK;
+}
+
+static bool write_new(void *ctx, const void *buf, uint32_t len) {
+    job_t *j = ctx;
+    mbedtls_sha256_update(&j->sha, buf, len);
+    int64_t t0 = esp_timer_get_time();
+    esp_err_t err = esp_ota_write(j->ota, buf, len);
+    j->flash_us += esp_timer_get_time() - t0;
+    if (err != ESP_OK) ESP_LOGE(TAG, "Slot write failed: %s", esp_err_to_name(err));
+    return err == ESP_OK;
+}
+
+// --- Download ---
+
+// Read exactly @p len bytes unless the body ends first
+static int http_read_full(esp_http_client_handle_t c, uint8_t *buf, int len) {
+    int got = 0;
+    while (got < len) {
+        int n = esp_http_client_read(c, (char *)buf + got, len - got);
+        if (n < 0) return -1;
+        if (n == 0) break;
+        got += n;
+    }
+    return got;
+}
+
+static bool running_matches(const esp_partition_t *p, const delta_hdr_t *hdr, uint8_t *buf) {
+    if (hdr->old_size > p->size) return false;
+    mbedtls_sha256_context sha;
+    mbedtls_sha256_init(&sha);
+    mbedtls_sha256_starts(&sha, 0);
+    bool ok = true;
+    for (uint32_t off = 0; ok && off < hdr->old_size; off += CHUNK) {
+        uint32_t n = hdr->old_size - off < CHUNK ? hdr->old_size - off : CHUNK;
+        ok = esp_partition_read(p, off, buf, n) == ESP_OK;
+        if (ok) mbedtls_sha256_update(&sha, buf, n);
+    }
+    uint8_t digest[32];
+    mbedtls_sha256_finish(&sha, digest);
+    mbedtls_sha256_free(&sha);
+    return ok && memcmp(digest, hdr->old_sha256, sizeof(digest)) == 0;
+}
+
+// --- Inflate + apply ---
+
+typedef struct {
+    tinfl_decompressor inf;
+    uint8_t dict[TINFL_LZ_DICT_SIZE];   // Output window; also the chunk handed to the patcher
+    size_t dict_ofs;
+    bool done;
+} inflate_t;
+
+// Inflate one piece of the body into the patcher; @p more is false for the last piece
+static esp_err_t feed(inflate_t *z, delta_t *d, const uint8_t *in, size_t len, bool more) {
+    while (!z->done) {
+        size_t in_bytes = len;
+        size_t out_bytes = TINFL_LZ_DICT_SIZE - z->dict_ofs;
+        tinfl_status st = tinfl_decompress(&z->inf, in, &in_bytes, z->dict, z->dict + z->dict_ofs, &out_bytes,
+                                           TINFL_FLAG_PARSE_ZLIB_HEADER | (more ? TINFL_FLAG_HAS_MORE_INPUT : 0));
+        in += in_bytes;
+        len -= in_bytes;
+        if (out_bytes && delta_feed(d, z->dict + z->dict_ofs, out_bytes) != DELTA_OK) return ESP_FAIL;
+        z->dict_ofs = (z->dict_ofs + out_bytes) & (TINFL_LZ_DICT_SIZE - 1);
+        if (st == TINFL_STATUS_DONE) {
+            z->done = true;
+        } else if (st < TINFL_STATUS_DONE) {
+            ESP_LOGE(TAG, "Patch body is corrupt (inflate %d)", (int)st);
+            return ESP_ERR_INVALID_CRC;
+        } else if (st == TINFL_STATUS_NEEDS_MORE_INPUT) {
+            if (!more) ESP_LOGE(TAG, "Patch body is truncated");
+            return more ? ESP_OK : ESP_ERR_INVALID_SIZE;
+        }
+    }
+    return ESP_OK;
+}
+
+static const char *delta_err_name(delta_err_t err) {
+    switch (err) {
+    case DELTA_ERR_FORMAT: return "bad record";
+    case DELTA_ERR_RANGE: return "record outside the images";
+    case DELTA_ERR_IO: return "flash access failed";
+    case DELTA_ERR_SHORT: return "new image incomplete";
+    default: return "ok";
+    }
+}
+
+esp_err_t ui_ota_delta_update(const char *url, ui_ota_delta_result_t *out) {
+    ui_ota_delta_result_t r = { .err = ESP_FAIL };
+    int64_t t0 = esp_timer_get_time();
+    job_t job = { .running = esp_ota_get_running_partition() };
+    const esp_partition_t *next = esp_ota_get_next_update_partition(NULL);
+    esp_http_client_handle_t http = NULL;
+    inflate_t *z = NULL;
+    delta_t *d = NULL;
+    uint8_t *buf = NULL, *body = NULL;
+    bool ota_open = false;
+
+    if (!url || !*url || !job.running || !next) {
+        ESP_LOGE(TAG, "No patch URL or no OTA slot to write");
+        r.err = ESP_ERR_INVALID_ARG;
+        goto done;
+    }
+    snprintf(r.slot, sizeof(r.slot), "%s", next->label);
+    buf = heap_caps_malloc(CHUNK, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    z = heap_caps_malloc(sizeof(inflate_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!buf || !z) {
+        r.err = ESP_ERR_NO_MEM;
+        goto done;
+    }
+    tinfl_init(&z->inf);
+    z->dict_ofs = 0;
+    z->done = false;
+
+    esp_http_client_config_t cfg = {
+        .url = url,
+        .timeout_ms = HTTP_TIMEOUT_MS,
+        .buffer_size = CHUNK,
+        .crt_bundle_attach = esp_crt_bundle_attach,
+    };
+    http = esp_http_client_init(&cfg);
+    int64_t radio_t0 = esp_timer_get_time();
+    if (!http || (r.err = esp_http_client_open(http, 0)) != ESP_OK) {
+        ESP_LOGE(TAG, "Cannot reach %s", url);
+        if (r.err == ESP_OK) r.err = ESP_FAIL;
+        goto done;
+    }
+    int64_t content_len = esp_http_client_fetch_headers(http);
+    int status = esp_http_client_get_status_code(http);
+    if (status != 200) {
+        ESP_LOGE(TAG, "%s: HTTP %d", url, status);
+        r.err = ESP_ERR_NOT_FOUND;
+        goto done;
+    }
+
+    delta_hdr_t hdr;
+    if (http_read_full(http, buf, DELTA_HDR_SIZE) != DELTA_HDR_SIZE || delta_parse_header(buf, &hdr) != DELTA_OK ||
+        (content_len > 0 && content_len != (int64_t)DELTA_HDR_SIZE + hdr.body_size)) {
+        ESP_LOGE(TAG, "Not a delta patch");
+        r.err = ESP_ERR_INVALID_VERSION;
+        goto done;
+    }
+    r.patch_bytes = DELTA_HDR_SIZE;
+    r.image_bytes = hdr.new_size;
+    if (hdr.new_size > next->size) {
+        ESP_LOGE(TAG, "New image (%lu bytes) does not fit %s", (unsigned long)hdr.new_size, next->label);
+        r.err = ESP_ERR_INVALID_SIZE;
+        goto done;
+    }
+
+    // Small patches are downloaded whole so the radio is done before the slot is erased and written
+    if (hdr.body_size <= CONFIG_UI_OTA_DELTA_BUFFER_KB * 1024u) {
+        body = heap_caps_malloc(hdr.body_size ? hdr.body_size : 1, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    if (body) {
+        if (http_read_full(http, body, (int)hdr.body_size) != (int)hdr.body_size) {
+            ESP_LOGE(TAG, "Download cut short");
+            r.err = ESP_ERR_INVALID_SIZE;
+            goto done;
+        }
+        r.patch_bytes += hdr.body_size;
+        r.radio_ms = ms_since(radio_t0);
+        esp_http_client_cleanup(http);
+        http = NULL;
+    }
+
+    if (!running_matches(job.running, &hdr, buf)) {
+        ESP_LOGE(TAG, "Patch is for another build than the one in %s", job.running->label);
+        r.err = ESP_ERR_INVALID_STATE;
+        goto done;
+    }
+
+    int64_t erase_t0 = esp_timer_get_time();
+    if ((r.err = esp_ota_begin(next, hdr.new_size, &job.ota)) != ESP_OK) {
+        ESP_LOGE(TAG, "esp_ota_begin(%s): %s", next->label, esp_err_to_name(r.err));
+        goto done;
+    }
+    ota_open = true;
+    job.flash_us = esp_timer_get_time() - erase_t0;
+    mbedtls_sha256_init(&job.sha);
+    mbedtls_sha256_starts(&job.sha, 0);
+    delta_io_t io = { .read_old = read_old, .write_new = write_new, .ctx = &job };
+    if (!(d = delta_create(&hdr, &io))) {
+        mbedtls_sha256_free(&job.sha);
+        r.err = ESP_ERR_NO_MEM;
+        goto done;
+    }
+
+    if (body) {
+        r.err = feed(z, d, body, hdr.body_size, false);
+    } else {
+        uint32_t left = hdr.body_size;
+        r.err = ESP_OK;
+        while (r.err == ESP_OK && left) {
+            int n = esp_http_client_read(http, (char *)buf, left < CHUNK ? (int)left : CHUNK);
+            if (n <= 0) {
+                ESP_LOGE(TAG, "Download cut short");
+                r.err = ESP_ERR_INVALID_SIZE;
+                break;
+            }
+            left -= (uint32_t)n;
+            r.patch_bytes += (uint32_t)n;
+            r.err = feed(z, d, buf, (size_t)n, left > 0);
+        }
+        r.radio_ms = ms_since(radio_t0);
+    }
+    if (r.err == ESP_FAIL || (r.err == ESP_OK && delta_finish(d) != DELTA_OK)) {
+        ESP_LOGE(TAG, "Patch does not apply: %s", delta_err_name(delta_finish(d)));
+        r.err = ESP_ERR_INVALID_RESPONSE;
+    }
+    if (r.err != ESP_OK) goto done;
+
+    uint8_t digest[32];
+    mbedtls_sha256_finish(&job.sha, digest);
+    if (memcmp(digest, hdr.new_sha256, sizeof(digest)) != 0) {
+        ESP_LOGE(TAG, "Patched image does not match the new build");
+        r.err = ESP_ERR_INVALID_CRC;
+        goto done;
+    }
+    ota_open = false;
+    if ((r.err = esp_ota_end(job.ota)) != ESP_OK || (r.err = esp_ota_set_boot_partition(next)) != ESP_OK) {
+        ESP_LOGE(TAG, "%s not made bootable: %s", next->label, esp_err_to_name(r.err));
+        goto done;
+    }
+    ESP_LOGI(TAG, "%s patched (%lu KB from %lu KB of patch); it runs after the next restart", next->label,
+             (unsigned long)(hdr.new_size / 1024), (unsigned long)(r.patch_bytes / 1024));
+
+done:
+    if (ota_open) esp_ota_abort(job.ota);
+    if (d) {
+        mbedtls_sha256_free(&job.sha);
+        delta_destroy(d);
+    }
+    if (http) esp_http_client_cleanup(http);
+    heap_caps_free(body);
+    heap_caps_free(z);
+    heap_caps_free(buf);
+    r.flash_ms = (uint32_t)(job.flash_us / 1000);
+    r.total_ms = ms_since(t0);
+    last = r;
+    have_last = true;
+    if (out) *out = r;
+    return r.err;
+}
+
+// --- Console ---
+
+void ui_ota_report(FILE *out) {
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    const esp_partition_t *next = esp_ota_get_next_update_partition(NULL);
+    fprintf(out, "Running %s from %s; next update goes to %s\n", esp_app_get_description()->version,
+            running ? running->label : "?", next ? next->label : "(none)");
+    if (!have_last) {
+        fprintf(out, "No delta update yet ('O' applies %s)\n",
+                *CONFIG_UI_OTA_DELTA_URL ? CONFIG_UI_OTA_DELTA_URL : "CONFIG_UI_OTA_DELTA_URL, which is unset");
+        return;
+    }
+    fprintf(out, "Last delta update to %s: %s\n", last.slot, esp_err_to_name(last.err));
+    fprintf(out, "  %lu bytes downloaded for a %lu byte image (%.1f%%)\n", (unsigned long)last.patch_bytes,
+            (unsigned long)last.image_bytes, last.image_bytes ? 100.0 * last.patch_bytes / last.image_bytes : 0);
+    fprintf(out, "  radio %lu ms, flash %lu ms, total %lu ms\n", (unsigned long)last.radio_ms,
+            (unsigned long)last.flash_ms, (unsigned long)last.total_ms);
+    // A full OTA moves image_bytes over the same link, then writes the same flash
+    if (last.err == ESP_OK && last.radio_ms && last.patch_bytes) {
+        uint64_t full_radio = (uint64_t)last.radio_ms * last.image_bytes / last.patch_bytes;
+        fprintf(out, "  full image at this link's rate: ~%llu ms of radio\n", (unsigned long long)full_radio);
+    }
+}
+
+static void update_task_fn(void *arg) {
+    ui_ota_delta_update(CONFIG_UI_OTA_DELTA_URL, NULL);
+    ui_ota_report(stdout);
+    task = NULL;
+    vTaskDelete(NULL);
+}
+
+static void console_update(FILE *out) {
+    if (!*CONFIG_UI_OTA_DELTA_URL) {
+        fprintf(out, "Set CONFIG_UI_OTA_DELTA_URL to a patch built with tools/ota_delta.c\n");
+        return;
+    }
+    if (task) {
+        fprintf(out, "Update already running\n");
+        return;
+    }
+    if (xTaskCreate(update_task_fn, "ui_ota", TASK_STACK, NULL, TASK_PRIO, &task) != pdPASS) {
+        fprintf(out, "No memory for the update task\n");
+        task = NULL;
+        return;
+    }
+    fprintf(out, "Fetching %s; the report follows when done\n", CONFIG_UI_OTA_DELTA_URL);
+}
+
+void ui_ota_init(void) {
+    ui_console_register('o', "OTA slots and last delta update", ui_ota_report);
+    ui_console_register('O', "delta OTA from CONFIG_UI_OTA_DELTA_URL", console_update);
+}
@@ -0,0 +1,414 @@
+#include "ui_photos.h"
+#include "ui_decode.h"
+#include "ui_assets.h"
+#include "ui_status_bar.h"
+#include "ui_trace.h"
+#include "ui_arena.h"
+#include "ui_app.h"
+#include "ui_mem.h"
+#include "ui_fill.h"
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+static const char *TAG = "ui_photos";
+
+#define MAX_PHOTOS   256
+#define NAME_LEN     64
+#define GRID_COLS    4
+#define GRID_PAD     8
+#define CACHE_BYTES  (CONFIG_UI_PHOTOS_THUMB_CACHE_KB * 1024)
+#define VIEWER_BYTES (600 * 450 * 2)    // One RGB565 frame of the panel
+
+typedef struct {
+    lv_obj_t *img;
+    int16_t slot;               // Thumbnail slot, -1 if none
+    bool failed;                // Not decodable, don't retry
+} tile_t;
+
+typedef struct {
+    int16_t tile;               // Tile shown from this slot, -1 if free
+    uint32_t job;               // Decode in flight, 0 if none
+    bool ready;
+    uint32_t last_seen;         // Request pass that last found the tile near the viewport
+    lv_draw_buf_t buf;
+} slot_t;
+
+static lv_obj_t *photos_screen = NULL;
+static lv_obj_t *grid = NULL;
+
+static char (*names)[NAME_LEN] = NULL;
+static tile_t *tiles = NULL;
+static uint16_t photo_count = 0;
+
+// Thumbnail cache: slot_count equal slots carved from one PSRAM slab
+static slot_t *slots = NULL;
+static uint8_t *slab = NULL;
+static uint16_t slot_count = 0;
+static uint16_t thumb_w = 0, thumb_h = 0;
+static uint32_t pass = 0;
+
+static lv_obj_t *viewer = NULL;
+static lv_obj_t *viewer_img = NULL;
+static lv_obj_t *viewer_lbl = NULL;
+static lv_draw_buf_t viewer_buf;
+static void *viewer_data = NULL;
+static uint32_t viewer_job = 0;
+static uint16_t viewer_tile = 0;
+
+// --- Files ---
+
+static bool is_photo(const char *name) {
+    const char *dot = strrchr(name, '.');
+    return dot && (!strcasecmp(dot, ".jpg") || !strcasecmp(dot, ".jpeg") || !strcasecmp(dot, ".png"));
+}
+
+static void photo_path(uint16_t i, char *out, size_t len) {
+    snprintf(out, len, "%s/%s", CONFIG_UI_PHOTOS_DIR, names[i]);
+}
+
+static uint16_t scan_dir(void) {
+    DIR *dir = opendir(CONFIG_UI_PHOTOS_DIR);
+    if (!dir) {
+        ESP_LOGW(TAG, "Can't open %s", CONFIG_UI_PHOTOS_DIR);
+        return 0;
+    }
+    uint16_t n = 0;
+    struct dirent *de;
+    while (n < MAX_PHOTOS && (de = readdir(dir)) != NULL) {
+        if (de->d_type == DT_DIR || !is_photo(de->d_name) || strlen(de->d_name) >= NAME_LEN) continue;
+        strcpy(names[n++], de->d_name);
+    }
+    closedir(dir);
+    return n;
+}
+
+// --- Thumbnail cache ---
+
+static void slot_release(slot_t *s) {
+    if (s->job) ui_decode_cancel(s->job);
+    if (s->ready) lv_image_cache_drop(&s->buf);
+    if (s->tile >= 0) {
+        tile_t *t = &tiles[s->tile];
+        t->slot = -1;
+        lv_image_set_src(t->img, NULL);
+    }
+    s->tile = -1;
+    s->job = 0;
+    s->ready = false;
+}
+
+// Free slot, else the least recently seen one not near the viewport
+static int take_slot(void) {
+    int lru = -1;
+    for (int i = 0; i < slot_count; i++) {
+        if (slots[i].tile < 0) return i;
+        if (slots[i].last_seen != pass && (lru < 0 || slots[i].last_seen < slots[lru].last_seen)) lru = i;
+    }
+    if (lru >= 0) slot_release(&slots[lru]);
+    return lru;
+}
+
+static void thumb_decoded(uint32_t id, const ui_decode_info_t *info, void *user) {
+    slot_t *s = &slots[(intptr_t)user];
+    if (info->status == UI_DECODE_PROGRESS || s->job != id) return;
+    s->job = 0;
+    tile_t *t = &tiles[s->tile];
+    if (info->status == UI_DECODE_DONE) {
+        s->ready = true;
+        lv_image_set_src(t->img, &s->buf);
+    } else {
+        t->failed = true;
+        t->slot = -1;
+        s->tile = -1;
+        lv_image_set_src(t->img, LV_SYMBOL_WARNING);
+    }
+}
+
+// One row of tiles above and below the viewport is prefetched
+static bool tile_near_view(const tile_t *t, const lv_area_t *view) {
+    lv_area_t a;
+    lv_obj_get_coords(t->img, &a);
+    return a.y2 >= view->y1 - thumb_h && a.y1 <= view->y2 + thumb_h;
+}
+
+static void request_visible(void) {
+    if (!grid || !slot_count || viewer_data) return;
+    lv_area_t view;
+    lv_obj_get_coords(grid, &view);
+    pass++;
+
+    // Mark first, so a tile further down the list isn't evicted for one above it
+    for (uint16_t i = 0; i < photo_count; i++) {
+        if (tiles[i].slot >= 0 && tile_near_view(&tiles[i], &view)) slots[tiles[i].slot].last_seen = pass;
+    }
+    for (uint16_t i = 0; i < photo_count; i++) {
+        tile_t *t = &tiles[i];
+        if (t->slot >= 0 || t->failed || !tile_near_view(t, &view)) continue;
+        int si = take_slot();
+        if (si < 0) break;              // Every slot holds a tile in view
+
+        slot_t *s = &slots[si];
+        char path[UI_DECODE_PATH_MAX];
+        photo_path(i, path, sizeof(path));
+        s->job = ui_decode_submit(path, &s->buf, UI_DECODE_CACHED, thumb_decoded, (void *)(intptr_t)si);
+        if (!s->job) break;             // Decode queue full; the next scroll retries
+        s->tile = (int16_t)i;
+        s->last_seen = pass;
+        t->slot = (int16_t)si;
+    }
+}
+
+static void cancel_thumbs(void) {
+    for (uint16_t i = 0; i < slot_count; i++) {
+        if (slots[i].job) slot_release(&slots[i]);
+    }
+}
+
+// --- Viewer ---
+
+static void viewer_decoded(uint32_t id, const ui_decode_info_t *info, void *user) {
+    if (id != viewer_job) return;
+    lv_image_cache_drop(&viewer_buf);
+    lv_obj_invalidate(viewer_img);
+    if (info->status == UI_DECODE_PROGRESS) return;
+
+    viewer_job = 0;
+    if (info->status == UI_DECODE_DONE) {
+        lv_label_set_text_fmt(viewer_lbl, "%s  %ux%u  %lu ms%s", names[viewer_tile], info->src_w, info->src_h,
+                              (unsigned long)info->elapsed_ms, info->cached ? " (cached)" : "");
+    } else {
+        lv_label_set_text_fmt(viewer_lbl, "%s  can't be decoded", names[viewer_tile]);
+    }
+}
+
+static void viewer_open(uint16_t i) {
+    uint32_t stride = lv_draw_buf_width_to_stride(LV_HOR_RES, LV_COLOR_FORMAT_RGB565);
+    viewer_data = ui_mem_malloc(UI_MEM_APP_PHOTOS, stride * LV_VER_RES, MALLOC_CAP_SPIRAM);
+    if (!viewer_data) return;
+    cancel_thumbs();                    // The viewer goes to the front of the decode queue
+
+    lv_draw_buf_init(&viewer_buf, LV_HOR_RES, LV_VER_RES, LV_COLOR_FORMAT_RGB565, stride, viewer_data, stride * LV_VER_RES);
+    ui_fill_rect(viewer_data, stride, LV_HOR_RES, LV_VER_RES, 0x0000);
+    lv_image_set_src(viewer_img, &viewer_buf);
+    lv_label_set_text_fmt(viewer_lbl, "%s", names[i]);
+    lv_obj_remove_flag(viewer, LV_OBJ_FLAG_HIDDEN);
+    viewer_tile = i;
+
+    char path[UI_DECODE_PATH_MAX];
+    photo_path(i, path, sizeof(path));
+    viewer_job = ui_decode_submit(path, &viewer_buf, UI_DECODE_PREVIEW | UI_DECODE_CACHED, viewer_decoded, NULL);
+    if (!viewer_job) lv_label_set_text_fmt(viewer_lbl, "%s  decoder busy", names[i]);
+}
+
+static void viewer_release(void) {
+    ui_decode_cancel(viewer_job);
+    viewer_job = 0;
+    if (viewer_data) {
+        lv_image_cache_drop(&viewer_buf);
+        ui_mem_free(viewer_data);
+        viewer_data = NULL;
+    }
+}
+
+static void viewer_close(void) {
+    lv_obj_add_flag(viewer, LV_OBJ_FLAG_HIDDEN);
+    lv_image_set_src(viewer_img, NULL);
+    viewer_release();
+    request_visible();
+}
+
+// --- Events ---
+
+static void btn_back_event_cb(lv_event_t *e) {
+    if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
+        ESP_LOGI(TAG, "Back button clicked");
+        ui_app_exit();
+    }
+}
+
+static void tile_event_cb(lv_event_t *e) {
+    uint16_t i = (uint16_t)(intptr_t)lv_event_get_user_data(e);
+    if (!tiles[i].failed) viewer_open(i);
+}
+
+static void viewer_event_cb(lv_event_t *e) {
+    viewer_close();
+}
+
+static void grid_scroll_cb(lv_event_t *e) {
+    request_visible();
+}
+
+// --- Screen ---
+
+void ui_photos_cleanup(void) {
+    for (uint16_t i = 0; i < slot_count; i++) {
+        if (slots[i].job) ui_decode_cancel(slots[i].job);
+        if (slots[i].ready) lv_image_cache_drop(&slots[i].buf);
+    }
+    viewer_release();
+    if (photos_screen) {
+        ESP_LOGI(TAG, "Cleaning up photos screen");
+        lv_obj_del(photos_screen);
+        photos_screen = NULL;
+    }
+    grid = viewer = viewer_img = viewer_lbl = NULL;
+
+    ui_mem_free(slab);
+    ui_mem_free(slots);
+    ui_mem_free(tiles);
+    ui_mem_free(names);
+    slab = NULL;
+    slots = NULL;
+    tiles = NULL;
+    names = NULL;
+    slot_count = 0;
+    photo_count = 0;
+}
+
+static bool alloc_cache(void) {
+    thumb_w = (LV_HOR_RES - GRID_PAD * (GRID_COLS + 1)) / GRID_COLS;
+    thumb_h = thumb_w * 3 / 4;
+    uint32_t stride = lv_draw_buf_width_to_stride(thumb_w, LV_COLOR_FORMAT_RGB565);
+    uint32_t thumb_bytes = stride * thumb_h;
+    uint32_t count = CACHE_BYTES / thumb_bytes;
+    if (count > MAX_PHOTOS) count = MAX_PHOTOS;
+
+    names = ui_mem_malloc(UI_MEM_APP_PHOTOS, MAX_PHOTOS * NAME_LEN, MALLOC_CAP_SPIRAM);
+    tiles = ui_mem_malloc(UI_MEM_APP_PHOTOS, MAX_PHOTOS * sizeof(tile_t), MALLOC_CAP_INTERNAL);
+    slots = ui_mem_malloc(UI_MEM_APP_PHOTOS, count * sizeof(slot_t), MALLOC_CAP_INTERNAL);
+    slab = ui_mem_malloc(UI_MEM_APP_PHOTOS, count * thumb_bytes, MALLOC_CAP_SPIRAM);
+    if (!names || !tiles || !slots || !slab || !count) return false;
+
+    slot_count = (uint16_t)count;
+    for (uint16_t i = 0; i < slot_count; i++) {
+        slots[i] = (slot_t){ .tile = -1 };
+        lv_draw_buf_init(&slots[i].buf, thumb_w, thumb_h, LV_COLOR_FORMAT_RGB565, stride,
+                         slab + i * thumb_bytes, thumb_bytes);
+    }
+    return true;
+}
+
+void ui_photos_show(void) {
+    ESP_LOGI(TAG, "Showing Photos app");
+    ui_trace_t span = ui_trace_begin();
+
+    ui_status_bar_set_visible(false);   // Apps draw their own top bar
+    ui_photos_cleanup();
+
+    bool cache_ok = alloc_cache();
+    int64_t t0 = esp_timer_get_time();
+    if (cache_ok) photo_count = scan_dir();
+    uint32_t scan_ms = (uint32_t)((esp_timer_get_time() - t0) / 1000);
+
+    // Create main screen; its LVGL allocations come from one arena
+    ui_arena_t *arena = ui_arena_begin("photos");
+    photos_screen = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(photos_screen, lv_color_hex(0x101010), 0);
+    lv_obj_remove_flag(photos_screen, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_flex_flow(photos_screen, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(photos_screen, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_all(photos_screen, 0, 0);
+
+    // Top bar with back button and photo count
+    lv_obj_t *top_bar = lv_obj_create(photos_screen);
+    lv_obj_set_size(top_bar, LV_PCT(100), 60);
+    lv_obj_set_style_bg_opa(top_bar, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(top_bar, 0, 0);
+    lv_obj_remove_flag(top_bar, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_flex_flow(top_bar, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(top_bar, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_left(top_bar, 10, 0);
+    lv_obj_set_style_pad_gap(top_bar, 20, 0);
+
+    lv_obj_t *btn_back = lv_button_create(top_bar);
+    lv_obj_set_size(btn_back, 80, 45);
+    lv_obj_add_event_cb(btn_back, btn_back_event_cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_t *lbl_back = lv_label_create(btn_back);
+    lv_label_set_text(lbl_back, LV_SYMBOL_LEFT " Back");
+    lv_obj_center(lbl_back);
+
+    lv_obj_t *title = lv_label_create(top_bar);
+    if (!cache_ok) {
+        lv_label_set_text(title, "Photos: out of memory");
+    } else {
+        lv_label_set_text_fmt(title, "Photos (%u)", photo_count);
+    }
+    lv_obj_set_style_text_font(title, ui_assets_font(22), 0);
+    lv_obj_set_style_text_color(title, lv_color_white(), 0);
+
+    // Thumbnail grid
+    grid = lv_obj_create(photos_screen);
+    lv_obj_set_width(grid, LV_PCT(100));
+    lv_obj_set_flex_grow(grid, 1);
+    lv_obj_set_style_bg_opa(grid, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(grid, 0, 0);
+    lv_obj_set_style_pad_all(grid, GRID_PAD, 0);
+    lv_obj_set_style_pad_gap(grid, GRID_PAD, 0);
+    lv_obj_set_flex_flow(grid, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_scroll_dir(grid, LV_DIR_VER);
+    lv_obj_add_event_cb(grid, grid_scroll_cb, LV_EVENT_SCROLL_END, NULL);
+
+    for (uint16_t i = 0; i < photo_count; i++) {
+        lv_obj_t *img = lv_image_create(grid);
+        lv_obj_set_size(img, thumb_w, thumb_h);
+        lv_obj_set_style_bg_opa(img, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(img, lv_color_hex(0x202020), 0);
+        lv_obj_set_style_text_font(img, ui_assets_font(22), 0);    // Failed tiles show a symbol
+        lv_obj_set_style_text_color(img, lv_color_hex(0x808080), 0);
+        lv_obj_add_flag(img, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_add_event_cb(img, tile_event_cb, LV_EVENT_CLICKED, (void *)(intptr_t)i);
+        tiles[i] = (tile_t){ .img = img, .slot = -1 };
+    }
+    if (cache_ok && !photo_count) {
+        lv_obj_t *empty = lv_label_create(grid);
+        lv_label_set_text(empty, "No JPEG or PNG files in " CONFIG_UI_PHOTOS_DIR);
+        lv_obj_set_style_text_font(empty, ui_assets_font(18), 0);
+        lv_obj_set_style_text_color(empty, lv_color_hex(0xCCCCCC), 0);
+    }
+
+    // Full-screen viewer, shown over the grid while a photo is open
+    viewer = lv_obj_create(photos_screen);
+    lv_obj_add_flag(viewer, LV_OBJ_FLAG_FLOATING | LV_OBJ_FLAG_HIDDEN);
+    lv_obj_remove_flag(viewer, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_size(viewer, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_pos(viewer, 0, 0);
+    lv_obj_set_style_pad_all(viewer, 0, 0);
+    lv_obj_set_style_border_width(viewer, 0, 0);
+    lv_obj_set_style_radius(viewer, 0, 0);
+    lv_obj_set_style_bg_color(viewer, lv_color_hex(0x000000), 0);
+    lv_obj_add_event_cb(viewer, viewer_event_cb, LV_EVENT_CLICKED, NULL);
+    viewer_img = lv_image_create(viewer);
+    lv_obj_center(viewer_img);
+    viewer_lbl = lv_label_create(viewer);
+    lv_obj_set_style_text_font(viewer_lbl, ui_assets_font(16), 0);
+    lv_obj_set_style_text_color(viewer_lbl, lv_color_white(), 0);
+    lv_obj_align(viewer_lbl, LV_ALIGN_BOTTOM_MID, 0, -10);
+
+    lv_screen_load(photos_screen);
+    ui_arena_end(arena, photos_screen);
+
+    lv_obj_update_layout(photos_screen);
+    request_visible();
+    ui_trace_end(TAG, UI_TRACE_LAYOUT, span);
+
+    ESP_LOGI(TAG, "%u photos in %s (listed in %lu ms), %u thumbnail slots of %ux%u in %u KB",
+             photo_count, CONFIG_UI_PHOTOS_DIR, (unsigned long)scan_ms, slot_count, thumb_w, thumb_h,
+             CONFIG_UI_PHOTOS_THUMB_CACHE_KB);
+}
+
+const ui_app_t ui_app_photos = {
+    .name = "Photos",
+    .icon = LV_SYMBOL_IMAGE,
+    .color = 0xE91E63,              // LV_PALETTE_PINK
+    .mem_app = UI_MEM_APP_PHOTOS,
+    .mem_budget = CACHE_BYTES + VIEWER_BYTES + 32 * 1024,
+    .create = ui_photos_show,
+    .destroy = ui_photos_cleanup,
+};
@@ -0,0 +1,370 @@
+#include "ui_rafs_core.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SECTOR      512         // Random reads load from here, in these units
+
+typedef enum {
+    BLK_FREE = 0,
+    BLK_QUEUED,                 // Reserved for read-ahead, not started
+    BLK_LOADING,                // Backend read in flight (worker or reader)
+    BLK_READY,
+} blk_state_t;
+
+typedef struct shared {
+    struct shared *next;
+    void *h;
+    uint32_t size;
+    uint16_t refs;
+    char path[];
+} shared_t;
+
+typedef struct {
+    shared_t *file;             // NULL when free
+    uint32_t off;               // Block-aligned, or sector-aligned for a random read
+    uint32_t len;               // Bytes covered (being) loaded, up to block_size
+    uint32_t used;              // LRU stamp
+    uint8_t state;
+    bool ahead;                 // Loaded by read-ahead and not used yet
+    uint8_t *buf;               // Allocated on first use, freed when no file is open
+} block_t;
+
+struct rafs_file {
+    rafs_t *fs;
+    shared_t *sf;
+    uint32_t pos;
+    uint32_t last_end;          // Where the previous read stopped
+    uint8_t streak;             // Reads in a row that started at last_end
+};
+
+struct rafs {
+    rafs_config_t cfg;
+    rafs_backend_t be;
+    block_t *blocks;
+    shared_t *files;
+    uint32_t clock;
+    rafs_stats_t stats;
+};
+
+#define LOCK(fs)    (fs)->be.lock((fs)->be.ctx)
+#define UNLOCK(fs)  (fs)->be.unlock((fs)->be.ctx)
+
+// --- Pool ---
+
+// Block holding (or about to hold) byte @p pos of @p sf
+static block_t *find(rafs_t *fs, const shared_t *sf, uint32_t pos) {
+    for (uint16_t i = 0; i < fs->cfg.blocks; i++) {
+        block_t *b = &fs->blocks[i];
+        if (b->file == sf && b->state != BLK_FREE && pos >= b->off && pos - b->off < b->len) return b;
+    }
+    return NULL;
+}
+
+// Loaded blocks a reader has used go before read-ahead still waiting for one
+static bool older(const block_t *a, const block_t *b) {
+    return a->ahead != b->ahead ? !a->ahead : a->used < b->used;
+}
+
+// Free block, else the least recently used loaded one; never one in flight or queued
+static block_t *claim(rafs_t *fs, shared_t *sf, uint32_t off, uint32_t len) {
+    block_t *pick = NULL;
+    for (uint16_t i = 0; i < fs->cfg.blocks; i++) {
+        block_t *b = &fs->blocks[i];
+        if (b->state == BLK_FREE) {
+            pick = b;
+            if (b->buf) break;          // Prefer one that already has a buffer
+            continue;
+        }
+        if (b->state == BLK_READY && (!pick || (pick->state == BLK_READY && older(b, pick)))) pick = b;
+    }
+    if (!pick) return NULL;
+    if (!pick->buf) {
+        pick->buf = fs->be.alloc(fs->be.ctx, fs->cfg.block_size);
+        if (!pick->buf) return NULL;
+    }
+    pick->file = sf;
+    pick->off = off;
+    pick->len = len;
+    pick->ahead = false;
+    pick->used = ++fs->clock;
+    return pick;
+}
+
+// Called locked with b QUEUED or freshly claimed; returns locked
+static bool load(rafs_t *fs, block_t *b) {
+    shared_t *sf = b->file;
+    b->state = BLK_LOADING;
+    UNLOCK(fs);
+    int r = fs->be.pread(fs->be.ctx, sf->h, b->buf, b->len, b->off);
+    LOCK(fs);
+    fs->stats.backend_reads++;
+    if (r > 0) fs->stats.backend_bytes += (uint32_t)r;
+    bool ok = r == (int)b->len;
+    b->state = ok ? BLK_READY : BLK_FREE;
+    if (!ok) b->file = NULL;
+    if (fs->be.signal) fs->be.signal(fs->be.ctx);
+    return ok;
+}
+
+static uint32_t block_len(rafs_t *fs, const shared_t *sf, uint32_t off) {
+    return sf->size - off < fs->cfg.block_size ? sf->size - off : fs->cfg.block_size;
+}
+
+static void queue_ahead(rafs_t *fs, rafs_file_t *f) {
+    uint32_t bs = fs->cfg.block_size;
+    uint32_t start = f->pos & ~(bs - 1);
+    bool queued = false;
+    for (uint32_t i = 0; i <= fs->cfg.readahead; i++) {
+        uint32_t off = start + i * bs;
+        if (off >= f->sf->size) break;
+        if (find(fs, f->sf, off)) continue;
+        block_t *b = claim(fs, f->sf, off, block_len(fs, f->sf, off));
+        if (!b) break;
+        b->state = BLK_QUEUED;
+        b->ahead = true;
+        queued = true;
+    }
+    if (queued && fs->be.kick) fs->be.kick(fs->be.ctx);
+}
+
+// --- API ---
+
+rafs_t *rafs_create(const rafs_config_t *cfg, const rafs_backend_t *be) {
+    if (!cfg->block_size || (cfg->block_size & (cfg->block_size - 1)) || !cfg->blocks) return NULL;
+    rafs_t *fs = calloc(1, sizeof(rafs_t));
+    if (!fs) return NULL;
+    fs->cfg = *cfg;
+    fs->be = *be;
+    fs->blocks = calloc(cfg->blocks, sizeof(block_t));
+    if (!fs->blocks) {
+        free(fs);
+        return NULL;
+    }
+    return fs;
+}
+
+void rafs_destroy(rafs_t *fs) {
+    if (!fs) return;
+    for (uint16_t i = 0; i < fs->cfg.blocks; i++) {
+        if (fs->blocks[i].buf) fs->be.free(fs->be.ctx, fs->blocks[i].buf);
+    }
+    free(fs->blocks);
+    free(fs);
+}
+
+rafs_file_t *rafs_open(rafs_t *fs, const char *path) {
+    rafs_file_t *f = calloc(1, sizeof(rafs_file_t));
+    if (!f) return NULL;
+    f->fs = fs;
+
+    LOCK(fs);
+    shared_t *sf = fs->files;
+    while (sf && strcmp(sf->path, path) != 0) sf = sf->next;
+    if (sf) {
+        fs->stats.shared_opens++;
+    } else {
+        size_t len = strlen(path) + 1;
+        sf = malloc(sizeof(shared_t) + len);
+        uint32_t size = 0;
+        void *h = sf ? fs->be.open(fs->be.ctx, path, &size) : NULL;
+        if (!h) {
+            UNLOCK(fs);
+            free(sf);
+            free(f);
+            return NULL;
+        }
+        sf->h = h;
+        sf->size = size;
+        sf->refs = 0;
+        memcpy(sf->path, path, len);
+        sf->next = fs->files;
+        fs->files = sf;
+        fs->stats.open_files++;
+    }
+    sf->refs++;
+    fs->stats.opens++;
+    f->sf = sf;
+    UNLOCK(fs);
+    return f;
+}
+
+void rafs_close(rafs_file_t *f) {
+    rafs_t *fs = f->fs;
+    shared_t *sf = f->sf;
+    LOCK(fs);
+    if (--sf->refs == 0) {
+        // Drop its blocks; one in flight is waited out, since it reads through sf->h
+        for (uint16_t i = 0; i < fs->cfg.blocks; i++) {
+            block_t *b = &fs->blocks[i];
+            while (b->file == sf && b->state == BLK_LOADING) fs->be.wait(fs->be.ctx);
+            if (b->file == sf) {
+                b->file = NULL;
+                b->state = BLK_FREE;
+            }
+        }
+        shared_t **pp = &fs->files;
+        while (*pp != sf) pp = &(*pp)->next;
+        *pp = sf->next;
+        fs->be.close(fs->be.ctx, sf->h);
+        fs->stats.open_files--;
+        free(sf);
+
+        // Nothing open: give the buffers back
+        if (!fs->files) {
+            for (uint16_t i = 0; i < fs->cfg.blocks; i++) {
+                block_t *b = &fs->blocks[i];
+                if (b->buf && b->state == BLK_FREE) {
+                    fs->be.free(fs->be.ctx, b->buf);
+                    b->buf = NULL;
+                }
+            }
+        }
+    }
+    UNLOCK(fs);
+    free(f);
+}
+
+int rafs_read(rafs_file_t *f, void *buf, uint32_t len) {
+    rafs_t *fs = f->fs;
+    shared_t *sf = f->sf;
+    uint32_t bs = fs->cfg.block_size;
+    uint8_t *out = buf;
+
+    LOCK(fs);
+    if (f->pos >= sf->size) {
+        UNLOCK(fs);
+        return 0;
+    }
+    if (len > sf->size - f->pos) len = sf->size - f->pos;
+    f->streak = f->pos == f->last_end ? (f->streak < UINT8_MAX ? f->streak + 1 : f->streak) : 0;
+    fs->stats.read_bytes += len;
+
+    uint32_t done = 0;
+    bool failed = false;
+    while (done < len && !failed) {
+        uint32_t p = f->pos + done;
+        uint32_t rem = len - done;
+        block_t *b = find(fs, sf, p);
+
+        // Whole blocks straight into the caller's buffer, ahead of any read-ahead for them
+        if ((!b || b->state == BLK_QUEUED) && !(p & (bs - 1)) && rem >= bs &&
+            (!fs->be.direct_ok || fs->be.direct_ok(fs->be.ctx, out + done))) {
+            uint32_t n = rem & ~(bs - 1);
+            for (uint32_t o = p; o < p + n; o += bs) {
+                block_t *q = find(fs, sf, o);
+                if (q && q->state == BLK_QUEUED) {
+                    q->file = NULL;
+                    q->state = BLK_FREE;
+                }
+            }
+            UNLOCK(fs);
+            int r = fs->be.pread(fs->be.ctx, sf->h, out + done, n, p);
+            LOCK(fs);
+            fs->stats.backend_reads++;
+            if (r > 0) {
+                fs->stats.backend_bytes += (uint32_t)r;
+                fs->stats.direct_bytes += (uint32_t)r;
+                done += (uint32_t)r;
+            }
+            failed = r != (int)n;
+            continue;
+        }
+
+        if (b && b->state == BLK_READY) {
+            uint32_t n = b->off + b->len - p;
+            if (n > rem) n = rem;
+            memcpy(out + done, b->buf + (p - b->off), n);
+            fs->stats.hit_bytes += n;
+            if (b->ahead) {
+                b->ahead = false;
+                fs->stats.ahead_used++;
+            }
+            b->used = ++fs->clock;
+            done += n;
+            continue;
+        }
+        if (b && b->state == BLK_LOADING) {
+            fs->stats.waits++;
+            fs->be.wait(fs->be.ctx);
+            continue;
+        }
+        if (b) {                        // Queued but not started: load it now
+            b->ahead = false;
+            failed = !load(fs, b);
+            continue;
+        }
+
+        // Sequential: the whole block. Random: just what was asked for, from its
+        // sector, but at least a quarter block so nearby small reads still hit.
+        uint32_t off = p & ~(bs - 1), n = block_len(fs, sf, off);
+        if (!f->streak) {
+            uint32_t want = (p & (SECTOR - 1)) + rem;
+            if (want < bs / 4) want = bs / 4;
+            want = (want + SECTOR - 1) & ~(uint32_t)(SECTOR - 1);
+            off = p & ~(uint32_t)(SECTOR - 1);
+            n = want < bs ? want : bs;
+            if (n > sf->size - off) n = sf->size - off;
+        }
+        b = claim(fs, sf, off, n);
+        if (b) {
+            failed = !load(fs, b);
+            continue;
+        }
+        // Pool exhausted (every block queued or in flight): read unbuffered
+        UNLOCK(fs);
+        int r = fs->be.pread(fs->be.ctx, sf->h, out + done, rem, p);
+        LOCK(fs);
+        fs->stats.backend_reads++;
+        if (r > 0) {
+            fs->stats.backend_bytes += (uint32_t)r;
+            done += (uint32_t)r;
+        }
+        failed = r != (int)rem;
+    }
+
+    f->pos += done;
+    f->last_end = f->pos;
+    // Readers of whole blocks already pay one request per block; read ahead for small ones
+    if (f->streak >= 2 && len < bs && fs->cfg.readahead && f->pos < sf->size) queue_ahead(fs, f);
+    UNLOCK(fs);
+    return failed && !done ? -1 : (int)done;
+}
+
+bool rafs_seek(rafs_file_t *f, uint32_t pos) {
+    if (pos > f->sf->size) return false;
+    f->pos = pos;
+    return true;
+}
+
+uint32_t rafs_tell(const rafs_file_t *f) {
+    return f->pos;
+}
+
+uint32_t rafs_size(const rafs_file_t *f) {
+    return f->sf->size;
+}
+
+bool rafs_service(rafs_t *fs) {
+    LOCK(fs);
+    block_t *b = NULL;
+    for (uint16_t i = 0; i < fs->cfg.blocks && !b; i++) {
+        if (fs->blocks[i].state == BLK_QUEUED) b = &fs->blocks[i];
+    }
+    if (b && load(fs, b)) fs->stats.ahead_loaded++;
+    UNLOCK(fs);
+    return b != NULL;
+}
+
+void rafs_get_stats(rafs_t *fs, rafs_stats_t *out) {
+    LOCK(fs);
+    *out = fs->stats;
+    UNLOCK(fs);
+}
+
+void rafs_reset_stats(rafs_t *fs) {
+    LOCK(fs);
+    uint32_t open_files = fs->stats.open_files;
+    memset(&fs->stats, 0, sizeof(fs->stats));
+    fs->stats.open_files = open_files;
+    UNLOCK(fs);
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+/**
+ * Read-ahead block cache for read-only file access, independent of LVGL and
+ * FreeRTOS.
+ *
+ * Files are read through a pool of equal, block-aligned buffers shared by
+ * every open file. A handle whose reads follow on from each other is
+ * treated as sequential: the blocks after its position are queued and a
+ * worker loads them (rafs_service()) while the caller works on what it has.
+ * A read after a seek loads only the sectors it needs (at least a quarter
+ * block). Reads that start on a block boundary and cover whole blocks skip
+ * the pool and go straight into the caller's buffer when the backend
+ * allows it. Opening a path that is already open shares its backend handle and
+ * cached blocks; each open still has its own position.
+ *
+ * Platform pieces (file I/O, buffer allocation, locking and waking the
+ * worker) come from a backend. ui_fs.c provides one over the VFS with a
+ * FreeRTOS worker; tools/fs_bench.c provides one over POSIX with a
+ * simulated SD card.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    // Open @p path for reading; NULL if it can't be. Sets *size.
+    void *(*open)(void *ctx, const char *path, uint32_t *size);
+    // Read @p len bytes at @p off; bytes read, < 0 on error
+    int (*pread)(void *ctx, void *h, void *buf, uint32_t len, uint32_t off);
+    void (*close)(void *ctx, void *h);
+    // Block buffers (block_size bytes)
+    void *(*alloc)(void *ctx, size_t size);
+    void (*free)(void *ctx, void *p);
+    // Whether @p buf can take a direct backend read (e.g. DMA-capable); NULL = always
+    bool (*direct_ok)(void *ctx, const void *buf);
+    void (*lock)(void *ctx);
+    void (*unlock)(void *ctx);
+    // Called locked: release the lock, sleep until signal() (or briefly), relock
+    void (*wait)(void *ctx);
+    void (*signal)(void *ctx);
+    // Read-ahead was queued: have the worker call rafs_service() until it returns false
+    void (*kick)(void *ctx);
+    void *ctx;
+} rafs_backend_t;
+
+typedef struct {
+    uint32_t block_size;        // Power of two
+    uint16_t blocks;            // Pool size; buffers are allocated on demand
+    uint8_t readahead;          // Blocks queued past a sequential reader, 0 = none
+} rafs_config_t;
+
+typedef struct {
+    uint64_t read_bytes;        // Asked for by callers (after clipping to the file)
+    uint64_t hit_bytes;         // Copied from blocks already loaded
+    uint64_t direct_bytes;      // Read straight into callers' buffers
+    uint64_t backend_bytes;     // Read from the backend, read-ahead included
+    uint32_t backend_reads;
+    uint32_t ahead_loaded;      // Blocks loaded by read-ahead...
+    uint32_t ahead_used;        // ...that a reader then used
+    uint32_t waits;             // Reads that waited for a block in flight
+    uint32_t opens, shared_opens;
+    uint32_t open_files;        // Distinct backend handles open now
+} rafs_stats_t;
+
+typedef struct rafs rafs_t;
+typedef struct rafs_file rafs_file_t;
+
+rafs_t *rafs_create(const rafs_config_t *cfg, const rafs_backend_t *be);
+
+/**
+ * @brief Free the pool; every file must be closed
+ */
+void rafs_destroy(rafs_t *fs);
+
+rafs_file_t *rafs_open(rafs_t *fs, const char *path);
+void rafs_close(rafs_file_t *f);
+
+/**
+ * @brief Read at the handle's position
+ * @return Bytes read (short at the end of the file), < 0 on error
+ */
+int rafs_read(rafs_file_t *f, void *buf, uint32_t len);
+
+/**
+ * @brief Set the position; false past the end of the file
+ */
+bool rafs_seek(rafs_file_t *f, uint32_t pos);
+
+uint32_t rafs_tell(const rafs_file_t *f);
+uint32_t rafs_size(const rafs_file_t *f);
+
+/**
+ * @brief Load one queued read-ahead block (worker side)
+ * @return false if nothing was queued
+ */
+bool rafs_service(rafs_t *fs);
+
+void rafs_get_stats(rafs_t *fs, rafs_stats_t *out);
+void rafs_reset_stats(rafs_t *fs);
+
+#ifdef __cplusplus
+}
+#endif
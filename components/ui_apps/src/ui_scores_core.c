@@ -0,0 +1,186 @@
+#include "ui_scores_core.h"
+#include <stdio.h>
+#include <string.h>
+
+// --- Model ---
+
+typedef struct {
+    const char *p;
+    size_t n;
+} field_t;
+
+// Split in place on '|'; extra fields are ignored
+static int split(const char *d, size_t len, field_t *f, int max) {
+    const char *end = d + len;
+    int n = 0;
+    while (n < max) {
+        const char *bar = memchr(d, '|', (size_t)(end - d));
+        f[n].p = d;
+        f[n].n = bar ? (size_t)(bar - d) : (size_t)(end - d);
+        n++;
+        if (!bar) break;
+        d = bar + 1;
+    }
+    return n;
+}
+
+static bool to_uint(field_t f, uint64_t max, uint64_t *out) {
+    if (!f.n || f.n > 20) return false;
+    uint64_t v = 0;
+    for (size_t i = 0; i < f.n; i++) {
+        if (f.p[i] < '0' || f.p[i] > '9') return false;
+        v = v * 10 + (uint64_t)(f.p[i] - '0');
+    }
+    if (v > max) return false;
+    *out = v;
+    return true;
+}
+
+static void copy_field(char *dst, size_t cap, field_t f) {
+    size_t n = f.n < cap ? f.n : cap - 1;
+    memcpy(dst, f.p, n);
+    dst[n] = '\0';
+}
+
+static int find(const scores_t *s, uint64_t id) {
+    for (int i = 0; i < s->count; i++) {
+        if (s->match[i].id == id) return i;
+    }
+    return -1;
+}
+
+// <home goals>|<away goals>|<clock>[|<ts>] starting at f[0]
+static bool apply_score(score_match_t *m, const field_t *f, int n) {
+    uint64_t home, away, ts = 0;
+    if (n < 3 || !to_uint(f[0], UINT8_MAX, &home) || !to_uint(f[1], UINT8_MAX, &away)) return false;
+    if (n > 3 && !to_uint(f[3], UINT64_MAX, &ts)) return false;
+    m->home_goals = (uint8_t)home;
+    m->away_goals = (uint8_t)away;
+    copy_field(m->clock, sizeof(m->clock), f[2]);
+    m->ts_ms = ts;
+    return true;
+}
+
+int scores_apply(scores_t *s, const sse_event_t *ev) {
+    field_t f[7];
+    if (strcmp(ev->type, "reset") == 0) {
+        s->count = 0;
+        return SCORES_RESET;
+    }
+    bool is_match = strcmp(ev->type, "match") == 0;
+    if (!is_match && strcmp(ev->type, "score") != 0) return SCORES_IGNORED;
+
+    int n = split(ev->data, ev->data_len, f, 7);
+    uint64_t id;
+    if (!to_uint(f[0], UINT16_MAX, &id)) return SCORES_IGNORED;
+    int i = find(s, id);
+    if (!is_match) {
+        if (i < 0 || !apply_score(&s->match[i], f + 1, n - 1)) return SCORES_IGNORED;
+        return i;
+    }
+
+    if (n < 6) return SCORES_IGNORED;
+    score_match_t m = { .id = (uint16_t)id };
+    copy_field(m.home, sizeof(m.home), f[1]);
+    copy_field(m.away, sizeof(m.away), f[2]);
+    if (!apply_score(&m, f + 3, n - 3)) return SCORES_IGNORED;
+    if (i < 0) {
+        if (s->count == SCORES_MAX) return SCORES_IGNORED;
+        i = s->count++;
+    }
+    s->match[i] = m;
+    return i;
+}
+
+// --- Radio-on time ---
+
+void radio_note(radio_model_t *r, uint64_t now_us) {
+    uint64_t until = now_us + (uint64_t)r->tail_ms * 1000;
+    if (now_us >= r->awake_until_us) {
+        r->wakeups++;
+        r->on_us += until - now_us;
+    } else if (until > r->awake_until_us) {
+        r->on_us += until - r->awake_until_us;
+    }
+    if (until > r->awake_until_us) r->awake_until_us = until;
+}
+
+// --- Client ---
+
+void live_init(live_t *l, const live_config_t *cfg, const live_io_t *io, uint32_t radio_tail_ms) {
+    memset(l, 0, offsetof(live_t, sse));
+    l->cfg = *cfg;
+    l->io = *io;
+    l->radio.tail_ms = radio_tail_ms;
+    sse_init(&l->sse);
+}
+
+static uint64_t now_us(live_t *l) {
+    return l->io.now_us(l->io.ctx);
+}
+
+static bool on_sse(void *arg, const sse_event_t *ev) {
+    live_t *l = arg;
+    l->io.on_event(l->io.ctx, ev);
+    return !l->io.stopping(l->io.ctx);
+}
+
+static bool on_body(void *arg, const uint8_t *data, size_t len) {
+    live_t *l = arg;
+    radio_note(&l->radio, now_us(l));
+    l->stats.bytes += (uint32_t)len;
+    return sse_feed(&l->sse, data, len, on_sse, l) && !l->io.stopping(l->io.ctx);
+}
+
+static uint32_t poll(live_t *l) {
+    if (now_us(l) - l->poll_since_us >= (uint64_t)l->cfg.stream_retry_ms * 1000) {
+        l->mode = LIVE_STREAM;
+        return 0;
+    }
+    int status = 0;
+    sse_reset_event(&l->sse);
+    radio_note(&l->radio, now_us(l));
+    l->io.fetch(l->io.ctx, l->cfg.poll_url, NULL, false, 0, on_body, l, &status);
+    radio_note(&l->radio, now_us(l));
+    l->stats.polls++;
+    return l->io.stopping(l->io.ctx) ? 0 : l->cfg.poll_ms;
+}
+
+uint32_t live_step(live_t *l) {
+    if (l->mode == LIVE_POLL) return poll(l);
+
+    char headers[96 + SSE_ID_MAX];
+    int n = snprintf(headers, sizeof(headers), "Accept: text/event-stream\r\nCache-Control: no-cache\r\n");
+    if (l->sse.id[0]) {
+        snprintf(headers + n, sizeof(headers) - (size_t)n, "Last-Event-ID: %s\r\n", l->sse.id);
+        l->stats.resumes++;
+    }
+    l->stats.connects++;
+    sse_reset_event(&l->sse);
+    uint32_t seen = l->sse.events + l->sse.comments;
+    int status = 0;
+    radio_note(&l->radio, now_us(l));
+    l->io.fetch(l->io.ctx, l->cfg.stream_url, headers, true, l->cfg.idle_ms, on_body, l, &status);
+    radio_note(&l->radio, now_us(l));
+    if (l->io.stopping(l->io.ctx)) return 0;
+
+    // Events or keep-alives mean a working stream (a captive portal's 200 has neither)
+    if (status == 200 && l->sse.events + l->sse.comments != seen) {
+        l->stats.drops++;
+        l->failed = 0;
+        return l->sse.retry_ms ? l->sse.retry_ms : l->cfg.retry_ms;
+    }
+    l->stats.failures++;
+    if (l->failed < UINT8_MAX) l->failed++;
+    bool can_poll = l->cfg.poll_url && *l->cfg.poll_url;
+    if (can_poll && (status == 204 || l->failed >= LIVE_FALLBACK_AFTER)) {
+        l->mode = LIVE_POLL;
+        l->poll_since_us = now_us(l);
+        l->failed = 0;
+        l->stats.fallbacks++;
+        return 0;
+    }
+    uint32_t ms = l->cfg.retry_ms;
+    for (uint8_t i = 1; i < l->failed && ms < l->cfg.retry_max_ms; i++) ms *= 2;
+    return ms < l->cfg.retry_max_ms ? ms : l->cfg.retry_max_ms;
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+/**
+ * Live scores over Server-Sent Events, independent of ESP-IDF and LVGL:
+ * the score model, the wire format, and the client that keeps a stream
+ * open and falls back to polling.
+ *
+ * Events (one line of '|'-separated fields, parsed in place):
+ *   event: match   data: <id>|<home>|<away>|<home goals>|<away goals>|<clock>[|<ts>]
+ *   event: score   data: <id>|<home goals>|<away goals>|<clock>[|<ts>]
+ *   event: reset   (the server can't resume from Last-Event-ID; match events follow)
+ * <ts> is when the score changed, in ms (Unix time from a real service),
+ * so the client can tell how late an update reached the screen. The stream
+ * carries "id:" on every event; the poll URL returns the current matches as
+ * the same match events, with the ID of the latest change.
+ *
+ * The client reconnects after the server's "retry" delay, sending
+ * Last-Event-ID so the server replays only what was missed. After
+ * LIVE_FALLBACK_AFTER failed attempts in a row (or a 204, which tells SSE
+ * clients to stop) it polls instead, and tries the stream again every
+ * stream_retry_ms.
+ */
+
+#include "ui_http_core.h"
+#include "ui_sse_core.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCORES_MAX          8
+#define SCORES_NAME_MAX     16
+#define SCORES_CLOCK_MAX    8
+#define LIVE_FALLBACK_AFTER 3
+
+// --- Model ---
+
+typedef struct {
+    uint16_t id;
+    uint8_t home_goals, away_goals;
+    char home[SCORES_NAME_MAX];
+    char away[SCORES_NAME_MAX];
+    char clock[SCORES_CLOCK_MAX];   // "67'", "HT", "FT"
+    uint64_t ts_ms;                 // When the score last changed, 0 if not sent
+} score_match_t;
+
+typedef struct {
+    score_match_t match[SCORES_MAX];
+    uint8_t count;
+} scores_t;
+
+#define SCORES_RESET    (-1)        // Every match changed
+#define SCORES_IGNORED  (-2)        // Unknown event, unknown match or malformed data
+
+/**
+ * @brief Apply one event to the model
+ * @return Index of the changed match, SCORES_RESET or SCORES_IGNORED
+ */
+int scores_apply(scores_t *s, const sse_event_t *ev);
+
+// --- Radio-on time ---
+
+/**
+ * Wi-Fi in modem sleep stays awake for a while after traffic before it
+ * dozes again; traffic closer together than that shares one wake-up.
+ * Counted from the times bytes were sent or received.
+ */
+typedef struct {
+    uint32_t tail_ms;
+    uint32_t wakeups;
+    uint64_t on_us;
+    uint64_t awake_until_us;
+} radio_model_t;
+
+void radio_note(radio_model_t *r, uint64_t now_us);
+
+// --- Client ---
+
+typedef struct {
+    // Blocking GET; for a stream, waits up to idle_ms between bytes. Return as http_get().
+    http_err_t (*fetch)(void *ctx, const char *url, const char *headers, bool stream, uint32_t idle_ms,
+                        http_body_cb_t on_body, void *arg, int *status);
+    // A parsed event, on the fetching task
+    void (*on_event)(void *ctx, const sse_event_t *ev);
+    // Checked as bytes arrive; true ends the current fetch
+    bool (*stopping)(void *ctx);
+    uint64_t (*now_us)(void *ctx);
+    void *ctx;
+} live_io_t;
+
+typedef struct {
+    const char *stream_url;
+    const char *poll_url;           // NULL or "": no fallback, keep retrying the stream
+    uint32_t poll_ms;
+    uint32_t idle_ms;               // A stream silent this long (no event, no keep-alive) is dead
+    uint32_t retry_ms;              // Reconnect delay until the server sends "retry"
+    uint32_t retry_max_ms;          // Backoff limit for failing connects
+    uint32_t stream_retry_ms;       // While polling, try the stream again this often
+} live_config_t;
+
+typedef enum {
+    LIVE_STREAM = 0,
+    LIVE_POLL,
+} live_mode_t;
+
+typedef struct {
+    uint32_t connects;              // Stream requests
+    uint32_t resumes;               // ... of them sent with Last-Event-ID
+    uint32_t drops;                 // Streams that delivered events, then ended
+    uint32_t failures;              // Stream requests that delivered nothing
+    uint32_t polls, fallbacks;
+    uint32_t bytes;
+} live_stats_t;
+
+typedef struct {
+    live_config_t cfg;
+    live_io_t io;
+    live_mode_t mode;
+    uint8_t failed;                 // Consecutive failed stream attempts
+    uint64_t poll_since_us;
+    live_stats_t stats;
+    radio_model_t radio;
+    sse_parser_t sse;
+} live_t;
+
+void live_init(live_t *l, const live_config_t *cfg, const live_io_t *io, uint32_t radio_tail_ms);
+
+/**
+ * @brief Run one stream connection (until it ends) or one poll
+ * @return Milliseconds to wait before calling again
+ */
+uint32_t live_step(live_t *l);
+
+#ifdef __cplusplus
+}
+#endif
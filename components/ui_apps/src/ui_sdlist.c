@@ -0,0 +1,420 @@
+#include "ui_sdlist.h"
+#include "ui_dirlist_core.h"
+#include "ui_assets.h"
+#include "ui_private.h"
+#include "lvgl_mgr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_vfs_fat.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "ui_sdlist";
+
+#define ROW_H           40
+#define POOL_ROWS       14          // Rows that fit the list, plus one partly shown at each end
+#define PATH_LEN        192
+#define QUEUE_LEN       8
+#define WORKER_STACK    4096
+#define WORKER_PRIO     2           // Below the LVGL task
+
+LV_IMG_DECLARE(swipeR34);
+
+static const struct {
+    const char *label;
+    const char *exts;
+} filters[] = {
+    { "All",    NULL },
+    { "Images", "jpg,jpeg,png,bmp,gif" },
+    { "Audio",  "mp3,wav,flac,ogg,aac" },
+};
+#define FILTER_COUNT (sizeof(filters) / sizeof(filters[0]))
+
+static const char *const order_labels[DIRLIST_ORDER_COUNT] = { "Name", "Name Z-A", "Type" };
+
+typedef enum { CMD_OPEN, CMD_SORT, CMD_STOP } cmd_type_t;
+
+// Every command carries the page's whole state; the worker applies what changed
+typedef struct {
+    cmd_type_t type;
+    uint32_t gen;
+    uint8_t order;
+    uint8_t filter;
+    char path[PATH_LEN];
+} cmd_t;
+
+static QueueHandle_t queue = NULL;
+
+// --- Page state, under the LVGL lock (the worker publishes into it) ---
+
+static uint32_t page_gen = 0;                   // Bumped per listing and when the page goes
+static const dirlist_entry_t **shown = NULL;    // Copy of the worker's view; entries belong to the worker
+static size_t shown_count = 0, shown_cap = 0;
+static size_t total_count = 0;
+static bool scanning = false, open_failed = false;
+static uint32_t first_ms = 0, scan_ms = 0;
+static uint64_t card_total = 0, card_free = 0;
+
+static char cur_path[PATH_LEN] = UI_SDLIST_ROOT;
+static uint8_t cur_order = DIRLIST_ORDER_NAME;
+static uint8_t cur_filter = 0;
+
+static lv_obj_t *list = NULL;
+static lv_obj_t *spacer = NULL;                 // Gives the list its full scroll height
+static lv_obj_t *rows[POOL_ROWS];
+static int32_t row_index[POOL_ROWS];            // Entry each pool row shows, -1 if none
+static lv_obj_t *lbl_path = NULL;
+static lv_obj_t *lbl_status = NULL;
+static lv_obj_t *lbl_order = NULL;
+static lv_obj_t *lbl_filter = NULL;
+
+// --- Rows ---
+
+// Entry i always lands in pool row i % POOL_ROWS, so scrolling by one row relabels one object
+static void bind_rows(bool force) {
+    int32_t first = lv_obj_get_scroll_y(list) / ROW_H;
+    if (first < 0) first = 0;
+    for (int32_t i = first; i < first + POOL_ROWS; i++) {
+        int32_t r = i % POOL_ROWS;
+        if ((size_t)i >= shown_count) {
+            lv_obj_add_flag(rows[r], LV_OBJ_FLAG_HIDDEN);
+            row_index[r] = -1;
+            continue;
+        }
+        if (!force && row_index[r] == i) continue;
+        const dirlist_entry_t *e = shown[i];
+        lv_label_set_text_fmt(rows[r], "%s  %s", e->dir ? LV_SYMBOL_DIRECTORY : LV_SYMBOL_FILE, e->name);
+        lv_obj_set_pos(rows[r], 0, i * ROW_H);
+        lv_obj_remove_flag(rows[r], LV_OBJ_FLAG_HIDDEN);
+        row_index[r] = i;
+    }
+}
+
+static void page_refresh(void) {
+    lv_obj_set_height(spacer, shown_count ? (int32_t)(shown_count * ROW_H) : 1);
+    lv_label_set_text(lbl_path, cur_path);
+    if (open_failed) {
+        lv_label_set_text(lbl_status, "Can't open this folder (no card?)");
+    } else if (scanning && !first_ms) {
+        lv_label_set_text(lbl_status, "Reading...");
+    } else if (scanning) {
+        lv_label_set_text_fmt(lbl_status, "%u entries so far, first after %lu ms...", (unsigned)total_count,
+                              (unsigned long)first_ms);
+    } else if (card_total) {
+        lv_label_set_text_fmt(lbl_status, "%u shown of %u, listed in %lu ms  |  %llu of %llu MB free",
+                              (unsigned)shown_count, (unsigned)total_count, (unsigned long)scan_ms,
+                              (unsigned long long)(card_free >> 20), (unsigned long long)(card_total >> 20));
+    } else {
+        lv_label_set_text_fmt(lbl_status, "%u shown of %u, listed in %lu ms", (unsigned)shown_count,
+                              (unsigned)total_count, (unsigned long)scan_ms);
+    }
+    bind_rows(true);
+}
+
+// --- Worker ---
+
+static dirlist_t *dl = NULL;
+static DIR *dir = NULL;
+static uint32_t scan_gen = 0;
+static size_t batch = DIRLIST_FIRST_BATCH;
+static int64_t scan_start_us = 0;
+static uint32_t scan_first_ms = 0;          // Rounded up, so 0 means no batch yet
+static uint32_t scan_total_ms = 0;
+static uint8_t scan_filter = 0;
+
+// Entries are about to be freed: the page must not hold pointers to them
+static void drop_list(void) {
+    lvgl_mgr_lock();
+    shown_count = 0;
+    total_count = 0;
+    if (list) bind_rows(true);
+    lvgl_mgr_unlock();
+    dirlist_clear(dl);
+}
+
+static void publish(bool failed) {
+    const dirlist_entry_t *const *view;
+    size_t n = dirlist_view(dl, &view);
+    uint64_t total = 0, free_bytes = 0;
+    // f_getfree can walk the whole FAT on a big card; only once the listing is out
+    if (!dir && !failed) esp_vfs_fat_info(UI_SDLIST_ROOT, &total, &free_bytes);
+
+    lvgl_mgr_lock();
+    if (list && scan_gen == page_gen) {
+        if (n > shown_cap) {
+            const dirlist_entry_t **grown = heap_caps_realloc(shown, n * sizeof(*grown), MALLOC_CAP_SPIRAM);
+            if (grown) {
+                shown = grown;
+                shown_cap = n;
+            } else {
+                n = shown_cap;
+            }
+        }
+        if (n) memcpy(shown, view, n * sizeof(*shown));
+        shown_count = n;
+        total_count = dirlist_count(dl);
+        scanning = dir != NULL;
+        open_failed = failed;
+        first_ms = scan_first_ms;
+        scan_ms = dir ? (uint32_t)((esp_timer_get_time() - scan_start_us) / 1000) : scan_total_ms;
+        card_total = total;
+        card_free = free_bytes;
+        page_refresh();
+    }
+    lvgl_mgr_unlock();
+}
+
+static void close_dir(void) {
+    if (dir) closedir(dir);
+    dir = NULL;
+}
+
+static void handle(const cmd_t *cmd) {
+    switch (cmd->type) {
+    case CMD_OPEN:
+        close_dir();
+        drop_list();
+        scan_gen = cmd->gen;
+        dirlist_set_order(dl, cmd->order);
+        dirlist_set_filter(dl, filters[cmd->filter].exts);
+        scan_filter = cmd->filter;
+        scan_start_us = esp_timer_get_time();
+        scan_first_ms = 0;
+        batch = DIRLIST_FIRST_BATCH;
+        dir = opendir(cmd->path);
+        if (!dir) {
+            ESP_LOGW(TAG, "%s: can't open", cmd->path);
+            publish(true);
+        }
+        break;
+    case CMD_SORT:
+        if (cmd->gen != scan_gen) break;
+        if (cmd->filter != scan_filter) dirlist_set_filter(dl, filters[cmd->filter].exts);
+        scan_filter = cmd->filter;
+        dirlist_set_order(dl, cmd->order);
+        publish(false);
+        break;
+    case CMD_STOP:
+        close_dir();
+        drop_list();
+        break;
+    }
+}
+
+static void read_batch(void) {
+    size_t n = dirlist_read(dl, dir, batch);
+    if (n) {
+        dirlist_commit(dl);
+        batch = batch * 2 > DIRLIST_MAX_BATCH ? DIRLIST_MAX_BATCH : batch * 2;
+        if (!scan_first_ms) scan_first_ms = (uint32_t)((esp_timer_get_time() - scan_start_us) / 1000) + 1;
+    } else {
+        close_dir();
+        scan_total_ms = (uint32_t)((esp_timer_get_time() - scan_start_us) / 1000);
+        ESP_LOGI(TAG, "%u entries listed in %lu ms, first batch after %lu ms", (unsigned)dirlist_count(dl),
+                 (unsigned long)scan_total_ms, (unsigned long)scan_first_ms);
+    }
+    publish(false);
+}
+
+static void worker_fn(void *arg) {
+    for (;;) {
+        cmd_t cmd;
+        // Commands first; between them, one batch at a time while a folder is open
+        if (xQueueReceive(queue, &cmd, dir ? 0 : portMAX_DELAY) == pdTRUE) {
+            handle(&cmd);
+        } else if (dir) {
+            read_batch();
+        }
+    }
+}
+
+static bool start_worker(void) {
+    if (queue) return true;
+    dl = dirlist_create();
+    queue = xQueueCreate(QUEUE_LEN, sizeof(cmd_t));
+    if (!dl || !queue ||
+        xTaskCreatePinnedToCore(worker_fn, "ui_sdlist", WORKER_STACK, NULL, WORKER_PRIO, NULL, tskNO_AFFINITY) != pdPASS) {
+        ESP_LOGE(TAG, "List worker not started");
+        dirlist_destroy(dl);
+        if (queue) vQueueDelete(queue);
+        dl = NULL;
+        queue = NULL;
+        return false;
+    }
+    return true;
+}
+
+static void send(cmd_type_t type) {
+    if (!queue) return;
+    if (type == CMD_OPEN) {
+        page_gen++;
+        scanning = true;
+        open_failed = false;
+    }
+    cmd_t cmd = { .type = type, .gen = page_gen, .order = cur_order, .filter = cur_filter };
+    strcpy(cmd.path, cur_path);
+    if (xQueueSend(queue, &cmd, 0) != pdTRUE) ESP_LOGW(TAG, "List worker busy, request dropped");
+    if (list && type != CMD_STOP) lv_obj_scroll_to_y(list, 0, LV_ANIM_OFF);
+}
+
+// --- Events ---
+
+static void row_click_cb(lv_event_t *e) {
+    int32_t i = row_index[(intptr_t)lv_event_get_user_data(e)];
+    if (i < 0 || (size_t)i >= shown_count || !shown[i]->dir) return;
+    size_t len = strlen(cur_path);
+    if (len + 1 + strlen(shown[i]->name) >= PATH_LEN) return;
+    cur_path[len] = '/';
+    strcpy(cur_path + len + 1, shown[i]->name);
+    send(CMD_OPEN);
+}
+
+static void up_cb(lv_event_t *e) {
+    char *slash = strrchr(cur_path, '/');
+    if (strcmp(cur_path, UI_SDLIST_ROOT) == 0 || !slash) return;
+    *slash = '\0';
+    send(CMD_OPEN);
+}
+
+static void order_cb(lv_event_t *e) {
+    cur_order = (cur_order + 1) % DIRLIST_ORDER_COUNT;
+    lv_label_set_text_fmt(lbl_order, LV_SYMBOL_LIST " %s", order_labels[cur_order]);
+    send(CMD_SORT);
+}
+
+static void filter_cb(lv_event_t *e) {
+    cur_filter = (cur_filter + 1) % FILTER_COUNT;
+    lv_label_set_text_fmt(lbl_filter, LV_SYMBOL_EYE_OPEN " %s", filters[cur_filter].label);
+    send(CMD_SORT);
+}
+
+static void scroll_cb(lv_event_t *e) {
+    bind_rows(false);
+}
+
+static void page_delete_cb(lv_event_t *e) {
+    send(CMD_STOP);
+    page_gen++;                         // Anything published from here on is dropped
+    heap_caps_free(shown);
+    shown = NULL;
+    shown_count = shown_cap = 0;
+    list = NULL;
+    spacer = NULL;
+    lbl_path = lbl_status = lbl_order = lbl_filter = NULL;
+}
+
+static void page_swipe_cb(lv_event_t *e) {
+    if (lv_indev_get_gesture_dir(lv_indev_get_act()) == LV_DIR_RIGHT) {
+        show_home_view(e);     // Back to the Board Settings hub
+    }
+}
+
+// --- Page ---
+
+static lv_obj_t *header_btn(lv_obj_t *parent, const char *text, lv_event_cb_t cb, lv_obj_t **label) {
+    lv_obj_t *btn = lv_button_create(parent);
+    lv_obj_set_height(btn, 36);
+    lv_obj_set_style_bg_color(btn, lv_color_hex(0x202020), 0);
+    lv_obj_set_style_radius(btn, 8, 0);
+    lv_obj_add_event_cb(btn, cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_t *lbl = lv_label_create(btn);
+    lv_label_set_text(lbl, text);
+    lv_obj_set_style_text_font(lbl, ui_assets_font(16), 0);
+    lv_obj_center(lbl);
+    if (label) *label = lbl;
+    return btn;
+}
+
+void ui_sdlist_page_create(lv_obj_t *parent) {
+    // home_cont is the container clear_current_view() deletes on the next switch
+    home_cont = lv_obj_create(parent);
+    lv_obj_set_size(home_cont, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_style_bg_opa(home_cont, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(home_cont, 0, 0);
+    lv_obj_set_style_pad_all(home_cont, 20, 0);
+    lv_obj_set_style_pad_gap(home_cont, 8, 0);
+    lv_obj_set_flex_flow(home_cont, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(home_cont, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_remove_flag(home_cont, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(home_cont, page_swipe_cb, LV_EVENT_GESTURE, NULL);
+    lv_obj_add_event_cb(home_cont, page_delete_cb, LV_EVENT_DELETE, NULL);
+    lv_obj_clear_flag(home_cont, LV_OBJ_FLAG_GESTURE_BUBBLE);
+
+    lv_obj_t *img_swipe = lv_image_create(home_cont);
+    lv_image_set_src(img_swipe, &swipeR34);
+    lv_obj_add_flag(img_swipe, LV_OBJ_FLAG_FLOATING);
+    lv_obj_align(img_swipe, LV_ALIGN_TOP_LEFT, 5, 5);
+
+    lv_obj_t *title = lv_label_create(home_cont);
+    lv_label_set_text(title, "SD Card");
+    lv_obj_set_style_text_font(title, ui_assets_font(30), 0);
+    lv_obj_set_style_text_color(title, lv_color_hex(0xFFD700), 0);
+
+    // Up, current folder, sort and filter
+    lv_obj_t *bar = lv_obj_create(home_cont);
+    lv_obj_set_size(bar, LV_PCT(100), LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_opa(bar, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(bar, 0, 0);
+    lv_obj_set_style_pad_all(bar, 0, 0);
+    lv_obj_set_style_pad_gap(bar, 8, 0);
+    lv_obj_set_flex_flow(bar, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(bar, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_remove_flag(bar, LV_OBJ_FLAG_SCROLLABLE);
+
+    header_btn(bar, LV_SYMBOL_UP, up_cb, NULL);
+    lbl_path = lv_label_create(bar);
+    lv_obj_set_flex_grow(lbl_path, 1);
+    lv_label_set_long_mode(lbl_path, LV_LABEL_LONG_DOT);
+    lv_obj_set_style_text_font(lbl_path, ui_assets_font(16), 0);
+    lv_obj_set_style_text_color(lbl_path, lv_color_white(), 0);
+    header_btn(bar, "", order_cb, &lbl_order);
+    lv_label_set_text_fmt(lbl_order, LV_SYMBOL_LIST " %s", order_labels[cur_order]);
+    header_btn(bar, "", filter_cb, &lbl_filter);
+    lv_label_set_text_fmt(lbl_filter, LV_SYMBOL_EYE_OPEN " %s", filters[cur_filter].label);
+
+    lbl_status = lv_label_create(home_cont);
+    lv_obj_set_style_text_font(lbl_status, ui_assets_font(14), 0);
+    lv_obj_set_style_text_color(lbl_status, lv_color_hex(0xAAAAAA), 0);
+
+    // Virtualised list: rows are placed by hand over a spacer as tall as all entries
+    list = lv_obj_create(home_cont);
+    lv_obj_set_width(list, LV_PCT(100));
+    lv_obj_set_flex_grow(list, 1);
+    lv_obj_set_style_bg_color(list, lv_color_hex(0x101010), 0);
+    lv_obj_set_style_border_width(list, 0, 0);
+    lv_obj_set_style_pad_all(list, 0, 0);
+    lv_obj_set_scroll_dir(list, LV_DIR_VER);
+    lv_obj_add_event_cb(list, scroll_cb, LV_EVENT_SCROLL, NULL);
+
+    spacer = lv_obj_create(list);
+    lv_obj_remove_style_all(spacer);
+    lv_obj_set_size(spacer, 1, 1);
+    lv_obj_remove_flag(spacer, LV_OBJ_FLAG_CLICKABLE);
+
+    for (intptr_t r = 0; r < POOL_ROWS; r++) {
+        rows[r] = lv_label_create(list);
+        lv_obj_set_size(rows[r], LV_PCT(100), ROW_H);
+        lv_label_set_long_mode(rows[r], LV_LABEL_LONG_DOT);
+        lv_obj_set_style_pad_left(rows[r], 12, 0);
+        lv_obj_set_style_pad_top(rows[r], (ROW_H - 20) / 2, 0);
+        lv_obj_set_style_text_font(rows[r], ui_assets_font(16), 0);
+        lv_obj_set_style_text_color(rows[r], lv_color_white(), 0);
+        lv_obj_set_style_bg_color(rows[r], lv_color_hex(0x303030), LV_STATE_PRESSED);
+        lv_obj_set_style_bg_opa(rows[r], LV_OPA_COVER, LV_STATE_PRESSED);
+        lv_obj_add_flag(rows[r], LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_event_cb(rows[r], row_click_cb, LV_EVENT_CLICKED, (void *)r);
+        row_index[r] = -1;
+    }
+
+    shown_count = total_count = 0;
+    if (start_worker()) {
+        send(CMD_OPEN);
+    } else {
+        open_failed = true;
+    }
+    page_refresh();
+}
@@ -0,0 +1,307 @@
+#include "ui_splash.h"
+#include "sdkconfig.h"
+
+#if CONFIG_UI_BOOT_SPLASH
+
+#include "ui_app.h"
+#include "ui_fill.h"
+#include "ui_transition.h"
+#include "lvgl.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <string.h>
+
+static const char *TAG = "ui_splash";
+
+#define SPLASH_PARTITION   "storage"
+#define SPLASH_REGION      0x100000        // Last 1 MiB of the partition; the asset pack owns the start
+#define SPLASH_MAGIC       0x314C5053      // "SPL1"
+#define SPLASH_CAPTURE_MS  3000            // Launcher settle time before the first capture attempt
+#define SPLASH_IDLE_MS     1000            // No touch for this long, so no button is drawn pressed
+#define RLE_MAX            0x7FFF
+
+// Start of the splash region; the header is written last so a reset
+// mid-write leaves an erased (invalid) magic
+typedef struct {
+    uint32_t magic;
+    uint16_t w;
+    uint16_t h;
+    uint32_t pixel_hash;    // FNV-1a over the raw frame, to skip identical rewrites
+    uint32_t data_len;      // Bytes of RLE data following the header
+    uint32_t data_crc;
+} splash_hdr_t;
+
+static lv_obj_t *splash_img = NULL;
+static lv_draw_buf_t splash_buf;
+static void *splash_data = NULL;
+
+static lv_timer_t *capture_timer = NULL;
+static volatile bool capture_busy = false;
+static uint32_t stored_hash = 0;
+static bool have_stored = false;
+
+typedef struct {
+    lv_draw_buf_t buf;
+    void *data;
+} capture_t;
+
+// --- RLE over RGB565 pixels ---
+// Token: bit 15 set = a run of (token & 0x7FFF) copies of the next pixel,
+// clear = that many literal pixels follow. Tokens never cross a row.
+
+static size_t rle_encode_row(const uint16_t *src, size_t n, uint16_t *dst, size_t cap) {
+    size_t i = 0, o = 0;
+    while (i < n) {
+        size_t run = 1;
+        while (i + run < n && run < RLE_MAX && src[i + run] == src[i]) run++;
+        if (run >= 3) {
+            if (o + 2 > cap) return 0;
+            dst[o++] = (uint16_t)(0x8000 | run);
+            dst[o++] = src[i];
+            i += run;
+            continue;
+        }
+        // Literals up to the next run of three
+        size_t start = i, len = 0;
+        while (i < n && len < RLE_MAX) {
+            if (i + 2 < n && src[i] == src[i + 1] && src[i] == src[i + 2]) break;
+            i++;
+            len++;
+        }
+        if (o + 1 + len > cap) return 0;
+        dst[o++] = (uint16_t)len;
+        memcpy(&dst[o], &src[start], len * sizeof(uint16_t));
+        o += len;
+    }
+    return o;
+}
+
+// Decodes one row of @p w pixels, returns tokens consumed or 0 on corrupt data
+static size_t rle_decode_row(const uint16_t *src, size_t n, uint16_t *dst, size_t w) {
+    size_t i = 0, o = 0;
+    while (o < w) {
+        if (i >= n) return 0;
+        uint16_t t = src[i++];
+        size_t cnt = t & RLE_MAX;
+        if (cnt == 0 || o + cnt > w) return 0;
+        if (t & 0x8000) {
+            if (i >= n) return 0;
+            ui_fill_hspan(&dst[o], cnt, src[i++]);
+        } else {
+            if (i + cnt > n) return 0;
+            memcpy(&dst[o], &src[i], cnt * sizeof(uint16_t));
+            i += cnt;
+        }
+        o += cnt;
+    }
+    return i;
+}
+
+static uint32_t frame_hash(const lv_draw_buf_t *buf) {
+    uint32_t h = 2166136261u;
+    for (uint32_t y = 0; y < buf->header.h; y++) {
+        const uint8_t *row = buf->data + y * buf->header.stride;
+        for (uint32_t x = 0; x < buf->header.w * 2; x++) {
+            h = (h ^ row[x]) * 16777619u;
+        }
+    }
+    return h;
+}
+
+static const esp_partition_t *find_partition(void) {
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, SPLASH_PARTITION);
+    return part && part->size >= SPLASH_REGION ? part : NULL;
+}
+
+static uint32_t region_base(const esp_partition_t *part) {
+    return part->size - SPLASH_REGION;
+}
+
+static void *alloc_frame(lv_draw_buf_t *buf, uint32_t w, uint32_t h) {
+    uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+    void *data = heap_caps_aligned_alloc(LV_DRAW_BUF_ALIGN, stride * h, MALLOC_CAP_SPIRAM);
+    if (data) lv_draw_buf_init(buf, w, h, LV_COLOR_FORMAT_RGB565, stride, data, stride * h);
+    return data;
+}
+
+// --- Boot ---
+
+void ui_splash_show(void) {
+    int64_t t0 = esp_timer_get_time();
+    lv_display_t *disp = lv_display_get_default();
+    const esp_partition_t *part = find_partition();
+    if (!disp || !part) return;
+
+    splash_hdr_t hdr;
+    uint32_t base = region_base(part);
+    if (esp_partition_read(part, base, &hdr, sizeof(hdr)) != ESP_OK || hdr.magic != SPLASH_MAGIC) {
+        ESP_LOGI(TAG, "No stored launcher frame yet");
+        return;
+    }
+    if (hdr.w != lv_display_get_horizontal_resolution(disp) || hdr.h != lv_display_get_vertical_resolution(disp) ||
+        hdr.data_len > SPLASH_REGION - sizeof(hdr)) {
+        ESP_LOGW(TAG, "Stored frame is %ux%u, doesn't match the panel", hdr.w, hdr.h);
+        return;
+    }
+    stored_hash = hdr.pixel_hash;
+    have_stored = true;
+
+    const void *mapped;
+    esp_partition_mmap_handle_t map;
+    if (esp_partition_mmap(part, base, sizeof(hdr) + hdr.data_len, ESP_PARTITION_MMAP_DATA, &mapped, &map) != ESP_OK) {
+        return;
+    }
+    const uint16_t *rle = (const uint16_t *)((const uint8_t *)mapped + sizeof(hdr));
+    size_t tokens = hdr.data_len / sizeof(uint16_t);
+    bool ok = esp_rom_crc32_le(0, (const uint8_t *)rle, hdr.data_len) == hdr.data_crc;
+
+    if (ok) splash_data = alloc_frame(&splash_buf, hdr.w, hdr.h);
+    for (uint32_t y = 0; ok && splash_data && y < hdr.h; y++) {
+        size_t used = rle_decode_row(rle, tokens, (uint16_t *)(splash_buf.data + y * splash_buf.header.stride), hdr.w);
+        ok = used != 0;
+        rle += used;
+        tokens -= used;
+    }
+    esp_partition_munmap(map);
+
+    if (!ok || !splash_data) {
+        ESP_LOGW(TAG, "Stored frame is corrupt, skipping splash");
+        have_stored = false;            // Rewrite it on the next capture
+        if (splash_data) heap_caps_free(splash_data);
+        splash_data = NULL;
+        return;
+    }
+    int64_t decoded = esp_timer_get_time();
+
+    // Top layer: whatever lv_ui_init() puts on the screen stays hidden under it
+    splash_img = lv_image_create(lv_layer_top());
+    lv_image_set_src(splash_img, &splash_buf);
+    lv_obj_set_pos(splash_img, 0, 0);
+    lv_refr_now(disp);
+
+    int64_t now = esp_timer_get_time();
+    ESP_LOGI(TAG, "First pixel %lu ms after reset (decode %lu ms, %lu KB stored, flush %lu ms)",
+             (unsigned long)(now / 1000), (unsigned long)((decoded - t0) / 1000),
+             (unsigned long)(hdr.data_len / 1024), (unsigned long)((now - decoded) / 1000));
+}
+
+// --- Capture ---
+
+static void writer_task_fn(void *arg) {
+    capture_t *cap = arg;
+    const lv_draw_buf_t *buf = &cap->buf;
+    int64_t t0 = esp_timer_get_time();
+    uint32_t hash = frame_hash(buf);
+    uint16_t *rle = NULL;
+
+    if (have_stored && hash == stored_hash) {
+        ESP_LOGI(TAG, "Launcher frame unchanged, stored copy kept");
+        goto done;
+    }
+
+    // Anything bigger than the raw frame isn't worth storing
+    size_t cap_tokens = (size_t)buf->header.w * buf->header.h;
+    rle = heap_caps_malloc(cap_tokens * sizeof(uint16_t), MALLOC_CAP_SPIRAM);
+    const esp_partition_t *part = find_partition();
+    if (!rle || !part) goto done;
+
+    size_t len = 0;
+    for (uint32_t y = 0; y < buf->header.h; y++) {
+        const uint16_t *row = (const uint16_t *)(buf->data + y * buf->header.stride);
+        size_t used = rle_encode_row(row, buf->header.w, rle + len, cap_tokens - len);
+        if (!used) {
+            ESP_LOGW(TAG, "Launcher frame doesn't compress, not stored");
+            goto done;
+        }
+        len += used;
+    }
+
+    splash_hdr_t hdr = {
+        .magic = SPLASH_MAGIC,
+        .w = (uint16_t)buf->header.w,
+        .h = (uint16_t)buf->header.h,
+        .pixel_hash = hash,
+        .data_len = (uint32_t)(len * sizeof(uint16_t)),
+    };
+    hdr.data_crc = esp_rom_crc32_le(0, (const uint8_t *)rle, hdr.data_len);
+
+    uint32_t base = region_base(part);
+    size_t total = sizeof(hdr) + hdr.data_len;
+    size_t erase = (total + part->erase_size - 1) / part->erase_size * part->erase_size;
+    if (erase > SPLASH_REGION ||
+        esp_partition_erase_range(part, base, erase) != ESP_OK ||
+        esp_partition_write(part, base + sizeof(hdr), rle, hdr.data_len) != ESP_OK ||
+        esp_partition_write(part, base, &hdr, sizeof(hdr)) != ESP_OK) {
+        ESP_LOGW(TAG, "Writing the launcher frame failed");
+        goto done;
+    }
+    stored_hash = hash;
+    have_stored = true;
+    ESP_LOGI(TAG, "Launcher frame stored: %lu KB (%lu%% of raw) in %lu ms",
+             (unsigned long)(hdr.data_len / 1024),
+             (unsigned long)(hdr.data_len * 100 / (cap_tokens * sizeof(uint16_t))),
+             (unsigned long)((esp_timer_get_time() - t0) / 1000));
+
+done:
+    if (rle) heap_caps_free(rle);
+    heap_caps_free(cap->data);
+    heap_caps_free(cap);
+    capture_busy = false;
+    vTaskDelete(NULL);
+}
+
+static void capture_timer_cb(lv_timer_t *t) {
+    // Only a settled launcher: no app open, no transition, nobody touching it
+    if (capture_busy || ui_app_current() || ui_transition_active() ||
+        lv_display_get_inactive_time(NULL) < SPLASH_IDLE_MS) {
+        return;                         // Timer repeats, try again later
+    }
+    lv_timer_delete(t);
+    capture_timer = NULL;
+
+    lv_display_t *disp = lv_display_get_default();
+    capture_t *cap = heap_caps_malloc(sizeof(*cap), MALLOC_CAP_INTERNAL);
+    if (!cap) return;
+    cap->data = alloc_frame(&cap->buf, lv_display_get_horizontal_resolution(disp),
+                            lv_display_get_vertical_resolution(disp));
+    if (!cap->data || lv_snapshot_take_to_draw_buf(lv_screen_active(), LV_COLOR_FORMAT_RGB565, &cap->buf) != LV_RESULT_OK) {
+        ESP_LOGW(TAG, "Launcher snapshot failed");
+        if (cap->data) heap_caps_free(cap->data);
+        heap_caps_free(cap);
+        return;
+    }
+
+    // Hashing, compression and the flash write stay off the LVGL task
+    capture_busy = true;
+    if (xTaskCreate(writer_task_fn, "ui_splash", 4096, cap, 1, NULL) != pdPASS) {
+        heap_caps_free(cap->data);
+        heap_caps_free(cap);
+        capture_busy = false;
+    }
+}
+
+void ui_splash_handover(void) {
+    if (splash_img) {
+        // The launcher screen is loaded, so the next frame is the live one
+        lv_obj_delete(splash_img);
+        splash_img = NULL;
+        lv_image_cache_drop(&splash_buf);
+        heap_caps_free(splash_data);
+        splash_data = NULL;
+    }
+    if (!capture_timer && find_partition()) {
+        capture_timer = lv_timer_create(capture_timer_cb, SPLASH_CAPTURE_MS, NULL);
+    }
+}
+
+#else
+
+void ui_splash_show(void) {}
+void ui_splash_handover(void) {}
+
+#endif
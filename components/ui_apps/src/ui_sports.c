@@ -1,34 +1,288 @@
 #include "ui_sports.h"
-#include "ui_launcher.h"
+#include "ui_scores_core.h"
+#include "ui_net.h"
+#include "ui_console.h"
+#include "ui_assets.h"
+#include "ui_status_bar.h"
+#include "ui_trace.h"
+#include "ui_arena.h"
+#include "ui_app.h"
+#include "lvgl_mgr.h"
+#include "sdkconfig.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
 
 static const char *TAG = "ui_sports";
+
+#define LIVE_STACK      8192        // TLS handshakes run on the calling task
+#define LIVE_PRIO       2           // Below the LVGL task
+#define RETRY_MS        3000        // Until the server sends "retry"
+#define RETRY_MAX_MS    60000
+#define STREAM_RETRY_MS (5 * 60 * 1000)
+#define RADIO_TAIL_MS   100         // Modelled awake time after traffic; see radio_model_t
+#define VALID_TIME      1704067200  // 2024-01-01: before this the clock isn't set
+#define ROW_Y0          90
+#define ROW_H           40
+
 static lv_obj_t *sports_screen = NULL;
+static lv_obj_t *lbl_status = NULL;
+static lv_obj_t *rows[SCORES_MAX];
+
+// --- Live client ---
+
+// The model and client outlive the screen, so reopening the app shows the
+// last scores at once and the stream resumes from the last event ID.
+// live_wanted and live_task change under the LVGL lock (the app's create
+// and destroy run on the LVGL task, which holds it).
+static live_t live;
+static scores_t model;
+static bool live_ready = false;
+static volatile bool live_wanted = false;
+static TaskHandle_t live_task = NULL;
+static uint64_t run_us = 0, run_since_us = 0;
+
+typedef struct {
+    uint32_t n;
+    uint64_t sum_us;
+    uint32_t max_us;
+} lat_t;
+
+static lat_t goal_lat;      // Score change at the server to label updated (needs synced clocks)
+static lat_t apply_lat;     // Event parsed to label updated, including the wait for the LVGL lock
+
+static void lat_add(lat_t *l, uint64_t us) {
+    l->n++;
+    l->sum_us += us;
+    if (us > l->max_us) l->max_us = us > UINT32_MAX ? UINT32_MAX : (uint32_t)us;
+}
+
+// Under the LVGL lock
+static void show_row(int i) {
+    lv_obj_t *row = rows[i];
+    if (i >= model.count) {
+        lv_obj_add_flag(row, LV_OBJ_FLAG_HIDDEN);
+        return;
+    }
+    const score_match_t *m = &model.match[i];
+    lv_label_set_text_fmt(row, "%s  %u - %u  %s   %s", m->home, m->home_goals, m->away_goals, m->away, m->clock);
+    lv_obj_clear_flag(row, LV_OBJ_FLAG_HIDDEN);
+}
+
+// Under the LVGL lock
+static void show_status(void) {
+    if (!lbl_status) return;
+    if (live.mode == LIVE_POLL) {
+        lv_label_set_text_fmt(lbl_status, LV_SYMBOL_REFRESH " Polling every %lu s",
+                              (unsigned long)(live.cfg.poll_ms / 1000));
+    } else if (live.failed) {
+        lv_label_set_text(lbl_status, LV_SYMBOL_WARNING " Reconnecting...");
+    } else {
+        lv_label_set_text(lbl_status, LV_SYMBOL_WIFI " Live");
+    }
+}
+
+// A stream's span ends at its first bytes: how long it stays open isn't a
+// fetch cost. Timed with esp_timer, as the live task is not pinned to a core.
+typedef struct {
+    http_body_cb_t on_body;
+    void *arg;
+    ui_trace_us_t span;
+    bool traced;
+} fetch_trace_t;
+
+static bool trace_first_body(void *arg, const uint8_t *data, size_t len) {
+    fetch_trace_t *t = arg;
+    if (!t->traced) {
+        ui_trace_end_us(TAG, UI_TRACE_FETCH, t->span);
+        t->traced = true;
+    }
+    return t->on_body(t->arg, data, len);
+}
+
+static http_err_t io_fetch(void *ctx, const char *url, const char *headers, bool stream, uint32_t idle_ms,
+                           http_body_cb_t on_body, void *arg, int *status) {
+    fetch_trace_t t = { .on_body = on_body, .arg = arg, .span = ui_trace_begin_us() };
+    esp_err_t err = stream ? ui_net_stream(url, headers, idle_ms, trace_first_body, &t, status)
+                           : ui_net_get(url, headers, on_body, arg, status);
+    if (!t.traced) ui_trace_end_us(TAG, UI_TRACE_FETCH, t.span);
+    return err == ESP_OK ? HTTP_OK : HTTP_ERR_IO;
+}
+
+static void io_on_event(void *ctx, const sse_event_t *ev) {
+    uint64_t t0 = (uint64_t)esp_timer_get_time();
+    uint64_t ts_ms = 0;
+    lvgl_mgr_lock();
+    int i = scores_apply(&model, ev);
+    if (rows[0]) {
+        if (i == SCORES_RESET) {
+            for (int r = 0; r < SCORES_MAX; r++) show_row(r);
+        } else if (i >= 0) {
+            show_row(i);
+        }
+    }
+    if (i >= 0 && strcmp(ev->type, "score") == 0) ts_ms = model.match[i].ts_ms;
+    lvgl_mgr_unlock();
+    if (i == SCORES_IGNORED) return;
+
+    uint64_t t1 = (uint64_t)esp_timer_get_time();
+    lat_add(&apply_lat, t1 - t0);
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    uint64_t now_ms = (uint64_t)tv.tv_sec * 1000 + (uint64_t)tv.tv_usec / 1000;
+    if (ts_ms && tv.tv_sec > VALID_TIME && now_ms >= ts_ms) lat_add(&goal_lat, (now_ms - ts_ms) * 1000);
+}
+
+// Only checked as bytes arrive: an idle stream ends at its next keep-alive
+static bool io_stopping(void *ctx) {
+    return !live_wanted;
+}
+
+static uint64_t io_now_us(void *ctx) {
+    return (uint64_t)esp_timer_get_time();
+}
+
+static void live_task_fn(void *arg) {
+    run_since_us = (uint64_t)esp_timer_get_time();
+    for (;;) {
+        lvgl_mgr_lock();
+        bool run = live_wanted;
+        if (!run) live_task = NULL;
+        show_status();
+        lvgl_mgr_unlock();
+        if (!run) break;
+
+        uint32_t ms = live_step(&live);
+
+        lvgl_mgr_lock();
+        show_status();
+        lvgl_mgr_unlock();
+        if (ms) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+    }
+    run_us += (uint64_t)esp_timer_get_time() - run_since_us;
+    vTaskDelete(NULL);
+}
+
+static bool live_configured(void) {
+    return CONFIG_UI_SCORES_STREAM_URL[0] || CONFIG_UI_SCORES_POLL_URL[0];
+}
+
+// On the LVGL task
+static void live_start(void) {
+    if (!live_ready) {
+        static const live_io_t io = {
+            .fetch = io_fetch,
+            .on_event = io_on_event,
+            .stopping = io_stopping,
+            .now_us = io_now_us,
+        };
+        const live_config_t cfg = {
+            .stream_url = CONFIG_UI_SCORES_STREAM_URL,
+            .poll_url = CONFIG_UI_SCORES_POLL_URL,
+            .poll_ms = CONFIG_UI_SCORES_POLL_S * 1000,
+            .idle_ms = CONFIG_UI_SCORES_IDLE_S * 1000,
+            .retry_ms = RETRY_MS,
+            .retry_max_ms = RETRY_MAX_MS,
+            .stream_retry_ms = STREAM_RETRY_MS,
+        };
+        live_init(&live, &cfg, &io, RADIO_TAIL_MS);
+        // Without a stream URL, poll for good
+        if (!CONFIG_UI_SCORES_STREAM_URL[0]) {
+            live.mode = LIVE_POLL;
+            live.cfg.stream_retry_ms = UINT32_MAX;
+        }
+        live_ready = true;
+    }
+    live_wanted = true;
+    if (live_task) return;
+    if (xTaskCreatePinnedToCore(live_task_fn, "ui_sports_live", LIVE_STACK, NULL, LIVE_PRIO, &live_task,
+                                tskNO_AFFINITY) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to start the live scores task");
+        live_task = NULL;
+    }
+}
+
+// On the LVGL task
+static void live_stop(void) {
+    live_wanted = false;
+    if (live_task) xTaskNotifyGive(live_task);
+}
+
+static void print_lat(FILE *out, const char *what, const lat_t *l) {
+    if (!l->n) {
+        fprintf(out, "  %-14s -\n", what);
+        return;
+    }
+    fprintf(out, "  %-14s avg %.1f ms, max %.1f ms (%lu)\n", what, l->sum_us / 1000.0 / l->n, l->max_us / 1000.0,
+            (unsigned long)l->n);
+}
+
+static void console_cmd(FILE *out) {
+    if (!live_ready) {
+        fprintf(out, "Live scores not started (open the Sports app)\n");
+        return;
+    }
+    const live_stats_t *s = &live.stats;
+    uint64_t us = run_us + (live_task ? (uint64_t)esp_timer_get_time() - run_since_us : 0);
+    double h = us / 3600e6;
+    fprintf(out, "Live scores: %s, %u matches, running %.0f s\n", live.mode == LIVE_POLL ? "polling" : "streaming",
+            model.count, us / 1e6);
+    fprintf(out, "  stream         %lu connects (%lu resumed), %lu ended after events, %lu failed, %lu fallbacks\n",
+            (unsigned long)s->connects, (unsigned long)s->resumes, (unsigned long)s->drops,
+            (unsigned long)s->failures, (unsigned long)s->fallbacks);
+    fprintf(out, "  polls          %lu\n", (unsigned long)s->polls);
+    fprintf(out, "  events         %lu (%lu copied, %lu dropped), %lu keep-alives, %.1f KB\n",
+            (unsigned long)live.sse.events, (unsigned long)live.sse.copied, (unsigned long)live.sse.dropped,
+            (unsigned long)live.sse.comments, s->bytes / 1024.0);
+    print_lat(out, "goal-to-screen", &goal_lat);
+    print_lat(out, "event-to-label", &apply_lat);
+    fprintf(out, "  radio on       %.1f s in %lu wake-ups (modelled, %u ms tail)", live.radio.on_us / 1e6,
+            (unsigned long)live.radio.wakeups, RADIO_TAIL_MS);
+    if (h > 0) fprintf(out, ", %.1f s/h", live.radio.on_us / 1e6 / h);
+    fprintf(out, "\n");
+}
+
+void ui_sports_init(void) {
+    ui_console_register('l', "live scores: stream, polls, latency, radio", console_cmd);
+}
+
+// --- Screen ---
 
 static void btn_back_event_cb(lv_event_t *e) {
     if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
         ESP_LOGI(TAG, "Back button clicked");
-        
-        // Properly destroy sports screen before returning
-        if (sports_screen) {
-            lv_obj_del(sports_screen);
-            sports_screen = NULL;
-        }
-        
-        ui_launcher_show();
+        ui_app_exit();
     }
 }
 
+static void sports_destroy(void) {
+    live_stop();
+    if (sports_screen) {
+        lv_obj_del(sports_screen);
+        sports_screen = NULL;
+    }
+    lbl_status = NULL;
+    memset(rows, 0, sizeof(rows));
+}
+
 void ui_sports_show(void) {
     ESP_LOGI(TAG, "Showing Sports app");
-    
+    ui_trace_t span = ui_trace_begin();
+
+    ui_status_bar_set_visible(false);   // Apps draw their own top bar
+
     // Clean up previous instance if exists
     if (sports_screen) {
         lv_obj_del(sports_screen);
         sports_screen = NULL;
     }
-    
-    // Create main container
+
+    // Create main container; its LVGL allocations come from one arena
+    ui_arena_t *arena = ui_arena_begin("sports");
     sports_screen = lv_obj_create(NULL);
     lv_obj_t *screen = sports_screen;
     lv_obj_set_size(screen, LV_HOR_RES, LV_VER_RES);
@@ -37,32 +291,62 @@ void ui_sports_show(void) {
     lv_obj_clear_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
 
     lv_screen_load(sports_screen);
-    
+
     // Title
     lv_obj_t *title = lv_label_create(screen);
     lv_label_set_text(title, LV_SYMBOL_IMAGE " Sports App");
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_28, 0);
+    lv_obj_set_style_text_font(title, ui_assets_font(28), 0);
     lv_obj_set_style_text_color(title, lv_palette_main(LV_PALETTE_GREEN), 0);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
-    
-    // Content area
-    lv_obj_t *content = lv_label_create(screen);
-    lv_label_set_text(content, "Sports app coming soon...\n\n"
-                              "This will be a sports app.");
-    lv_obj_set_style_text_font(content, &lv_font_montserrat_18, 0);
-    lv_obj_set_style_text_color(content, lv_color_hex(0xCCCCCC), 0);
-    lv_obj_set_style_text_align(content, LV_TEXT_ALIGN_CENTER, 0);
-    lv_obj_align(content, LV_ALIGN_CENTER, 0, -20);
-    
+
+    if (live_configured()) {
+        lbl_status = lv_label_create(screen);
+        lv_obj_set_style_text_font(lbl_status, ui_assets_font(16), 0);
+        lv_obj_set_style_text_color(lbl_status, lv_color_hex(0xAAAAAA), 0);
+        lv_obj_align(lbl_status, LV_ALIGN_TOP_MID, 0, 60);
+        lv_label_set_text(lbl_status, "Connecting...");
+
+        // One label per match, filled from the model the worker keeps up to date
+        for (int i = 0; i < SCORES_MAX; i++) {
+            rows[i] = lv_label_create(screen);
+            lv_obj_set_style_text_font(rows[i], ui_assets_font(20), 0);
+            lv_obj_set_style_text_color(rows[i], lv_color_hex(0xFFFFFF), 0);
+            lv_obj_align(rows[i], LV_ALIGN_TOP_MID, 0, ROW_Y0 + i * ROW_H);
+            show_row(i);
+        }
+    } else {
+        lv_obj_t *content = lv_label_create(screen);
+        lv_label_set_text(content, "No live scores source\n\n"
+                                  "Set CONFIG_UI_SCORES_STREAM_URL\n"
+                                  "or CONFIG_UI_SCORES_POLL_URL.");
+        lv_obj_set_style_text_font(content, ui_assets_font(18), 0);
+        lv_obj_set_style_text_color(content, lv_color_hex(0xCCCCCC), 0);
+        lv_obj_set_style_text_align(content, LV_TEXT_ALIGN_CENTER, 0);
+        lv_obj_align(content, LV_ALIGN_CENTER, 0, -20);
+    }
+
     // Back Button
     lv_obj_t *btn_back = lv_btn_create(screen);
     lv_obj_set_size(btn_back, 200, 60);
     lv_obj_align(btn_back, LV_ALIGN_BOTTOM_MID, 0, -30);
     lv_obj_set_style_bg_color(btn_back, lv_palette_main(LV_PALETTE_GREY), 0);
     lv_obj_add_event_cb(btn_back, btn_back_event_cb, LV_EVENT_CLICKED, NULL);
-    
+
     lv_obj_t *lbl_back = lv_label_create(btn_back);
     lv_label_set_text(lbl_back, LV_SYMBOL_LEFT " Back");
-    lv_obj_set_style_text_font(lbl_back, &lv_font_montserrat_18, 0);
+    lv_obj_set_style_text_font(lbl_back, ui_assets_font(18), 0);
     lv_obj_center(lbl_back);
+    ui_arena_end(arena, sports_screen);
+    if (live_configured()) live_start();
+    ui_trace_end(TAG, UI_TRACE_LAYOUT, span);
 }
+
+const ui_app_t ui_app_sports = {
+    .name = "Sports",
+    .icon = LV_SYMBOL_GPS,
+    .color = 0x4CAF50,              // LV_PALETTE_GREEN
+    .mem_app = UI_MEM_APP_SPORTS,
+    .mem_budget = 64 * 1024,
+    .create = ui_sports_show,
+    .destroy = sports_destroy,
+};
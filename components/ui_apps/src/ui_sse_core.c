@@ -0,0 +1,162 @@
+#include "ui_sse_core.h"
+#include <string.h>
+
+void sse_init(sse_parser_t *p) {
+    memset(p, 0, offsetof(sse_parser_t, line));
+}
+
+void sse_reset_event(sse_parser_t *p) {
+    p->cr = false;
+    p->line_over = false;
+    p->truncated = false;
+    p->has_data = false;
+    p->data_ref = NULL;
+    p->data_len = 0;
+    p->line_len = 0;
+    p->type[0] = '\0';
+}
+
+// Move the event's data into data[] (it pointed into a slice that is going away)
+static void own_data(sse_parser_t *p) {
+    if (!p->has_data || p->data_ref == p->data) return;
+    if (p->data_len > SSE_DATA_MAX) {
+        p->data_len = SSE_DATA_MAX;
+        p->truncated = true;
+    }
+    memcpy(p->data, p->data_ref, p->data_len);
+    p->data_ref = p->data;
+}
+
+static void add_data(sse_parser_t *p, const char *v, size_t n, bool in_slice) {
+    if (!p->has_data && in_slice) {
+        p->data_ref = v;                // Zero-copy: valid until the end of this slice
+        p->data_len = n;
+        p->has_data = true;
+        return;
+    }
+    own_data(p);
+    size_t sep = p->has_data ? 1 : 0;
+    if (p->data_len + sep + n > SSE_DATA_MAX) {
+        p->truncated = true;
+        return;
+    }
+    if (sep) p->data[p->data_len] = '\n';
+    memcpy(p->data + p->data_len + sep, v, n);
+    p->data_len += sep + n;
+    p->data_ref = p->data;
+    p->has_data = true;
+}
+
+static bool dispatch(sse_parser_t *p, sse_event_cb_t cb, void *arg) {
+    bool go = true;
+    if (p->truncated) {
+        p->dropped++;
+    } else if (p->has_data) {
+        sse_event_t ev = {
+            .type = p->type[0] ? p->type : "message",
+            .data = p->data_ref,
+            .data_len = p->data_len,
+            .id = p->id,
+        };
+        p->events++;
+        if (p->data_ref == p->data) p->copied++;
+        go = cb(arg, &ev);
+    }
+    p->truncated = false;
+    p->has_data = false;
+    p->data_ref = NULL;
+    p->data_len = 0;
+    p->type[0] = '\0';
+    return go;
+}
+
+static bool field_is(const char *f, size_t n, const char *name) {
+    return strlen(name) == n && memcmp(f, name, n) == 0;
+}
+
+static void copy_str(char *dst, size_t cap, const char *v, size_t n) {
+    if (n >= cap) n = cap - 1;
+    memcpy(dst, v, n);
+    dst[n] = '\0';
+}
+
+static bool process_line(sse_parser_t *p, const char *line, size_t n, bool in_slice, sse_event_cb_t cb, void *arg) {
+    if (n == 0) return dispatch(p, cb, arg);
+    if (line[0] == ':') {
+        p->comments++;
+        return true;
+    }
+    const char *colon = memchr(line, ':', n);
+    size_t flen = colon ? (size_t)(colon - line) : n;
+    const char *v = colon ? colon + 1 : line + n;
+    size_t vlen = (size_t)(line + n - v);
+    if (vlen && *v == ' ') {
+        v++;
+        vlen--;
+    }
+
+    if (field_is(line, flen, "data")) {
+        add_data(p, v, vlen, in_slice);
+    } else if (field_is(line, flen, "event")) {
+        copy_str(p->type, sizeof(p->type), v, vlen);
+    } else if (field_is(line, flen, "id")) {
+        // An ID that can't be sent back whole is useless for resuming
+        if (!memchr(v, '\0', vlen) && vlen < sizeof(p->id)) copy_str(p->id, sizeof(p->id), v, vlen);
+    } else if (field_is(line, flen, "retry")) {
+        uint32_t ms = 0;
+        size_t i = 0;
+        while (i < vlen && v[i] >= '0' && v[i] <= '9' && ms < 100000000) ms = ms * 10 + (uint32_t)(v[i++] - '0');
+        if (i == vlen && vlen) p->retry_ms = ms;
+    }
+    return true;
+}
+
+// Keep the start of a line that continues in the next slice
+static void carry(sse_parser_t *p, const char *s, size_t n) {
+    if (p->line_len + n > SSE_LINE_MAX) {
+        n = SSE_LINE_MAX - p->line_len;
+        p->line_over = true;
+    }
+    memcpy(p->line + p->line_len, s, n);
+    p->line_len += (uint16_t)n;
+}
+
+bool sse_feed(sse_parser_t *p, const uint8_t *data, size_t len, sse_event_cb_t cb, void *arg) {
+    const char *s = (const char *)data;
+    size_t i = 0;
+    if (len && p->cr) {
+        if (s[0] == '\n') i = 1;
+        p->cr = false;
+    }
+    bool go = true;
+    while (go && i < len) {
+        size_t j = i;
+        while (j < len && s[j] != '\n' && s[j] != '\r') j++;
+        if (j == len) {
+            carry(p, s + i, len - i);
+            break;
+        }
+        if (p->line_len || p->line_over) {
+            carry(p, s + i, j - i);
+            if (p->line_over) {
+                p->truncated = true;
+            } else {
+                go = process_line(p, p->line, p->line_len, false, cb, arg);
+            }
+            p->line_len = 0;
+            p->line_over = false;
+        } else {
+            go = process_line(p, s + i, j - i, true, cb, arg);
+        }
+        i = j + 1;
+        if (s[j] == '\r') {
+            if (i < len) {
+                if (s[i] == '\n') i++;
+            } else {
+                p->cr = true;
+            }
+        }
+    }
+    own_data(p);
+    return go;
+}
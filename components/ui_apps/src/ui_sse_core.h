@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * Incremental Server-Sent Events (text/event-stream) parser, independent of
+ * ESP-IDF and LVGL.
+ *
+ * Fed the response body in whatever slices the connection delivers. An
+ * event whose lines all arrive in one slice - nearly every event, since
+ * servers write each one whole - is handed over as pointers into that
+ * slice. Only a line split across slices, or a multi-line data field, is
+ * copied, into the parser's own line and data buffers.
+ *
+ * Follows the WHATWG rules: lines end in CRLF, LF or CR; "field: value"
+ * with one optional space; ':' starts a comment (keep-alive); a blank line
+ * dispatches; an event without data is dropped; "id" sets the last event ID
+ * (sent back as Last-Event-ID on reconnect) and "retry" the reconnect delay.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSE_LINE_MAX    512     // Longest line carried across slices; longer ones drop their event
+#define SSE_DATA_MAX    1024    // Longest data of an event that has to be copied
+#define SSE_EVENT_MAX   32
+#define SSE_ID_MAX      64
+
+typedef struct {
+    const char *type;           // "message" when the event had no "event" field
+    const char *data;           // Data lines joined by '\n'; not NUL-terminated
+    size_t data_len;
+    const char *id;             // Last event ID, "" if none yet
+} sse_event_t;
+
+// Return false to stop parsing
+typedef bool (*sse_event_cb_t)(void *arg, const sse_event_t *ev);
+
+typedef struct {
+    uint32_t retry_ms;          // Last "retry" field, 0 if none
+    uint32_t events, copied;    // Dispatched, and of those, whose data had to be copied
+    uint32_t comments, dropped;
+    bool cr;                    // Previous slice ended in CR: skip a leading LF
+    bool line_over;             // The carried line overflowed line[]; it is skipped
+    bool truncated;             // Part of the current event was lost; it is dropped
+    // Current event: data either points into the slice being parsed or sits in data[]
+    bool has_data;
+    const char *data_ref;
+    size_t data_len;
+    uint16_t line_len;
+    char type[SSE_EVENT_MAX];
+    char id[SSE_ID_MAX];
+    char line[SSE_LINE_MAX];
+    char data[SSE_DATA_MAX];
+} sse_parser_t;
+
+void sse_init(sse_parser_t *p);
+
+/**
+ * @brief Parse the next @p len body bytes, calling @p cb for each complete event
+ * @return false if @p cb stopped it
+ */
+bool sse_feed(sse_parser_t *p, const uint8_t *data, size_t len, sse_event_cb_t cb, void *arg);
+
+/**
+ * @brief Forget a partial event (the connection dropped); the last event ID is kept
+ */
+void sse_reset_event(sse_parser_t *p);
+
+#ifdef __cplusplus
+}
+#endif
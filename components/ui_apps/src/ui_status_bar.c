@@ -0,0 +1,223 @@
+#include "ui_status_bar.h"
+#include "ui_assets.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_event.h"
+#include "esp_wifi.h"
+#include "esp_netif.h"
+#include "lvgl_mgr.h"
+#include "wifi_mgr.h"
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+static const char *TAG = "ui_status_bar";
+
+// Clock only shows minutes; wake this long after the boundary to be safely past it
+#define MINUTE_SLACK_MS     20
+// HTTP time sync has no completion event we can hook, so poll while syncing
+#define SYNC_POLL_MS        1000
+#define STATS_REPORT_MS     (60 * 60 * 1000)
+
+typedef enum {
+    STATUS_WAITING_WIFI = 0,
+    STATUS_SYNCING,
+    STATUS_CLOCK,
+} status_state_t;
+
+static lv_obj_t *status_bar = NULL;
+static lv_obj_t *lbl_time = NULL;
+static lv_obj_t *lbl_wifi = NULL;
+static lv_timer_t *status_timer = NULL;
+static bool status_visible = false;
+
+// Written from the event loop task, read under the LVGL lock
+static volatile bool wifi_connected = false;
+static bool events_registered = false;
+
+// Last values pushed to LVGL - only touch widgets when these change
+static char last_text[40] = "";
+static int last_wifi_state = -1;
+
+static ui_status_bar_stats_t stats;
+static uint32_t stats_report_tick = 0;
+
+static status_state_t compute_text(char *buf, size_t len, struct tm *timeinfo) {
+    if (!wifi_connected) {
+        snprintf(buf, len, "waiting for Wi-Fi connection . . .");
+        return STATUS_WAITING_WIFI;
+    }
+    if (timeinfo->tm_year > (2020 - 1900)) {
+        snprintf(buf, len, "%02d/%02d/%04d %02d:%02d",
+            timeinfo->tm_mon + 1, timeinfo->tm_mday, timeinfo->tm_year + 1900,
+            timeinfo->tm_hour, timeinfo->tm_min);
+        return STATUS_CLOCK;
+    }
+    snprintf(buf, len, "http d/t syncing . . .");
+    return STATUS_SYNCING;
+}
+
+// Milliseconds until the wall clock rolls over to the next minute
+static uint32_t ms_to_next_minute(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    uint32_t into_minute = (uint32_t)(tv.tv_sec % 60) * 1000 + (uint32_t)(tv.tv_usec / 1000);
+    return (60000 - into_minute) + MINUTE_SLACK_MS;
+}
+
+static void reschedule(status_state_t state) {
+    if (!status_timer) return;
+    if (!status_visible) {
+        lv_timer_pause(status_timer);
+        return;
+    }
+    switch (state) {
+        case STATUS_CLOCK:
+            lv_timer_set_period(status_timer, ms_to_next_minute());
+            lv_timer_reset(status_timer);
+            lv_timer_resume(status_timer);
+            break;
+        case STATUS_SYNCING:
+            lv_timer_set_period(status_timer, SYNC_POLL_MS);
+            lv_timer_resume(status_timer);
+            break;
+        case STATUS_WAITING_WIFI:
+            // Nothing can change until a Wi-Fi event wakes us
+            lv_timer_pause(status_timer);
+            break;
+    }
+}
+
+void ui_status_bar_refresh(void) {
+    if (!lbl_time || !lbl_wifi) return;
+
+    int64_t start_us = esp_timer_get_time();
+    stats.wakeups++;
+
+    time_t now;
+    struct tm timeinfo;
+    time(&now);
+    localtime_r(&now, &timeinfo);
+
+    char text[sizeof(last_text)];
+    status_state_t state = compute_text(text, sizeof(text), &timeinfo);
+    if (strcmp(text, last_text) != 0) {
+        strcpy(last_text, text);
+        lv_label_set_text(lbl_time, last_text);
+        stats.label_updates++;
+    }
+
+    int wifi_state = wifi_connected ? 1 : 0;
+    if (wifi_state != last_wifi_state) {
+        last_wifi_state = wifi_state;
+        lv_obj_set_style_text_color(lbl_wifi,
+            lv_palette_main(wifi_state ? LV_PALETTE_GREEN : LV_PALETTE_RED), 0);
+        stats.color_updates++;
+    }
+
+    reschedule(state);
+    stats.cpu_time_us += (uint64_t)(esp_timer_get_time() - start_us);
+
+    if (lv_tick_elaps(stats_report_tick) >= STATS_REPORT_MS) {
+        stats_report_tick = lv_tick_get();
+        ESP_LOGI(TAG, "Last hour: wakeups=%lu wifi_events=%lu label_updates=%lu color_updates=%lu cpu=%llu us",
+                 (unsigned long)stats.wakeups, (unsigned long)stats.wifi_events,
+                 (unsigned long)stats.label_updates, (unsigned long)stats.color_updates,
+                 (unsigned long long)stats.cpu_time_us);
+        memset(&stats, 0, sizeof(stats));
+    }
+}
+
+static void status_timer_cb(lv_timer_t *t) {
+    (void)t;
+    ui_status_bar_refresh();
+}
+
+// Runs on the default event loop task - take the LVGL lock before touching widgets
+static void wifi_event_handler(void *arg, esp_event_base_t base, int32_t id, void *data) {
+    if (base == IP_EVENT && id == IP_EVENT_STA_GOT_IP) {
+        wifi_connected = true;
+    } else if (base == WIFI_EVENT && id == WIFI_EVENT_STA_DISCONNECTED) {
+        wifi_connected = false;
+    } else {
+        return;
+    }
+
+    lvgl_mgr_lock();
+    stats.wifi_events++;
+    ui_status_bar_refresh();
+    lvgl_mgr_unlock();
+}
+
+static void register_wifi_events(void) {
+    if (events_registered) return;
+
+    esp_err_t err = esp_event_handler_instance_register(IP_EVENT, IP_EVENT_STA_GOT_IP,
+                                                        wifi_event_handler, NULL, NULL);
+    if (err == ESP_OK) {
+        err = esp_event_handler_instance_register(WIFI_EVENT, WIFI_EVENT_STA_DISCONNECTED,
+                                                  wifi_event_handler, NULL, NULL);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register Wi-Fi event handlers: %s", esp_err_to_name(err));
+        return;
+    }
+    events_registered = true;
+}
+
+void ui_status_bar_init(void) {
+    if (status_bar) return;
+
+    wifi_connected = wifi_mgr_is_connected();
+    register_wifi_events();
+
+    // Lives on the top layer so every screen shares the same widgets
+    status_bar = lv_obj_create(lv_layer_top());
+    lv_obj_remove_flag(status_bar, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_remove_flag(status_bar, LV_OBJ_FLAG_CLICKABLE);   // Let touches fall through to the screen
+    lv_obj_set_size(status_bar, LV_PCT(100), UI_STATUS_BAR_HEIGHT);
+    lv_obj_align(status_bar, LV_ALIGN_TOP_MID, 0, 0);
+    lv_obj_set_style_bg_opa(status_bar, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(status_bar, 0, 0);
+    lv_obj_set_flex_flow(status_bar, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(status_bar, LV_FLEX_ALIGN_SPACE_BETWEEN, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_left(status_bar, 10, 0);
+    lv_obj_set_style_pad_right(status_bar, 10, 0);
+
+    // Time Label
+    lbl_time = lv_label_create(status_bar);
+    lv_obj_set_style_text_font(lbl_time, ui_assets_font(22), 0);
+    lv_obj_set_style_text_color(lbl_time, lv_color_white(), 0);
+
+    // WiFi Label - glyph never changes, only its colour
+    lbl_wifi = lv_label_create(status_bar);
+    lv_label_set_text_static(lbl_wifi, LV_SYMBOL_WIFI);
+    lv_obj_set_style_text_font(lbl_wifi, ui_assets_font(24), 0);
+
+    status_timer = lv_timer_create(status_timer_cb, SYNC_POLL_MS, NULL);
+    lv_timer_pause(status_timer);
+    stats_report_tick = lv_tick_get();
+
+    lv_obj_add_flag(status_bar, LV_OBJ_FLAG_HIDDEN);
+    status_visible = false;
+    ui_status_bar_refresh();
+
+    ESP_LOGI(TAG, "Status bar initialized");
+}
+
+void ui_status_bar_set_visible(bool visible) {
+    if (!status_bar || visible == status_visible) return;
+
+    status_visible = visible;
+    if (visible) {
+        lv_obj_remove_flag(status_bar, LV_OBJ_FLAG_HIDDEN);
+        ui_status_bar_refresh();   // Catch up and reschedule for the next minute
+    } else {
+        lv_obj_add_flag(status_bar, LV_OBJ_FLAG_HIDDEN);
+        if (status_timer) lv_timer_pause(status_timer);
+    }
+}
+
+void ui_status_bar_get_stats(ui_status_bar_stats_t *out) {
+    if (out) *out = stats;
+}
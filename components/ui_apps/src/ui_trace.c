@@ -0,0 +1,296 @@
+#include "ui_trace.h"
+#include "ui_assets.h"
+#include "ui_console.h"
+#include "lvgl.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdatomic.h>
+#include <string.h>
+
+static const char *TAG = "ui_trace";
+
+#define OVERLAY_PERIOD_MS   500
+#define SUMMARY_MAX_ROWS    24
+
+static lv_obj_t *overlay_label = NULL;
+static lv_timer_t *overlay_timer = NULL;
+
+const char *ui_trace_kind_name(ui_trace_kind_t kind) {
+    switch (kind) {
+        case UI_TRACE_RENDER: return "render";
+        case UI_TRACE_FLUSH:  return "flush";
+        case UI_TRACE_LAYOUT: return "layout";
+        case UI_TRACE_FETCH:  return "fetch";
+        default: break;
+    }
+    return "?";
+}
+
+#if CONFIG_UI_TRACE_ENABLE
+
+#define TRACE_ENTRIES   CONFIG_UI_TRACE_ENTRIES
+#define TRACE_MASK      (TRACE_ENTRIES - 1)
+_Static_assert((TRACE_ENTRIES & TRACE_MASK) == 0, "UI_TRACE_ENTRIES must be a power of two");
+
+// One slot of the ring. seq is written last (release) so readers can detect
+// slots that are mid-write or have been lapped by a newer span.
+typedef struct {
+    atomic_uint seq;
+    const char *app;
+    uint32_t start_us;
+    uint32_t dur_cycles;
+    uint8_t kind;
+    uint8_t core;
+} trace_entry_t;
+
+typedef struct {
+    const char *app;
+    uint32_t start_us;
+    uint32_t dur_cycles;
+    uint8_t kind;
+    uint8_t core;
+} trace_snapshot_t;
+
+static trace_entry_t ring[TRACE_ENTRIES];
+static atomic_uint ring_head = 0;
+static atomic_uint ring_clear_mark = 0;
+
+// Display span starts - only touched from the LVGL task
+static ui_trace_t render_start = 0;
+static ui_trace_t flush_start = 0;
+
+static void push(const char *app, ui_trace_kind_t kind, uint32_t start_us, uint32_t cycles) {
+    unsigned idx = atomic_fetch_add_explicit(&ring_head, 1, memory_order_relaxed);
+    trace_entry_t *e = &ring[idx & TRACE_MASK];
+    atomic_store_explicit(&e->seq, 0, memory_order_relaxed);
+    e->app = app;
+    e->kind = (uint8_t)kind;
+    e->core = (uint8_t)esp_cpu_get_core_id();
+    e->dur_cycles = cycles;
+    e->start_us = start_us;
+    atomic_store_explicit(&e->seq, idx + 1, memory_order_release);
+}
+
+void ui_trace_end(const char *app, ui_trace_kind_t kind, ui_trace_t start) {
+    uint32_t cycles = esp_cpu_get_cycle_count() - start;
+    uint32_t now_us = (uint32_t)esp_timer_get_time();
+    push(app, kind, now_us - cycles / esp_rom_get_cpu_ticks_per_us(), cycles);
+}
+
+void ui_trace_end_us(const char *app, ui_trace_kind_t kind, ui_trace_us_t start) {
+    uint64_t cycles = (uint64_t)(esp_timer_get_time() - start) * esp_rom_get_cpu_ticks_per_us();
+    push(app, kind, (uint32_t)start, cycles > UINT32_MAX ? UINT32_MAX : (uint32_t)cycles);
+}
+
+// Copy slot idx if it still holds span idx; false if torn or overwritten
+static bool read_entry(unsigned idx, trace_snapshot_t *out) {
+    trace_entry_t *e = &ring[idx & TRACE_MASK];
+    unsigned seq = atomic_load_explicit(&e->seq, memory_order_acquire);
+    if (seq != idx + 1) return false;
+    out->app = e->app;
+    out->start_us = e->start_us;
+    out->dur_cycles = e->dur_cycles;
+    out->kind = e->kind;
+    out->core = e->core;
+    return atomic_load_explicit(&e->seq, memory_order_acquire) == seq;
+}
+
+static void ring_bounds(unsigned *first, unsigned *last) {
+    unsigned head = atomic_load_explicit(&ring_head, memory_order_acquire);
+    unsigned mark = atomic_load_explicit(&ring_clear_mark, memory_order_relaxed);
+    unsigned start = head > TRACE_ENTRIES ? head - TRACE_ENTRIES : 0;
+    *first = start > mark ? start : mark;
+    *last = head;
+}
+
+void ui_trace_clear(void) {
+    atomic_store(&ring_clear_mark, atomic_load(&ring_head));
+}
+
+static void disp_event_cb(lv_event_t *e) {
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_RENDER_START:
+            render_start = ui_trace_begin();
+            break;
+        case LV_EVENT_RENDER_READY:
+            ui_trace_end("lvgl", UI_TRACE_RENDER, render_start);
+            break;
+        case LV_EVENT_FLUSH_START:
+            flush_start = ui_trace_begin();
+            break;
+        case LV_EVENT_FLUSH_FINISH:
+            ui_trace_end("lvgl", UI_TRACE_FLUSH, flush_start);
+            break;
+        default:
+            break;
+    }
+}
+
+static void cmd_trace_clear(FILE *out) {
+    ui_trace_clear();
+    fprintf(out, "trace cleared\n");
+}
+
+void ui_trace_init(void) {
+    static bool initialized = false;
+    if (initialized) return;
+    initialized = true;
+
+    lv_display_t *disp = lv_display_get_default();
+    if (disp) {
+        lv_display_add_event_cb(disp, disp_event_cb, LV_EVENT_RENDER_START, NULL);
+        lv_display_add_event_cb(disp, disp_event_cb, LV_EVENT_RENDER_READY, NULL);
+        lv_display_add_event_cb(disp, disp_event_cb, LV_EVENT_FLUSH_START, NULL);
+        lv_display_add_event_cb(disp, disp_event_cb, LV_EVENT_FLUSH_FINISH, NULL);
+    }
+
+    ui_console_register('t', "trace summary", ui_trace_dump_summary);
+    ui_console_register('j', "trace as Chrome JSON", ui_trace_dump_chrome);
+    ui_console_register('c', "clear trace", cmd_trace_clear);
+
+    ESP_LOGI(TAG, "Tracing %d spans", TRACE_ENTRIES);
+}
+
+#else  // !CONFIG_UI_TRACE_ENABLE
+
+typedef struct {
+    const char *app;
+    uint32_t start_us;
+    uint32_t dur_cycles;
+    uint8_t kind;
+    uint8_t core;
+} trace_snapshot_t;
+
+static bool read_entry(unsigned idx, trace_snapshot_t *out) { (void)idx; (void)out; return false; }
+static void ring_bounds(unsigned *first, unsigned *last) { *first = 0; *last = 0; }
+void ui_trace_clear(void) {}
+void ui_trace_init(void) {}
+
+#endif
+
+// --- Reporting ---
+
+typedef struct {
+    const char *app;
+    uint8_t kind;
+    uint32_t count;
+    uint32_t last_cycles;
+    uint32_t max_cycles;
+    uint64_t sum_cycles;
+} trace_row_t;
+
+static int build_summary(trace_row_t *rows, int max_rows) {
+    int n = 0;
+    unsigned first, last;
+    ring_bounds(&first, &last);
+
+    for (unsigned i = first; i < last; i++) {
+        trace_snapshot_t s;
+        if (!read_entry(i, &s)) continue;
+
+        trace_row_t *row = NULL;
+        for (int r = 0; r < n; r++) {
+            if (rows[r].app == s.app && rows[r].kind == s.kind) {
+                row = &rows[r];
+                break;
+            }
+        }
+        if (!row) {
+            if (n >= max_rows) continue;
+            row = &rows[n++];
+            memset(row, 0, sizeof(*row));
+            row->app = s.app;
+            row->kind = s.kind;
+        }
+        row->count++;
+        row->last_cycles = s.dur_cycles;
+        row->sum_cycles += s.dur_cycles;
+        if (s.dur_cycles > row->max_cycles) row->max_cycles = s.dur_cycles;
+    }
+    return n;
+}
+
+static inline float cycles_to_ms(uint64_t cycles) {
+    return (float)cycles / (float)(esp_rom_get_cpu_ticks_per_us() * 1000);
+}
+
+void ui_trace_dump_summary(FILE *out) {
+    trace_row_t rows[SUMMARY_MAX_ROWS];
+    int n = build_summary(rows, SUMMARY_MAX_ROWS);
+
+    fprintf(out, "%-14s %-7s %6s %9s %9s %9s\n", "app", "span", "count", "last ms", "avg ms", "max ms");
+    for (int r = 0; r < n; r++) {
+        fprintf(out, "%-14s %-7s %6lu %9.2f %9.2f %9.2f\n",
+                rows[r].app, ui_trace_kind_name(rows[r].kind), (unsigned long)rows[r].count,
+                cycles_to_ms(rows[r].last_cycles),
+                cycles_to_ms(rows[r].sum_cycles / rows[r].count),
+                cycles_to_ms(rows[r].max_cycles));
+    }
+}
+
+void ui_trace_dump_chrome(FILE *out) {
+    unsigned first, last;
+    ring_bounds(&first, &last);
+    uint32_t ticks_per_us = esp_rom_get_cpu_ticks_per_us();
+    bool comma = false;
+
+    fprintf(out, "{\"traceEvents\":[\n");
+    for (unsigned i = first; i < last; i++) {
+        trace_snapshot_t s;
+        if (!read_entry(i, &s)) continue;
+        fprintf(out, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                comma ? ",\n" : "", ui_trace_kind_name(s.kind), s.app,
+                (unsigned long)s.start_us, (double)s.dur_cycles / ticks_per_us, s.core);
+        comma = true;
+    }
+    fprintf(out, "\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+// --- On-screen overlay ---
+
+static void overlay_timer_cb(lv_timer_t *t) {
+    (void)t;
+    if (!overlay_label) return;
+
+    static char text[SUMMARY_MAX_ROWS * 40];
+    trace_row_t rows[SUMMARY_MAX_ROWS];
+    int n = build_summary(rows, SUMMARY_MAX_ROWS);
+    size_t len = 0;
+
+    text[0] = '\0';
+    for (int r = 0; r < n && len < sizeof(text); r++) {
+        len += snprintf(text + len, sizeof(text) - len, "%s%s %s %.1f/%.1f ms",
+                        r ? "\n" : "", rows[r].app, ui_trace_kind_name(rows[r].kind),
+                        cycles_to_ms(rows[r].sum_cycles / rows[r].count),
+                        cycles_to_ms(rows[r].max_cycles));
+    }
+    lv_label_set_text(overlay_label, n ? text : "no spans yet");
+}
+
+void ui_trace_overlay_toggle(void) {
+    if (overlay_label) {
+        lv_timer_del(overlay_timer);
+        overlay_timer = NULL;
+        lv_obj_del(overlay_label);
+        overlay_label = NULL;
+        ESP_LOGI(TAG, "Overlay off");
+        return;
+    }
+
+    // Top layer so it stays up while moving between apps
+    overlay_label = lv_label_create(lv_layer_top());
+    lv_obj_remove_flag(overlay_label, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_style_bg_color(overlay_label, lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(overlay_label, LV_OPA_70, 0);
+    lv_obj_set_style_pad_all(overlay_label, 4, 0);
+    lv_obj_set_style_text_font(overlay_label, ui_assets_font(14), 0);
+    lv_obj_set_style_text_color(overlay_label, lv_color_hex(0x39FF14), 0);
+    lv_obj_align(overlay_label, LV_ALIGN_BOTTOM_RIGHT, -4, -4);
+
+    overlay_timer = lv_timer_create(overlay_timer_cb, OVERLAY_PERIOD_MS, NULL);
+    overlay_timer_cb(NULL);
+    ESP_LOGI(TAG, "Overlay on (avg/max per span)");
+}
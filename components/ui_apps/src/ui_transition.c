@@ -0,0 +1,202 @@
+#include "ui_transition.h"
+#include "ui_trace.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+
+static const char *TAG = "ui_transition";
+
+typedef struct {
+    lv_draw_buf_t buf;
+    void *data;                 // PSRAM, owned here (not an LVGL allocation)
+} snap_t;
+
+static snap_t snap_out;
+static snap_t snap_in;
+static bool have_out = false;
+static int64_t snap_out_us = 0;
+static int64_t snap_in_us = 0;
+
+static lv_obj_t *trans_screen = NULL;     // Bare screen holding the two bitmaps
+static lv_obj_t *img_out = NULL;
+static lv_obj_t *img_in = NULL;
+static lv_obj_t *target_screen = NULL;    // Loaded for real when the animation ends
+static ui_transition_kind_t trans_kind;
+static int32_t scr_w = 0;
+
+// Frame stats while a transition is on screen
+static int64_t trans_start_us = 0;
+static int64_t frame_start_us = 0;
+static int64_t frame_sum_us = 0;
+static int64_t frame_max_us = 0;
+static uint32_t frames = 0;
+
+static const char *kind_name(ui_transition_kind_t kind) {
+    switch (kind) {
+        case UI_TRANSITION_SLIDE_LEFT:  return "slide-left";
+        case UI_TRANSITION_SLIDE_RIGHT: return "slide-right";
+        case UI_TRANSITION_FADE:        return "fade";
+        default:                        return "?";
+    }
+}
+
+static void snap_free(snap_t *s) {
+    if (!s->data) return;
+    lv_image_cache_drop(&s->buf);   // Address may be reused by the next snapshot
+    heap_caps_free(s->data);
+    s->data = NULL;
+}
+
+static bool snap_take(snap_t *s, lv_obj_t *scr, int64_t *took_us) {
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp || !scr) return false;
+
+    uint32_t w = lv_display_get_horizontal_resolution(disp);
+    uint32_t h = lv_display_get_vertical_resolution(disp);
+    uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+    uint32_t size = stride * h;
+
+    s->data = heap_caps_aligned_alloc(LV_DRAW_BUF_ALIGN, size, MALLOC_CAP_SPIRAM);
+    if (!s->data) {
+        ESP_LOGW(TAG, "No PSRAM for a %u KB snapshot, loading without transition", (unsigned)(size / 1024));
+        return false;
+    }
+    lv_draw_buf_init(&s->buf, w, h, LV_COLOR_FORMAT_RGB565, stride, s->data, size);
+
+    int64_t t0 = esp_timer_get_time();
+    ui_trace_t span = ui_trace_begin();
+    lv_obj_update_layout(scr);
+    lv_result_t res = lv_snapshot_take_to_draw_buf(scr, LV_COLOR_FORMAT_RGB565, &s->buf);
+    ui_trace_end(TAG, UI_TRACE_RENDER, span);
+    *took_us = esp_timer_get_time() - t0;
+
+    if (res != LV_RESULT_OK) {
+        ESP_LOGW(TAG, "Snapshot failed, loading without transition");
+        snap_free(s);
+        return false;
+    }
+    return true;
+}
+
+static void frame_event_cb(lv_event_t *e) {
+    int64_t now = esp_timer_get_time();
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_START) {
+        frame_start_us = now;
+    } else if (frame_start_us) {
+        // REFR_READY: rendered and flushed
+        int64_t dt = now - frame_start_us;
+        frame_start_us = 0;
+        frames++;
+        frame_sum_us += dt;
+        if (dt > frame_max_us) frame_max_us = dt;
+    }
+}
+
+static void transition_finish(void) {
+    if (!trans_screen) return;
+
+    lv_anim_delete(trans_screen, NULL);
+    lv_display_t *disp = lv_display_get_default();
+    lv_display_remove_event_cb_with_user_data(disp, frame_event_cb, NULL);
+
+    if (target_screen && lv_obj_is_valid(target_screen)) {
+        lv_screen_load(target_screen);
+    }
+    lv_obj_delete(trans_screen);
+    trans_screen = img_out = img_in = target_screen = NULL;
+    snap_free(&snap_out);
+    snap_free(&snap_in);
+
+    int64_t elapsed_us = esp_timer_get_time() - trans_start_us;
+    ESP_LOGI(TAG, "%s: %lu frames in %lu ms (%lu fps), frame avg %lu.%lu ms max %lu.%lu ms; snapshots out %lu ms, in %lu ms",
+             kind_name(trans_kind), (unsigned long)frames, (unsigned long)(elapsed_us / 1000),
+             (unsigned long)(elapsed_us > 0 ? (int64_t)frames * 1000000 / elapsed_us : 0),
+             (unsigned long)(frames ? frame_sum_us / frames / 1000 : 0),
+             (unsigned long)(frames ? frame_sum_us / frames % 1000 / 100 : 0),
+             (unsigned long)(frame_max_us / 1000), (unsigned long)(frame_max_us % 1000 / 100),
+             (unsigned long)(snap_out_us / 1000), (unsigned long)(snap_in_us / 1000));
+}
+
+static void anim_exec_cb(void *var, int32_t v) {
+    switch (trans_kind) {
+        case UI_TRANSITION_SLIDE_LEFT:
+            lv_obj_set_x(img_out, -v);
+            lv_obj_set_x(img_in, scr_w - v);
+            break;
+        case UI_TRANSITION_SLIDE_RIGHT:
+            lv_obj_set_x(img_out, v);
+            lv_obj_set_x(img_in, v - scr_w);
+            break;
+        case UI_TRANSITION_FADE:
+            lv_obj_set_style_image_opa(img_in, (lv_opa_t)v, 0);
+            break;
+    }
+}
+
+static void anim_completed_cb(lv_anim_t *a) {
+    transition_finish();
+}
+
+void ui_transition_begin(void) {
+#if CONFIG_UI_TRANSITION_MS > 0
+    transition_finish();
+    snap_free(&snap_out);           // begin() without run()
+    have_out = snap_take(&snap_out, lv_screen_active(), &snap_out_us);
+#endif
+}
+
+void ui_transition_run(ui_transition_kind_t kind) {
+    if (!have_out) return;
+    have_out = false;
+
+    lv_obj_t *scr = lv_screen_active();
+    if (!snap_take(&snap_in, scr, &snap_in_us)) {
+        snap_free(&snap_out);
+        return;
+    }
+
+    trans_kind = kind;
+    target_screen = scr;
+    scr_w = (int32_t)snap_in.buf.header.w;
+
+    trans_screen = lv_obj_create(NULL);
+    lv_obj_remove_flag(trans_screen, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_style_bg_color(trans_screen, lv_color_hex(0x000000), 0);
+
+    img_out = lv_image_create(trans_screen);
+    lv_image_set_src(img_out, &snap_out.buf);
+    lv_obj_set_pos(img_out, 0, 0);
+
+    img_in = lv_image_create(trans_screen);
+    lv_image_set_src(img_in, &snap_in.buf);
+    lv_obj_set_pos(img_in, 0, 0);
+
+    int32_t end = scr_w;
+    if (kind == UI_TRANSITION_FADE) {
+        lv_obj_set_style_image_opa(img_in, LV_OPA_TRANSP, 0);
+        end = LV_OPA_COVER;
+    }
+    anim_exec_cb(NULL, 0);
+    lv_screen_load(trans_screen);
+
+    frames = 0;
+    frame_sum_us = frame_max_us = frame_start_us = 0;
+    trans_start_us = esp_timer_get_time();
+    lv_display_t *disp = lv_display_get_default();
+    lv_display_add_event_cb(disp, frame_event_cb, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(disp, frame_event_cb, LV_EVENT_REFR_READY, NULL);
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, trans_screen);
+    lv_anim_set_values(&a, 0, end);
+    lv_anim_set_duration(&a, CONFIG_UI_TRANSITION_MS);
+    lv_anim_set_exec_cb(&a, anim_exec_cb);
+    lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+    lv_anim_set_completed_cb(&a, anim_completed_cb);
+    lv_anim_start(&a);
+}
+
+bool ui_transition_active(void) {
+    return trans_screen != NULL;
+}
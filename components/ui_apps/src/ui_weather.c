@@ -1,5 +1,9 @@
 #include "ui_weather.h"
-#include "ui_launcher.h"
+#include "ui_assets.h"
+#include "ui_status_bar.h"
+#include "ui_trace.h"
+#include "ui_arena.h"
+#include "ui_app.h"
 #include "esp_log.h"
 #include "lvgl.h"
 
@@ -10,7 +14,7 @@ static lv_obj_t *weather_screen = NULL;
 static void btn_back_event_cb(lv_event_t *e) {
     if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
         ESP_LOGI(TAG, "Back button clicked");
-        ui_launcher_show();
+        ui_app_exit();
     }
 }
 
@@ -24,11 +28,15 @@ void ui_weather_cleanup(void) {
 
 void ui_weather_show(void) {
     ESP_LOGI(TAG, "Showing weather screen");
+    ui_trace_t span = ui_trace_begin();
+    
+    ui_status_bar_set_visible(false);   // Apps draw their own top bar
     
     // Clean up if already exists
     ui_weather_cleanup();
     
-    // Create main screen
+    // Create main screen; its LVGL allocations come from one arena
+    ui_arena_t *arena = ui_arena_begin("weather");
     weather_screen = lv_obj_create(NULL);
     lv_obj_set_style_bg_color(weather_screen, lv_color_hex(0x001020), 0); // Dark blue background
     lv_obj_set_flex_flow(weather_screen, LV_FLEX_FLOW_COLUMN);
@@ -65,13 +73,13 @@ void ui_weather_show(void) {
     // Weather icon
     lv_obj_t *icon = lv_label_create(content);
     lv_label_set_text(icon, LV_SYMBOL_TINT);
-    lv_obj_set_style_text_font(icon, &lv_font_montserrat_30, 0);
+    lv_obj_set_style_text_font(icon, ui_assets_font(30), 0);
     lv_obj_set_style_text_color(icon, lv_palette_main(LV_PALETTE_CYAN), 0); // Cyan water drop
     
     // Title
     lv_obj_t *title = lv_label_create(content);
     lv_label_set_text(title, "Weather");
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_30, 0);
+    lv_obj_set_style_text_font(title, ui_assets_font(30), 0);
     lv_obj_set_style_text_color(title, lv_palette_main(LV_PALETTE_CYAN), 0);
     
     // Placeholder text
@@ -83,12 +91,24 @@ void ui_weather_show(void) {
                                    "• Location info");
     lv_label_set_long_mode(placeholder, LV_LABEL_LONG_WRAP);
     lv_obj_set_width(placeholder, LV_PCT(90));
-    lv_obj_set_style_text_font(placeholder, &lv_font_montserrat_18, 0);
+    lv_obj_set_style_text_font(placeholder, ui_assets_font(18), 0);
     lv_obj_set_style_text_color(placeholder, lv_color_white(), 0);
     lv_obj_set_style_text_align(placeholder, LV_TEXT_ALIGN_CENTER, 0);
     
     // Load screen
     lv_screen_load(weather_screen);
+    ui_arena_end(arena, weather_screen);
+    ui_trace_end(TAG, UI_TRACE_LAYOUT, span);
     
     ESP_LOGI(TAG, "Weather screen initialized");
 }
+
+const ui_app_t ui_app_weather = {
+    .name = "Weather",
+    .icon = LV_SYMBOL_TINT,
+    .color = 0x00BCD4,              // LV_PALETTE_CYAN
+    .mem_app = UI_MEM_APP_WEATHER,
+    .mem_budget = 64 * 1024,
+    .create = ui_weather_show,
+    .destroy = ui_weather_cleanup,
+};
@@ -2,12 +2,30 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
 #include "hal_mgr.h"
-#include "lvgl_mgr.h"
 #include "lvgl.h"
 #include "lv_ui.h"
 #include "ui_private.h"
 #include "ui_launcher.h"
+#include "ui_maze.h"
+#include "ui_governor.h"
+#include "ui_trace.h"
+#include "ui_log.h"
+#include "ui_arena.h"
+#include "ui_mem.h"
+#include "ui_cpu.h"
+#include "ui_draw.h"
+#include "ui_fill.h"
+#include "ui_splash.h"
+#include "ui_boot.h"
+#include "ui_assets.h"
+#include "ui_imgcache.h"
+#include "ui_fs.h"
+#include "ui_ota.h"
+#include "ui_net.h"
+#include "ui_sports.h"
 
 static const char *TAG = "app_launcher";
 
@@ -28,38 +46,174 @@ static void my_rotation_handler(rm690b0_rotation_t rot, void *user_ctx) {
     ESP_LOGI(TAG, "Display rotation changed to: %d", rot);
 }
 
-void app_main(void)
-{
-    ESP_LOGI(TAG, "My Custom App Starting...");
+// --- Boot steps ---
+// Each runs once from the table below; see ui_boot.h for lanes and deps.
 
-    // Initialize BSP from the base components
-    if (bsp_init() != ESP_OK) {
-        ESP_LOGE(TAG, "BSP init failed!");
-        return;
-    }
+static esp_err_t boot_log(void) {
+    // Drain task for deferred ui_apps debug logs
+    ui_log_init();
+    return ESP_OK;
+}
 
-    ESP_LOGI(TAG, "BSP initialized - HAL, LVGL ready!");
-    
+static esp_err_t boot_mem(void) {
+    // Heap history and per-app attribution ('m' on the console dumps CSV)
+    ui_mem_init();
+    return ESP_OK;
+}
+
+static esp_err_t boot_cpu(void) {
+    // Per-core load and task runtime ('p' on the console, CPU page in Board Settings)
+    ui_cpu_init();
+    return ESP_OK;
+}
+
+static esp_err_t boot_bsp(void) {
+    // HAL, panel, touch, Wi-Fi manager and LVGL from the base components
+    return bsp_init();
+}
+
+static esp_err_t boot_splash(void) {
+    ui_splash_show(); // Last stored launcher frame on the panel before any widgets are built
+    return ESP_OK;
+}
+
+static esp_err_t boot_hal_ui(void) {
     // Initialize HAL BSP UI system (stats timer, etc.)
     // Note: This will create ui_home, but we've wrapped ui_home_create to be empty overridden by our own UI
-    lvgl_mgr_lock();
     lv_obj_set_style_bg_color(lv_screen_active(), lv_color_hex(0x000000), 0); // Ensure black BG immediately
     lv_ui_init();   // Initialize HAL BSP UI components
-    
-    // Show our ui_launcher page as default home screen
-    ui_launcher_init();
-    lvgl_mgr_unlock();
+    return ESP_OK;
+}
+
+static esp_err_t boot_diag(void) {
+    ui_trace_init(); // Render/flush spans; 't'/'j' on the console dumps them ('?' lists keys)
+    ui_draw_init();  // Draw unit bands; 'd' on the console times this build's units
+    ui_fill_init();  // RGB565 fill kernels; 'f' on the console checks them and prints MB/s
+    return ESP_OK;
+}
 
-    ESP_LOGI(TAG, "Launcher UI initialized");
+static esp_err_t boot_fs(void) {
+    ui_fs_init(); // "S:" drive with read-ahead; 'r' on the console prints MB/s against stdio
+    return ESP_OK;
+}
+
+static esp_err_t boot_imgcache(void) {
+    ui_imgcache_init(); // SD image cache; 'i' on the console prints hit rate and decode time saved
+    return ESP_OK;
+}
 
-    // Register HAL callbacks after UI is set up
+static esp_err_t boot_ota(void) {
+    ui_ota_init(); // Delta OTA; 'o' on the console shows the slots, 'O' patches from CONFIG_UI_OTA_DELTA_URL
+    return ESP_OK;
+}
+
+static esp_err_t boot_net(void) {
+    // Shared HTTPS pool and TLS sessions ('h' shows handshakes, 'H' benchmarks a refresh).
+    // Seeding the DRBG and loading saved sessions from NVS stay off the launcher's path.
+    ui_net_init();
+    return ESP_OK;
+}
+
+static esp_err_t boot_sports(void) {
+    ui_sports_init(); // Live scores; 'l' on the console shows stream, polls, latency and radio time
+    return ESP_OK;
+}
+
+static esp_err_t boot_hal_cb(void) {
     hal_mgr_register_usb_callback(my_usb_handler, NULL);
     hal_mgr_register_charge_callback(my_charge_handler, NULL);
     hal_mgr_register_battery_callback(my_battery_handler, NULL);
     hal_mgr_register_rotation_callback(my_rotation_handler, NULL);
+    return ESP_OK;
+}
+
+static esp_err_t boot_assets(void) {
+    ui_assets_init(); // Map the storage asset pack (maze levels); built-ins if there is none
+    return ESP_OK;
+}
+
+static esp_err_t boot_launcher(void) {
+    // Show our ui_launcher page as default home screen
+    ui_launcher_init();
+    ui_splash_handover(); // Live launcher takes over; re-stores the frame if it changed
+    return ESP_OK;
+}
+
+static esp_err_t boot_governor(void) {
+    // Drop refresh rate, pause cosmetic timers and dim when nobody is touching the screen
+    ui_governor_init();
+    return ESP_OK;
+}
 
-    // Main loop - UI is now interactive via touch
-    while (1) {
-        vTaskDelay(pdMS_TO_TICKS(1000));
+static esp_err_t boot_checks(void) {
+#if CONFIG_UI_MAZE_RENDER_CHECK
+    ui_maze_render_check();
+#endif
+#if CONFIG_UI_FILL_CHECK
+    ui_fill_check();
+    ui_fill_bench(stdout);
+#endif
+#if CONFIG_UI_DRAW_BENCH
+    ui_draw_bench(CONFIG_UI_DRAW_BENCH_FRAMES, NULL);
+#endif
+#if CONFIG_UI_LOG_BENCH_MOVES > 0
+    ui_maze_log_bench(CONFIG_UI_LOG_BENCH_MOVES);
+#endif
+#if CONFIG_UI_ARENA_SOAK_CYCLES > 0
+    ui_arena_soak_start(CONFIG_UI_ARENA_SOAK_CYCLES);
+#endif
+    return ESP_OK;
+}
+
+enum {
+    BOOT_LOG, BOOT_MEM, BOOT_CPU, BOOT_BSP, BOOT_SPLASH, BOOT_HAL_UI,
+    BOOT_DIAG, BOOT_FS, BOOT_HAL_CB, BOOT_ASSETS, BOOT_IMGCACHE, BOOT_OTA, BOOT_NET, BOOT_SPORTS,
+    BOOT_LAUNCHER, BOOT_GOVERNOR, BOOT_CHECKS,
+};
+
+#define DEP UI_BOOT_DEP
+#define MAIN UI_BOOT_LANE_MAIN
+#define SIDE UI_BOOT_LANE_SIDE
+
+// Table order is each lane's run order. Telemetry and the HAL callbacks run
+// on the other core while this one brings up the BSP and builds the UI;
+// net comes after assets there so TLS setup overlaps the launcher build.
+static const ui_boot_step_t boot_steps[] = {
+    [BOOT_LOG]      = { "log",      boot_log,      0,                                   SIDE, false },
+    [BOOT_MEM]      = { "mem",      boot_mem,      0,                                   SIDE, false },
+    [BOOT_CPU]      = { "cpu",      boot_cpu,      0,                                   SIDE, false },
+    [BOOT_BSP]      = { "bsp",      boot_bsp,      0,                                   MAIN, false },
+    [BOOT_SPLASH]   = { "splash",   boot_splash,   DEP(BOOT_BSP),                       MAIN, true },
+    [BOOT_HAL_UI]   = { "hal_ui",   boot_hal_ui,   DEP(BOOT_SPLASH),                    MAIN, true },
+    [BOOT_DIAG]     = { "diag",     boot_diag,     DEP(BOOT_BSP),                       MAIN, true },
+    [BOOT_FS]       = { "fs",       boot_fs,       DEP(BOOT_BSP),                       MAIN, true },
+    [BOOT_HAL_CB]   = { "hal_cb",   boot_hal_cb,   DEP(BOOT_BSP),                       SIDE, false },
+    [BOOT_ASSETS]   = { "assets",   boot_assets,   0,                                   SIDE, false },
+    [BOOT_IMGCACHE] = { "imgcache", boot_imgcache, 0,                                   SIDE, false },
+    [BOOT_OTA]      = { "ota",      boot_ota,      0,                                   SIDE, false },
+    [BOOT_NET]      = { "net",      boot_net,      DEP(BOOT_BSP),                       SIDE, false },
+    [BOOT_SPORTS]   = { "sports",   boot_sports,   0,                                   SIDE, false },
+    [BOOT_LAUNCHER] = { "launcher", boot_launcher, DEP(BOOT_HAL_UI) | DEP(BOOT_MEM) | DEP(BOOT_FS), MAIN, true },
+    [BOOT_GOVERNOR] = { "governor", boot_governor, DEP(BOOT_LAUNCHER),                  MAIN, true },
+    [BOOT_CHECKS]   = { "checks",   boot_checks,   DEP(BOOT_LAUNCHER) | DEP(BOOT_DIAG) | DEP(BOOT_ASSETS), MAIN, true },
+};
+
+void app_main(void)
+{
+    ESP_LOGI(TAG, "My Custom App Starting...");
+
+    // Prints the boot timeline when done ('b' on the console reprints it)
+    if (ui_boot_run(boot_steps, sizeof(boot_steps) / sizeof(boot_steps[0])) != ESP_OK) {
+        ESP_LOGE(TAG, "Boot failed, see the timeline above");
+        return;
     }
+
+    // Boot cost: time-to-interactive and idle heap, logged against the
+    // previous firmware image so a change's cost shows up after flashing it.
+    // The launcher takes touches from here on.
+    ui_boot_log_cost();
+
+    // UI is now interactive via touch and driven entirely by the LVGL task.
+    // Returning lets ESP-IDF delete the main task instead of waking it every second.
+    ESP_LOGI(TAG, "Startup complete, main task exiting");
 }
@@ -0,0 +1,508 @@
+/*
+ * Host soak for the per-screen arenas (components/ui_apps/src/ui_arena_core.c).
+ *
+ * Plays the allocation pattern of opening and closing the apps from the
+ * launcher over a simulated heap (first-fit with coalescing, standing in
+ * for the IDF heap), once with every block on the heap and once with screen
+ * builds routed into arenas the way ui_arena.c does it. Each app open:
+ *   - builds the app screen: a synthetic mix shaped like an LVGL 9 screen
+ *     (objects, style and event entries, label text, a few arrays, the odd
+ *     image descriptor over ARENA_MAX_PAYLOAD), some of it resized;
+ *   - deletes the launcher screen and allocates the app's own buffers;
+ *   - updates labels while it runs (heap reallocs outside the build);
+ *   - leaves a few small long-lived heap blocks behind (log lines, caches);
+ *   - on exit rebuilds the launcher and deletes the app screen.
+ * Both runs are repeated with 1% of build blocks outliving their screen
+ * (something global created during the build), which pins arenas.
+ * Every block is filled on allocation and checked on free. Reports free
+ * space, largest free block and fragmentation for both runs, then frees
+ * everything and checks the heap is whole again and every arena released.
+ * A run fails if it runs out of heap, or if the arenas end with the heap
+ * more fragmented than the heap-only run of the same workload.
+ *
+ * Build and run:
+ *   cc -O2 -Wall -fsanitize=address,undefined -Icomponents/ui_apps/src \
+ *      tools/arena_soak.c components/ui_apps/src/ui_arena_core.c -o arena_soak
+ *   ./arena_soak [cycles]     (default 200 cycles over 5 apps; exit status 0
+ *                              if every check passed)
+ */
+
+#include "ui_arena_core.h"
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HEAP_SIZE       (320 * 1024)    // About the internal RAM left to LVGL
+#define CHUNK_SIZE      16384           // CONFIG_UI_ARENA_CHUNK_SIZE default
+#define MAX_ARENAS      6               // CONFIG_UI_ARENA_MAX default
+#define MAX_CHUNKS      8               // CONFIG_UI_ARENA_MAX_CHUNKS default
+#define APP_COUNT       5
+#define SURVIVE_OPENS   7               // Build blocks that outlive their screen live this long
+#define KEEP_OPENS      20              // Long-lived heap blocks live this long
+#define MAX_LONG        256
+
+// --- Simulated heap: header and footer tags, first fit, coalescing ---
+
+#define TAG_SIZE        8
+#define MIN_BLOCK       32
+
+static uint8_t heap[HEAP_SIZE] __attribute__((aligned(8)));
+static size_t heap_used = 0;
+
+static uint32_t *hdr_at(size_t off) { return (uint32_t *)(heap + off); }
+static uint32_t blk_size(size_t off) { return *hdr_at(off) & ~7u; }
+static int blk_used(size_t off) { return *hdr_at(off) & 1; }
+
+static void set_blk(size_t off, uint32_t size, int used) {
+    *hdr_at(off) = size | (uint32_t)used;
+    *hdr_at(off + size - 4) = size | (uint32_t)used;
+}
+
+static void heap_init(void) {
+    set_blk(0, HEAP_SIZE, 0);
+    heap_used = 0;
+}
+
+static void *heap_malloc(size_t n) {
+    uint32_t need = (uint32_t)((n + 7) & ~(size_t)7) + TAG_SIZE;
+    if (need < MIN_BLOCK) need = MIN_BLOCK;
+    for (size_t off = 0; off < HEAP_SIZE; off += blk_size(off)) {
+        uint32_t size = blk_size(off);
+        if (blk_used(off) || size < need) continue;
+        if (size - need >= MIN_BLOCK) {
+            set_blk(off + need, size - need, 0);
+            size = need;
+        }
+        set_blk(off, size, 1);
+        heap_used += size;
+        return heap + off + 4;
+    }
+    return NULL;
+}
+
+static void heap_free(void *p) {
+    if (!p) return;
+    size_t off = (size_t)((uint8_t *)p - heap) - 4;
+    uint32_t size = blk_size(off);
+    heap_used -= size;
+    size_t next = off + size;
+    if (next < HEAP_SIZE && !blk_used(next)) size += blk_size(next);
+    if (off > 0 && !(*hdr_at(off - 4) & 1)) {
+        uint32_t prev = *hdr_at(off - 4) & ~7u;
+        off -= prev;
+        size += prev;
+    }
+    set_blk(off, size, 0);
+}
+
+// Payloads start 4 bytes into a block: keep them 8-byte aligned for the arenas
+static void *heap_malloc8(size_t n) {
+    uint8_t *p = heap_malloc(n + 4);
+    return p ? p + 4 : NULL;
+}
+
+static void heap_free8(void *p) {
+    heap_free(p ? (uint8_t *)p - 4 : NULL);
+}
+
+typedef struct {
+    size_t free_bytes, largest;
+    unsigned blocks;
+} heap_info_t;
+
+static heap_info_t heap_info(void) {
+    heap_info_t h = { 0 };
+    for (size_t off = 0; off < HEAP_SIZE; off += blk_size(off)) {
+        if (blk_used(off)) continue;
+        h.free_bytes += blk_size(off);
+        if (blk_size(off) > h.largest) h.largest = blk_size(off);
+        h.blocks++;
+    }
+    return h;
+}
+
+static unsigned frag_pct(const heap_info_t *h) {
+    return h->free_bytes ? (unsigned)(100 - h->largest * 100 / h->free_bytes) : 0;
+}
+
+// --- The allocator under test: heap only, or arenas as ui_arena.c routes them ---
+
+static arena_pool_t *pool = NULL;       // NULL: heap only
+static arena_t *routing = NULL;
+static unsigned arena_allocs = 0, heap_allocs = 0;
+static unsigned failures = 0;
+
+static void *chunk_alloc(void *ctx, size_t size) { return heap_malloc8(size); }
+static void chunk_free(void *ctx, void *chunk) { heap_free8(chunk); }
+
+static void *ui_malloc(size_t size) {
+    if (pool && routing && size <= ARENA_MAX_PAYLOAD) {
+        void *p = arena_alloc(pool, routing, size);
+        if (p) {
+            arena_allocs++;
+            return p;
+        }
+    }
+    heap_allocs++;
+    return heap_malloc8(size);
+}
+
+static void ui_free(void *p) {
+    if (!pool || !arena_free(pool, p)) heap_free8(p);
+}
+
+static void *ui_realloc(void *p, size_t old_size, size_t new_size) {
+    if (pool && arena_owns(pool, p)) {
+        void *np = arena_realloc(pool, p, new_size);
+        if (np) return np;
+    }
+    void *np = heap_malloc8(new_size);
+    if (np) {
+        heap_allocs++;
+        memcpy(np, p, old_size < new_size ? old_size : new_size);
+        ui_free(p);
+    }
+    return np;
+}
+
+// --- Workload ---
+
+typedef struct {
+    uint8_t *p;
+    uint32_t size;
+    uint8_t fill;
+    uint32_t until;         // Open count it lives to (long-lived blocks)
+} blk_t;
+
+typedef struct {
+    blk_t *blks;
+    size_t count, cap;
+    arena_t *arena;
+} screen_t;
+
+static uint32_t rng_state = 0x2545F491;
+static uint32_t opens = 0;
+static unsigned survive_per_mille = 0;
+static blk_t longs[MAX_LONG];
+static size_t long_count = 0;
+
+static uint32_t rng(void) {
+    uint32_t x = rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return rng_state = x;
+}
+
+static uint32_t rng_range(uint32_t lo, uint32_t hi) {
+    return lo + rng() % (hi - lo + 1);
+}
+
+static void blk_fill(blk_t *b) {
+    b->fill = (uint8_t)rng();
+    memset(b->p, b->fill, b->size);
+}
+
+static void blk_check(const blk_t *b) {
+    for (uint32_t i = 0; i < b->size; i++) {
+        if (b->p[i] != b->fill) {
+            fprintf(stderr, "FAIL block %p (%u bytes) overwritten at %u\n", (void *)b->p, (unsigned)b->size, (unsigned)i);
+            failures++;
+            return;
+        }
+    }
+}
+
+static void blk_release(blk_t *b) {
+    blk_check(b);
+    ui_free(b->p);
+    b->p = NULL;
+}
+
+static jmp_buf oom_jmp;
+
+// Ends the run (host allocations failing end the program)
+static void out_of_memory(const char *what) {
+    if (strcmp(what, "host") == 0) {
+        fprintf(stderr, "out of host memory\n");
+        exit(1);
+    }
+    longjmp(oom_jmp, 1);
+}
+
+static void keep_long(blk_t b) {
+    if (long_count == MAX_LONG) {
+        blk_release(&b);
+        return;
+    }
+    longs[long_count++] = b;
+}
+
+static void expire_longs(void) {
+    for (size_t i = 0; i < long_count;) {
+        if (longs[i].until <= opens) {
+            blk_release(&longs[i]);
+            longs[i] = longs[--long_count];
+        } else {
+            i++;
+        }
+    }
+}
+
+static void screen_push(screen_t *s, blk_t b) {
+    if (s->count == s->cap) {
+        s->cap = s->cap ? s->cap * 2 : 256;
+        s->blks = realloc(s->blks, s->cap * sizeof(blk_t));
+        if (!s->blks) out_of_memory("host");
+    }
+    s->blks[s->count++] = b;
+}
+
+// Sizes shaped like LVGL 9 allocations
+static uint32_t lvgl_size(void) {
+    uint32_t r = rng() % 100;
+    if (r < 35) return rng_range(64, 128);      // Objects and their spec attrs
+    if (r < 65) return rng_range(16, 48);       // Style entries, event descriptors
+    if (r < 90) return rng_range(8, 64);        // Label text
+    if (r < 98) return rng_range(96, 512);      // Point and option arrays
+    return rng_range(600, 2400);                // Image descriptors, canvases
+}
+
+static void screen_build(screen_t *s, unsigned objs) {
+    if (pool) {
+        s->arena = arena_open(pool);
+        routing = s->arena;                     // NULL when every slot is taken
+    }
+    for (unsigned i = 0; i < objs; i++) {
+        blk_t b = { .size = lvgl_size() };
+        b.p = ui_malloc(b.size);
+        if (!b.p) out_of_memory("build");
+        blk_fill(&b);
+        if (rng() % 10 == 0) {                  // lv_label_set_text on a new label
+            blk_check(&b);
+            uint32_t size = rng_range(8, 96);
+            b.p = ui_realloc(b.p, b.size, size);
+            if (!b.p) out_of_memory("build realloc");
+            b.size = size;
+            blk_fill(&b);
+        }
+        if (rng() % 1000 < survive_per_mille) {  // Something global made during the build
+            b.until = opens + SURVIVE_OPENS;
+            keep_long(b);
+        } else {
+            screen_push(s, b);
+        }
+    }
+    routing = NULL;
+}
+
+static void screen_delete(screen_t *s) {
+    // LVGL frees children before parents; shuffle a little around that order
+    for (size_t i = 0; i + 1 < s->count; i++) {
+        if (rng() % 4 == 0) {
+            blk_t t = s->blks[i];
+            s->blks[i] = s->blks[i + 1];
+            s->blks[i + 1] = t;
+        }
+    }
+    for (size_t i = s->count; i-- > 0;) blk_release(&s->blks[i]);
+    s->count = 0;
+    if (s->arena) arena_close(pool, s->arena);
+    s->arena = NULL;
+}
+
+// Label updates while the app runs: heap reallocs outside the build
+static void screen_run(screen_t *s, unsigned updates) {
+    for (unsigned i = 0; i < updates && s->count; i++) {
+        blk_t *b = &s->blks[rng() % s->count];
+        blk_check(b);
+        uint32_t size = rng_range(8, 160);
+        b->p = ui_realloc(b->p, b->size, size);
+        if (!b->p) out_of_memory("update");
+        b->size = size;
+        blk_fill(b);
+    }
+}
+
+static const struct {
+    const char *name;
+    unsigned objs;
+    unsigned updates;
+    uint32_t buf_size;                          // App buffer allocated in create()
+} apps[APP_COUNT] = {
+    { "maze", 260, 40, 24 * 1024 },
+    { "sports", 180, 80, 4 * 1024 },
+    { "weather", 120, 20, 2 * 1024 },
+    { "photos", 300, 30, 32 * 1024 },
+    { "settings", 220, 10, 0 },
+};
+
+#define LAUNCHER_OBJS   90
+
+typedef struct {
+    heap_info_t end;
+    size_t worst_largest;
+    unsigned worst_frag;
+    unsigned arena_allocs, heap_allocs;
+    uint32_t max_chunks, max_pinned;
+    uint32_t oom_open;                          // App open that ran out of heap, 0 if none
+} result_t;
+
+static screen_t launcher, app;
+static result_t res;
+
+static void track(void) {
+    heap_info_t h = heap_info();
+    if (!res.worst_largest || h.largest < res.worst_largest) res.worst_largest = h.largest;
+    if (frag_pct(&h) > res.worst_frag) res.worst_frag = frag_pct(&h);
+    if (pool) {
+        arena_stats_t st;
+        arena_get_stats(pool, NULL, &st);
+        if (st.chunks > res.max_chunks) res.max_chunks = st.chunks;
+        if (st.pinned > res.max_pinned) res.max_pinned = st.pinned;
+    }
+}
+
+static void cycle_apps(unsigned cycles) {
+    screen_build(&launcher, LAUNCHER_OBJS);
+    for (unsigned c = 0; c < cycles; c++) {
+        for (int i = 0; i < APP_COUNT; i++) {
+            opens++;
+            screen_build(&app, apps[i].objs);
+            screen_delete(&launcher);
+            uint8_t *buf = apps[i].buf_size ? heap_malloc8(apps[i].buf_size) : NULL;
+            if (apps[i].buf_size && !buf) out_of_memory(apps[i].name);
+            screen_run(&app, apps[i].updates);
+            for (int k = rng() % 3; k > 0; k--) {
+                blk_t b = { .size = rng_range(24, 200), .until = opens + KEEP_OPENS };
+                b.p = ui_malloc(b.size);
+                if (!b.p) out_of_memory("long-lived");
+                blk_fill(&b);
+                keep_long(b);
+            }
+            track();
+
+            screen_build(&launcher, LAUNCHER_OBJS);
+            heap_free8(buf);
+            screen_delete(&app);
+            expire_longs();
+            track();
+        }
+    }
+}
+
+// Tear down: the heap must be whole again and every arena released
+static void teardown(void) {
+    screen_delete(&launcher);
+    while (long_count) blk_release(&longs[--long_count]);
+    if (pool) {
+        arena_stats_t st;
+        arena_get_stats(pool, NULL, &st);
+        if (st.open || st.pinned || st.chunks || st.live_blocks) {
+            fprintf(stderr, "FAIL %u open / %u pinned arenas, %u chunks, %u blocks left after teardown\n",
+                    (unsigned)st.open, (unsigned)st.pinned, (unsigned)st.chunks, (unsigned)st.live_blocks);
+            failures++;
+        }
+    }
+    heap_info_t h = heap_info();
+    if (heap_used || h.blocks != 1 || h.largest != HEAP_SIZE) {
+        fprintf(stderr, "FAIL heap not whole after teardown: %u bytes used, %u free blocks\n",
+                (unsigned)heap_used, h.blocks);
+        failures++;
+    }
+}
+
+static result_t run(bool arenas, unsigned survive, unsigned cycles) {
+    memset(&res, 0, sizeof(res));
+    survive_per_mille = survive;
+    heap_init();
+    rng_state = 0x2545F491;
+    opens = 0;
+    arena_allocs = heap_allocs = 0;
+    if (arenas) {
+        const arena_pool_config_t cfg = { .chunk_size = CHUNK_SIZE, .max_arenas = MAX_ARENAS,
+                                            .max_chunks = MAX_CHUNKS };
+        const arena_backend_t be = { .chunk_alloc = chunk_alloc, .chunk_free = chunk_free };
+        pool = arena_pool_create(&cfg, &be);
+        if (!pool) out_of_memory("host");
+    }
+
+    if (setjmp(oom_jmp) == 0) {
+        cycle_apps(cycles);
+        res.end = heap_info();
+        res.arena_allocs = arena_allocs;
+        res.heap_allocs = heap_allocs;
+        teardown();
+    } else {
+        // Out of simulated heap: the run's state is abandoned, not checked
+        res.oom_open = opens;
+        launcher.count = app.count = long_count = 0;
+        launcher.arena = app.arena = NULL;
+        routing = NULL;
+    }
+    arena_pool_destroy(pool);
+    pool = NULL;
+    return res;
+}
+
+static void print_result(const char *mode, const result_t *r) {
+    if (r->oom_open) {
+        printf("%-7s out of heap at app open %u, %u chunks and %u pinned arenas at most\n", mode,
+               (unsigned)r->oom_open, (unsigned)r->max_chunks, (unsigned)r->max_pinned);
+        return;
+    }
+    printf("%-7s %7u %7u %9u %9u %4u%% %10u %4u%% %7u %7u\n", mode,
+           r->arena_allocs, r->heap_allocs, (unsigned)r->end.free_bytes, (unsigned)r->end.largest,
+           frag_pct(&r->end), (unsigned)r->worst_largest, r->worst_frag,
+           (unsigned)r->max_chunks, (unsigned)r->max_pinned);
+}
+
+int main(int argc, char **argv) {
+    unsigned cycles = argc > 1 ? (unsigned)strtoul(argv[1], NULL, 0) : 200;
+
+    printf("%u cycles over %d apps, %u KB heap, %u KB chunks, %u arenas\n\n", cycles, APP_COUNT,
+           HEAP_SIZE / 1024, CHUNK_SIZE / 1024, MAX_ARENAS);
+    printf("%-7s %7s %7s %9s %9s %5s %10s %5s %7s %7s\n", "", "arena", "heap", "free", "largest",
+           "frag", "worst lrg", "worst", "chunks", "pinned");
+
+    static const struct {
+        const char *mode;
+        bool arenas;
+        unsigned survive;
+    } runs[] = {
+        { "heap", false, 0 },
+        { "arenas", true, 0 },
+        { "heap+", false, 10 },
+        { "arenas+", true, 10 },
+    };
+    result_t results[sizeof(runs) / sizeof(runs[0])];
+    for (size_t i = 0; i < sizeof(runs) / sizeof(runs[0]); i++) {
+        results[i] = run(runs[i].arenas, runs[i].survive, cycles);
+        print_result(runs[i].mode, &results[i]);
+    }
+
+    printf("\n+ : 1%% of build blocks outlive their screen\n");
+
+    // The arenas must hold up and leave the heap no worse than the heap alone
+    for (size_t i = 0; i < sizeof(runs) / sizeof(runs[0]); i++) {
+        const result_t *r = &results[i];
+        if (r->oom_open) {
+            printf("FAIL %s ran out of heap\n", runs[i].mode);
+            failures++;
+        }
+        if (!runs[i].arenas || r->oom_open || results[i - 1].oom_open) continue;
+        const result_t *base = &results[i - 1];     // Heap run with the same workload
+        if (frag_pct(&r->end) > frag_pct(&base->end)) {
+            printf("FAIL %s ends at %u%% fragmentation, %s at %u%%\n", runs[i].mode,
+                   frag_pct(&r->end), runs[i - 1].mode, frag_pct(&base->end));
+            failures++;
+        }
+    }
+
+    free(launcher.blks);
+    free(app.blks);
+    if (failures) printf("%u check(s) failed\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,185 @@
+/*
+ * Host throughput benchmark for the ui_apps image decode core
+ * (components/ui_apps/src/ui_decode_core.c).
+ *
+ * Decodes each JPEG at thumbnail size, at screen size and at full size
+ * (no scaled IDCT, what a plain decoder would do) and prints ms per image
+ * and source megapixels per second. Without arguments it generates
+ * baseline and progressive test JPEGs in memory. Host numbers are for
+ * comparing settings; the ESP32-S3 is roughly 10-20x slower.
+ *
+ * Build and run (needs libjpeg-turbo headers):
+ *   cc -O2 -Icomponents/ui_apps/src tools/decode_bench.c \
+ *      components/ui_apps/src/ui_decode_core.c -ljpeg -o decode_bench
+ *   ./decode_bench [photo.jpg ...]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "ui_decode_core.h"
+#include <jpeglib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define THUMB_W   140
+#define THUMB_H   105
+#define SCREEN_W  600
+#define SCREEN_H  450
+#define MIN_NS    300000000LL       // Repeat each case for at least 0.3 s
+
+typedef struct {
+    uint32_t rows;
+    uint32_t coarse_rows;
+    uint32_t sum;
+} bench_sink_t;
+
+static bool bench_row(void *ctx, const decode_geom_t *g, uint16_t y, const uint16_t *px, const uint8_t *alpha,
+                      bool final) {
+    bench_sink_t *s = ctx;
+    if (final) s->rows++; else s->coarse_rows++;
+    s->sum += px[g->out_w / 2];     // Touch the output so nothing is optimised away
+    return true;
+}
+
+static int64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Photo-like test image: gradients plus noise, so the entropy coder has real work
+static unsigned char *make_jpeg(int w, int h, bool progressive, unsigned long *len) {
+    struct jpeg_compress_struct ci;
+    struct jpeg_error_mgr err;
+    unsigned char *out = NULL;
+    ci.err = jpeg_std_error(&err);
+    jpeg_create_compress(&ci);
+    jpeg_mem_dest(&ci, &out, len);
+    ci.image_width = w;
+    ci.image_height = h;
+    ci.input_components = 3;
+    ci.in_color_space = JCS_RGB;
+    jpeg_set_defaults(&ci);
+    jpeg_set_quality(&ci, 85, TRUE);
+    if (progressive) jpeg_simple_progression(&ci);
+    jpeg_start_compress(&ci, TRUE);
+
+    unsigned char *row = malloc((size_t)w * 3);
+    uint32_t seed = 1;
+    while (ci.next_scanline < ci.image_height) {
+        int y = ci.next_scanline;
+        for (int x = 0; x < w; x++) {
+            seed = seed * 1103515245u + 12345u;
+            int n = (seed >> 16) & 31;
+            row[x * 3 + 0] = (unsigned char)(x * 255 / w + n / 2);
+            row[x * 3 + 1] = (unsigned char)(y * 255 / h);
+            row[x * 3 + 2] = (unsigned char)(((x ^ y) & 0xFF) / 2 + n);
+        }
+        JSAMPROW r = row;
+        jpeg_write_scanlines(&ci, &r, 1);
+    }
+    free(row);
+    jpeg_finish_compress(&ci);
+    jpeg_destroy_compress(&ci);
+    return out;
+}
+
+static void bench_case(const char *name, const unsigned char *data, size_t len, int box_w, int box_h, bool coarse) {
+    bench_sink_t s = { 0 };
+    decode_sink_t sink = { .row = bench_row, .ctx = &s, .coarse_pass = coarse };
+    decode_geom_t g = { 0 };
+    int runs = 0;
+    int64_t t0 = now_ns(), t;
+    do {
+        FILE *f = fmemopen((void *)data, len, "rb");
+        s = (bench_sink_t){ 0 };
+        if (decode_jpeg_file(f, box_w, box_h, &sink) != DECODE_OK) {
+            printf("%-28s %4dx%-4d  decode failed\n", name, box_w, box_h);
+            fclose(f);
+            return;
+        }
+        fclose(f);
+        runs++;
+        t = now_ns() - t0;
+    } while (t < MIN_NS);
+
+    // Geometry once more, for the report
+    FILE *f = fmemopen((void *)data, len, "rb");
+    struct jpeg_decompress_struct ci;
+    struct jpeg_error_mgr err;
+    ci.err = jpeg_std_error(&err);
+    jpeg_create_decompress(&ci);
+    jpeg_stdio_src(&ci, f);
+    jpeg_read_header(&ci, TRUE);
+    g.src_w = (uint16_t)ci.image_width;
+    g.src_h = (uint16_t)ci.image_height;
+    jpeg_destroy_decompress(&ci);
+    fclose(f);
+    decode_fit(g.src_w, g.src_h, box_w, box_h, &g.out_w, &g.out_h);
+
+    double ms = (double)t / runs / 1e6;
+    double mps = (double)g.src_w * g.src_h / 1e6 / (ms / 1e3);
+    printf("%-28s %4dx%-4d -> %4ux%-4u  %8.2f ms  %7.1f MP/s%s\n", name, box_w, box_h, g.out_w, g.out_h, ms, mps,
+           s.coarse_rows ? "  (+coarse pass)" : "");
+}
+
+static void bench_jpeg(const char *name, const unsigned char *data, size_t len, int full_w, int full_h) {
+    bench_case(name, data, len, THUMB_W, THUMB_H, false);
+    bench_case(name, data, len, SCREEN_W, SCREEN_H, false);
+    bench_case(name, data, len, SCREEN_W, SCREEN_H, true);
+    bench_case(name, data, len, full_w, full_h, false);
+}
+
+static void bench_rgba(int w, int h) {
+    uint8_t *rgba = malloc((size_t)w * h * 4);
+    for (size_t i = 0; i < (size_t)w * h * 4; i++) rgba[i] = (uint8_t)(i * 2654435761u >> 24);
+    bench_sink_t s = { 0 };
+    decode_sink_t sink = { .row = bench_row, .ctx = &s };
+    int runs = 0;
+    int64_t t0 = now_ns(), t;
+    do {
+        decode_rgba(rgba, w, h, SCREEN_W, SCREEN_H, &sink);
+        runs++;
+        t = now_ns() - t0;
+    } while (t < MIN_NS);
+    printf("%-28s %4dx%-4d  %8.3f ms per fit (PNG after lodepng)\n", "rgba fit", w, h, (double)t / runs / 1e6);
+    free(rgba);
+}
+
+int main(int argc, char **argv) {
+    printf("%-28s %-9s    %-9s  %11s  %12s\n", "image", "box", "out", "time", "throughput");
+    if (argc > 1) {
+        for (int i = 1; i < argc; i++) {
+            FILE *f = fopen(argv[i], "rb");
+            if (!f) {
+                perror(argv[i]);
+                continue;
+            }
+            fseek(f, 0, SEEK_END);
+            long len = ftell(f);
+            fseek(f, 0, SEEK_SET);
+            unsigned char *data = malloc(len);
+            if (fread(data, 1, len, f) == (size_t)len) bench_jpeg(argv[i], data, len, 65535, 65535);
+            fclose(f);
+            free(data);
+        }
+        return 0;
+    }
+
+    static const struct { int w, h; bool progressive; const char *name; } gen[] = {
+        { 4032, 3024, false, "4032x3024 baseline" },
+        { 4032, 3024, true,  "4032x3024 progressive" },
+        { 1920, 1080, false, "1920x1080 baseline" },
+        { 1920, 1080, true,  "1920x1080 progressive" },
+    };
+    for (size_t i = 0; i < sizeof(gen) / sizeof(gen[0]); i++) {
+        unsigned long len = 0;
+        unsigned char *data = make_jpeg(gen[i].w, gen[i].h, gen[i].progressive, &len);
+        bench_jpeg(gen[i].name, data, len, gen[i].w, gen[i].h);
+        free(data);
+    }
+    bench_rgba(1024, 1024);
+    return 0;
+}
@@ -0,0 +1,171 @@
+/*
+ * Host benchmark for the incremental directory listing used by the SD Card
+ * page (components/ui_apps/src/ui_dirlist_core.c).
+ *
+ * Creates synthetic directories of 100, 1k and 10k empty files (plus a few
+ * folders) and compares:
+ *   - all at once: read every entry, sort, then show (what the old view did);
+ *   - streamed: batches of DIRLIST_FIRST_BATCH doubling to DIRLIST_MAX_BATCH,
+ *     each sorted, merged and published (copying the view, as the worker
+ *     does for the UI).
+ * Time-to-first-entry of the streamed listing should not grow with the
+ * directory. Also times a re-sort and an extension filter over the result.
+ * Host file systems are far faster than FAT on SD; compare the shapes.
+ *
+ * Build and run:
+ *   cc -O2 -Icomponents/ui_apps/src tools/dirlist_bench.c \
+ *      components/ui_apps/src/ui_dirlist_core.c -o dirlist_bench
+ *   ./dirlist_bench [scratch-dir]      (default /tmp/dirlist_bench)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "ui_dirlist_core.h"
+#include <dirent.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RUNS 5                      // Best of
+
+static const char *exts[] = { "jpg", "png", "mp3", "wav", "txt", "bin", "JPG", "log" };
+
+static int64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static double ms(int64_t ns) {
+    return ns / 1e6;
+}
+
+// Names in no particular order, like a card filled over time
+static int make_dir(const char *base, int n, char *path, size_t len) {
+    snprintf(path, len, "%s/%d", base, n);
+    if (mkdir(base, 0755) != 0 && errno != EEXIST) return -1;
+    if (mkdir(path, 0755) != 0) {
+        if (errno == EEXIST) return 0;      // Kept from an earlier run
+        return -1;
+    }
+    uint32_t seed = (uint32_t)n;
+    char name[512];
+    for (int i = 0; i < n; i++) {
+        seed = seed * 1103515245u + 12345u;
+        if (i % 97 == 0) {
+            snprintf(name, sizeof(name), "%s/Folder %08x", path, seed);
+            mkdir(name, 0755);
+            continue;
+        }
+        snprintf(name, sizeof(name), "%s/IMG_%08x_%d.%s", path, seed, i, exts[(seed >> 8) % 8]);
+        FILE *f = fopen(name, "w");
+        if (!f) return -1;
+        fclose(f);
+    }
+    return 0;
+}
+
+typedef struct {
+    int64_t first_ns, total_ns;
+    size_t publishes, entries;
+} result_t;
+
+static void run_all_at_once(const char *path, result_t *r) {
+    int64_t t0 = now_ns();
+    dirlist_t *l = dirlist_create();
+    DIR *d = opendir(path);
+    while (dirlist_read(l, d, SIZE_MAX)) {
+    }
+    closedir(d);
+    dirlist_commit(l);
+    const dirlist_entry_t *const *view;
+    r->entries = dirlist_view(l, &view);
+    r->first_ns = r->total_ns = now_ns() - t0;
+    r->publishes = 1;
+    dirlist_destroy(l);
+}
+
+static void run_streamed(const char *path, result_t *r) {
+    int64_t t0 = now_ns();
+    dirlist_t *l = dirlist_create();
+    const dirlist_entry_t **shown = NULL;
+    r->first_ns = 0;
+    r->publishes = 0;
+    DIR *d = opendir(path);
+    for (size_t batch = DIRLIST_FIRST_BATCH;; batch = batch * 2 > DIRLIST_MAX_BATCH ? DIRLIST_MAX_BATCH : batch * 2) {
+        size_t n = dirlist_read(l, d, batch);
+        if (!n) break;
+        dirlist_commit(l);
+        const dirlist_entry_t *const *view;
+        size_t count = dirlist_view(l, &view);
+        shown = realloc(shown, count * sizeof(*shown));
+        memcpy(shown, view, count * sizeof(*shown));
+        r->publishes++;
+        if (!r->first_ns) r->first_ns = now_ns() - t0;
+        r->entries = count;
+    }
+    closedir(d);
+    r->total_ns = now_ns() - t0;
+    free(shown);
+    dirlist_destroy(l);
+}
+
+static void best_of(void (*fn)(const char *, result_t *), const char *path, result_t *best) {
+    for (int i = 0; i < RUNS; i++) {
+        result_t r = { 0 };
+        fn(path, &r);
+        if (i == 0 || r.first_ns < best->first_ns) best->first_ns = r.first_ns;
+        if (i == 0 || r.total_ns < best->total_ns) best->total_ns = r.total_ns;
+        best->publishes = r.publishes;
+        best->entries = r.entries;
+    }
+}
+
+static void bench_ops(const char *path) {
+    dirlist_t *l = dirlist_create();
+    DIR *d = opendir(path);
+    while (dirlist_read(l, d, SIZE_MAX)) {
+    }
+    closedir(d);
+    dirlist_commit(l);
+
+    const dirlist_entry_t *const *view;
+    int64_t t0 = now_ns();
+    dirlist_set_order(l, DIRLIST_ORDER_TYPE);
+    int64_t t1 = now_ns();
+    dirlist_set_filter(l, "jpg,jpeg,png");
+    size_t images = dirlist_view(l, &view);
+    int64_t t2 = now_ns();
+    dirlist_set_filter(l, NULL);
+    dirlist_set_order(l, DIRLIST_ORDER_NAME);
+    printf("  re-sort by type %.2f ms, image filter %.2f ms (%zu of %zu shown)\n", ms(t1 - t0), ms(t2 - t1), images,
+           dirlist_count(l));
+    dirlist_destroy(l);
+}
+
+int main(int argc, char **argv) {
+    const char *base = argc > 1 ? argv[1] : "/tmp/dirlist_bench";
+    static const int sizes[] = { 100, 1000, 10000 };
+    char path[256];
+
+    printf("%-8s %-14s %12s %12s %10s\n", "entries", "listing", "first entry", "complete", "publishes");
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if (make_dir(base, sizes[i], path, sizeof(path)) != 0) {
+            perror(base);
+            return 1;
+        }
+        result_t once = { 0 }, streamed = { 0 };
+        best_of(run_all_at_once, path, &once);
+        best_of(run_streamed, path, &streamed);
+        printf("%-8zu %-14s %9.3f ms %9.3f ms %10zu\n", once.entries, "all at once", ms(once.first_ns),
+               ms(once.total_ns), once.publishes);
+        printf("%-8zu %-14s %9.3f ms %9.3f ms %10zu\n", streamed.entries, "streamed", ms(streamed.first_ns),
+               ms(streamed.total_ns), streamed.publishes);
+        bench_ops(path);
+    }
+    return 0;
+}
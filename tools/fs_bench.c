@@ -0,0 +1,341 @@
+/*
+ * Host benchmark for the read-ahead block cache behind the "S:" LVGL drive
+ * (components/ui_apps/src/ui_rafs_core.c).
+ *
+ * Runs the core over a POSIX backend whose reads cost what an SD card
+ * would: a fixed latency per read (command, FAT lookup) plus transfer
+ * time at a set bandwidth, slept with the lock released. A pthread plays
+ * the read-ahead worker. Compares:
+ *   - stdio: LVGL's per-file cache as CONFIG_LV_FS_STDIO_CACHE_SIZE=8192
+ *     set it up: a miss reads the 8 KB from the position on, a read
+ *     larger than the cache goes straight to the file;
+ *   - S: without read-ahead, and S: with the Kconfig defaults
+ *     (4 x 16 KB, read-ahead 2);
+ * over sequential and random reads, and a sequential reader that spends
+ * time on each chunk as a decoder would, which read-ahead overlaps. Every
+ * byte read is checked against the file. Also opens the file twice to show
+ * the second handle sharing the first one's blocks.
+ *
+ * Build and run:
+ *   cc -O2 -pthread -Icomponents/ui_apps/src tools/fs_bench.c \
+ *      components/ui_apps/src/ui_rafs_core.c -o fs_bench
+ *   ./fs_bench [latency-us] [MB/s]     (default 400 us, 16 MB/s)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "ui_rafs_core.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define FILE_PATH   "/tmp/fs_bench.bin"
+#define FILE_SIZE   (4 * 1024 * 1024)
+#define RANDOM_READS 256
+#define DECODE_NS_PER_KB 60000      // ~16 MB/s of "decoding" in the consumer pattern
+
+static uint32_t latency_us = 400;
+static double bandwidth_mb = 16;
+
+static int64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void sleep_ns(int64_t ns) {
+    struct timespec ts = { ns / 1000000000LL, ns % 1000000000LL };
+    nanosleep(&ts, NULL);
+}
+
+static void spin_ns(int64_t ns) {
+    int64_t end = now_ns() + ns;
+    while (now_ns() < end) {
+    }
+}
+
+static uint8_t byte_at(uint32_t off) {
+    return (uint8_t)(off * 31u >> 7 ^ off >> 13);
+}
+
+// --- Backend: POSIX files with a simulated SD cost ---
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t ready;
+    pthread_cond_t kick;
+    bool kicked, stop;
+    rafs_t *fs;
+} host_t;
+
+static void *be_open(void *ctx, const char *path, uint32_t *size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    fstat(fd, &st);
+    *size = (uint32_t)st.st_size;
+    return (void *)(intptr_t)(fd + 1);
+}
+
+// One transfer at a time, as on the SD bus
+static int be_pread(void *ctx, void *h, void *buf, uint32_t len, uint32_t off) {
+    static pthread_mutex_t card = PTHREAD_MUTEX_INITIALIZER;
+    pthread_mutex_lock(&card);
+    sleep_ns(latency_us * 1000LL + (int64_t)(len / (bandwidth_mb * 1024 * 1024) * 1e9));
+    int r = (int)pread((int)(intptr_t)h - 1, buf, len, off);
+    pthread_mutex_unlock(&card);
+    return r;
+}
+
+static void be_close(void *ctx, void *h) {
+    close((int)(intptr_t)h - 1);
+}
+
+static void *be_alloc(void *ctx, size_t size) {
+    return aligned_alloc(64, size);
+}
+
+static void be_free(void *ctx, void *p) {
+    free(p);
+}
+
+static void be_lock(void *ctx) {
+    pthread_mutex_lock(&((host_t *)ctx)->mutex);
+}
+
+static void be_unlock(void *ctx) {
+    pthread_mutex_unlock(&((host_t *)ctx)->mutex);
+}
+
+static void be_wait(void *ctx) {
+    host_t *h = ctx;
+    pthread_cond_wait(&h->ready, &h->mutex);
+}
+
+static void be_signal(void *ctx) {
+    pthread_cond_broadcast(&((host_t *)ctx)->ready);
+}
+
+// Called with the core's lock held, which is this mutex
+static void be_kick(void *ctx) {
+    host_t *h = ctx;
+    h->kicked = true;
+    pthread_cond_signal(&h->kick);
+}
+
+static void *worker_fn(void *arg) {
+    host_t *h = arg;
+    pthread_mutex_lock(&h->mutex);
+    while (!h->stop) {
+        if (!h->kicked) {
+            pthread_cond_wait(&h->kick, &h->mutex);
+            continue;
+        }
+        h->kicked = false;
+        pthread_mutex_unlock(&h->mutex);
+        while (rafs_service(h->fs)) {
+        }
+        pthread_mutex_lock(&h->mutex);
+    }
+    pthread_mutex_unlock(&h->mutex);
+    return NULL;
+}
+
+// --- Runs ---
+
+typedef struct {
+    const char *name;
+    rafs_config_t cfg;
+} config_t;
+
+typedef struct {
+    const char *name;
+    uint32_t chunk;
+    bool random;
+    bool decode;                // Spend DECODE_NS_PER_KB on each chunk after reading it
+} pattern_t;
+
+static const config_t configs[] = {
+    { "S: no ahead", { 16 * 1024, 4, 0 } },
+    { "S:", { 16 * 1024, 4, 2 } },
+};
+
+#define STDIO_CACHE 8192
+
+static const pattern_t patterns[] = {
+    { "seq 4K", 4096, false, false },
+    { "seq 32K", 32768, false, false },
+    { "rand 4K", 4096, true, false },
+    { "seq 4K + decode", 4096, false, true },
+};
+
+static int make_file(void) {
+    struct stat st;
+    if (stat(FILE_PATH, &st) == 0 && st.st_size == FILE_SIZE) return 0;
+    FILE *f = fopen(FILE_PATH, "wb");
+    if (!f) return -1;
+    for (uint32_t off = 0; off < FILE_SIZE; off++) fputc(byte_at(off), f);
+    return fclose(f);
+}
+
+static uint32_t next_offset(uint32_t *seed, uint32_t chunk) {
+    *seed = *seed * 1103515245u + 12345u;
+    return (*seed >> 8) % (FILE_SIZE / chunk) * chunk;
+}
+
+static bool check(const uint8_t *buf, uint32_t off, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++) {
+        if (buf[i] != byte_at(off + i)) {
+            fprintf(stderr, "mismatch at %u\n", off + i);
+            return false;
+        }
+    }
+    return true;
+}
+
+// LVGL's lv_fs cache over the same card
+typedef struct {
+    void *h;
+    uint32_t pos, start, end;   // Cached [start, end)
+    uint8_t buf[STDIO_CACHE];
+} stdio_file_t;
+
+static int stdio_read(stdio_file_t *f, uint8_t *out, uint32_t len) {
+    if (f->pos >= f->start && f->pos + len <= f->end) {
+        memcpy(out, f->buf + (f->pos - f->start), len);
+    } else if (len > STDIO_CACHE) {
+        if (be_pread(NULL, f->h, out, len, f->pos) != (int)len) return -1;
+    } else {
+        int r = be_pread(NULL, f->h, f->buf, STDIO_CACHE, f->pos);
+        if (r < (int)len) return -1;
+        f->start = f->pos;
+        f->end = f->pos + (uint32_t)r;
+        memcpy(out, f->buf, len);
+    }
+    f->pos += len;
+    return (int)len;
+}
+
+static double run_stdio(const pattern_t *p, uint8_t *buf) {
+    uint32_t size;
+    stdio_file_t *f = calloc(1, sizeof(stdio_file_t));
+    f->h = be_open(NULL, FILE_PATH, &size);
+    uint32_t seed = 1, reads = p->random ? RANDOM_READS : FILE_SIZE / p->chunk;
+    bool ok = f->h != NULL;
+    int64_t t0 = now_ns();
+    for (uint32_t i = 0; i < reads && ok; i++) {
+        if (p->random) f->pos = next_offset(&seed, p->chunk);
+        uint32_t off = f->pos;
+        ok = stdio_read(f, buf, p->chunk) == (int)p->chunk && check(buf, off, p->chunk);
+        if (p->decode) spin_ns((int64_t)p->chunk / 1024 * DECODE_NS_PER_KB);
+    }
+    int64_t ns = now_ns() - t0;
+    if (f->h) be_close(NULL, f->h);
+    free(f);
+    return ok ? (double)reads * p->chunk / (1024 * 1024) / (ns / 1e9) : -1;
+}
+
+// MB/s, < 0 on a read error or bad data
+static double run(rafs_t *fs, const pattern_t *p, uint8_t *buf) {
+    rafs_file_t *f = rafs_open(fs, FILE_PATH);
+    if (!f) return -1;
+    uint32_t seed = 1, reads = p->random ? RANDOM_READS : FILE_SIZE / p->chunk;
+    bool ok = true;
+    int64_t t0 = now_ns();
+    for (uint32_t i = 0; i < reads && ok; i++) {
+        if (p->random) rafs_seek(f, next_offset(&seed, p->chunk));
+        uint32_t off = rafs_tell(f);
+        ok = rafs_read(f, buf, p->chunk) == (int)p->chunk && check(buf, off, p->chunk);
+        if (p->decode) spin_ns((int64_t)p->chunk / 1024 * DECODE_NS_PER_KB);
+    }
+    int64_t ns = now_ns() - t0;
+    rafs_close(f);
+    return ok ? (double)reads * p->chunk / (1024 * 1024) / (ns / 1e9) : -1;
+}
+
+// Two handles on one file, the second half a block behind: its reads come from the first one's blocks
+static void shared(rafs_t *fs, uint8_t *buf) {
+    rafs_reset_stats(fs);
+    rafs_file_t *a = rafs_open(fs, FILE_PATH), *b = rafs_open(fs, FILE_PATH);
+    bool ok = a && b;
+    for (uint32_t off = 0; ok && off < 1024 * 1024; off += 4096) {
+        ok = rafs_read(a, buf, 4096) == 4096 && check(buf, off, 4096);
+        if (ok && off >= 8192) ok = rafs_read(b, buf, 4096) == 4096 && check(buf, off - 8192, 4096);
+    }
+    rafs_stats_t s;
+    rafs_get_stats(fs, &s);
+    printf("  two handles on one file: %s, %u opens (%u shared), %u file open, %llu KB read, %llu KB off the card\n",
+           ok ? "ok" : "FAILED", s.opens, s.shared_opens, s.open_files, (unsigned long long)(s.read_bytes / 1024),
+           (unsigned long long)(s.backend_bytes / 1024));
+    if (a) rafs_close(a);
+    if (b) rafs_close(b);
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) latency_us = (uint32_t)atoi(argv[1]);
+    if (argc > 2) bandwidth_mb = atof(argv[2]);
+    if (make_file() != 0) {
+        perror(FILE_PATH);
+        return 1;
+    }
+    uint8_t *buf = aligned_alloc(64, 32768);
+    printf("Simulated card: %u us per read + %.0f MB/s; file %d MB\n", latency_us, bandwidth_mb,
+           FILE_SIZE / (1024 * 1024));
+    printf("%-16s %12s", "pattern", "stdio");
+    for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) printf(" %12s", configs[c].name);
+    printf("   (MB/s)\n");
+
+    host_t hosts[sizeof(configs) / sizeof(configs[0])];
+    pthread_t threads[sizeof(configs) / sizeof(configs[0])];
+    for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        host_t *h = &hosts[c];
+        memset(h, 0, sizeof(*h));
+        pthread_mutex_init(&h->mutex, NULL);
+        pthread_cond_init(&h->ready, NULL);
+        pthread_cond_init(&h->kick, NULL);
+        rafs_backend_t be = {
+            .open = be_open, .pread = be_pread, .close = be_close, .alloc = be_alloc, .free = be_free,
+            .lock = be_lock, .unlock = be_unlock, .wait = be_wait, .signal = be_signal, .kick = be_kick,
+            .ctx = h,
+        };
+        h->fs = rafs_create(&configs[c].cfg, &be);
+        pthread_create(&threads[c], NULL, worker_fn, h);
+    }
+
+    int rc = 0;
+    for (size_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); p++) {
+        double mbs = run_stdio(&patterns[p], buf);
+        if (mbs < 0) rc = 1;
+        printf("%-16s %12.2f", patterns[p].name, mbs);
+        for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+            mbs = run(hosts[c].fs, &patterns[p], buf);
+            if (mbs < 0) rc = 1;
+            printf(" %12.2f", mbs);
+        }
+        printf("\n");
+    }
+
+    host_t *h = &hosts[1];
+    rafs_stats_t s;
+    rafs_get_stats(h->fs, &s);
+    printf("  S: %llu KB from blocks, %llu KB direct, read-ahead %u blocks (%u used), %u waits\n",
+           (unsigned long long)(s.hit_bytes / 1024), (unsigned long long)(s.direct_bytes / 1024), s.ahead_loaded,
+           s.ahead_used, s.waits);
+    shared(h->fs, buf);
+
+    for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        pthread_mutex_lock(&hosts[c].mutex);
+        hosts[c].stop = true;
+        pthread_cond_signal(&hosts[c].kick);
+        pthread_mutex_unlock(&hosts[c].mutex);
+        pthread_join(threads[c], NULL);
+        rafs_destroy(hosts[c].fs);
+    }
+    free(buf);
+    return rc;
+}
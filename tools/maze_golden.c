@@ -0,0 +1,171 @@
+/*
+ * Host check of the maze display-list goldens (components/ui_apps/src/ui_maze_view.c).
+ *
+ * Runs the geometry half of the device render check (CONFIG_UI_MAZE_RENDER_CHECK)
+ * without a board: for each built-in level, builds the display list of every
+ * open cell, facing and throat flag, checks the R9C8-facing-North invariant
+ * and compares the folded hash with maze_view_golden_level; then walks the
+ * scripted route to the level's exit and compares the folded hash of its
+ * frames with maze_view_golden_route. The routes must reach their exits and
+ * differ from level to level. Every frame's display-list build must make no
+ * heap allocation and stay under HOST_MAX_BUILD_NS. Pixel hashes need
+ * LVGL's rasterizer and are only checked on the device.
+ *
+ * Build and run (the --wrap flags let the tool count allocations):
+ *   cc -O2 -Wall -Icomponents/ui_apps/src tools/maze_golden.c \
+ *      components/ui_apps/src/ui_maze_view.c -lm \
+ *      -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc -o maze_golden
+ *   ./maze_golden       (exit status 0 if every check passed; on a golden
+ *                        mismatch it prints the tables to paste)
+ */
+
+#include "ui_maze_view.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Per-frame build budget on the host. The build takes well under a
+// microsecond; this only catches an accidental change of complexity.
+#define HOST_MAX_BUILD_NS   20000
+
+// --- Heap allocations made by ui_maze_view.c ---
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *p, size_t size);
+
+static unsigned allocs = 0;
+
+void *__wrap_malloc(size_t size) {
+    allocs++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+    allocs++;
+    return __real_calloc(n, size);
+}
+
+void *__wrap_realloc(void *p, size_t size) {
+    allocs++;
+    return __real_realloc(p, size);
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t level_hash(int lvl, unsigned *poses, unsigned *broken) {
+    const uint32_t *rows = maze_view_builtin[lvl];
+    uint32_t h = 2166136261u;
+    for (int r = 0; r < 32; r++) {
+        for (int c = 0; c < 32; c++) {
+            if (maze_view_wall_at(rows, r, c)) continue;
+            for (int f = 0; f < 4; f++) {
+                for (int s = 0; s < 2; s++) {
+                    maze_pose_t pose = { .level = lvl, .row = r, .col = c, .facing = f, .suppress_throat_horiz = s };
+                    maze_view_t view;
+                    maze_view_build(rows, &pose, &view);
+                    if (!maze_view_check_r9c8n(&pose, &view)) (*broken)++;
+                    h = maze_view_fold(h, maze_view_hash(&view));
+                    (*poses)++;
+                }
+            }
+        }
+    }
+    return h;
+}
+
+typedef struct {
+    unsigned frames;
+    unsigned max_allocs;        // Heap allocations in one frame's build
+    uint64_t max_build_ns;
+    bool reached_exit;
+    int exit_row, exit_col;
+} route_stats_t;
+
+static uint32_t route_hash(int lvl, route_stats_t *st) {
+    const uint32_t *rows = maze_view_builtin[lvl];
+    uint32_t h = 2166136261u;
+    maze_pose_t pose;
+    maze_view_route_start(lvl, &pose);
+    for (int step = 0; step < MAZE_VIEW_ROUTE_STEPS; step++) {
+        maze_view_t view;
+        unsigned before = allocs;
+        uint64_t t0 = now_ns();
+        maze_view_build(rows, &pose, &view);
+        uint64_t ns = now_ns() - t0;
+        if (allocs - before > st->max_allocs) st->max_allocs = allocs - before;
+        if (ns > st->max_build_ns) st->max_build_ns = ns;
+        h = maze_view_fold(h, maze_view_hash(&view));
+        st->frames++;
+        if (!maze_view_route_next(rows, &pose)) break;
+    }
+    st->reached_exit = maze_view_route_done(&pose);
+    st->exit_row = pose.row;
+    st->exit_col = pose.col;
+    return h;
+}
+
+static void print_table(const char *name, const uint32_t *v) {
+    printf("const uint32_t %s[MAZE_VIEW_LEVELS] = {\n   ", name);
+    for (int i = 0; i < MAZE_VIEW_LEVELS; i++) printf(" 0x%08lx,", (unsigned long)v[i]);
+    printf("\n};\n");
+}
+
+int main(void) {
+    uint32_t levels[MAZE_VIEW_LEVELS], routes[MAZE_VIEW_LEVELS];
+    int failures = 0, golden_failures = 0;
+
+    for (int lvl = 0; lvl < MAZE_VIEW_LEVELS; lvl++) {
+        unsigned poses = 0, broken = 0;
+        route_stats_t st = { 0 };
+        levels[lvl] = level_hash(lvl, &poses, &broken);
+        routes[lvl] = route_hash(lvl, &st);
+
+        bool level_ok = levels[lvl] == maze_view_golden_level[lvl];
+        bool route_ok = routes[lvl] == maze_view_golden_route[lvl];
+        printf("Level %d: %u poses, hash 0x%08lx %s; route %u frames to exit R%dC%d, hash 0x%08lx %s, "
+               "build max %llu ns, %u allocs/frame\n",
+               lvl + 1, poses, (unsigned long)levels[lvl], level_ok ? "ok" : "FAIL",
+               st.frames, st.exit_row + 1, st.exit_col + 1, (unsigned long)routes[lvl], route_ok ? "ok" : "FAIL",
+               (unsigned long long)st.max_build_ns, st.max_allocs);
+        failures += !level_ok + !route_ok;
+        golden_failures += !level_ok + !route_ok;
+
+        if (broken) {
+            printf("FAIL level %d: R9C8N invariant broken in %u pose(s)\n", lvl + 1, broken);
+            failures++;
+        }
+        if (!st.reached_exit) {
+            printf("FAIL level %d: route stops at R%dC%d, not an exit, after %u frames\n",
+                   lvl + 1, st.exit_row + 1, st.exit_col + 1, st.frames);
+            failures++;
+        }
+        if (st.max_allocs) {
+            printf("FAIL level %d: display-list build allocates (%u per frame)\n", lvl + 1, st.max_allocs);
+            failures++;
+        }
+        if (st.max_build_ns > HOST_MAX_BUILD_NS) {
+            printf("FAIL level %d: display-list build max %llu ns > %d ns\n",
+                   lvl + 1, (unsigned long long)st.max_build_ns, HOST_MAX_BUILD_NS);
+            failures++;
+        }
+        for (int prev = 0; prev < lvl; prev++) {
+            if (routes[prev] == routes[lvl]) {
+                printf("FAIL levels %d and %d: same route hash, the routes do not tell them apart\n",
+                       prev + 1, lvl + 1);
+                failures++;
+            }
+        }
+    }
+
+    if (golden_failures) {
+        printf("\nIf the geometry change is intended, paste into ui_maze_view.c:\n");
+        print_table("maze_view_golden_level", levels);
+        print_table("maze_view_golden_route", routes);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""Build the ui_apps asset pack from assets/manifest.json.
+
+The pack is flashed to the start of the `storage` partition and
+memory-mapped by components/ui_apps/src/ui_assets.c. Layout (little-endian):
+
+    header  32 bytes   magic "UIAP", version, count, index offset, pack size,
+                       CRC-32 of the index, 3 reserved words
+    index   48 bytes   per entry: name (40 bytes, NUL padded), offset, size
+    data               entries, each starting on a 16-byte boundary
+
+Entry types in the manifest:
+    levels  maze text file ('#' wall, '.' floor, 32 columns per row; the
+            leftmost column is bit 31) packed as uint32 rows
+    raw     file copied as is
+
+Usage (the build runs this when CONFIG_UI_ASSET_PACK is set):
+    tools/mkassets.py assets/manifest.json build/assets.bin
+"""
+
+import argparse
+import binascii
+import json
+import os
+import struct
+import sys
+
+PACK_MAGIC = 0x50414955  # "UIAP"
+PACK_VERSION = 1
+HEADER_FMT = "<IHHIII12x"
+ENTRY_FMT = "<40sII"
+NAME_LEN = 40
+ALIGN = 16
+
+
+def align(n):
+    return (n + ALIGN - 1) & ~(ALIGN - 1)
+
+
+def build_levels(entry, base):
+    rows = []
+    with open(os.path.join(base, entry["src"])) as f:
+        for n, line in enumerate(f, 1):
+            line = line.rstrip("\n")
+            if len(line) == 32 and set(line) <= {"#", "."}:
+                rows.append(int(line.replace("#", "1").replace(".", "0"), 2))
+            elif line.strip() and not line.startswith("#"):
+                sys.exit(f"mkassets: {entry['src']}:{n}: expected 32 '#'/'.' columns")
+    if len(rows) % 32:
+        sys.exit(f"mkassets: {entry['src']}: {len(rows)} rows, expected whole 32-row levels")
+    return struct.pack(f"<{len(rows)}I", *rows)
+
+
+def build_entry(entry, base):
+    kind = entry["type"]
+    if kind == "levels":
+        return build_levels(entry, base)
+    if kind == "raw":
+        with open(os.path.join(base, entry["src"]), "rb") as f:
+            return f.read()
+    sys.exit(f"mkassets: {entry['name']}: unknown type {kind}")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("manifest")
+    ap.add_argument("output")
+    ap.add_argument("--max-size", type=lambda s: int(s, 0), help="fail if the pack is larger")
+    args = ap.parse_args()
+
+    base = os.path.dirname(os.path.abspath(args.manifest))
+    with open(args.manifest) as f:
+        manifest = json.load(f)
+    entries = manifest["entries"]
+
+    names = set()
+    for e in entries:
+        name = e["name"].encode()
+        if len(name) >= NAME_LEN or name in names:
+            sys.exit(f"mkassets: {e['name']}: name too long or duplicated")
+        names.add(name)
+
+    index_offset = struct.calcsize(HEADER_FMT)
+    offset = align(index_offset + len(entries) * struct.calcsize(ENTRY_FMT))
+    index = bytearray()
+    data = bytearray()
+    for e in entries:
+        blob = build_entry(e, base)
+        pad = offset - (align(index_offset + len(entries) * struct.calcsize(ENTRY_FMT)) + len(data))
+        data += b"\0" * pad
+        index += struct.pack(ENTRY_FMT, e["name"].encode(), offset, len(blob))
+        data += blob
+        print(f"  {e['name']:<{NAME_LEN}} {len(blob):>8} bytes")
+        offset = align(offset + len(blob))
+
+    body = index.ljust(align(index_offset + len(index)) - index_offset, b"\0") + data
+    size = index_offset + len(body)
+    header = struct.pack(HEADER_FMT, PACK_MAGIC, PACK_VERSION, len(entries), index_offset, size,
+                         binascii.crc32(index) & 0xFFFFFFFF)
+    if args.max_size is not None and size > args.max_size:
+        sys.exit(f"mkassets: pack is {size} bytes, only {args.max_size} available")
+
+    with open(args.output, "wb") as f:
+        f.write(header + body)
+    print(f"mkassets: {len(entries)} entries, {size} bytes -> {args.output}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,643 @@
+/*
+ * Delta OTA patches for the ui_apps firmware, and a host run of the
+ * device-side patcher (components/ui_apps/src/ui_delta_core.c).
+ *
+ *   ota_delta diff OLD.bin NEW.bin PATCH      build a patch
+ *   ota_delta apply OLD.bin PATCH OUT.bin     apply it as the device would
+ *   ota_delta sim OLD.bin NEW.bin [PATCH] [wifi-KB/s] [flash-KB/s]
+ *
+ * The diff is bsdiff's: a Larsson-Sadakane suffix array of the old image,
+ * then the new image is walked for the longest matches, extended forwards
+ * and backwards while at least half the bytes agree (C. Percival, "Naive
+ * differences of executable code"). Records are written interleaved (see
+ * ui_delta_core.h) and the body is zlib-compressed, so the device can apply
+ * it in one pass with a fixed amount of RAM.
+ *
+ * sim serves the full image and the patch from a local HTTP server
+ * throttled to the given Wi-Fi rate (default 150 KB/s, about what HTTPS OTA
+ * reaches on the S3), then runs a full update and a delta update into a
+ * scratch "slot" file written at the given flash rate (default 400 KB/s),
+ * checking SHA-256 of the old image before patching and of the result
+ * after. Patches up to PATCH_BUFFER_MAX are downloaded whole before
+ * patching, larger ones are applied as they stream in. Prints bytes
+ * transferred, radio time (first to last byte received) and update time
+ * for both. Both write the whole new image to flash, so flash rate sets
+ * the floor of the update time.
+ *
+ * Build:
+ *   cc -O2 -pthread -Icomponents/ui_apps/src tools/ota_delta.c \
+ *      components/ui_apps/src/ui_delta_core.c -lz -lcrypto -o ota_delta
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "ui_delta_core.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <openssl/evp.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#define NET_CHUNK   4096            // Server send and client receive size
+#define SLOT_PATH   "/tmp/ota_delta_slot.bin"
+#define PATCH_BUFFER_MAX (256 * 1024)   // Patches up to this are downloaded before patching, as on the device
+
+typedef struct {
+    uint8_t *data;
+    size_t len, cap;
+} buf_t;
+
+static int64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void sleep_until(int64_t t_us) {
+    int64_t d = t_us - now_us();
+    if (d <= 0) return;
+    struct timespec ts = { d / 1000000, d % 1000000 * 1000 };
+    nanosleep(&ts, NULL);
+}
+
+static void sha256(const void *data, size_t len, uint8_t out[32]) {
+    EVP_Digest(data, len, out, NULL, EVP_sha256(), NULL);
+}
+
+static bool load(const char *path, buf_t *b) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    b->len = b->cap = (size_t)ftell(f);
+    fseek(f, 0, SEEK_SET);
+    b->data = malloc(b->len + 1);
+    bool ok = b->data && fread(b->data, 1, b->len, f) == b->len;
+    fclose(f);
+    return ok;
+}
+
+static bool save(const char *path, const uint8_t *data, size_t len) {
+    FILE *f = fopen(path, "wb");
+    bool ok = f && fwrite(data, 1, len, f) == len;
+    if (f && fclose(f) != 0) ok = false;
+    if (!ok) perror(path);
+    return ok;
+}
+
+static void put(buf_t *b, const void *data, size_t len) {
+    if (b->len + len > b->cap) {
+        b->cap = (b->len + len) * 2;
+        b->data = realloc(b->data, b->cap);
+    }
+    memcpy(b->data + b->len, data, len);
+    b->len += len;
+}
+
+// --- Suffix array (Larsson-Sadakane) ---
+
+static void split(int64_t *I, int64_t *V, int64_t start, int64_t len, int64_t h) {
+    int64_t i, j, k, x, tmp;
+    if (len < 16) {
+        for (k = start; k < start + len; k += j) {
+            j = 1;
+            x = V[I[k] + h];
+            for (i = 1; k + i < start + len; i++) {
+                if (V[I[k + i] + h] < x) {
+                    x = V[I[k + i] + h];
+                    j = 0;
+                }
+                if (V[I[k + i] + h] == x) {
+                    tmp = I[k + j];
+                    I[k + j] = I[k + i];
+                    I[k + i] = tmp;
+                    j++;
+                }
+            }
+            for (i = 0; i < j; i++) V[I[k + i]] = k + j - 1;
+            if (j == 1) I[k] = -1;
+        }
+        return;
+    }
+
+    x = V[I[start + len / 2] + h];
+    int64_t jj = 0, kk = 0;
+    for (i = start; i < start + len; i++) {
+        if (V[I[i] + h] < x) jj++;
+        if (V[I[i] + h] == x) kk++;
+    }
+    jj += start;
+    kk += jj;
+
+    i = start;
+    j = 0;
+    k = 0;
+    while (i < jj) {
+        if (V[I[i] + h] < x) {
+            i++;
+        } else if (V[I[i] + h] == x) {
+            tmp = I[i];
+            I[i] = I[jj + j];
+            I[jj + j] = tmp;
+            j++;
+        } else {
+            tmp = I[i];
+            I[i] = I[kk + k];
+            I[kk + k] = tmp;
+            k++;
+        }
+    }
+    while (jj + j < kk) {
+        if (V[I[jj + j] + h] == x) {
+            j++;
+        } else {
+            tmp = I[jj + j];
+            I[jj + j] = I[kk + k];
+            I[kk + k] = tmp;
+            k++;
+        }
+    }
+
+    if (jj > start) split(I, V, start, jj - start, h);
+    for (i = 0; i < kk - jj; i++) V[I[jj + i]] = kk - 1;
+    if (jj == kk - 1) I[jj] = -1;
+    if (start + len > kk) split(I, V, kk, start + len - kk, h);
+}
+
+static void suffix_sort(int64_t *I, int64_t *V, const uint8_t *old, int64_t n) {
+    int64_t buckets[256] = { 0 };
+    for (int64_t i = 0; i < n; i++) buckets[old[i]]++;
+    for (int i = 1; i < 256; i++) buckets[i] += buckets[i - 1];
+    for (int i = 255; i > 0; i--) buckets[i] = buckets[i - 1];
+    buckets[0] = 0;
+
+    for (int64_t i = 0; i < n; i++) I[++buckets[old[i]]] = i;
+    I[0] = n;
+    for (int64_t i = 0; i < n; i++) V[i] = buckets[old[i]];
+    V[n] = 0;
+    for (int i = 1; i < 256; i++) {
+        if (buckets[i] == buckets[i - 1] + 1) I[buckets[i]] = -1;
+    }
+    I[0] = -1;
+
+    for (int64_t h = 1; I[0] != -(n + 1); h += h) {
+        int64_t len = 0, i = 0;
+        while (i < n + 1) {
+            if (I[i] < 0) {
+                len -= I[i];
+                i -= I[i];
+            } else {
+                if (len) I[i - len] = -len;
+                len = V[I[i]] + 1 - i;
+                split(I, V, i, len, h);
+                i += len;
+                len = 0;
+            }
+        }
+        if (len) I[i - len] = -len;
+    }
+    for (int64_t i = 0; i < n + 1; i++) I[V[i]] = i;
+}
+
+static int64_t match_len(const uint8_t *a, int64_t alen, const uint8_t *b, int64_t blen) {
+    int64_t i = 0;
+    while (i < alen && i < blen && a[i] == b[i]) i++;
+    return i;
+}
+
+// Longest match of nw in old, by binary search of the suffix array between st and en
+static int64_t search(const int64_t *I, const uint8_t *old, int64_t oldsize, const uint8_t *nw, int64_t nwsize,
+                      int64_t st, int64_t en, int64_t *pos) {
+    while (en - st >= 2) {
+        int64_t x = st + (en - st) / 2;
+        int64_t n = oldsize - I[x] < nwsize ? oldsize - I[x] : nwsize;
+        if (memcmp(old + I[x], nw, (size_t)n) < 0) {
+            st = x;
+        } else {
+            en = x;
+        }
+    }
+    int64_t x = match_len(old + I[st], oldsize - I[st], nw, nwsize);
+    int64_t y = match_len(old + I[en], oldsize - I[en], nw, nwsize);
+    *pos = x > y ? I[st] : I[en];
+    return x > y ? x : y;
+}
+
+// --- diff ---
+
+static void put_record(buf_t *body, const uint8_t *old, int64_t oldpos, const uint8_t *nw, int64_t nwpos,
+                       int64_t diff_len, int64_t extra_len, int64_t seek) {
+    uint8_t v[30];
+    size_t n = delta_put_varint(v, (uint64_t)diff_len);
+    n += delta_put_varint(v + n, (uint64_t)extra_len);
+    n += delta_put_varint(v + n, (uint64_t)(seek << 1) ^ (uint64_t)(seek >> 63));
+    put(body, v, n);
+    for (int64_t i = 0; i < diff_len; i++) {
+        uint8_t d = (uint8_t)(nw[nwpos + i] - old[oldpos + i]);
+        put(body, &d, 1);
+    }
+    put(body, nw + nwpos + diff_len, (size_t)extra_len);
+}
+
+static void make_body(const buf_t *old_b, const buf_t *new_b, buf_t *body) {
+    const uint8_t *old = old_b->data, *nw = new_b->data;
+    int64_t oldsize = (int64_t)old_b->len, nwsize = (int64_t)new_b->len;
+    int64_t *I = malloc((size_t)(oldsize + 1) * sizeof(int64_t));
+    int64_t *V = malloc((size_t)(oldsize + 1) * sizeof(int64_t));
+    suffix_sort(I, V, old, oldsize);
+    free(V);
+
+    int64_t scan = 0, len = 0, pos = 0, lastscan = 0, lastpos = 0, lastoffset = 0;
+    while (scan < nwsize) {
+        int64_t oldscore = 0;
+        int64_t scsc = scan += len;
+        for (; scan < nwsize; scan++) {
+            len = search(I, old, oldsize, nw + scan, nwsize - scan, 0, oldsize, &pos);
+            for (; scsc < scan + len; scsc++) {
+                if (scsc + lastoffset < oldsize && old[scsc + lastoffset] == nw[scsc]) oldscore++;
+            }
+            if ((len == oldscore && len != 0) || len > oldscore + 8) break;
+            if (scan + lastoffset < oldsize && old[scan + lastoffset] == nw[scan]) oldscore--;
+        }
+        if (len == oldscore && scan != nwsize) continue;
+
+        // Extend the previous match forwards and this one backwards while half the bytes agree
+        int64_t s = 0, best = 0, lenf = 0;
+        for (int64_t i = 0; lastscan + i < scan && lastpos + i < oldsize;) {
+            if (old[lastpos + i] == nw[lastscan + i]) s++;
+            i++;
+            if (s * 2 - i > best * 2 - lenf) {
+                best = s;
+                lenf = i;
+            }
+        }
+        int64_t lenb = 0;
+        if (scan < nwsize) {
+            s = 0;
+            best = 0;
+            for (int64_t i = 1; scan >= lastscan + i && pos >= i; i++) {
+                if (old[pos - i] == nw[scan - i]) s++;
+                if (s * 2 - i > best * 2 - lenb) {
+                    best = s;
+                    lenb = i;
+                }
+            }
+        }
+        if (lastscan + lenf > scan - lenb) {
+            int64_t overlap = (lastscan + lenf) - (scan - lenb), lens = 0;
+            s = 0;
+            best = 0;
+            for (int64_t i = 0; i < overlap; i++) {
+                if (nw[lastscan + lenf - overlap + i] == old[lastpos + lenf - overlap + i]) s++;
+                if (nw[scan - lenb + i] == old[pos - lenb + i]) s--;
+                if (s > best) {
+                    best = s;
+                    lens = i + 1;
+                }
+            }
+            lenf += lens - overlap;
+            lenb -= lens;
+        }
+
+        put_record(body, old, lastpos, nw, lastscan, lenf, (scan - lenb) - (lastscan + lenf),
+                   (pos - lenb) - (lastpos + lenf));
+        lastscan = scan - lenb;
+        lastpos = pos - lenb;
+        lastoffset = pos - scan;
+    }
+    free(I);
+}
+
+static bool make_patch(const buf_t *old, const buf_t *nw, buf_t *patch) {
+    buf_t body = { 0 };
+    make_body(old, nw, &body);
+
+    uLongf zlen = compressBound(body.len);
+    patch->data = malloc(DELTA_HDR_SIZE + zlen);
+    if (compress2(patch->data + DELTA_HDR_SIZE, &zlen, body.data, body.len, 9) != Z_OK) return false;
+    delta_hdr_t hdr = { .old_size = (uint32_t)old->len, .new_size = (uint32_t)nw->len, .body_size = (uint32_t)zlen };
+    sha256(old->data, old->len, hdr.old_sha256);
+    sha256(nw->data, nw->len, hdr.new_sha256);
+    delta_write_header(&hdr, patch->data);
+    patch->len = patch->cap = DELTA_HDR_SIZE + zlen;
+    printf("patch: %zu bytes (%zu uncompressed) for a %zu byte image, %.1f%%\n", patch->len, body.len, nw->len,
+           100.0 * patch->len / nw->len);
+    free(body.data);
+    return true;
+}
+
+// --- Patcher, as on the device ---
+
+typedef struct {
+    const buf_t *old;           // Running slot
+    FILE *slot;                 // Slot being written
+    EVP_MD_CTX *sha;
+    uint32_t flash_kbs;
+    int64_t flash_until;        // Simulated flash busy until
+} slot_t;
+
+static bool slot_write(slot_t *s, const void *buf, uint32_t len) {
+    EVP_DigestUpdate(s->sha, buf, len);
+    if (s->flash_kbs) {
+        int64_t start = s->flash_until > now_us() ? s->flash_until : now_us();
+        s->flash_until = start + (int64_t)len * 1000000 / (s->flash_kbs * 1024);
+        sleep_until(s->flash_until);
+    }
+    return fwrite(buf, 1, len, s->slot) == len;
+}
+
+static bool io_read_old(void *ctx, uint32_t off, void *buf, uint32_t len) {
+    const slot_t *s = ctx;
+    if (off + (uint64_t)len > s->old->len) return false;
+    memcpy(buf, s->old->data + off, len);
+    return true;
+}
+
+static bool io_write_new(void *ctx, const void *buf, uint32_t len) {
+    return slot_write(ctx, buf, len);
+}
+
+typedef size_t (*source_fn_t)(void *src, uint8_t *buf, size_t len);
+
+static size_t read_fully(source_fn_t read, void *src, uint8_t *buf, size_t len) {
+    size_t got = 0;
+    while (got < len) {
+        size_t n = read(src, buf + got, len - got);
+        if (!n) break;
+        got += n;
+    }
+    return got;
+}
+
+// Streams a patch from @p read into the slot; returns an error string or NULL
+static const char *apply_stream(source_fn_t read, void *src, slot_t *s, size_t *peak_ram) {
+    uint8_t hdr_buf[DELTA_HDR_SIZE];
+    delta_hdr_t hdr;
+    if (read_fully(read, src, hdr_buf, sizeof(hdr_buf)) != sizeof(hdr_buf) ||
+        delta_parse_header(hdr_buf, &hdr) != DELTA_OK) {
+        return "not a patch";
+    }
+    uint8_t sha[32];
+    if (hdr.old_size != s->old->len) return "patch is for another build (size)";
+    sha256(s->old->data, s->old->len, sha);
+    if (memcmp(sha, hdr.old_sha256, 32) != 0) return "patch is for another build (SHA-256)";
+
+    delta_io_t io = { .read_old = io_read_old, .write_new = io_write_new, .ctx = s };
+    delta_t *d = delta_create(&hdr, &io);
+    z_stream z = { 0 };
+    inflateInit(&z);
+    static uint8_t in[NET_CHUNK], out[NET_CHUNK];
+    const char *err = NULL;
+    uint32_t left = hdr.body_size;
+    int zr = Z_OK;
+    while (!err && left && zr != Z_STREAM_END) {
+        size_t n = read(src, in, left < sizeof(in) ? left : sizeof(in));
+        if (!n) {
+            err = "patch truncated";
+            break;
+        }
+        left -= (uint32_t)n;
+        z.next_in = in;
+        z.avail_in = (uInt)n;
+        while (z.avail_in && zr != Z_STREAM_END && !err) {
+            z.next_out = out;
+            z.avail_out = sizeof(out);
+            zr = inflate(&z, Z_NO_FLUSH);
+            if (zr != Z_OK && zr != Z_STREAM_END) err = "corrupt patch body";
+            else if (delta_feed(d, out, sizeof(out) - z.avail_out) != DELTA_OK) err = "bad patch record";
+        }
+    }
+    if (!err && delta_finish(d) != DELTA_OK) err = "patch ended early";
+    EVP_DigestFinal_ex(s->sha, sha, NULL);
+    if (!err && memcmp(sha, hdr.new_sha256, 32) != 0) err = "result does not match (SHA-256)";
+    // delta_t holds DELTA_OUT_BUF + DELTA_OLD_BUF and a little state; zlib its 32 KB window and ~7 KB
+    *peak_ram = DELTA_OUT_BUF + DELTA_OLD_BUF + 256 + (32 * 1024 + 7 * 1024) + sizeof(in) + sizeof(out);
+    inflateEnd(&z);
+    delta_destroy(d);
+    return err;
+}
+
+typedef struct {
+    const buf_t *b;
+    size_t pos;
+} mem_src_t;
+
+static size_t mem_read(void *src, uint8_t *buf, size_t len) {
+    mem_src_t *m = src;
+    size_t n = m->b->len - m->pos < len ? m->b->len - m->pos : len;
+    memcpy(buf, m->b->data + m->pos, n);
+    m->pos += n;
+    return n;
+}
+
+// --- Local update server ---
+
+typedef struct {
+    int listen_fd;
+    uint16_t port;
+    const buf_t *full, *patch;
+    uint32_t wifi_kbs;
+} server_t;
+
+static void *server_fn(void *arg) {
+    server_t *sv = arg;
+    for (;;) {
+        int fd = accept(sv->listen_fd, NULL, NULL);
+        if (fd < 0) break;
+        char req[512];
+        ssize_t n = recv(fd, req, sizeof(req) - 1, 0);
+        req[n > 0 ? n : 0] = '\0';
+        const buf_t *b = strncmp(req, "GET /patch ", 11) == 0 ? sv->patch : strncmp(req, "GET /full ", 10) == 0 ? sv->full : NULL;
+        char hdr[128];
+        int hl = b ? snprintf(hdr, sizeof(hdr), "HTTP/1.1 200 OK\r\nContent-Length: %zu\r\nConnection: close\r\n\r\n", b->len)
+                   : snprintf(hdr, sizeof(hdr), "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n");
+        send(fd, hdr, (size_t)hl, 0);
+        int64_t t0 = now_us();
+        for (size_t off = 0; b && off < b->len; off += NET_CHUNK) {
+            size_t len = b->len - off < NET_CHUNK ? b->len - off : NET_CHUNK;
+            if (send(fd, b->data + off, len, 0) != (ssize_t)len) break;
+            sleep_until(t0 + (int64_t)(off + len) * 1000000 / (sv->wifi_kbs * 1024));
+        }
+        close(fd);
+    }
+    return NULL;
+}
+
+typedef struct {
+    int fd;
+    size_t received;            // Body bytes
+    int64_t first_us, last_us;  // Radio on: first to last body byte
+} http_src_t;
+
+static size_t http_read(void *src, uint8_t *buf, size_t len) {
+    http_src_t *h = src;
+    ssize_t n = recv(h->fd, buf, len, 0);
+    if (n <= 0) return 0;
+    h->last_us = now_us();
+    if (!h->received) h->first_us = h->last_us;
+    h->received += (size_t)n;
+    return (size_t)n;
+}
+
+// Returns Content-Length, or -1
+static long http_get(http_src_t *h, uint16_t port, const char *path) {
+    h->fd = socket(AF_INET, SOCK_STREAM, 0);
+    h->received = 0;
+    h->first_us = h->last_us = 0;
+    struct sockaddr_in a = { .sin_family = AF_INET, .sin_port = htons(port), .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+    if (connect(h->fd, (struct sockaddr *)&a, sizeof(a)) != 0) return -1;
+    char req[128];
+    int n = snprintf(req, sizeof(req), "GET %s HTTP/1.1\r\nHost: localhost\r\n\r\n", path);
+    send(h->fd, req, (size_t)n, 0);
+
+    // Headers a byte at a time so no body byte is consumed here
+    char line[256];
+    size_t ll = 0;
+    long length = -1;
+    bool ok = false;
+    for (;;) {
+        char c;
+        if (recv(h->fd, &c, 1, 0) != 1) return -1;
+        if (c != '\n') {
+            if (ll < sizeof(line) - 1) line[ll++] = c;
+            continue;
+        }
+        line[ll && line[ll - 1] == '\r' ? ll - 1 : ll] = '\0';
+        if (line[0] == '\0') break;
+        if (strncmp(line, "HTTP/1.1 200", 12) == 0) ok = true;
+        if (strncmp(line, "Content-Length:", 15) == 0) length = atol(line + 15);
+        ll = 0;
+    }
+    return ok ? length : -1;
+}
+
+static int sim(const buf_t *old, const buf_t *nw, const buf_t *patch, uint32_t wifi_kbs, uint32_t flash_kbs) {
+    server_t sv = { .full = nw, .patch = patch, .wifi_kbs = wifi_kbs };
+    sv.listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in a = { .sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+    socklen_t al = sizeof(a);
+    if (bind(sv.listen_fd, (struct sockaddr *)&a, sizeof(a)) != 0 || listen(sv.listen_fd, 4) != 0 ||
+        getsockname(sv.listen_fd, (struct sockaddr *)&a, &al) != 0) {
+        perror("server");
+        return 1;
+    }
+    sv.port = ntohs(a.sin_port);
+    pthread_t th;
+    pthread_create(&th, NULL, server_fn, &sv);
+    printf("update server on 127.0.0.1:%u, Wi-Fi %u KB/s, flash writes %u KB/s\n", sv.port, wifi_kbs, flash_kbs);
+
+    // Full: body straight to the slot
+    http_src_t h;
+    slot_t s = { .old = old, .flash_kbs = flash_kbs };
+    int64_t t0 = now_us();
+    long len = http_get(&h, sv.port, "/full");
+    s.slot = fopen(SLOT_PATH, "wb");
+    s.sha = EVP_MD_CTX_new();
+    EVP_DigestInit_ex(s.sha, EVP_sha256(), NULL);
+    static uint8_t chunk[NET_CHUNK];
+    size_t n;
+    while (len > 0 && (n = http_read(&h, chunk, sizeof(chunk))) > 0) slot_write(&s, chunk, (uint32_t)n);
+    close(h.fd);
+    fclose(s.slot);
+    uint8_t sha[32], want[32];
+    EVP_DigestFinal_ex(s.sha, sha, NULL);
+    EVP_MD_CTX_free(s.sha);
+    sha256(nw->data, nw->len, want);
+    int64_t full_us = now_us() - t0, full_radio_us = h.last_us - h.first_us;
+    size_t full_bytes = h.received;
+    bool full_ok = len == (long)nw->len && full_bytes == nw->len && memcmp(sha, want, 32) == 0;
+
+    // Delta: patch streamed through inflate and the patcher into the slot
+    slot_t d = { .old = old, .flash_kbs = flash_kbs };
+    size_t peak = 0;
+    t0 = now_us();
+    len = http_get(&h, sv.port, "/patch");
+    d.slot = fopen(SLOT_PATH, "wb");
+    d.sha = EVP_MD_CTX_new();
+    EVP_DigestInit_ex(d.sha, EVP_sha256(), NULL);
+    const char *err = NULL;
+    if (len <= 0) {
+        err = "download failed";
+    } else if (len <= PATCH_BUFFER_MAX) {
+        // Small patch: fetch it whole so the radio can idle while flash is written
+        buf_t whole = { .data = malloc((size_t)len), .len = (size_t)len };
+        if (read_fully(http_read, &h, whole.data, whole.len) != whole.len) err = "download failed";
+        close(h.fd);
+        h.fd = -1;
+        mem_src_t m = { &whole, 0 };
+        if (!err) err = apply_stream(mem_read, &m, &d, &peak);
+        peak += whole.len;
+        free(whole.data);
+    } else {
+        err = apply_stream(http_read, &h, &d, &peak);
+    }
+    if (h.fd >= 0) close(h.fd);
+    fclose(d.slot);
+    EVP_MD_CTX_free(d.sha);
+    int64_t delta_us = now_us() - t0, delta_radio_us = h.last_us - h.first_us;
+
+    printf("%-6s %12s %10s %10s  %s\n", "update", "transferred", "radio", "total", "result");
+    printf("%-6s %12zu %8.2f s %8.2f s  %s\n", "full", full_bytes, full_radio_us / 1e6, full_us / 1e6,
+           full_ok ? "SHA-256 ok" : "FAILED");
+    printf("%-6s %12zu %8.2f s %8.2f s  %s\n", "delta", h.received, delta_radio_us / 1e6, delta_us / 1e6,
+           err ? err : "SHA-256 ok");
+    printf("delta: %.1f%% of the bytes, %.1f%% of the radio time, %.1f%% of the update time; patcher RAM about %zu KB\n",
+           100.0 * h.received / full_bytes, 100.0 * delta_radio_us / full_radio_us, 100.0 * delta_us / full_us,
+           peak / 1024);
+
+    shutdown(sv.listen_fd, SHUT_RDWR);
+    close(sv.listen_fd);
+    pthread_join(th, NULL);
+    unlink(SLOT_PATH);
+    return full_ok && !err ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+    buf_t old = { 0 }, nw = { 0 }, patch = { 0 };
+    int rc = 2;
+    if (argc == 5 && strcmp(argv[1], "diff") == 0) {
+        rc = load(argv[2], &old) && load(argv[3], &nw) && make_patch(&old, &nw, &patch) &&
+                     save(argv[4], patch.data, patch.len) ? 0 : 1;
+    } else if (argc == 5 && strcmp(argv[1], "apply") == 0) {
+        slot_t s = { .old = &old };
+        rc = 1;
+        if (load(argv[2], &old) && load(argv[3], &patch) && (s.slot = fopen(argv[4], "wb")) != NULL) {
+            s.sha = EVP_MD_CTX_new();
+            EVP_DigestInit_ex(s.sha, EVP_sha256(), NULL);
+            mem_src_t m = { &patch, 0 };
+            size_t peak;
+            const char *err = apply_stream(mem_read, &m, &s, &peak);
+            fclose(s.slot);
+            EVP_MD_CTX_free(s.sha);
+            printf("%s\n", err ? err : "ok, SHA-256 matches");
+            rc = err ? 1 : 0;
+        } else if (old.data && patch.data) {
+            perror(argv[4]);
+        }
+    } else if (argc >= 4 && strcmp(argv[1], "sim") == 0) {
+        int arg = 4;
+        rc = 1;
+        if (load(argv[2], &old) && load(argv[3], &nw)) {
+            // A third file name is a prebuilt patch; numbers are rates
+            bool ok = argc > arg && atoi(argv[arg]) == 0 ? load(argv[arg++], &patch) : make_patch(&old, &nw, &patch);
+            uint32_t wifi = argc > arg ? (uint32_t)atoi(argv[arg]) : 150;
+            uint32_t flash = argc > arg + 1 ? (uint32_t)atoi(argv[arg + 1]) : 400;
+            if (ok) rc = sim(&old, &nw, &patch, wifi, flash);
+        }
+    } else {
+        fprintf(stderr, "usage: %s diff OLD NEW PATCH | apply OLD PATCH OUT | sim OLD NEW [PATCH] [wifi-KB/s] [flash-KB/s]\n",
+                argv[0]);
+    }
+    free(old.data);
+    free(nw.data);
+    free(patch.data);
+    return rc;
+}
@@ -0,0 +1,559 @@
+/*
+ * Host benchmark for live scores: Server-Sent Events against polling
+ * (components/ui_apps/src/ui_scores_core.c over ui_http_core.c).
+ *
+ * A local HTTP server stands in for the scores service. It plays a
+ * scripted match day - six matches, goals at random (fixed seed) times -
+ * on a simulated clock running SIM_SPEED times faster than real time, and
+ * serves it two ways:
+ *   /scores            the current matches, for polling (keep-alive);
+ *   /stream?hb=<s>     an event stream (chunked) that sends each goal as it
+ *                      happens, a ": ping" keep-alive every <s> seconds, and
+ *                      replays what was missed when a client reconnects
+ *                      with Last-Event-ID.
+ * Twice during the run it drops every stream connection, and for eight
+ * minutes it answers /stream with 503, so the clients' reconnect, resume
+ * and polling fallback are part of what is measured.
+ *
+ * Clients (run side by side against the same match day):
+ *   - poll 30 s / poll 10 s: what an auto-refreshing app does;
+ *   - stream, with keep-alives every 15 s and every 60 s.
+ * For each, on the simulated clock and scaled to one hour: goal-to-screen
+ * latency (from the goal until the client's model shows it), radio-on time
+ * and wake-ups under the radio_model_t tail, bytes received, connections
+ * and requests. The last column checks that the final model matches the
+ * server and that no goal was skipped.
+ *
+ * Times below ~20 ms are host scheduling and loopback stretched by
+ * SIM_SPEED; on the device a stream adds the network's one-way delay.
+ *
+ * Build and run:
+ *   cc -O2 -pthread -Icomponents/ui_apps/src tools/sse_bench.c \
+ *      components/ui_apps/src/ui_scores_core.c components/ui_apps/src/ui_sse_core.c \
+ *      components/ui_apps/src/ui_http_core.c -o sse_bench
+ *   ./sse_bench [minutes]     (simulated, default 60)
+ */
+
+#define _GNU_SOURCE
+#include "ui_scores_core.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SIM_SPEED       200                 // Simulated seconds per real second
+#define MATCHES         6
+#define MAX_GOALS       64
+#define RADIO_TAIL_MS   100
+#define SERVER_RETRY_MS 3000
+
+static const char *teams[MATCHES][2] = {
+    { "Ajax", "PSV" }, { "Celtic", "Rangers" }, { "Porto", "Benfica" },
+    { "Lazio", "Roma" }, { "Boca", "River" }, { "Inter", "Milan" },
+};
+
+static uint64_t mono_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+static uint64_t t0_real;
+
+static uint64_t sim_us(void) {
+    return (mono_us() - t0_real) * SIM_SPEED;
+}
+
+static void sleep_until_sim(uint64_t sim) {
+    uint64_t real = t0_real + sim / SIM_SPEED;
+    uint64_t now = mono_us();
+    if (real > now) usleep((useconds_t)(real - now));
+}
+
+// --- Match day ---
+
+typedef struct {
+    uint64_t t_us;                  // Simulated
+    uint8_t match, home, away;      // Score after the goal
+} goal_t;
+
+static goal_t goals[MAX_GOALS];
+static int goal_count;
+static uint64_t duration_us, drop_at[2], outage_from, outage_to;
+
+static int cmp_goal(const void *a, const void *b) {
+    const goal_t *x = a, *y = b;
+    return x->t_us < y->t_us ? -1 : x->t_us > y->t_us;
+}
+
+static void script(void) {
+    srand(1);
+    uint8_t home[MATCHES] = { 0 }, away[MATCHES] = { 0 };
+    goal_count = 0;
+    for (int m = 0; m < MATCHES; m++) {
+        int n = rand() % 6;
+        for (int g = 0; g < n && goal_count < MAX_GOALS; g++) {
+            goals[goal_count].t_us = (uint64_t)(rand() % 1000) * duration_us / 1000;
+            goals[goal_count].match = (uint8_t)m;
+            goal_count++;
+        }
+    }
+    qsort(goals, (size_t)goal_count, sizeof(goals[0]), cmp_goal);
+    for (int i = 0; i < goal_count; i++) {
+        int m = goals[i].match;
+        if (rand() % 2) {
+            home[m]++;
+        } else {
+            away[m]++;
+        }
+        goals[i].home = home[m];
+        goals[i].away = away[m];
+    }
+    drop_at[0] = duration_us * 25 / 100;
+    drop_at[1] = duration_us * 45 / 100;
+    outage_from = duration_us * 60 / 100;
+    outage_to = outage_from + 8 * 60 * 1000000ULL;
+}
+
+// --- Server ---
+
+static pthread_mutex_t srv_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t srv_cond;     // On CLOCK_MONOTONIC, set up in main()
+static int published;               // Goals that have happened; the last event ID
+static int drop_gen;
+static bool srv_stop;
+static int srv_port;
+
+static void clock_str(char *out, size_t cap, uint64_t t_us) {
+    uint64_t min = t_us / 60000000 + 1;
+    snprintf(out, cap, "%llu'", (unsigned long long)(min > 90 ? 90 : min));
+}
+
+// Current state of match m after the first n goals
+static void match_state(int m, int n, uint8_t *home, uint8_t *away, uint64_t *ts) {
+    *home = *away = 0;
+    *ts = 0;
+    for (int i = 0; i < n; i++) {
+        if (goals[i].match != m) continue;
+        *home = goals[i].home;
+        *away = goals[i].away;
+        *ts = goals[i].t_us / 1000;
+    }
+}
+
+static size_t snapshot(char *buf, size_t cap, int n) {
+    size_t len = 0;
+    for (int m = 0; m < MATCHES; m++) {
+        uint8_t h, a;
+        uint64_t ts;
+        char clk[8];
+        match_state(m, n, &h, &a, &ts);
+        clock_str(clk, sizeof(clk), sim_us());
+        len += (size_t)snprintf(buf + len, cap - len, "id: %d\nevent: match\ndata: %d|%s|%s|%u|%u|%s|%llu\n\n", n,
+                                m + 1, teams[m][0], teams[m][1], h, a, clk, (unsigned long long)ts);
+    }
+    return len;
+}
+
+static bool send_all(int fd, const char *s, size_t n) {
+    while (n) {
+        ssize_t w = send(fd, s, n, MSG_NOSIGNAL);
+        if (w <= 0) return false;
+        s += w;
+        n -= (size_t)w;
+    }
+    return true;
+}
+
+static bool send_chunk(int fd, const char *s, size_t n) {
+    char hdr[16];
+    int hl = snprintf(hdr, sizeof(hdr), "%zx\r\n", n);
+    return send_all(fd, hdr, (size_t)hl) && send_all(fd, s, n) && send_all(fd, "\r\n", 2);
+}
+
+static bool outage(void) {
+    uint64_t now = sim_us();
+    return now >= outage_from && now < outage_to;
+}
+
+// Until the client goes, the server drops it, or the run ends
+static void serve_stream(int fd, int last_id, uint32_t hb_s) {
+    static const char head[] = "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\n"
+                               "Transfer-Encoding: chunked\r\n\r\n";
+    char buf[4096];
+    if (!send_all(fd, head, sizeof(head) - 1)) return;
+    int len = snprintf(buf, sizeof(buf), "retry: %d\n\n", SERVER_RETRY_MS);
+    if (!send_chunk(fd, buf, (size_t)len)) return;
+
+    pthread_mutex_lock(&srv_mutex);
+    int cursor = published, gen = drop_gen;
+    pthread_mutex_unlock(&srv_mutex);
+    if (last_id < 0 || last_id > cursor) {
+        // Nothing to resume from: start over with the current matches
+        size_t n = (size_t)snprintf(buf, sizeof(buf), "event: reset\ndata:\n\n");
+        n += snapshot(buf + n, sizeof(buf) - n, cursor);
+        if (!send_chunk(fd, buf, n)) return;
+    } else {
+        cursor = last_id;           // Replay what was missed below
+    }
+
+    uint64_t next_hb = sim_us() + (uint64_t)hb_s * 1000000;
+    for (;;) {
+        pthread_mutex_lock(&srv_mutex);
+        while (published == cursor && drop_gen == gen && !srv_stop && sim_us() < next_hb) {
+            uint64_t real = t0_real + next_hb / SIM_SPEED;
+            struct timespec ts = { (time_t)(real / 1000000), (long)(real % 1000000) * 1000 };
+            pthread_cond_timedwait(&srv_cond, &srv_mutex, &ts);
+        }
+        int upto = published;
+        bool drop = drop_gen != gen || srv_stop;
+        pthread_mutex_unlock(&srv_mutex);
+        if (drop) return;           // Abrupt close: no terminating chunk
+
+        size_t n = 0;
+        for (; cursor < upto && n < sizeof(buf) - 128; cursor++) {
+            const goal_t *g = &goals[cursor];
+            char clk[8];
+            clock_str(clk, sizeof(clk), g->t_us);
+            n += (size_t)snprintf(buf + n, sizeof(buf) - n, "id: %d\nevent: score\ndata: %d|%u|%u|%s|%llu\n\n",
+                                  cursor + 1, g->match + 1, g->home, g->away, clk,
+                                  (unsigned long long)(g->t_us / 1000));
+        }
+        if (!n && sim_us() >= next_hb) n = (size_t)snprintf(buf, sizeof(buf), ": ping\n");
+        if (n) {
+            if (!send_chunk(fd, buf, n)) return;
+            next_hb = sim_us() + (uint64_t)hb_s * 1000000;
+        }
+    }
+}
+
+static void *server_conn_fn(void *arg) {
+    int fd = (int)(intptr_t)arg;
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    char req[2048];
+    size_t have = 0;
+    for (;;) {
+        ssize_t n = recv(fd, req + have, sizeof(req) - 1 - have, 0);
+        if (n <= 0) break;
+        have += (size_t)n;
+        req[have] = '\0';
+        char *end = strstr(req, "\r\n\r\n");
+        if (!end) continue;
+        *end = '\0';
+
+        const char *lei = strcasestr(req, "\r\nLast-Event-ID:");
+        int last_id = lei ? atoi(lei + 16) : -1;
+        if (strncmp(req, "GET /stream", 11) == 0) {
+            const char *hb = strstr(req, "hb=");
+            if (outage()) {
+                static const char busy[] = "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n";
+                if (!send_all(fd, busy, sizeof(busy) - 1)) break;
+            } else {
+                serve_stream(fd, last_id, hb ? (uint32_t)atoi(hb + 3) : 15);
+                break;
+            }
+        } else {
+            char body[2048], head[128];
+            pthread_mutex_lock(&srv_mutex);
+            int n_pub = published;
+            pthread_mutex_unlock(&srv_mutex);
+            size_t bl = snapshot(body, sizeof(body), n_pub);
+            int hl = snprintf(head, sizeof(head), "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\n"
+                              "Content-Length: %zu\r\n\r\n", bl);
+            if (!send_all(fd, head, (size_t)hl) || !send_all(fd, body, bl)) break;
+        }
+        size_t used = (size_t)(end + 4 - req);
+        memmove(req, req + used, have - used);
+        have -= used;
+    }
+    close(fd);
+    return NULL;
+}
+
+static void *server_accept_fn(void *arg) {
+    int lfd = (int)(intptr_t)arg;
+    for (;;) {
+        int fd = accept(lfd, NULL, NULL);
+        if (fd < 0) continue;
+        pthread_t t;
+        pthread_create(&t, NULL, server_conn_fn, (void *)(intptr_t)fd);
+        pthread_detach(t);
+    }
+    return NULL;
+}
+
+// Publishes the goals, the drops and the start of the outage at their times
+static void *publisher_fn(void *arg) {
+    uint64_t drops[3] = { drop_at[0], drop_at[1], outage_from };
+    int g = 0, d = 0;
+    while (g < goal_count || d < 3) {
+        bool goal_next = g < goal_count && (d == 3 || goals[g].t_us <= drops[d]);
+        sleep_until_sim(goal_next ? goals[g].t_us : drops[d]);
+        pthread_mutex_lock(&srv_mutex);
+        if (goal_next) {
+            published = ++g;
+        } else {
+            drop_gen++;
+            d++;
+        }
+        pthread_cond_broadcast(&srv_cond);
+        pthread_mutex_unlock(&srv_mutex);
+    }
+    return NULL;
+}
+
+static void server_start(void) {
+    int lfd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(lfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+    bind(lfd, (struct sockaddr *)&addr, sizeof(addr));
+    socklen_t alen = sizeof(addr);
+    getsockname(lfd, (struct sockaddr *)&addr, &alen);
+    srv_port = ntohs(addr.sin_port);
+    listen(lfd, 64);
+    pthread_t t;
+    pthread_create(&t, NULL, server_accept_fn, (void *)(intptr_t)lfd);
+    pthread_detach(t);
+}
+
+// --- Client backend: plain TCP on the simulated clock ---
+
+typedef struct {
+    const char *name;
+    bool stream;
+    uint32_t poll_s, hb_s;
+    // Results
+    scores_t model;
+    uint64_t reached_us[MATCHES][2 * MAX_GOALS + 1];    // When the model first showed n goals
+    uint32_t connections;
+    http_pool_t *pool;
+    live_t live;
+    pthread_mutex_t mutex;
+    pthread_t thread;
+} client_t;
+
+static volatile bool clients_stop;
+
+static void *be_connect(void *ctx, const char *host, uint16_t port, bool tls, const uint8_t *session,
+                        size_t session_len, bool *resumed) {
+    client_t *c = ctx;
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_port = htons(port),
+                                .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+    if (tls || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return NULL;
+    }
+    c->connections++;
+    return (void *)(intptr_t)(fd + 1);
+}
+
+static int be_send(void *ctx, void *conn, const void *buf, size_t len) {
+    return (int)send((int)(intptr_t)conn - 1, buf, len, MSG_NOSIGNAL);
+}
+
+static int be_recv(void *ctx, void *conn, void *buf, size_t len, uint32_t timeout_ms) {
+    struct pollfd p = { .fd = (int)(intptr_t)conn - 1, .events = POLLIN };
+    int real_ms = (int)(timeout_ms / SIM_SPEED) + 1;
+    if (poll(&p, 1, real_ms) <= 0) return -1;
+    return (int)recv(p.fd, buf, len, 0);
+}
+
+static size_t be_save_session(void *ctx, void *conn, uint8_t *buf, size_t cap) {
+    return 0;
+}
+
+static void be_close(void *ctx, void *conn) {
+    close((int)(intptr_t)conn - 1);
+}
+
+static void be_lock(void *ctx) {
+    pthread_mutex_lock(&((client_t *)ctx)->mutex);
+}
+
+static void be_unlock(void *ctx) {
+    pthread_mutex_unlock(&((client_t *)ctx)->mutex);
+}
+
+static uint64_t be_now_us(void *ctx) {
+    return sim_us();
+}
+
+// --- live_io_t ---
+
+static http_err_t io_fetch(void *ctx, const char *url, const char *headers, bool stream, uint32_t idle_ms,
+                           http_body_cb_t on_body, void *arg, int *status) {
+    client_t *c = ctx;
+    http_result_t res;
+    http_err_t err = stream ? http_stream(c->pool, url, headers, idle_ms, on_body, arg, &res)
+                            : http_get(c->pool, url, headers, on_body, arg, &res);
+    *status = res.status;
+    return err;
+}
+
+static void io_event(void *ctx, const sse_event_t *ev) {
+    client_t *c = ctx;
+    int old[SCORES_MAX] = { 0 };
+    for (int i = 0; i < c->model.count; i++) old[i] = c->model.match[i].home_goals + c->model.match[i].away_goals;
+    uint8_t old_count = c->model.count;
+    int i = scores_apply(&c->model, ev);
+    if (i < 0) return;
+    const score_match_t *m = &c->model.match[i];
+    int now = m->home_goals + m->away_goals;
+    int before = i < old_count ? old[i] : 0;
+    for (int g = before + 1; g <= now && m->id >= 1 && m->id <= MATCHES; g++) {
+        if (!c->reached_us[m->id - 1][g]) c->reached_us[m->id - 1][g] = sim_us();
+    }
+}
+
+static bool io_stopping(void *ctx) {
+    return clients_stop;
+}
+
+static uint64_t io_now_us(void *ctx) {
+    return sim_us();
+}
+
+// --- Runs ---
+
+static client_t clients[] = {
+    { .name = "poll 30 s", .poll_s = 30 },
+    { .name = "poll 10 s", .poll_s = 10 },
+    { .name = "stream 15 s", .stream = true, .poll_s = 30, .hb_s = 15 },
+    { .name = "stream 60 s", .stream = true, .poll_s = 30, .hb_s = 60 },
+};
+
+static void *client_fn(void *arg) {
+    client_t *c = arg;
+    char stream_url[64], poll_url[64];
+    snprintf(stream_url, sizeof(stream_url), "http://127.0.0.1:%d/stream?hb=%u", srv_port, c->hb_s);
+    snprintf(poll_url, sizeof(poll_url), "http://127.0.0.1:%d/scores", srv_port);
+
+    pthread_mutex_init(&c->mutex, NULL);
+    http_pool_config_t pcfg = { .slots = 1, .sessions = 0, .idle_ms = 20000, .timeout_ms = 10000 };
+    http_backend_t be = {
+        .connect = be_connect,
+        .send = be_send,
+        .recv = be_recv,
+        .save_session = be_save_session,
+        .close = be_close,
+        .lock = be_lock,
+        .unlock = be_unlock,
+        .now_us = be_now_us,
+        .ctx = c,
+    };
+    c->pool = http_pool_create(&pcfg, &be);
+    live_config_t cfg = {
+        .stream_url = stream_url,
+        .poll_url = poll_url,
+        .poll_ms = c->poll_s * 1000,
+        .idle_ms = c->hb_s * 1000 * 3 / 2 + 5000,
+        .retry_ms = 1000,
+        .retry_max_ms = 60000,
+        .stream_retry_ms = 5 * 60 * 1000,
+    };
+    live_io_t io = { .fetch = io_fetch, .on_event = io_event, .stopping = io_stopping, .now_us = io_now_us, .ctx = c };
+    live_init(&c->live, &cfg, &io, RADIO_TAIL_MS);
+    if (!c->stream) {
+        c->live.mode = LIVE_POLL;           // And never back
+        c->live.cfg.stream_retry_ms = UINT32_MAX;
+    }
+    while (!clients_stop) {
+        uint32_t ms = live_step(&c->live);
+        if (ms) sleep_until_sim(sim_us() + (uint64_t)ms * 1000);
+    }
+    http_pool_destroy(c->pool);
+    return NULL;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void report(client_t *c) {
+    uint64_t lat[MAX_GOALS], sum = 0;
+    int n = 0, missing = 0;
+    for (int i = 0; i < goal_count; i++) {
+        const goal_t *g = &goals[i];
+        uint64_t at = c->reached_us[g->match][g->home + g->away];
+        if (!at) {
+            missing++;
+            continue;
+        }
+        lat[n] = at > g->t_us ? at - g->t_us : 0;
+        sum += lat[n++];
+    }
+    qsort(lat, (size_t)n, sizeof(lat[0]), cmp_u64);
+
+    bool same = c->model.count == MATCHES;
+    for (int m = 0; m < c->model.count; m++) {
+        uint8_t h, a;
+        uint64_t ts;
+        const score_match_t *sm = &c->model.match[m];
+        match_state(sm->id - 1, goal_count, &h, &a, &ts);
+        same = same && sm->home_goals == h && sm->away_goals == a;
+    }
+    double hours = duration_us / 3.6e9;
+    const live_stats_t *s = &c->live.stats;
+    printf("%-12s %6.2f %6.2f %6.2f %8.1f %7.0f %7.1f %6.0f %7.0f  %s\n", c->name,
+           n ? sum / 1e6 / n : 0.0, n ? lat[n / 2] / 1e6 : 0.0,
+           n ? lat[n - 1] / 1e6 : 0.0, c->live.radio.on_us / 1e6 / hours, c->live.radio.wakeups / hours,
+           s->bytes / 1024.0 / hours, c->connections / hours, (s->connects + s->polls) / hours,
+           same && !missing ? "ok" : "MISMATCH");
+    if (c->stream) {
+        printf("%12s %u streams (%u resumed with Last-Event-ID), %u dropped, %u failed, %u fallbacks to "
+               "polling, %u polls\n", "", s->connects, s->resumes, s->drops, s->failures, s->fallbacks, s->polls);
+    }
+}
+
+int main(int argc, char **argv) {
+    int minutes = argc > 1 ? atoi(argv[1]) : 60;
+    if (minutes < 20) minutes = 20;         // Room for the drops and the outage
+    duration_us = (uint64_t)minutes * 60 * 1000000;
+    script();
+
+    pthread_condattr_t ca;
+    pthread_condattr_init(&ca);
+    pthread_condattr_setclock(&ca, CLOCK_MONOTONIC);
+    pthread_cond_init(&srv_cond, &ca);
+
+    t0_real = mono_us();
+    server_start();
+    pthread_t pub;
+    pthread_create(&pub, NULL, publisher_fn, NULL);
+    size_t nc = sizeof(clients) / sizeof(clients[0]);
+    for (size_t i = 0; i < nc; i++) pthread_create(&clients[i].thread, NULL, client_fn, &clients[i]);
+
+    pthread_join(pub, NULL);
+    sleep_until_sim(duration_us);
+    clients_stop = true;
+    pthread_mutex_lock(&srv_mutex);
+    srv_stop = true;
+    pthread_cond_broadcast(&srv_cond);
+    pthread_mutex_unlock(&srv_mutex);
+    for (size_t i = 0; i < nc; i++) pthread_join(clients[i].thread, NULL);
+
+    printf("%d simulated minutes, %d goals in %d matches; streams dropped at %llu and %llu min, "
+           "503 from %llu to %llu min\n", minutes, goal_count, MATCHES,
+           (unsigned long long)(drop_at[0] / 60000000), (unsigned long long)(drop_at[1] / 60000000),
+           (unsigned long long)(outage_from / 60000000), (unsigned long long)(outage_to / 60000000));
+    printf("Goal-to-model latency (s), and per hour: radio-on (s) and wake-ups with a %d ms tail, KB received,\n"
+           "connections opened and requests\n", RADIO_TAIL_MS);
+    printf("%-12s %6s %6s %6s %8s %7s %7s %6s %7s  %s\n", "client", "avg", "median", "max", "radio s", "wakes",
+           "KB", "conns", "reqs", "state");
+    for (size_t i = 0; i < nc; i++) report(&clients[i]);
+    return 0;
+}
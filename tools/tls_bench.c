@@ -0,0 +1,501 @@
+/*
+ * Host benchmark for the pooled HTTPS client behind ui_net
+ * (components/ui_apps/src/ui_http_core.c).
+ *
+ * Starts two local TLS servers standing in for the weather and sports
+ * APIs, each with its own self-signed P-256 certificate, ticket keys and
+ * session cache, speaking HTTP/1.1 keep-alive (one answers with
+ * Content-Length, the other chunked). The client runs the core over
+ * OpenSSL, limited to TLS 1.2 like the device's mbedTLS, and verifies the
+ * server certificate on every full handshake.
+ *
+ * A refresh is what the apps would fetch together: current weather and
+ * forecast from one host, scores from the other. Refreshes are 10 minutes
+ * apart on a simulated clock, so pooled connections have expired by the
+ * next one. Five setups:
+ *   - fresh:  a new connection and full handshake per request (what an
+ *             esp_http_client per fetch does);
+ *   - pool:   keep-alive pool, no session cache;
+ *   - resume: pool and session cache;
+ *   - reboot: as resume, but the client restarts before every refresh
+ *             and only has the sessions it persisted (NVS on the device);
+ *   - 1 slot: as reboot with one pooled connection (the Kconfig default),
+ *             so a new host's connection replaces the idle one.
+ * For each, per refresh: handshakes (full/resumed), requests on pooled
+ * connections, client CPU time, wall time, the peak of the client's
+ * OpenSSL heap during the refresh and what the pool keeps allocated until
+ * its idle connections expire, plus session writes to the persistent store.
+ *
+ * Build and run:
+ *   cc -O2 -pthread -Icomponents/ui_apps/src tools/tls_bench.c \
+ *      components/ui_apps/src/ui_http_core.c -lssl -lcrypto -o tls_bench
+ *   ./tls_bench [refreshes]     (default 10)
+ */
+
+#define _GNU_SOURCE
+#include "ui_http_core.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define REFRESH_GAP_US  (600ULL * 1000000)  // Weather refresh period
+#define IDLE_MS         20000               // Pool idle limit (servers commonly keep 60 s)
+#define SERVER_IDLE_S   30
+#define STORE_MAX       8
+
+// --- OpenSSL heap of the client thread ---
+
+static _Thread_local bool track;
+static atomic_long heap_now, heap_peak;
+
+typedef struct {
+    size_t size;
+    bool tracked;
+    max_align_t align[];
+} mem_hdr_t;
+
+static void *mem_malloc(size_t n, const char *file, int line) {
+    mem_hdr_t *h = malloc(sizeof(mem_hdr_t) + n);
+    if (!h) return NULL;
+    h->size = n;
+    h->tracked = track;
+    if (track) {
+        long now = atomic_fetch_add(&heap_now, (long)n) + (long)n;
+        long peak = atomic_load(&heap_peak);
+        while (now > peak && !atomic_compare_exchange_weak(&heap_peak, &peak, now)) {
+        }
+    }
+    return h->align;
+}
+
+static void mem_free(void *p, const char *file, int line) {
+    if (!p) return;
+    mem_hdr_t *h = (mem_hdr_t *)((char *)p - offsetof(mem_hdr_t, align));
+    if (h->tracked) atomic_fetch_sub(&heap_now, (long)h->size);
+    free(h);
+}
+
+static void *mem_realloc(void *p, size_t n, const char *file, int line) {
+    if (!p) return mem_malloc(n, file, line);
+    mem_hdr_t *h = (mem_hdr_t *)((char *)p - offsetof(mem_hdr_t, align));
+    void *q = mem_malloc(n, file, line);
+    if (!q) return NULL;
+    memcpy(q, p, h->size < n ? h->size : n);
+    mem_free(p, file, line);
+    return q;
+}
+
+// --- Servers ---
+
+typedef struct {
+    const char *name;
+    bool chunked;
+    size_t body;                // Response size
+    int port;
+    int listen_fd;
+    SSL_CTX *ctx;
+    X509 *cert;
+} server_t;
+
+static server_t servers[] = {
+    { .name = "wx.local", .chunked = false, .body = 2600 },
+    { .name = "sports.local", .chunked = true, .body = 1400 },
+};
+
+static EVP_PKEY *make_key(void) {
+    return EVP_PKEY_Q_keygen(NULL, NULL, "EC", "P-256");
+}
+
+static X509 *make_cert(EVP_PKEY *key, const char *cn) {
+    X509 *x = X509_new();
+    X509_set_version(x, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(x), 1);
+    X509_gmtime_adj(X509_getm_notBefore(x), -3600);
+    X509_gmtime_adj(X509_getm_notAfter(x), 86400);
+    X509_set_pubkey(x, key);
+    X509_NAME *name = X509_get_subject_name(x);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, (const unsigned char *)cn, -1, -1, 0);
+    X509_set_issuer_name(x, name);
+    X509_sign(x, key, EVP_sha256());
+    return x;
+}
+
+typedef struct {
+    server_t *srv;
+    int fd;
+} conn_arg_t;
+
+static void *server_conn_fn(void *arg) {
+    conn_arg_t a = *(conn_arg_t *)arg;
+    free(arg);
+    struct timeval tv = { SERVER_IDLE_S, 0 };
+    setsockopt(a.fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    int one = 1;
+    setsockopt(a.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    SSL *ssl = SSL_new(a.srv->ctx);
+    SSL_set_fd(ssl, a.fd);
+    char *body = malloc(a.srv->body);
+    for (size_t i = 0; i < a.srv->body; i++) body[i] = "{\"temp\":21.5,\"wind\":3}"[i % 23];
+    if (SSL_accept(ssl) == 1) {
+        char req[2048];
+        size_t have = 0;
+        for (;;) {
+            int n = SSL_read(ssl, req + have, (int)(sizeof(req) - 1 - have));
+            if (n <= 0) break;
+            have += (size_t)n;
+            req[have] = '\0';
+            char *end = strstr(req, "\r\n\r\n");
+            if (!end) continue;
+            char hdr[256];
+            int hl;
+            if (a.srv->chunked) {
+                hl = snprintf(hdr, sizeof(hdr), "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                              "Transfer-Encoding: chunked\r\n\r\n");
+                SSL_write(ssl, hdr, hl);
+                // Two chunks and the terminator
+                size_t half = a.srv->body / 2;
+                for (int c = 0; c < 2; c++) {
+                    size_t len = c ? a.srv->body - half : half;
+                    hl = snprintf(hdr, sizeof(hdr), "%zx\r\n", len);
+                    SSL_write(ssl, hdr, hl);
+                    SSL_write(ssl, body + (c ? half : 0), (int)len);
+                    SSL_write(ssl, "\r\n", 2);
+                }
+                SSL_write(ssl, "0\r\n\r\n", 5);
+            } else {
+                hl = snprintf(hdr, sizeof(hdr), "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                              "Content-Length: %zu\r\nConnection: keep-alive\r\n\r\n", a.srv->body);
+                SSL_write(ssl, hdr, hl);
+                SSL_write(ssl, body, (int)a.srv->body);
+            }
+            size_t used = (size_t)(end + 4 - req);
+            memmove(req, req + used, have - used);
+            have -= used;
+        }
+    }
+    free(body);
+    SSL_shutdown(ssl);
+    SSL_free(ssl);
+    close(a.fd);
+    return NULL;
+}
+
+static void *server_accept_fn(void *arg) {
+    server_t *s = arg;
+    for (;;) {
+        int fd = accept(s->listen_fd, NULL, NULL);
+        if (fd < 0) continue;
+        conn_arg_t *a = malloc(sizeof(*a));
+        a->srv = s;
+        a->fd = fd;
+        pthread_t t;
+        pthread_create(&t, NULL, server_conn_fn, a);
+        pthread_detach(t);
+    }
+    return NULL;
+}
+
+static void server_start(server_t *s) {
+    EVP_PKEY *key = make_key();
+    s->cert = make_cert(key, s->name);
+    s->ctx = SSL_CTX_new(TLS_server_method());
+    SSL_CTX_set_max_proto_version(s->ctx, TLS1_2_VERSION);
+    SSL_CTX_use_certificate(s->ctx, s->cert);
+    SSL_CTX_use_PrivateKey(s->ctx, key);
+    SSL_CTX_set_session_cache_mode(s->ctx, SSL_SESS_CACHE_SERVER);
+    SSL_CTX_set_session_id_context(s->ctx, (const unsigned char *)s->name, (unsigned)strlen(s->name));
+    EVP_PKEY_free(key);
+
+    s->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(s->listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+    bind(s->listen_fd, (struct sockaddr *)&addr, sizeof(addr));
+    socklen_t len = sizeof(addr);
+    getsockname(s->listen_fd, (struct sockaddr *)&addr, &len);
+    s->port = ntohs(addr.sin_port);
+    listen(s->listen_fd, 16);
+    pthread_t t;
+    pthread_create(&t, NULL, server_accept_fn, s);
+    pthread_detach(t);
+}
+
+// --- Client backend: OpenSSL, simulated clock ---
+
+typedef struct {
+    SSL_CTX *ctx;
+    pthread_mutex_t mutex;
+    uint64_t clock_offset_us;
+    // Persistent session store (NVS on the device)
+    struct {
+        char key[HTTP_HOST_MAX + 8];
+        uint8_t blob[HTTP_SESSION_MAX];
+        size_t len;
+    } store[STORE_MAX];
+    uint32_t store_writes;
+} client_t;
+
+typedef struct {
+    int fd;
+    SSL *ssl;
+} conn_t;
+
+static uint64_t mono_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+static server_t *server_for(const char *host) {
+    for (size_t i = 0; i < sizeof(servers) / sizeof(servers[0]); i++) {
+        if (strcmp(servers[i].name, host) == 0) return &servers[i];
+    }
+    return NULL;
+}
+
+static void *be_connect(void *ctx, const char *host, uint16_t port, bool tls, const uint8_t *session,
+                        size_t session_len, bool *resumed) {
+    client_t *c = ctx;
+    server_t *s = server_for(host);
+    if (!s || !tls) return NULL;
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_port = htons((uint16_t)s->port),
+                                .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return NULL;
+    }
+    SSL *ssl = SSL_new(c->ctx);
+    SSL_set_fd(ssl, fd);
+    SSL_set_tlsext_host_name(ssl, host);
+    SSL_set1_host(ssl, host);
+    if (session) {
+        const unsigned char *p = session;
+        SSL_SESSION *sess = d2i_SSL_SESSION(NULL, &p, (long)session_len);
+        if (sess) {
+            SSL_set_session(ssl, sess);
+            SSL_SESSION_free(sess);
+        }
+    }
+    if (SSL_connect(ssl) != 1) {
+        ERR_print_errors_fp(stderr);
+        SSL_free(ssl);
+        close(fd);
+        return NULL;
+    }
+    *resumed = SSL_session_reused(ssl);
+    conn_t *conn = malloc(sizeof(conn_t));
+    conn->fd = fd;
+    conn->ssl = ssl;
+    return conn;
+}
+
+static int be_send(void *ctx, void *h, const void *buf, size_t len) {
+    conn_t *conn = h;
+    int n = SSL_write(conn->ssl, buf, (int)len);
+    return n > 0 ? n : -1;
+}
+
+// The local servers always answer, so no timeout
+static int be_recv(void *ctx, void *h, void *buf, size_t len, uint32_t timeout_ms) {
+    conn_t *conn = h;
+    int n = SSL_read(conn->ssl, buf, (int)len);
+    if (n > 0) return n;
+    int e = SSL_get_error(conn->ssl, n);
+    return e == SSL_ERROR_ZERO_RETURN || e == SSL_ERROR_SYSCALL ? 0 : -1;
+}
+
+static size_t be_save_session(void *ctx, void *h, uint8_t *buf, size_t cap) {
+    conn_t *conn = h;
+    SSL_SESSION *sess = SSL_get1_session(conn->ssl);
+    if (!sess) return 0;
+    int len = i2d_SSL_SESSION(sess, NULL);
+    size_t out = 0;
+    if (len > 0 && (size_t)len <= cap) {
+        unsigned char *p = buf;
+        i2d_SSL_SESSION(sess, &p);
+        out = (size_t)len;
+    }
+    SSL_SESSION_free(sess);
+    return out;
+}
+
+static void be_close(void *ctx, void *h) {
+    conn_t *conn = h;
+    SSL_shutdown(conn->ssl);
+    SSL_free(conn->ssl);
+    close(conn->fd);
+    free(conn);
+}
+
+static void be_session_saved(void *ctx, const char *key, const uint8_t *blob, size_t len) {
+    client_t *c = ctx;
+    size_t i = 0;
+    while (i < STORE_MAX - 1 && c->store[i].len && strcmp(c->store[i].key, key) != 0) i++;
+    snprintf(c->store[i].key, sizeof(c->store[i].key), "%s", key);
+    memcpy(c->store[i].blob, blob, len);
+    c->store[i].len = len;
+    c->store_writes++;
+}
+
+static void be_lock(void *ctx) {
+    pthread_mutex_lock(&((client_t *)ctx)->mutex);
+}
+
+static void be_unlock(void *ctx) {
+    pthread_mutex_unlock(&((client_t *)ctx)->mutex);
+}
+
+static uint64_t be_now_us(void *ctx) {
+    return mono_us() + ((client_t *)ctx)->clock_offset_us;
+}
+
+static uint64_t be_cpu_us(void *ctx) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+static http_pool_t *pool_new(client_t *c, uint8_t slots, uint8_t sessions) {
+    http_pool_config_t cfg = { .slots = slots, .sessions = sessions, .idle_ms = IDLE_MS, .timeout_ms = 10000 };
+    http_backend_t be = {
+        .connect = be_connect,
+        .send = be_send,
+        .recv = be_recv,
+        .save_session = be_save_session,
+        .close = be_close,
+        .session_saved = be_session_saved,
+        .lock = be_lock,
+        .unlock = be_unlock,
+        .now_us = be_now_us,
+        .cpu_us = be_cpu_us,
+        .ctx = c,
+    };
+    http_pool_t *p = http_pool_create(&cfg, &be);
+    for (size_t i = 0; p && i < STORE_MAX; i++) {
+        if (c->store[i].len) http_pool_put_session(p, c->store[i].key, c->store[i].blob, c->store[i].len);
+    }
+    return p;
+}
+
+// --- Runs ---
+
+typedef struct {
+    const char *name;
+    uint8_t slots, sessions;
+    bool reboot;
+} setup_t;
+
+static const setup_t setups[] = {
+    { "fresh", 0, 0, false },
+    { "pool", 2, 0, false },
+    { "resume", 2, 4, false },
+    { "reboot", 2, 4, true },
+    { "1 slot", 1, 4, true },
+};
+
+static bool count_body(void *arg, const uint8_t *data, size_t len) {
+    *(size_t *)arg += len;
+    return true;
+}
+
+static void run(const setup_t *s, int refreshes) {
+    client_t *c = calloc(1, sizeof(client_t));
+    pthread_mutex_init(&c->mutex, NULL);
+    track = true;
+    c->ctx = SSL_CTX_new(TLS_client_method());
+    SSL_CTX_set_max_proto_version(c->ctx, TLS1_2_VERSION);
+    SSL_CTX_set_verify(c->ctx, SSL_VERIFY_PEER, NULL);
+    SSL_CTX_set_session_cache_mode(c->ctx, SSL_SESS_CACHE_OFF);     // Sessions only via the core
+    X509_STORE *store = SSL_CTX_get_cert_store(c->ctx);
+    for (size_t i = 0; i < sizeof(servers) / sizeof(servers[0]); i++) X509_STORE_add_cert(store, servers[i].cert);
+
+    char urls[3][96];
+    snprintf(urls[0], sizeof(urls[0]), "https://wx.local:%d/v1/now?lat=52.5&lon=13.4", servers[0].port);
+    snprintf(urls[1], sizeof(urls[1]), "https://wx.local:%d/v1/forecast?lat=52.5&lon=13.4", servers[0].port);
+    snprintf(urls[2], sizeof(urls[2]), "https://sports.local:%d/v1/scores", servers[1].port);
+
+    http_pool_t *p = pool_new(c, s->slots, s->sessions);
+    uint64_t cpu = 0, wall = 0;
+    long peak_sum = 0, held_sum = 0;
+    http_pool_stats_t total = { 0 };
+    size_t bytes = 0;
+    int errors = 0;
+    for (int r = 0; r < refreshes; r++) {
+        if (r && s->reboot) {
+            http_pool_destroy(p);
+            p = pool_new(c, s->slots, s->sessions);
+        }
+        long base = atomic_load(&heap_now);
+        atomic_store(&heap_peak, base);
+        uint64_t c0 = be_cpu_us(c), t0 = mono_us();
+        for (int u = 0; u < 3; u++) {
+            if (http_get(p, urls[u], "Accept: application/json\r\n", count_body, &bytes, NULL) != HTTP_OK) errors++;
+        }
+        cpu += be_cpu_us(c) - c0;
+        wall += mono_us() - t0;
+        peak_sum += atomic_load(&heap_peak) - base;
+
+        http_pool_stats_t st;
+        http_pool_get_stats(p, &st);
+        http_pool_reset_stats(p);
+        total.requests += st.requests;
+        total.reused += st.reused;
+        total.full += st.full;
+        total.resumed += st.resumed;
+        total.retries += st.retries;
+        total.handshake_cpu_us[0] += st.handshake_cpu_us[0];
+        total.handshake_cpu_us[1] += st.handshake_cpu_us[1];
+        // Idle connections keep their buffers until the expiry timer closes them
+        long after = atomic_load(&heap_now);
+        c->clock_offset_us += REFRESH_GAP_US;
+        http_pool_expire(p);
+        held_sum += after - atomic_load(&heap_now);
+    }
+    http_pool_destroy(p);
+
+    double n = refreshes;
+    printf("%-7s %6.1f %8.1f %7.1f %8.2f %8.2f %9.1f %9.1f %6u%s\n", s->name, total.full / n, total.resumed / n,
+           total.reused / n, cpu / n / 1000, wall / n / 1000, peak_sum / n / 1024, held_sum / n / 1024,
+           c->store_writes, errors ? "  ERRORS" : "");
+    if (total.full && total.resumed) {
+        printf("        full handshake %.2f ms CPU, resumed %.2f ms\n",
+               total.handshake_cpu_us[0] / 1000.0 / total.full, total.handshake_cpu_us[1] / 1000.0 / total.resumed);
+    }
+    if (bytes != (size_t)refreshes * (2 * servers[0].body + servers[1].body)) printf("        body bytes wrong: %zu\n", bytes);
+
+    SSL_CTX_free(c->ctx);
+    track = false;
+    pthread_mutex_destroy(&c->mutex);
+    free(c);
+}
+
+int main(int argc, char **argv) {
+    int refreshes = argc > 1 ? atoi(argv[1]) : 10;
+    if (refreshes < 1) refreshes = 1;
+    CRYPTO_set_mem_functions(mem_malloc, mem_realloc, mem_free);
+    for (size_t i = 0; i < sizeof(servers) / sizeof(servers[0]); i++) server_start(&servers[i]);
+
+    printf("%d refreshes of 3 requests (2 hosts), %llu s apart; TLS 1.2, P-256 certificates\n", refreshes,
+           REFRESH_GAP_US / 1000000);
+    printf("%-7s %6s %8s %7s %8s %8s %9s %9s %6s\n", "setup", "full", "resumed", "pooled", "CPU ms", "wall ms",
+           "peak KB", "held KB", "saves");
+    printf("%-7s %6s %8s %7s %8s %8s %9s %9s %6s\n", "", "/refr", "/refr", "/refr", "/refr", "/refr", "/refr",
+           "idle", "");
+    for (size_t i = 0; i < sizeof(setups) / sizeof(setups[0]); i++) run(&setups[i], refreshes);
+    return 0;
+}
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""Decode deferred ui_apps log records ("#UL" lines) using the firmware ELF.
+
+The device only sends the addresses of the tag and format string plus raw
+32-bit arguments. This script looks those strings up in the ELF and formats
+the message on the host. Every other line is passed through unchanged.
+
+Usage:
+    idf.py monitor | tools/ui_log_decode.py build/t4-s3_base-apps.elf
+    tools/ui_log_decode.py build/t4-s3_base-apps.elf < captured.log
+
+Requires pyelftools (already part of the ESP-IDF Python environment).
+"""
+
+import argparse
+import re
+import sys
+
+from elftools.elf.elffile import ELFFile
+
+LEVELS = {1: "E", 2: "W", 3: "I", 4: "D", 5: "V"}
+
+# printf conversion: flags, width, precision, length modifier, conversion
+CONV_RE = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|z|j|t|L)?([diouxXcsp%])")
+
+
+class ElfStrings:
+    """Read NUL-terminated strings at absolute addresses from loadable sections."""
+
+    def __init__(self, path):
+        self._sections = []
+        with open(path, "rb") as f:
+            elf = ELFFile(f)
+            for sec in elf.iter_sections():
+                addr = sec["sh_addr"]
+                if addr and sec["sh_type"] == "SHT_PROGBITS":
+                    self._sections.append((addr, addr + sec["sh_size"], sec.data()))
+        self._cache = {}
+
+    def get(self, addr):
+        if addr in self._cache:
+            return self._cache[addr]
+        for start, end, data in self._sections:
+            if start <= addr < end:
+                off = addr - start
+                stop = data.find(b"\0", off)
+                text = data[off:stop if stop >= 0 else len(data)].decode("utf-8", "replace")
+                self._cache[addr] = text
+                return text
+        return None
+
+
+def to_signed(v):
+    return v - (1 << 32) if v & 0x80000000 else v
+
+
+def format_message(fmt, args, strings):
+    it = iter(args)
+
+    def repl(m):
+        flags, conv = m.group(1), m.group(2)
+        if conv == "%":
+            return "%"
+        try:
+            v = next(it)
+        except StopIteration:
+            return m.group(0)
+        if conv in "di":
+            return ("%" + flags + "d") % to_signed(v)
+        if conv == "u":
+            return ("%" + flags + "d") % v
+        if conv in "oxX":
+            return ("%" + flags + conv) % v
+        if conv == "c":
+            return chr(v & 0xFF)
+        if conv == "p":
+            return "0x%08x" % v
+        if conv == "s":
+            s = strings.get(v)
+            return ("%" + flags + "s") % (s if s is not None else "<0x%08x>" % v)
+        return m.group(0)
+
+    return CONV_RE.sub(repl, fmt)
+
+
+def decode_line(line, strings):
+    parts = line.split()
+    if len(parts) >= 2 and parts[1] == "dropped":
+        return "ui_log: %s deferred records dropped" % parts[2]
+    if len(parts) < 5:
+        return line
+    ts_us = int(parts[1], 16)
+    level = int(parts[2])
+    tag = strings.get(int(parts[3], 16)) or "?"
+    fmt = strings.get(int(parts[4], 16))
+    args = [int(a, 16) for a in parts[5:]]
+    if fmt is None:
+        msg = "<unknown fmt 0x%s> %s" % (parts[4], " ".join(parts[5:]))
+    else:
+        msg = format_message(fmt, args, strings)
+    return "%s (%d) %s: %s" % (LEVELS.get(level, "?"), ts_us // 1000, tag, msg)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="firmware ELF matching the running image")
+    args = parser.parse_args()
+
+    strings = ElfStrings(args.elf)
+    for raw in sys.stdin:
+        line = raw.rstrip("\n")
+        idx = line.find("#UL ")
+        if idx >= 0:
+            line = line[:idx] + decode_line(line[idx:], strings)
+        print(line, flush=True)
+
+
+if __name__ == "__main__":
+    main()